@@ -0,0 +1,544 @@
+/*****************************************************************************
+**																			**
+**			              Neversoft Entertainment.			                **
+**																		   	**
+**				   Copyright (C) 2000 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		Core library											**
+**																			**
+**	Module:			Job		      			 								**
+**																			**
+**	File name:		core/thread/jobsystem.cpp								**
+**																			**
+**	Description:	Work-stealing worker thread pool							**
+**																			**
+*****************************************************************************/
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#include <core/defines.h>
+#include <core/thread/jobsystem.h>
+
+#include <thread>
+
+// Workers are started and woken with the native API. std::thread heap allocates
+// its launch state and frees it from the new thread, behind the back of the
+// (single threaded) Mem manager, and <mutex> can't be used alongside the
+// operator new overloads in core/defines.h.
+#ifdef __PLAT_WN32__
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/*****************************************************************************
+**								  Externals									**
+*****************************************************************************/
+
+namespace Job
+{
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+enum
+{
+	MAX_QUEUED_JOBS		= 1024,		// per thread, must be a power of two
+	MAX_PARALLEL_BATCHES	= 64,
+};
+
+/*****************************************************************************
+**								Private Types								**
+*****************************************************************************/
+
+struct SJob
+{
+	JobFunc		mpFunc;
+	void *		mpData;
+	CCounter *	mpCounter;
+};
+
+// The owning thread pushes and pops at the tail, so it works on what it kicked
+// most recently while that is still in cache. Thieves take from the head.
+// Contention is rare enough that a lock per queue does fine.
+struct alignas( 64 ) SJobQueue
+{
+	CSpinLock	mLock;
+	uint32		mHead;
+	uint32		mTail;
+	SJob		mpJobs[MAX_QUEUED_JOBS];
+};
+
+struct SRangeBatch
+{
+	RangeFunc	mpFunc;
+	void *		mpData;
+	int			mBegin;
+	int			mEnd;
+};
+
+/*****************************************************************************
+**								 Private Data								**
+*****************************************************************************/
+
+#ifdef __PLAT_WN32__
+static HANDLE					sp_workers[MAX_WORKERS];
+#else
+static pthread_t				sp_workers[MAX_WORKERS];
+#endif
+static int						s_num_workers = 0;
+static int						s_num_queues = 1;	// set before the workers start, for stealing
+static std::atomic< bool >		s_quit( false );
+
+// One queue per thread, indexed by s_thread_index. The storage is static so
+// that neither side of a queue touches the heap.
+static SJobQueue				sp_queues[MAX_THREADS];
+
+// Counts wake ups owed to sleeping workers, one per kicked job.
+#ifdef __PLAT_WN32__
+static HANDLE					s_wake_sema = NULL;
+#else
+static pthread_mutex_t			s_wake_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t			s_wake_cond = PTHREAD_COND_INITIALIZER;
+static int						s_wake_count = 0;
+#endif
+
+static thread_local int		s_thread_index = 0;
+
+/*****************************************************************************
+**							  Private Functions								**
+*****************************************************************************/
+
+void finish_job( CCounter *p_counter )
+{
+	if( p_counter )
+	{
+		p_counter->m_pending.fetch_sub( 1, std::memory_order_acq_rel );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_push_job( const SJob &job )
+{
+	SJobQueue *p_queue = &sp_queues[s_thread_index];
+	bool pushed = false;
+
+	p_queue->mLock.Lock();
+	if( p_queue->mTail - p_queue->mHead < MAX_QUEUED_JOBS )
+	{
+		p_queue->mpJobs[p_queue->mTail & ( MAX_QUEUED_JOBS - 1 )] = job;
+		++p_queue->mTail;
+		pushed = true;
+	}
+	p_queue->mLock.Unlock();
+
+	return pushed;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_pop_job( SJob *p_job )
+{
+	SJobQueue *p_queue = &sp_queues[s_thread_index];
+	bool popped = false;
+
+	p_queue->mLock.Lock();
+	if( p_queue->mHead != p_queue->mTail )
+	{
+		--p_queue->mTail;
+		*p_job = p_queue->mpJobs[p_queue->mTail & ( MAX_QUEUED_JOBS - 1 )];
+		popped = true;
+	}
+	p_queue->mLock.Unlock();
+
+	return popped;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_steal_job( SJob *p_job )
+{
+	int num_queues = s_num_queues;
+	for( int i = 1; i < num_queues; ++i )
+	{
+		SJobQueue *p_queue = &sp_queues[( s_thread_index + i ) % num_queues];
+
+		bool stolen = false;
+		p_queue->mLock.Lock();
+		if( p_queue->mHead != p_queue->mTail )
+		{
+			*p_job = p_queue->mpJobs[p_queue->mHead & ( MAX_QUEUED_JOBS - 1 )];
+			++p_queue->mHead;
+			stolen = true;
+		}
+		p_queue->mLock.Unlock();
+
+		if( stolen )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_get_job( SJob *p_job )
+{
+	return s_pop_job( p_job ) || s_steal_job( p_job );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_wake_workers( int count )
+{
+#ifdef __PLAT_WN32__
+	ReleaseSemaphore( s_wake_sema, count, NULL );
+#else
+	pthread_mutex_lock( &s_wake_mutex );
+	s_wake_count += count;
+	pthread_mutex_unlock( &s_wake_mutex );
+	if( count == 1 )
+	{
+		pthread_cond_signal( &s_wake_cond );
+	}
+	else
+	{
+		pthread_cond_broadcast( &s_wake_cond );
+	}
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_wait_for_wake( void )
+{
+#ifdef __PLAT_WN32__
+	WaitForSingleObject( s_wake_sema, INFINITE );
+#else
+	pthread_mutex_lock( &s_wake_mutex );
+	while( s_wake_count == 0 )
+	{
+		pthread_cond_wait( &s_wake_cond, &s_wake_mutex );
+	}
+	--s_wake_count;
+	pthread_mutex_unlock( &s_wake_mutex );
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_run_job( const SJob &job )
+{
+	job.mpFunc( job.mpData );
+	finish_job( job.mpCounter );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_run_batch( void *p_data )
+{
+	SRangeBatch *p_batch = (SRangeBatch*)p_data;
+	p_batch->mpFunc( p_batch->mpData, p_batch->mBegin, p_batch->mEnd );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+#ifdef __PLAT_WN32__
+static DWORD WINAPI s_worker_main( LPVOID p_index )
+#else
+static void *s_worker_main( void *p_index )
+#endif
+{
+	s_thread_index = (int)(size_t)p_index;
+
+	for( ;; )
+	{
+		SJob job;
+		if( s_get_job( &job ))
+		{
+			s_run_job( job );
+			continue;
+		}
+
+		// Only quit once the queue has drained.
+		if( s_quit.load())
+		{
+			return 0;
+		}
+
+		s_wait_for_wake();
+	}
+}
+
+/*****************************************************************************
+**							  Public Functions								**
+*****************************************************************************/
+
+void Init( int numWorkers )
+{
+	Dbg_MsgAssert( s_num_workers == 0, ( "Job system already initialized" ));
+
+	if( numWorkers < 0 )
+	{
+		numWorkers = (int)std::thread::hardware_concurrency() - 1;
+	}
+	if( numWorkers > MAX_WORKERS )
+	{
+		numWorkers = MAX_WORKERS;
+	}
+	if( numWorkers < 0 )
+	{
+		// hardware_concurrency() can return 0 when it doesn't know
+		numWorkers = 0;
+	}
+
+	s_quit = false;
+	s_num_workers = 0;
+	for( int i = 0; i < MAX_THREADS; ++i )
+	{
+		sp_queues[i].mHead = sp_queues[i].mTail = 0;
+	}
+	s_num_queues = numWorkers + 1;
+#ifdef __PLAT_WN32__
+	s_wake_sema = CreateSemaphore( NULL, 0, 0x7fffffff, NULL );
+#else
+	s_wake_count = 0;
+#endif
+	for( int i = 0; i < numWorkers; ++i )
+	{
+#ifdef __PLAT_WN32__
+		sp_workers[i] = CreateThread( NULL, 0, s_worker_main, (LPVOID)(size_t)( i + 1 ), 0, NULL );
+		if( sp_workers[i] == NULL )
+#else
+		if( pthread_create( &sp_workers[i], NULL, s_worker_main, (void*)(size_t)( i + 1 )) != 0 )
+#endif
+		{
+			Dbg_Message( "Failed to start job worker %d", i );
+			break;
+		}
+		++s_num_workers;
+	}
+
+	Dbg_Message( "Job system started with %d worker threads", s_num_workers );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void DeInit( void )
+{
+	s_quit = true;
+	s_wake_workers( s_num_workers );
+
+	for( int i = 0; i < s_num_workers; ++i )
+	{
+#ifdef __PLAT_WN32__
+		WaitForSingleObject( sp_workers[i], INFINITE );
+		CloseHandle( sp_workers[i] );
+#else
+		pthread_join( sp_workers[i], NULL );
+#endif
+	}
+	s_num_workers = 0;
+	s_num_queues = 1;
+
+#ifdef __PLAT_WN32__
+	if( s_wake_sema )
+	{
+		CloseHandle( s_wake_sema );
+		s_wake_sema = NULL;
+	}
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int GetNumWorkers( void )
+{
+	return s_num_workers;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool IsWorkerThread( void )
+{
+	return s_thread_index > 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int GetThreadIndex( void )
+{
+	return s_thread_index;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void Kick( JobFunc func, void *p_data, CCounter *p_counter )
+{
+	Dbg_Assert( func );
+
+	if( p_counter )
+	{
+		p_counter->m_pending.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	SJob job = { func, p_data, p_counter };
+
+	if( s_num_workers == 0 )
+	{
+		s_run_job( job );
+		return;
+	}
+
+	if( s_push_job( job ))
+	{
+		s_wake_workers( 1 );
+	}
+	else
+	{
+		// Queue is full; doing the work here is as good as waiting for a slot.
+		s_run_job( job );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool RunPendingJob( void )
+{
+	SJob job;
+	if( !s_get_job( &job ))
+	{
+		return false;
+	}
+	s_run_job( job );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void Wait( CCounter *p_counter )
+{
+	Dbg_Assert( p_counter );
+
+	while( !p_counter->IsDone())
+	{
+		if( !RunPendingJob())
+		{
+			// Everything left is already running on a worker.
+			std::this_thread::yield();
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void ParallelFor( RangeFunc func, void *p_data, int count, int batchSize )
+{
+	Dbg_Assert( func );
+
+	if( count <= 0 )
+	{
+		return;
+	}
+	if( batchSize < 1 )
+	{
+		batchSize = 1;
+	}
+	if( s_num_workers == 0 || count <= batchSize )
+	{
+		func( p_data, 0, count );
+		return;
+	}
+
+	int num_batches = ( count + batchSize - 1 ) / batchSize;
+	if( num_batches > MAX_PARALLEL_BATCHES )
+	{
+		num_batches = MAX_PARALLEL_BATCHES;
+		batchSize = ( count + num_batches - 1 ) / num_batches;
+	}
+
+	// Lives on the stack, as we don't return until every batch has run.
+	SRangeBatch p_batches[MAX_PARALLEL_BATCHES];
+	CCounter counter;
+
+	// Kick all but the first, which this thread runs itself.
+	for( int b = 1; b < num_batches; ++b )
+	{
+		p_batches[b].mpFunc = func;
+		p_batches[b].mpData = p_data;
+		p_batches[b].mBegin = b * batchSize;
+		p_batches[b].mEnd = ( b + 1 ) * batchSize < count ? ( b + 1 ) * batchSize : count;
+		if( p_batches[b].mBegin < p_batches[b].mEnd )
+		{
+			Kick( s_run_batch, &p_batches[b], &counter );
+		}
+	}
+
+	func( p_data, 0, batchSize );
+	Wait( &counter );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+} // namespace Job
@@ -0,0 +1,132 @@
+/*****************************************************************************
+**																			**
+**			              Neversoft Entertainment.			                **
+**																		   	**
+**				   Copyright (C) 2000 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		Core library											**
+**																			**
+**	Module:			Job		      			 								**
+**																			**
+**	File name:		core/thread/jobsystem.h									**
+**																			**
+**	Description:	Pool of worker threads that run small fire-and-forget	**
+**					jobs. Completion is tracked with CCounter, and the		**
+**					thread that waits on a counter runs queued jobs itself	**
+**					rather than idling.										**
+**																			**
+**					Each thread has its own job queue. A thread runs the	**
+**					newest job on its own queue first, and when that is		**
+**					empty steals the oldest job from another thread's.		**
+**																			**
+**					Jobs run concurrently with the main thread, so they		**
+**					must not allocate from the Mem:: heaps (which includes	**
+**					plain new/delete), touch script or object state, or		**
+**					call anything else that is not explicitly thread safe.	**
+**					Allocate up front on the main thread instead.			**
+**																			**
+*****************************************************************************/
+
+#ifndef __CORE_THREAD_JOBSYSTEM_H
+#define __CORE_THREAD_JOBSYSTEM_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#ifndef __CORE_DEFINES_H
+#include <core/defines.h>
+#endif
+
+#include <atomic>
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+namespace Job
+{
+
+enum
+{
+	MAX_WORKERS		= 16,
+	MAX_THREADS		= MAX_WORKERS + 1,	// the workers and the main thread
+};
+
+typedef void (*JobFunc)( void *p_data );
+
+// For ParallelFor; handles items [begin, end).
+typedef void (*RangeFunc)( void *p_data, int begin, int end );
+
+/*****************************************************************************
+**							Class Definitions								**
+*****************************************************************************/
+
+// For guarding the odd small piece of state shared with jobs. Never hold
+// one across anything that could block or take a while.
+class CSpinLock
+{
+public:
+				CSpinLock()		{ m_flag.clear(); }
+
+	void		Lock()			{ while( m_flag.test_and_set( std::memory_order_acquire )) {} }
+	void		Unlock()		{ m_flag.clear( std::memory_order_release ); }
+
+private:
+				CSpinLock( const CSpinLock& );
+	CSpinLock&	operator=( const CSpinLock& );
+
+	std::atomic_flag	m_flag;
+};
+
+// Counts the jobs that have been kicked against it and not yet finished.
+class CCounter
+{
+	friend void Kick( JobFunc func, void *p_data, CCounter *p_counter );
+	friend void finish_job( CCounter *p_counter );
+
+public:
+				CCounter() : m_pending( 0 ) {}
+
+	bool		IsDone() const { return m_pending.load( std::memory_order_acquire ) == 0; }
+
+private:
+				CCounter( const CCounter& );
+	CCounter&	operator=( const CCounter& );
+
+	std::atomic< int >	m_pending;
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// numWorkers of -1 picks one less than the number of hardware threads.
+// With no workers every job simply runs inline inside Kick.
+void	Init( int numWorkers = -1 );
+void	DeInit( void );
+
+int		GetNumWorkers( void );
+bool	IsWorkerThread( void );
+
+// 0 on the main thread (and any other thread that is not a worker), 1 to
+// GetNumWorkers() on the workers. For indexing per-thread data.
+int		GetThreadIndex( void );
+
+void	Kick( JobFunc func, void *p_data, CCounter *p_counter = NULL );
+
+// Runs queued jobs on the calling thread until p_counter reaches zero.
+void	Wait( CCounter *p_counter );
+
+// Runs at most one queued job on the calling thread. Returns false if there was none.
+bool	RunPendingJob( void );
+
+// Splits [0, count) into batches of at least batchSize items, runs them across the
+// workers and the calling thread, and returns when all are done.
+void	ParallelFor( RangeFunc func, void *p_data, int count, int batchSize );
+
+} // namespace Job
+
+#endif	// __CORE_THREAD_JOBSYSTEM_H
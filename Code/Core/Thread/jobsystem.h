@@ -0,0 +1 @@
+JobSystem.h
\ No newline at end of file
@@ -43,6 +43,7 @@
 #include <core/string/stringutils.h>
 
 #include <sys/file/AsyncFilesys.h>
+#include <sys/trace.h>
 
 #include <gel/assman/assettypes.h>
 #include <gel/assman/animasset.h>
@@ -258,6 +259,8 @@ void* CAssMan::LoadAsset(const char *p_assetName, bool async_load, bool use_pip,
 
 	Dbg_MsgAssert(!AssetAllocated(p_assetName),("Asset %s already loaded",p_assetName));
 
+	Trace::CScope trace("asset","LoadAsset",p_assetName);
+
 	CAsset	* p_asset = NULL;	
 	
 // Find the asset type	
@@ -550,6 +553,28 @@ bool CAssMan::ReloadAsset( uint32 assetID, const char* pFileName, bool assertOnF
 /*                                                                */
 /******************************************************************/
 
+bool CAssMan::ReloadAsset( uint32 assetID, uint32* p_data, int data_size )
+{
+	// For when the caller has already read the new file, eg the hot reloader,
+	// which wants the loose file rather than whatever copy is in a PRE
+
+	Ass::CAsset* pAsset = this->GetAssetNode( assetID, false );
+
+	if ( pAsset )
+	{
+		return pAsset->Reload( p_data, data_size );
+	}
+	else
+	{
+		return false;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 CAsset*	CAssMan::GetAssetNode( uint32 assetID, bool assertOnFail )
 {
 	CAsset *p_asset = mp_asset_table->GetItem(assetID);
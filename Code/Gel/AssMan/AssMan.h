@@ -55,6 +55,7 @@ public:
 	void*		LoadAssetFromStream(uint32 asset_name, uint32 asset_type, uint32* p_data, int data_size, bool permanent, uint32 group);
 	void*		LoadAsset(const char *p_assetName, bool async_load, bool use_pip = false, bool permanent = false, uint32 group = 0, void* pExtraData = NULL, Script::CStruct * pParams = NULL);
 	bool		ReloadAsset( uint32 assetID, const char* pFileName, bool assertOnFail );
+	bool		ReloadAsset( uint32 assetID, uint32* p_data, int data_size );
 	void*		GetAsset(const char *p_assetName, bool assertOnFail = true);	
 	void*		GetAsset(uint32	assetID, bool assertOnFail = true);	
 	void*		LoadOrGetAsset(const char *p_assetName, bool async_load, bool use_pip, bool permanent = false, uint32 group = 0, void* pExtraData = NULL, Script::CStruct *pParams = NULL);	
@@ -13,6 +13,7 @@
 
 #include	<gfx/bonedanim.h>
 #include	<gfx/nx.h>
+#include	<gfx/nxquickanim.h>
 
 #include	<gel/scripting/symboltable.h>
 
@@ -130,6 +131,30 @@ int CAnimAsset::Reload(const char* p_file)
 /*                                                                */
 /******************************************************************/
 
+int CAnimAsset::Reload(uint32* p_data, int data_size)
+{
+	Gfx::CBonedAnimFrameData* p_anim = (Gfx::CBonedAnimFrameData*) GetData();
+	Dbg_MsgAssert(p_anim, ("Reload(): Data pointer NULL"));
+
+	// Rebuild the anim where it is, rather than unloading it and loading a new one,
+	// as the quick anims playing it hold on to the pointer.  It's still the same file.
+	uint32 file_name_crc = p_anim->GetFileNameCRC();
+	p_anim->~CBonedAnimFrameData();
+	new (p_anim) Gfx::CBonedAnimFrameData;
+
+	bool success = p_anim->Load( p_data, data_size, false, file_name_crc );
+
+	// Their cached key pointers point into the old data, though
+	Nx::CQuickAnim::sInvalidateCaches();
+
+	return success;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool CAnimAsset::LoadFinished()
 {
 	Gfx::CBonedAnimFrameData * p_anim = (Gfx::CBonedAnimFrameData*) GetData();
@@ -25,6 +25,7 @@ public:
 		virtual int 				Load(uint32* p_data, int data_size);	// create or load the asset
         virtual int 				Unload();                     // Unload the asset
         virtual int 				Reload(const char *p_file);
+		virtual int					Reload(uint32* p_data, int data_size);
 		virtual bool				LoadFinished();    // Check to make sure asset is actually there
      	virtual const char *  		Name();            // printable name, for debugging
 		virtual EAssetType 			GetType();         // type is hard wired into asset class 
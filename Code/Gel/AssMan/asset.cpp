@@ -52,6 +52,12 @@ int CAsset::Reload(const char *p_file)
 	return 0;
 }
 
+int CAsset::Reload(uint32* p_data, int data_size)
+{
+	Dbg_MsgAssert(0,("CAsset::Reload() from data buffer should not be called"));
+	return 0;
+}
+
 int 	CAsset::Unload()                  
 {
 	Dbg_MsgAssert(0,("CAsset::Unload() should not be called"));
@@ -36,6 +36,7 @@ protected:
 		virtual		int			Load(uint32* p_data, int data_size);
 		virtual    	int 		Unload();                  	// Unload the asset
 		virtual    	int 		Reload(const char *p_file);
+		virtual		int			Reload(uint32* p_data, int data_size);
 		virtual		bool		LoadFinished();				// Check to make sure asset is actually there
 
 
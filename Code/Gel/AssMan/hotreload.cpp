@@ -0,0 +1,358 @@
+///////////////////////////////////////////////////////////////////////////
+// hotreload.cpp
+//
+// Reloads loose files edited while the game is running, so content changes
+// show up without restarting the level.
+//
+// The file watcher hands over the game name of each file that changed. The
+// loose file is read here with stdio rather than through File::LoadAlloc,
+// which would look in the loaded PREs first and find the old copy, and then
+// given to whichever system has it loaded. Anything that is not loaded is
+// ignored, so saving a file for some other level does nothing.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <gel/assman/hotreload.h>
+#include <gel/assman/assman.h>
+#include <gel/mainloop.h>
+#include <gel/scripting/struct.h>
+#include <gel/scripting/symboltable.h>
+#include <gel/scripting/checksum.h>
+#include <gel/scripting/script.h>
+#include <core/crc.h>
+#include <gfx/nxtexman.h>
+#include <sk/scripting/gs_file.h>
+#include <sys/file/filewatch.h>
+#include <sys/trace.h>
+
+namespace Ass
+{
+
+/*****************************************************************************
+**							  Private Functions								**
+*****************************************************************************/
+
+static void* s_load_host_file( const char* p_path, int* p_size )
+{
+	FILE* p_file = fopen( p_path, "rb" );
+	if ( !p_file )
+	{
+		return NULL;
+	}
+
+	fseek( p_file, 0, SEEK_END );
+	int size = ftell( p_file );
+	fseek( p_file, 0, SEEK_SET );
+
+	void* p_data = NULL;
+	if ( size > 0 )
+	{
+		// Only lives until the reload is done, so keep it out of the way
+		Mem::Manager::sHandle().PushContext( Mem::Manager::sHandle().TopDownHeap() );
+		p_data = Mem::Malloc( size );
+		Mem::Manager::sHandle().PopContext();
+
+		if ( (int)fread( p_data, 1, size, p_file ) != size )
+		{
+			Mem::Free( p_data );
+			p_data = NULL;
+		}
+	}
+	fclose( p_file );
+
+	*p_size = size;
+	return p_data;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Takes the last extension off, eg "anims\\skater\\ollie.ska.xbx" -> "anims\\skater\\ollie.ska"
+static bool s_strip_extension( char* p_name )
+{
+	char* p_dot = strrchr( p_name, '.' );
+	char* p_slash = strrchr( p_name, '\\' );
+	if ( !p_dot || ( p_slash && p_dot < p_slash ) )
+	{
+		return false;
+	}
+	*p_dot = 0;
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// p_ext must be lower case.
+static bool s_has_extension( const char* p_name, const char* p_ext )
+{
+	const char* p_dot = strrchr( p_name, '.' );
+	if ( !p_dot )
+	{
+		return false;
+	}
+
+	const char* p_ch = p_dot + 1;
+	for ( ; *p_ch && *p_ext; ++p_ch, ++p_ext )
+	{
+		if ( tolower( *p_ch ) != *p_ext )
+		{
+			return false;
+		}
+	}
+	return *p_ch == *p_ext;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Texture dictionaries usually have a platform extension after the .tex
+static bool s_is_tex_dict( const char* p_fileName )
+{
+	char name[File::MAX_WATCHED_PATH_LEN];
+	strcpy( name, p_fileName );
+	return s_has_extension( name, "tex" ) || ( s_strip_extension( name ) && s_has_extension( name, "tex" ));
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_qb_loaded( const char* p_fileName )
+{
+	uint32 file_checksum = SkateScript::GenerateFileNameChecksum( p_fileName );
+
+	Script::CSymbolTableEntry* p_sym = Script::GetNextSymbolTableEntry();
+	while ( p_sym )
+	{
+		if ( p_sym->mSourceFileNameChecksum == file_checksum )
+		{
+			return true;
+		}
+		p_sym = Script::GetNextSymbolTableEntry( p_sym );
+	}
+	return false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_reload_qb( const char* p_fileName, const char* p_path )
+{
+	if ( !s_qb_loaded( p_fileName ) )
+	{
+		return false;
+	}
+
+	int size;
+	uint8* p_qb = (uint8*)s_load_host_file( p_path, &size );
+	if ( !p_qb )
+	{
+		return false;
+	}
+
+	SkateScript::ReloadQB( p_fileName, p_qb );
+	Mem::Free( p_qb );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The anim asset is named without the platform extension the file has on disk,
+// so try both with and without it.
+static bool s_reload_anim( const char* p_fileName, const char* p_path )
+{
+	CAssMan* ass_man = CAssMan::Instance();
+
+	char asset_name[File::MAX_WATCHED_PATH_LEN];
+	strcpy( asset_name, p_fileName );
+
+	uint32 asset_id = 0;
+	do
+	{
+		if ( ass_man->FindAssetType( asset_name ) == ASSET_ANIM
+			 && ass_man->AssetAllocated( Script::GenerateCRC( asset_name )))
+		{
+			asset_id = Script::GenerateCRC( asset_name );
+			break;
+		}
+	}
+	while ( s_strip_extension( asset_name ));
+
+	if ( !asset_id )
+	{
+		return false;
+	}
+
+	int size;
+	uint32* p_data = (uint32*)s_load_host_file( p_path, &size );
+	if ( !p_data )
+	{
+		return false;
+	}
+
+	bool success = ass_man->ReloadAsset( asset_id, p_data, size );
+	Mem::Free( p_data );
+	return success;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Texture dictionaries are looked up by their name with no extension at all.
+// Only the base dictionary is found, not the copies made with a texDictOffset.
+static bool s_reload_tex_dict( const char* p_fileName, const char* p_path )
+{
+	char dict_name[File::MAX_WATCHED_PATH_LEN];
+	strcpy( dict_name, p_fileName );
+
+	Nx::CTexDict* p_dict = NULL;
+	while ( !p_dict && s_strip_extension( dict_name ))
+	{
+		p_dict = Nx::CTexDictManager::sGetTextureDictionary( Crc::GenerateCRCFromString( dict_name ));
+	}
+
+	if ( !p_dict )
+	{
+		return false;
+	}
+
+	int size;
+	uint8* p_data = (uint8*)s_load_host_file( p_path, &size );
+	if ( !p_data )
+	{
+		return false;
+	}
+
+	bool success = p_dict->ReloadFromBuffer( p_data, size );
+	Mem::Free( p_data );
+	return success;
+}
+
+/*****************************************************************************
+**							  Public Functions								**
+*****************************************************************************/
+
+bool ReloadFile( const char* p_fileName, const char* p_path )
+{
+	Dbg_MsgAssert( p_fileName && p_path, ( "NULL file name" ));
+
+	Trace::CScope trace( "asset", "HotReload", p_fileName );
+
+	bool reloaded;
+	if ( s_has_extension( p_fileName, "qb" ))
+	{
+		reloaded = s_reload_qb( p_fileName, p_path );
+	}
+	else if ( s_is_tex_dict( p_fileName ))
+	{
+		reloaded = s_reload_tex_dict( p_fileName, p_path );
+	}
+	else
+	{
+		reloaded = s_reload_anim( p_fileName, p_path );
+	}
+
+	if ( reloaded )
+	{
+		Dbg_Message( "Hot reloaded %s", p_fileName );
+	}
+	return reloaded;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+DefineSingletonClass( CHotReload, "Hot Reload module" );
+
+CHotReload::CHotReload()
+{
+	mp_logic_task = new Tsk::Task< CHotReload > ( CHotReload::s_logic_code, *this );
+}
+
+CHotReload::~CHotReload()
+{
+	delete mp_logic_task;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CHotReload::v_start_cb ( void )
+{
+	Mlp::Manager * mlp_manager = Mlp::Manager::Instance();
+	mlp_manager->AddLogicTask( *mp_logic_task );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CHotReload::v_stop_cb ( void )
+{
+	mp_logic_task->Remove();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CHotReload::s_logic_code ( const Tsk::Task< CHotReload >& task )
+{
+	Dbg_AssertType ( &task, Tsk::Task< CHotReload > );
+
+	char p_name[File::MAX_WATCHED_PATH_LEN];
+	char p_path[File::MAX_WATCHED_PATH_LEN];
+	while ( File::GetNextChangedFile( p_name, p_path ))
+	{
+		ReloadFile( p_name, p_path );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | HotReloadFile | Reloads a loose file into whatever has it loaded, as if
+// the file watcher had seen it change. Works for qb, anim and texture dictionary files.
+// @parm string | name | Game file name, eg "scripts\\game\\skater.qb"
+bool ScriptHotReloadFile( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	const char* p_name = NULL;
+	pParams->GetString( CRCD(0xa1dc81f9,"name"), &p_name, Script::ASSERT );
+
+	char p_path[File::MAX_WATCHED_PATH_LEN];
+	File::GetLooseFilePath( p_name, p_path );
+	return ReloadFile( p_name, p_path );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+} // namespace Ass
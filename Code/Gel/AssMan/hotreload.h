@@ -0,0 +1,71 @@
+//****************************************************************************
+//* MODULE:         Gel/AssMan
+//* FILENAME:       hotreload.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef __GEL_HOTRELOAD_H
+#define __GEL_HOTRELOAD_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#include <core/defines.h>
+
+#ifndef __GEL_MODULE_H
+#include <gel/module.h>
+#endif
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
+namespace Ass
+{
+
+/*****************************************************************************
+**							     Type Defines								**
+*****************************************************************************/
+
+// Once a frame, reloads any loose files that the file watcher has seen change.
+// Only the changed file is read, straight off the host, so a qb or anim that is
+// also in a loaded PRE gets the new version rather than the one in the PRE.
+class CHotReload : public Mdl::Module
+{
+	DeclareSingletonClass( CHotReload );
+
+			CHotReload();
+	virtual ~CHotReload();
+
+	void v_start_cb ( void );
+	void v_stop_cb ( void );
+
+	static Tsk::Task< CHotReload >::Code s_logic_code;
+	Tsk::Task< CHotReload > *mp_logic_task;
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// Reloads a single file into whatever has it loaded:
+//   .qb			the symbols it defines are replaced, and scripts running them restarted
+//   .ska, .fam		the anim is rebuilt in place
+//   .tex			the textures in the dictionary get their new images
+// p_fileName is the game file name, p_path the file to read it from.
+// Returns false if nothing had the file loaded.
+bool	ReloadFile( const char* p_fileName, const char* p_path );
+
+bool	ScriptHotReloadFile( Script::CStruct* pParams, Script::CScript* pScript );
+
+} // namespace Ass
+
+#endif	// __GEL_HOTRELOAD_H
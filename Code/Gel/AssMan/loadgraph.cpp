@@ -0,0 +1,825 @@
+///////////////////////////////////////////////////////////////////////////
+// loadgraph.cpp
+//
+// Dependency aware level loading.
+//
+// A level load is described as a graph of nodes (PRE files, QBs, texture
+// dictionaries, anims, setup scripts) with explicit dependencies. Each node
+// is driven through the ELoadStage sequence; the worker stages of all nodes
+// are overlapped on the job system while the main thread keeps opening new
+// files and finishing nodes whose dependencies are done.
+//
+// Only the file read runs on a worker. The engine's loaders all either
+// allocate from the Mem heaps or register the result with some global table,
+// so they have to stay on the main thread, and DecodeLZSS works out of a
+// static ring buffer shared with the Pip/PRE code, so decompressing and
+// parsing are left to the FINISH stage.
+//
+// No level load goes through here yet; see CLoadGraph.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include <gel/assman/loadgraph.h>
+#include <gel/assman/assman.h>
+#include <gel/assman/assettypes.h>
+
+#include <core/crc.h>
+#include <core/thread/jobsystem.h>
+
+#include <sys/file/filesys.h>
+#include <sys/file/pip.h>
+#include <sys/file/pre.h>
+#include <sys/file/prefetch.h>
+#include <sys/trace.h>
+#include <sys/mem/memman.h>
+
+#include <gel/scripting/script.h>
+#include <gel/scripting/struct.h>
+#include <gel/scripting/array.h>
+#include <gel/scripting/file.h>
+#include <gel/scripting/checksum.h>
+
+#include <gfx/nx.h>
+#include <gfx/nxtexman.h>
+
+#include <chrono>
+#include <thread>
+
+namespace Ass
+{
+
+// Nodes handed back by the workers. Only one graph executes at a time.
+static Job::CSpinLock	s_inbox_lock;
+static CLoadNode *	sp_inbox[CLoadGraph::MAX_NODES];
+static int			s_num_inbox = 0;
+static bool			s_executing = false;
+
+static const char *sp_stage_names[NUM_LOAD_STAGES] =
+{
+	"open", "io", "finish"
+};
+
+typedef std::chrono::steady_clock CClock;
+
+static float s_elapsed_ms( CClock::time_point start )
+{
+	return std::chrono::duration< float, std::milli >( CClock::now() - start ).count();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CLoadNode::CLoadNode( const char *p_name, uint32 nameChecksum )
+{
+	Dbg_MsgAssert( p_name, ( "NULL load node name" ));
+	strncpy( mp_name, p_name, MAX_NAME_LEN - 1 );
+	mp_name[MAX_NAME_LEN - 1] = 0;
+	m_name_checksum = nameChecksum ? nameChecksum : Crc::GenerateCRCFromString( p_name );
+
+	m_num_dependencies = 0;
+	m_pending_open = 0;
+	m_pending_finish = 0;
+
+	m_stage = LOAD_STAGE_OPEN;
+	m_started = false;
+	m_failed = false;
+	m_dependency_failed = false;
+	m_in_flight = false;
+	m_parked = false;
+	m_queued = false;
+
+	for( int i = 0; i < NUM_LOAD_STAGES; ++i )
+	{
+		m_stage_time[i] = 0.0f;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CLoadNode::~CLoadNode()
+{
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CLoadNode::AddDependency( CLoadNode *p_node )
+{
+	Dbg_MsgAssert( p_node && p_node != this, ( "Bad dependency for %s", mp_name ));
+	Dbg_MsgAssert( m_num_dependencies < MAX_DEPENDENCIES, ( "Too many dependencies for %s", mp_name ));
+	mp_dependencies[m_num_dependencies++] = p_node;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool CLoadNode::IsMainThreadStage( ELoadStage stage ) const
+{
+	return stage == LOAD_STAGE_OPEN || stage == LOAD_STAGE_FINISH;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CLoadGraph::CLoadGraph()
+{
+	m_num_nodes = 0;
+	m_num_done = 0;
+	m_num_failed = 0;
+	m_num_in_flight = 0;
+	m_ready_head = 0;
+	m_ready_tail = 0;
+	m_wall_time = 0.0f;
+	for( int i = 0; i < NUM_LOAD_STAGES; ++i )
+	{
+		m_stage_time[i] = 0.0f;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CLoadGraph::~CLoadGraph()
+{
+	for( int i = 0; i < m_num_nodes; ++i )
+	{
+		delete mp_nodes[i];
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CLoadGraph::AddNode( CLoadNode *p_node )
+{
+	Dbg_MsgAssert( m_num_nodes < MAX_NODES, ( "Too many nodes in load graph" ));
+	Dbg_MsgAssert( !FindNode( p_node->GetNameChecksum()), ( "Load graph already has a node called %s", p_node->GetName()));
+	mp_nodes[m_num_nodes++] = p_node;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CLoadNode *CLoadGraph::FindNode( uint32 nameChecksum ) const
+{
+	for( int i = 0; i < m_num_nodes; ++i )
+	{
+		if( mp_nodes[i]->GetNameChecksum() == nameChecksum )
+		{
+			return mp_nodes[i];
+		}
+	}
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CLoadGraph::s_run_stage( CLoadNode *p_node, ELoadStage stage )
+{
+	CClock::time_point start = CClock::now();
+	uint64 trace_start = Trace::GetTimeUS();
+	bool ok = p_node->RunStage( stage );
+	p_node->m_stage_time[stage] += s_elapsed_ms( start );
+	Trace::AddSpan( "loadgraph", sp_stage_names[stage], p_node->GetName(), trace_start, Trace::GetTimeUS());
+
+	if( ok )
+	{
+		++p_node->m_stage;
+	}
+	else
+	{
+		p_node->m_failed = true;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Runs on a worker: carries the node through its worker stage (IO, unless
+// the node keeps that on the main thread), then hands it back.
+void CLoadGraph::s_worker_stages( void *p_data )
+{
+	CLoadNode *p_node = (CLoadNode*)p_data;
+
+	while( !p_node->m_failed &&
+		   p_node->m_stage < NUM_LOAD_STAGES &&
+		   !p_node->IsMainThreadStage((ELoadStage)p_node->m_stage ))
+	{
+		s_run_stage( p_node, (ELoadStage)p_node->m_stage );
+	}
+
+	s_inbox_lock.Lock();
+	sp_inbox[s_num_inbox++] = p_node;
+	s_inbox_lock.Unlock();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CLoadGraph::queue( CLoadNode *p_node )
+{
+	if( !p_node->m_queued )
+	{
+		p_node->m_queued = true;
+		mp_ready[m_ready_tail] = p_node;
+		m_ready_tail = ( m_ready_tail + 1 ) % MAX_NODES;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Runs main thread stages until the node either completes, has to wait for
+// its dependencies, or is passed to a worker.
+void CLoadGraph::advance( CLoadNode *p_node )
+{
+	p_node->m_started = true;
+
+	for( ;; )
+	{
+		if( p_node->m_dependency_failed )
+		{
+			p_node->m_failed = true;
+		}
+
+		if( p_node->m_failed || p_node->m_stage == NUM_LOAD_STAGES )
+		{
+			complete( p_node );
+			return;
+		}
+
+		ELoadStage stage = (ELoadStage)p_node->m_stage;
+
+		if( stage == LOAD_STAGE_FINISH && p_node->m_pending_finish )
+		{
+			p_node->m_parked = true;
+			return;
+		}
+
+		if( p_node->IsMainThreadStage( stage ))
+		{
+			s_run_stage( p_node, stage );
+			continue;
+		}
+
+		p_node->m_in_flight = true;
+		++m_num_in_flight;
+		Job::Kick( s_worker_stages, p_node );
+		return;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CLoadGraph::complete( CLoadNode *p_node )
+{
+	p_node->Cleanup();
+
+	++m_num_done;
+	if( p_node->m_failed )
+	{
+		++m_num_failed;
+		Dbg_Message( "Load graph: %s failed", p_node->GetName());
+	}
+
+	for( int s = 0; s < NUM_LOAD_STAGES; ++s )
+	{
+		m_stage_time[s] += p_node->m_stage_time[s];
+	}
+
+	// Release anything that was waiting on this node.
+	for( int i = 0; i < m_num_nodes; ++i )
+	{
+		CLoadNode *p_dependent = mp_nodes[i];
+		for( int d = 0; d < p_dependent->m_num_dependencies; ++d )
+		{
+			if( p_dependent->mp_dependencies[d] != p_node )
+			{
+				continue;
+			}
+
+			if( p_node->m_failed )
+			{
+				p_dependent->m_dependency_failed = true;
+			}
+
+			if( p_node->GatesOpen())
+			{
+				if( --p_dependent->m_pending_open == 0 && !p_dependent->m_started )
+				{
+					queue( p_dependent );
+				}
+			}
+
+			if( --p_dependent->m_pending_finish == 0 && p_dependent->m_parked )
+			{
+				p_dependent->m_parked = false;
+				queue( p_dependent );
+			}
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int CLoadGraph::Execute( void )
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "Load graphs must be executed from the main thread" ));
+	Dbg_MsgAssert( !s_executing, ( "Load graph already executing" ));
+	s_executing = true;
+
+	CClock::time_point start = CClock::now();
+
+	for( int i = 0; i < m_num_nodes; ++i )
+	{
+		CLoadNode *p_node = mp_nodes[i];
+		p_node->m_pending_open = 0;
+		p_node->m_pending_finish = p_node->m_num_dependencies;
+		for( int d = 0; d < p_node->m_num_dependencies; ++d )
+		{
+			if( p_node->mp_dependencies[d]->GatesOpen())
+			{
+				++p_node->m_pending_open;
+			}
+		}
+	}
+
+	for( int i = 0; i < m_num_nodes; ++i )
+	{
+		if( mp_nodes[i]->m_pending_open == 0 )
+		{
+			queue( mp_nodes[i] );
+		}
+	}
+
+	while( m_num_done < m_num_nodes )
+	{
+		s_inbox_lock.Lock();
+		for( int i = 0; i < s_num_inbox; ++i )
+		{
+			sp_inbox[i]->m_in_flight = false;
+			--m_num_in_flight;
+			queue( sp_inbox[i] );
+		}
+		s_num_inbox = 0;
+		s_inbox_lock.Unlock();
+
+		if( m_ready_head != m_ready_tail )
+		{
+			while( m_ready_head != m_ready_tail )
+			{
+				CLoadNode *p_node = mp_ready[m_ready_head];
+				m_ready_head = ( m_ready_head + 1 ) % MAX_NODES;
+				p_node->m_queued = false;
+				advance( p_node );
+			}
+			continue;
+		}
+
+		if( m_num_in_flight == 0 )
+		{
+			// Can't happen while dependencies must be added before their dependents.
+			Dbg_MsgAssert( 0, ( "Load graph stalled with %d of %d nodes done", m_num_done, m_num_nodes ));
+			break;
+		}
+
+		// Nothing for the main thread to do but help the workers out.
+		if( !Job::RunPendingJob())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	m_wall_time = s_elapsed_ms( start );
+	s_executing = false;
+
+	return m_num_failed;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CLoadGraph::PrintTimings( bool perNode ) const
+{
+	printf( "Load graph: %d nodes, %d failed, %.2f ms with %d workers\n", m_num_nodes, m_num_failed, m_wall_time, Job::GetNumWorkers());
+
+	if( perNode )
+	{
+		printf( "  %-40s", "" );
+		for( int s = 0; s < NUM_LOAD_STAGES; ++s )
+		{
+			printf( " %8s", sp_stage_names[s] );
+		}
+		printf( "\n" );
+
+		for( int i = 0; i < m_num_nodes; ++i )
+		{
+			printf( "  %-40s", mp_nodes[i]->GetName());
+			for( int s = 0; s < NUM_LOAD_STAGES; ++s )
+			{
+				printf( " %8.2f", mp_nodes[i]->GetStageTime((ELoadStage)s ));
+			}
+			printf( "%s\n", mp_nodes[i]->Failed() ? "  FAILED" : "" );
+		}
+	}
+
+	printf( "  %-40s", "total (ms)" );
+	for( int s = 0; s < NUM_LOAD_STAGES; ++s )
+	{
+		printf( " %8.2f", m_stage_time[s] );
+	}
+	printf( "\n" );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Base for nodes backed by a single file. Files inside a loaded PRE come out
+// of Pip on the main thread; loose files are opened and sized on the main
+// thread and then read on a worker into a buffer allocated up front.
+class CFileLoadNode : public CLoadNode
+{
+public:
+							CFileLoadNode( const char *p_fileName, uint32 nameChecksum );
+
+protected:
+	virtual bool			RunStage( ELoadStage stage );
+	virtual bool			IsMainThreadStage( ELoadStage stage ) const;
+	virtual void			Cleanup();
+
+	virtual bool			Integrate( uint8 *p_data, int size ) = 0;
+
+private:
+	void *					mp_file;
+	uint8 *					mp_data;
+	int						m_size;
+	bool					m_from_pip;
+};
+
+CFileLoadNode::CFileLoadNode( const char *p_fileName, uint32 nameChecksum ) : CLoadNode( p_fileName, nameChecksum )
+{
+	mp_file = NULL;
+	mp_data = NULL;
+	m_size = 0;
+	m_from_pip = false;
+}
+
+bool CFileLoadNode::IsMainThreadStage( ELoadStage stage ) const
+{
+	// Nothing is left to read for a file that was already in memory.
+	if( m_from_pip )
+	{
+		return true;
+	}
+	return CLoadNode::IsMainThreadStage( stage );
+}
+
+bool CFileLoadNode::RunStage( ELoadStage stage )
+{
+	switch( stage )
+	{
+		case LOAD_STAGE_OPEN:
+			if( File::PreMgr::pre_fexist( GetName()))
+			{
+				m_from_pip = true;
+				mp_data = (uint8*)Pip::Load( GetName());
+				m_size = Pip::GetFileSize( GetName());
+				return mp_data != NULL;
+			}
+
+			File::RecordFileAccess( GetName());
+			mp_file = File::Open( GetName(), "rb" );
+			if( !mp_file )
+			{
+				return false;
+			}
+			m_size = File::GetFileSize( mp_file );
+			mp_data = (uint8*)Mem::Malloc( m_size );
+			return mp_data != NULL;
+
+		case LOAD_STAGE_IO:
+			if( !m_from_pip )
+			{
+				return File::Read( mp_data, 1, m_size, mp_file ) == (size_t)m_size;
+			}
+			return true;
+
+		case LOAD_STAGE_FINISH:
+			if( mp_file )
+			{
+				File::Close( mp_file );
+				mp_file = NULL;
+			}
+			return Integrate( mp_data, m_size );
+
+		default:
+			return true;
+	}
+}
+
+void CFileLoadNode::Cleanup()
+{
+	if( mp_file )
+	{
+		File::Close( mp_file );
+		mp_file = NULL;
+	}
+
+	if( mp_data )
+	{
+		if( m_from_pip )
+		{
+			Pip::Unload( GetName());
+		}
+		else
+		{
+			Mem::Free( mp_data );
+		}
+		mp_data = NULL;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+class CQBLoadNode : public CFileLoadNode
+{
+public:
+	CQBLoadNode( const char *p_fileName, uint32 nameChecksum ) : CFileLoadNode( p_fileName, nameChecksum ) {}
+
+protected:
+	virtual bool Integrate( uint8 *p_data, int size )
+	{
+		Script::LoadQBFromMemory( GetName(), p_data, Script::ASSERT_IF_DUPLICATE_SYMBOLS );
+		return true;
+	}
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Like the other texture and anim loaders, takes the name without the
+// platform extension and appends it to find the file.
+static void s_get_platform_file_name( const char *p_name, char *p_buf, int bufSize )
+{
+	snprintf( p_buf, bufSize, "%s.%s", p_name, Nx::CEngine::sGetPlatformExtension());
+}
+
+class CTexDictLoadNode : public CFileLoadNode
+{
+public:
+	CTexDictLoadNode( const char *p_fileName, uint32 nameChecksum, uint32 dictChecksum, bool isLevelData )
+		: CFileLoadNode( p_fileName, nameChecksum ), m_dict_checksum( dictChecksum ), m_level_data( isLevelData ) {}
+
+protected:
+	virtual bool Integrate( uint8 *p_data, int size )
+	{
+		return Nx::CTexDictManager::sLoadTextureDictionary( m_dict_checksum, (uint32*)p_data, size, m_level_data ) != NULL;
+	}
+
+private:
+	uint32	m_dict_checksum;
+	bool	m_level_data;
+};
+
+class CAnimLoadNode : public CFileLoadNode
+{
+public:
+	CAnimLoadNode( const char *p_fileName, uint32 nameChecksum, uint32 assetName, bool permanent, uint32 group )
+		: CFileLoadNode( p_fileName, nameChecksum ), m_asset_name( assetName ), m_permanent( permanent ), m_group( group ) {}
+
+protected:
+	virtual bool Integrate( uint8 *p_data, int size )
+	{
+		CAssMan *p_ass_man = CAssMan::Instance();
+		if( p_ass_man->AssetAllocated( m_asset_name ))
+		{
+			return true;
+		}
+		return p_ass_man->LoadAssetFromStream( m_asset_name, ASSET_ANIM, (uint32*)p_data, size, m_permanent, m_group ) != NULL;
+	}
+
+private:
+	uint32	m_asset_name;
+	bool	m_permanent;
+	uint32	m_group;
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Loads a PRE synchronously. Anything depending on it waits before opening,
+// since its files may be inside.
+class CPreLoadNode : public CLoadNode
+{
+public:
+	CPreLoadNode( const char *p_fileName, uint32 nameChecksum ) : CLoadNode( p_fileName, nameChecksum ) {}
+
+protected:
+	virtual bool IsMainThreadStage( ELoadStage stage ) const	{ return true; }
+	virtual bool GatesOpen() const								{ return true; }
+
+	virtual bool RunStage( ELoadStage stage )
+	{
+		if( stage == LOAD_STAGE_OPEN )
+		{
+			File::PreMgr::Instance()->LoadPre( GetName(), false );
+			return File::PreMgr::Instance()->InPre( GetName());
+		}
+		return true;
+	}
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Runs a script once everything it depends on has finished, eg the level's
+// setup script after its QBs and textures are in.
+class CScriptLoadNode : public CLoadNode
+{
+public:
+	CScriptLoadNode( const char *p_name, uint32 nameChecksum, uint32 script, Script::CStruct *p_params )
+		: CLoadNode( p_name, nameChecksum ), m_script( script ), mp_params( p_params ) {}
+
+protected:
+	virtual bool IsMainThreadStage( ELoadStage stage ) const	{ return true; }
+
+	virtual bool RunStage( ELoadStage stage )
+	{
+		if( stage == LOAD_STAGE_FINISH )
+		{
+			Script::RunScript( m_script, mp_params );
+		}
+		return true;
+	}
+
+private:
+	uint32				m_script;
+	Script::CStruct *	mp_params;
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | LoadAssetGraph | Loads a set of assets, overlapping file reads
+// with each other and with the main thread work of finishing earlier assets.
+// Each node's final stage waits for the nodes it depends on, which must
+// appear earlier in the array. Anything depending on a pre node waits for
+// the PRE before opening its file, in case the file lives inside it.
+// Only the scripts that call this get the parallel load; the usual level load
+// commands are unchanged.
+// eg LoadAssetGraph nodes=[
+//		{ name=lev_pre type=pre file="pre\\foo.pre" }
+//		{ name=lev_qb type=qb file="levels\\foo\\foo.qb" deps=[lev_pre] }
+//		{ name=lev_tex type=tex file="levels\\foo\\foo" level deps=[lev_pre] }
+//		{ type=script script=foo_setup deps=[lev_qb lev_tex] } ]
+// @parm array | nodes | structures with type (pre, qb, tex, anim or script),
+// file (or script, for script nodes), and optionally name, deps, params (for
+// script nodes), level (for tex nodes), permanent and group (for anim nodes)
+// @flag timings | print the per stage load timings
+// @flag verbose | print the timings of each node too
+bool ScriptLoadAssetGraph( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	Script::CArray *p_nodes = NULL;
+	pParams->GetArray( CRCD(0xe2c2fa03,"nodes"), &p_nodes, Script::ASSERT );
+
+	CLoadGraph graph;
+
+	for( uint32 i = 0; i < p_nodes->GetSize(); ++i )
+	{
+		Script::CStruct *p_desc = p_nodes->GetStructure( i );
+
+		uint32 type = 0;
+		p_desc->GetChecksum( CRCD(0x7321a8d6,"type"), &type, Script::ASSERT );
+
+		uint32 name = 0;
+		p_desc->GetChecksum( CRCD(0xa1dc81f9,"name"), &name );
+
+		const char *p_file = NULL;
+		CLoadNode *p_node = NULL;
+		char p_full_name[256];
+
+		switch( type )
+		{
+			case 0x749ec01e:	// pre
+				p_desc->GetString( CRCD(0x7360c9ef,"file"), &p_file, Script::ASSERT );
+				p_node = new CPreLoadNode( p_file, name );
+				break;
+
+			case 0x2bbea5c3:	// qb
+				p_desc->GetString( CRCD(0x7360c9ef,"file"), &p_file, Script::ASSERT );
+				p_node = new CQBLoadNode( p_file, name );
+				break;
+
+			case 0x1512808d:	// tex
+				p_desc->GetString( CRCD(0x7360c9ef,"file"), &p_file, Script::ASSERT );
+				s_get_platform_file_name( p_file, p_full_name, sizeof( p_full_name ));
+				p_node = new CTexDictLoadNode( p_full_name, name ? name : Crc::GenerateCRCFromString( p_file ),
+											   Crc::GenerateCRCFromString( p_file ),
+											   p_desc->ContainsFlag( CRCD(0x651533ec,"level") ));
+				break;
+
+			case 0x98549ba4:	// anim
+			{
+				p_desc->GetString( CRCD(0x7360c9ef,"file"), &p_file, Script::ASSERT );
+				int group = 0;
+				p_desc->GetInteger( CRCD(0x923fbb3a,"group"), &group );
+				s_get_platform_file_name( p_file, p_full_name, sizeof( p_full_name ));
+				p_node = new CAnimLoadNode( p_full_name, name ? name : Script::GenerateCRC( p_file ),
+											Script::GenerateCRC( p_file ),
+											p_desc->ContainsFlag( CRCD(0x23627fd7,"permanent") ), group );
+				break;
+			}
+
+			case 0xe37e78c5:	// script
+			{
+				uint32 script = 0;
+				p_desc->GetChecksum( CRCD(0xe37e78c5,"script"), &script, Script::ASSERT );
+				Script::CStruct *p_script_params = NULL;
+				p_desc->GetStructure( CRCD(0x7031f10c,"params"), &p_script_params );
+				p_node = new CScriptLoadNode( Script::FindChecksumName( script ), name ? name : script, script, p_script_params );
+				break;
+			}
+
+			default:
+				Dbg_MsgAssert( 0, ( "Unknown load graph node type %s", Script::FindChecksumName( type )));
+				continue;
+		}
+
+		Script::CArray *p_deps = NULL;
+		if( p_desc->GetArray( CRCD(0xc2d0100c,"deps"), &p_deps ))
+		{
+			for( uint32 d = 0; d < p_deps->GetSize(); ++d )
+			{
+				CLoadNode *p_dep = graph.FindNode( p_deps->GetChecksum( d ));
+				Dbg_MsgAssert( p_dep, ( "%s depends on %s, which is not earlier in the graph",
+										p_node->GetName(), Script::FindChecksumName( p_deps->GetChecksum( d ))));
+				if( p_dep )
+				{
+					p_node->AddDependency( p_dep );
+				}
+			}
+		}
+
+		graph.AddNode( p_node );
+	}
+
+	int num_failed = graph.Execute();
+
+	if( pParams->ContainsFlag( CRCD(0xd33aba92,"timings") ) || pParams->ContainsFlag( CRCD(0xdd6ee4a1,"verbose") ))
+	{
+		graph.PrintTimings( pParams->ContainsFlag( CRCD(0xdd6ee4a1,"verbose") ));
+	}
+
+	return num_failed == 0;
+}
+
+} // namespace Ass
@@ -0,0 +1,159 @@
+//****************************************************************************
+//* MODULE:         Gel/AssMan
+//* FILENAME:       loadgraph.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef __GEL_LOADGRAPH_H
+#define __GEL_LOADGRAPH_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#include <core/defines.h>
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
+namespace Ass
+{
+
+/*****************************************************************************
+**							     Type Defines								**
+*****************************************************************************/
+
+// Every asset in a load graph goes through the same stages in order. OPEN and
+// FINISH always run on the main thread; IO runs on the job system's workers
+// unless a node says otherwise, and must then only touch the node's own,
+// already allocated, buffers.
+enum ELoadStage
+{
+	LOAD_STAGE_OPEN,			// locate the file, allocate buffers
+	LOAD_STAGE_IO,				// read the raw bytes
+	LOAD_STAGE_FINISH,			// decompress, parse and hand the data to the owning system
+	NUM_LOAD_STAGES
+};
+
+class CLoadNode
+{
+	friend class CLoadGraph;
+
+public:
+	enum
+	{
+		MAX_DEPENDENCIES	= 16,
+		MAX_NAME_LEN		= 128,
+	};
+
+							// nameChecksum is what other nodes use to refer to this one;
+							// zero means the checksum of p_name.
+							CLoadNode( const char *p_name, uint32 nameChecksum = 0 );
+	virtual					~CLoadNode();
+
+	// A node's FINISH stage never runs before the FINISH stage of everything it
+	// depends on. Dependencies that say GatesOpen() hold back OPEN as well.
+	void					AddDependency( CLoadNode *p_node );
+
+	const char *			GetName() const				{ return mp_name; }
+	uint32					GetNameChecksum() const		{ return m_name_checksum; }
+	bool					Failed() const				{ return m_failed; }
+	float					GetStageTime( ELoadStage stage ) const { return m_stage_time[stage]; }
+
+protected:
+	// Returns false on failure, in which case the remaining stages are skipped,
+	// as is the FINISH stage of anything depending on this node.
+	virtual bool			RunStage( ELoadStage stage ) = 0;
+	virtual bool			IsMainThreadStage( ELoadStage stage ) const;
+
+	// True for nodes (eg PRE files) that other nodes need before they can even open.
+	virtual bool			GatesOpen() const			{ return false; }
+
+	// Always called on the main thread once the node is done, failed or not.
+	virtual void			Cleanup()					{}
+
+private:
+	char					mp_name[MAX_NAME_LEN];
+	uint32					m_name_checksum;
+
+	CLoadNode *				mp_dependencies[MAX_DEPENDENCIES];
+	int						m_num_dependencies;
+	int						m_pending_open;
+	int						m_pending_finish;
+
+	int						m_stage;
+	bool					m_started;
+	bool					m_failed;
+	bool					m_dependency_failed;
+	bool					m_in_flight;
+	bool					m_parked;		// waiting on dependencies before FINISH
+	bool					m_queued;		// in the graph's ready queue
+
+	float					m_stage_time[NUM_LOAD_STAGES];	// milliseconds
+};
+
+// Runs a set of CLoadNodes to completion, overlapping the file reads of
+// independent nodes with each other and with main thread stages.
+//
+// This is only the infrastructure.  Nothing builds one of these by itself; the level
+// load scripts still call LoadPreFile, LoadQB, LoadScene and friends one after another,
+// and level loads are no faster until they use LoadAssetGraph instead.
+class CLoadGraph
+{
+public:
+	enum
+	{
+		MAX_NODES	= 512,
+	};
+
+							CLoadGraph();
+							~CLoadGraph();		// deletes the nodes
+
+	void					AddNode( CLoadNode *p_node );
+	CLoadNode *				FindNode( uint32 nameChecksum ) const;
+
+	// Blocks until every node is done. Returns the number of nodes that failed.
+	int						Execute( void );
+
+	void					PrintTimings( bool perNode ) const;
+
+private:
+	void					queue( CLoadNode *p_node );
+	void					advance( CLoadNode *p_node );
+	void					complete( CLoadNode *p_node );
+
+	static void				s_run_stage( CLoadNode *p_node, ELoadStage stage );
+	static void				s_worker_stages( void *p_data );
+
+	CLoadNode *				mp_nodes[MAX_NODES];
+	int						m_num_nodes;
+	int						m_num_done;
+	int						m_num_failed;
+	int						m_num_in_flight;
+
+	// Ring of nodes with main thread work to do. A node is never in it twice.
+	CLoadNode *				mp_ready[MAX_NODES];
+	int						m_ready_head;
+	int						m_ready_tail;
+
+	float					m_stage_time[NUM_LOAD_STAGES];
+	float					m_wall_time;
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+bool ScriptLoadAssetGraph( Script::CStruct *pParams, Script::CScript *pScript );
+
+} // namespace Ass
+
+#endif // __GEL_LOADGRAPH_H
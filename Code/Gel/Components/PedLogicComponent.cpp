@@ -22,6 +22,7 @@
 #include <gel/environment/terrain.h>
 
 #include <gel/object/compositeobject.h>
+#include <gel/object/neighbourgrid.h>
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/script.h>
 #include <gel/scripting/struct.h>
@@ -45,6 +46,36 @@ namespace Obj
 
 #define	vDEFAULT_RANGE (10.0f)
 #define vACTION_WEIGHT_RESOLUTION (1000)
+#define vMAX_AVOID_PEDS (16)
+
+// Tuning globals, looked up again only when a qb is reloaded (see Script::CTunable)
+static Script::CTunable< float > s_ped_skater_vert_jump_slop_distance( 0x2b5bedba /* ped_skater_vert_jump_slop_distance */, Script::ASSERT );
+static Script::CTunable< float > s_ped_skater_min_square_distance_to_skater( 0xbc2e678a /* ped_skater_min_square_distance_to_skater */, Script::ASSERT );
+static Script::CTunable< int > s_ped_skater_min_square_distance_to_waypoint( 0xfb5d106f /* ped_skater_min_square_distance_to_waypoint */, Script::ASSERT );
+static Script::CTunable< int > s_ped_skater_min_square_distance_to_crouch_for_jump( 0x52ec432f /* ped_skater_min_square_distance_to_crouch_for_jump */, Script::ASSERT );
+static Script::CTunable< float > s_ped_avoid_ped_range( 0x7a78f471 /* ped_avoid_ped_range */ );
+static Script::CTunable< float > s_ped_avoid_ped_bias( 0xd1e6177b /* ped_avoid_ped_bias */ );
+static Script::CTunable< int > s_ped_avoid_untracked_peds( 0xc14fbf14 /* ped_avoid_untracked_peds */ );
+static Script::CTunable< float > s_ped_max_y_distance_to_ignore( 0x21b13ffc /* ped_max_y_distance_to_ignore */, Script::ASSERT );
+static Script::CTunable< float > s_ped_head_on_range( 0xd2e22cec /* ped_head_on_range */, Script::ASSERT );
+static Script::CTunable< float > s_ped_max_distance_to_path( 0xa876aa2c /* ped_max_distance_to_path */, Script::ASSERT );
+static Script::CTunable< float > s_ped_min_distance_to_path( 0x81085734 /* ped_min_distance_to_path */ );
+static Script::CTunable< float > s_ped_target_node_bias( 0x57342672 /* ped_target_node_bias */, Script::ASSERT );
+static Script::CTunable< float > s_ped_walker_min_square_distance_to_dead_end( 0x65b46f32 /* ped_walker_min_square_distance_to_dead_end */, Script::ASSERT );
+static Script::CTunable< int > s_ped_skater_fade_target_bias_max_distance_square( 0x354beda1 /* ped_skater_fade_target_bias_max_distance_square */, Script::ASSERT );
+static Script::CTunable< int > s_ped_fade_target_bias_max_distance_square( 0x5b21ab0e /* ped_fade_target_bias_max_distance_square */, Script::ASSERT );
+static Script::CTunable< float > s_ped_max_angle_to_heading( 0x8c84a44d /* ped_max_angle_to_heading */, Script::ASSERT );
+static Script::CTunable< float > s_ped_whisker_decay_factor( 0x98cd0c8c /* ped_whisker_decay_factor */, Script::ASSERT );
+static Script::CTunable< float > s_ped_min_bias( 0x4aba9798 /* ped_min_bias */, Script::ASSERT );
+static Script::CTunable< int > s_ped_min_inner_path_angle( 0xfe65d822 /* ped_min_inner_path_angle */, Script::ASSERT );
+static Script::CTunable< float > s_ped_low_priority_waypoint_probability( 0xb30356f9 /* ped_low_priority_waypoint_probability */, Script::ASSERT );
+static Script::CTunable< int > s_ped_skater_grind_wobble_frames( 0xc655e887 /* ped_skater_grind_wobble_frames */, Script::ASSERT );
+static Script::CTunable< float > s_ped_skater_jump_gravity( 0xe224a5d3 /* ped_skater_jump_gravity */, Script::ASSERT );
+static Script::CTunable< float > s_ped_skater_jump_to_next_node_height_slop( 0x23f14b13 /* ped_skater_jump_to_next_node_height_slop */, Script::ASSERT );
+static Script::CTunable< float > s_ped_skater_min_180_spin_time( 0x8b381ab1 /* ped_skater_min_180_spin_time */, Script::ASSERT );
+static Script::CTunable< float > s_ped_skater_spine_rotation_slop( 0x95e91d23 /* ped_skater_spine_rotation_slop */ );
+static Script::CTunable< float > s_ped_skater_vert_rotation_time_slop( 0xc1dfc97b /* ped_skater_vert_rotation_time_slop */, Script::ASSERT );
+static Script::CTunable< float > s_ped_skater_jump_speed( 0xf1ff758a /* ped_skater_jump_speed */, Script::ASSERT );
 
 /******************************************************************/
 /*                                                                */
@@ -120,7 +151,7 @@ void CPedLogicComponent::InitFromStructure( Script::CStruct* pParams )
 
 void CPedLogicComponent::Update()
 {	
-	m_time = Tmr::FrameLength();
+	m_time = GetFrameLength();
 	
 	// BB - Switch on the state and call the appropriate update function.
 	// This step could be removed by having the logic for each state in 
@@ -321,7 +352,7 @@ CBaseComponent::EMemberFunctionResult CPedLogicComponent::CallMemberFunction( ui
 			// find the horizontal distance we need to travel
 			float distance = pt.Length() / 2;
 			// bump it up a bit so we don't miss landing
-			distance *= Script::GetFloat( CRCD( 0x2b5bedba, "ped_skater_vert_jump_slop_distance" ), Script::ASSERT );
+			distance *= s_ped_skater_vert_jump_slop_distance;
 
 			// horizontal velocity
 			Mth::Vector vh = ( distance / time ) * pt.Normalize();
@@ -498,7 +529,7 @@ void CPedLogicComponent::GenericSkaterUpdate()
 		{
 			float d = Mth::DistanceSqr( GetObject()->m_pos, pSkater->GetPos() );
 			// printf("skater dist square = %f\n", d );
-			if ( d < Script::GetFloat( CRCD( 0xbc2e678a, "ped_skater_min_square_distance_to_skater" ), Script::ASSERT ) )
+			if ( d < s_ped_skater_min_square_distance_to_skater )
 			{
 				GrindBail();
 				return;
@@ -523,7 +554,7 @@ void CPedLogicComponent::GenericSkaterUpdate()
 			pt = ped_pos_no_y - wp_to_no_y;
 		}
 		float distance_to_target_square = pt.LengthSqr();
-		int min_dist_square = Script::GetInteger( CRCD( 0xfb5d106f, "ped_skater_min_square_distance_to_waypoint" ), Script::ASSERT );
+		int min_dist_square = s_ped_skater_min_square_distance_to_waypoint;
 	
 		if ( !( m_flags & PEDLOGIC_JUMPING_TO_NODE ) )
 		{
@@ -535,7 +566,7 @@ void CPedLogicComponent::GenericSkaterUpdate()
 
 		if ( m_flags & PEDLOGIC_JUMP_AT_TO_NODE )
 		{
-			int dist_to_crouch = Script::GetInteger( CRCD( 0x52ec432f, "ped_skater_min_square_distance_to_crouch_for_jump" ), Script::ASSERT );
+			int dist_to_crouch = s_ped_skater_min_square_distance_to_crouch_for_jump;
 			if ( distance_to_target_square < dist_to_crouch )
 			{
 				// clear flag!
@@ -649,74 +680,87 @@ bool CPedLogicComponent::CheckForOtherPeds()
 	bool is_avoiding = false;
 	if ( mp_path_object_tracker )
 	{		
-		const CSmtPtr<CCompositeObject>* pp_object_list = mp_path_object_tracker->GetObjectList();
 		Mth::Matrix display_matrix = GetObject()->GetDisplayMatrix();
-		float range = Script::GetFloat( CRCD( 0x7a78f471, "ped_avoid_ped_range" ) );
-		float avoid_ped_bias = Script::GetFloat( CRCD( 0xd1e6177b, "ped_avoid_ped_bias" ) );
+		float range = s_ped_avoid_ped_range;
+		float avoid_ped_bias = s_ped_avoid_ped_bias;
 		Obj::CMotionComponent* pMotionComp = GetMotionComponentFromObject( GetObject() );
 		Dbg_Assert( pMotionComp );
 
-		for ( int i = 0; i < CPathObjectTracker::MAX_OBJECTS_PER_PATH; ++i )
+		// only the nearest few peds matter
+		bool avoid_untracked_peds = ( s_ped_avoid_untracked_peds != 0 );
+		SNeighbour p_neighbours[vMAX_AVOID_PEDS];
+		int num_neighbours = FindNearestNeighbours( GetObject()->GetPos(), range, NEIGHBOUR_TYPE( SKATE_TYPE_PED ), GetObject(), p_neighbours, vMAX_AVOID_PEDS );
+
+		for ( int i = 0; i < num_neighbours; ++i )
 		{
-			if ( pp_object_list[i] )
+			CCompositeObject* p_ob = p_neighbours[i].mpObject;
+			Obj::CMotionComponent* pObMotionComp = GetMotionComponentFromObject( p_ob );
+			if ( !pObMotionComp )
 			{
-				CCompositeObject* p_ob=pp_object_list[i].Convert();
-	
-				if ( p_ob != GetObject() )
+				continue;
+			}
+
+			// Before the neighbour grid only the peds in our path object tracker were avoided,
+			// which leaves out peds that aren't following a path.  Set ped_avoid_untracked_peds
+			// to avoid those too.
+			if ( !avoid_untracked_peds )
+			{
+				CPedLogicComponent* pObLogicComp = GetPedLogicComponentFromObject( p_ob );
+				if ( !pObLogicComp || pObLogicComp->mp_path_object_tracker != mp_path_object_tracker )
 				{
-					// ignore peds that are too far above or below
-					float max_y_dist = Script::GetFloat( CRCD(0x21b13ffc,"ped_max_y_distance_to_ignore"), Script::ASSERT );
-					if ( Mth::Abs( GetObject()->GetPos()[Y] - p_ob->GetPos()[Y] ) > max_y_dist )
-					{
-						continue;
-					}
-					
-					// ignore peds that are facing the opposite direction and walking away
-					float z_dot = Mth::DotProduct( display_matrix[Z], p_ob->GetDisplayMatrix()[Z] );
-					if ( z_dot <= 0.0f && Mth::DotProduct( display_matrix[Z], p_ob->GetPos() - GetObject()->GetPos() ) <= 0.0f )
-					{
-						// printf("walking away from each other\n");
-						continue;
-					}
-					
-					// ignore peds that are facing the same direction and going faster than us
-					Obj::CMotionComponent* pObMotionComp = GetMotionComponentFromObject( p_ob );
-					Dbg_Assert( pObMotionComp );
-					if ( z_dot > 0.0f && pObMotionComp->m_max_vel >= pMotionComp->m_max_vel )
-					{
-						// printf("he's going faster than me\n");
-						continue;
-					}
+					continue;
+				}
+			}
 
-					float d = Mth::Distance( GetObject()->GetPos(), p_ob->GetPos() );					
-					if ( d <= range )
-					{						
-						// adjust whisker
-						// find the heading
-						float theta = acosf( z_dot / ( display_matrix[Z].Length() * p_ob->GetDisplayMatrix()[Z].Length() ) );
-						
-						// printf("theta = %f\n", theta);
-						// reduce to less than 2pi.
-						if ( theta > Mth::PI * 2 )
-							theta -= Mth::PI * 2 * (int)( theta / ( Mth::PI * 2 ) );
-						// if they're coming straight at each other, we'll have to throw in some
-						// sideways bias - we don't want them to stop moving or turn around
-						// As they start to pass each other, the offset will naturally start
-						// to create its own bias
-						if ( fabs( theta - Mth::PI ) < Script::GetFloat( CRCD( 0xd2e22cec, "ped_head_on_range" ), Script::ASSERT ) )
-						{
-							// printf("he's coming right for me!\n");
-							// left by default
-							theta = Mth::PI / 2;
-							// see if we should push them right
-							// if ( theta > Mth::PI )
-							if ( ( Mth::CrossProduct( display_matrix[Z], p_ob->GetDisplayMatrix()[Z] ) )[Y] < 0 )
-								theta *= -1;
-						}
-						is_avoiding = true;
-						AddWhiskerBias( theta, avoid_ped_bias, d, range );
-					}
+			// ignore peds that are too far above or below
+			float max_y_dist = s_ped_max_y_distance_to_ignore;
+			if ( Mth::Abs( GetObject()->GetPos()[Y] - p_ob->GetPos()[Y] ) > max_y_dist )
+			{
+				continue;
+			}
+			
+			// ignore peds that are facing the opposite direction and walking away
+			float z_dot = Mth::DotProduct( display_matrix[Z], p_ob->GetDisplayMatrix()[Z] );
+			if ( z_dot <= 0.0f && Mth::DotProduct( display_matrix[Z], p_ob->GetPos() - GetObject()->GetPos() ) <= 0.0f )
+			{
+				// printf("walking away from each other\n");
+				continue;
+			}
+			
+			// ignore peds that are facing the same direction and going faster than us
+			if ( z_dot > 0.0f && pObMotionComp->m_max_vel >= pMotionComp->m_max_vel )
+			{
+				// printf("he's going faster than me\n");
+				continue;
+			}
+
+			float d = Mth::Distance( GetObject()->GetPos(), p_ob->GetPos() );					
+			if ( d <= range )
+			{						
+				// adjust whisker
+				// find the heading
+				float theta = acosf( z_dot / ( display_matrix[Z].Length() * p_ob->GetDisplayMatrix()[Z].Length() ) );
+				
+				// printf("theta = %f\n", theta);
+				// reduce to less than 2pi.
+				if ( theta > Mth::PI * 2 )
+					theta -= Mth::PI * 2 * (int)( theta / ( Mth::PI * 2 ) );
+				// if they're coming straight at each other, we'll have to throw in some
+				// sideways bias - we don't want them to stop moving or turn around
+				// As they start to pass each other, the offset will naturally start
+				// to create its own bias
+				if ( fabs( theta - Mth::PI ) < s_ped_head_on_range )
+				{
+					// printf("he's coming right for me!\n");
+					// left by default
+					theta = Mth::PI / 2;
+					// see if we should push them right
+					// if ( theta > Mth::PI )
+					if ( ( Mth::CrossProduct( display_matrix[Z], p_ob->GetDisplayMatrix()[Z] ) )[Y] < 0 )
+						theta *= -1;
 				}
+				is_avoiding = true;
+				AddWhiskerBias( theta, avoid_ped_bias, d, range );
 			}
 		}
 	}
@@ -738,7 +782,7 @@ void CPedLogicComponent::UpdatePathBias()
 	Mth::Vector ped_pos_no_y = GetObject()->m_pos;
 	ped_pos_no_y[Y] = 0.0f;
 
-	float max_dist_to_path = Script::GetFloat( CRCD( 0xa876aa2c, "ped_max_distance_to_path" ), Script::ASSERT );
+	float max_dist_to_path = s_ped_max_distance_to_path;
 	Mth::Vector ft = wp_to_no_y - wp_from_no_y;
 	Mth::Vector fp = ped_pos_no_y - wp_from_no_y;
 
@@ -774,7 +818,7 @@ void CPedLogicComponent::UpdatePathBias()
 		path_bias = 1 - ( ( max_dist_to_path - current_distance ) / max_dist_to_path );
 
 	// reset the bias to get back on the path
-	if ( current_distance > Script::GetFloat( CRCD( 0x81085734, "ped_min_distance_to_path" ) ) )
+	if ( current_distance > s_ped_min_distance_to_path )
 		AdjustBias( Mth::DegToRad( angle_to_path ), path_bias );
 }
 
@@ -794,12 +838,12 @@ bool CPedLogicComponent::UpdateTargetBias()
 	Mth::Vector pt = ped_pos_no_y - wp_to_no_y;
 	float distance_to_target_square = pt.LengthSqr();
 	
-	float target_bias = Script::GetFloat( CRCD(0x57342672,"ped_target_node_bias"), Script::ASSERT );
+	float target_bias = s_ped_target_node_bias;
 	ResetBias();
 
 	if ( m_node_next == m_node_from )
 	{
-		float min_square_distance_to_dead_end = Script::GetFloat( CRCD( 0x65b46f32, "ped_walker_min_square_distance_to_dead_end" ), Script::ASSERT );
+		float min_square_distance_to_dead_end = s_ped_walker_min_square_distance_to_dead_end;
 		if ( distance_to_target_square <= min_square_distance_to_dead_end )
 		{
 			HitWaypoint();
@@ -809,9 +853,9 @@ bool CPedLogicComponent::UpdateTargetBias()
 	{
 		int fade_bias_max_distance_square;
 		if ( m_flags & PEDLOGIC_IS_SKATER )
-			fade_bias_max_distance_square = Script::GetInteger( CRCD( 0x354beda1, "ped_skater_fade_target_bias_max_distance_square" ), Script::ASSERT );
+			fade_bias_max_distance_square = s_ped_skater_fade_target_bias_max_distance_square;
 		else
-			fade_bias_max_distance_square = Script::GetInteger( CRCD( 0x5b21ab0e, "ped_fade_target_bias_max_distance_square" ), Script::ASSERT );
+			fade_bias_max_distance_square = s_ped_fade_target_bias_max_distance_square;
 
 		if ( m_max_turn_frames && m_turn_frames >= m_max_turn_frames )
 		{
@@ -921,7 +965,7 @@ void CPedLogicComponent::UpdatePosition()
 
 /*
 	float angle_to_new_heading = atan2( x_distance, z_distance );
-	if ( fabs( angle_to_new_heading ) > Script::GetFloat( "ped_max_angle_to_heading", Script::ASSERT ) )
+	if ( fabs( angle_to_new_heading ) > s_ped_max_angle_to_heading )
 	{
 		GetObject()->GetDisplayMatrix().Rotate( mat0[Y], angle_to_new_heading );
 		// mat0.Rotate( mat0[Y], angle_to_new_heading );
@@ -1076,8 +1120,8 @@ void CPedLogicComponent::AdjustBias( float angle, float amount )
 void CPedLogicComponent::DecayWhiskerBiases()
 {
 	// multiply each whisker by the decay factor
-	float decay_factor = Script::GetFloat( CRCD( 0x98cd0c8c, "ped_whisker_decay_factor" ), Script::ASSERT );
-	float min_bias = Script::GetFloat( CRCD( 0x4aba9798, "ped_min_bias" ), Script::ASSERT );
+	float decay_factor = s_ped_whisker_decay_factor;
+	float min_bias = s_ped_min_bias;
 	for ( int i = 0; i < vNUM_WHISKERS; i++ )
 	{
 		m_whiskers[i] *= decay_factor;
@@ -1115,7 +1159,7 @@ float CPedLogicComponent::GetTotalXBias()
 		if ( total <= -1 )
 			return -1;
 	}
-	if ( fabs( total ) < Script::GetFloat( CRCD( 0x4aba9798, "ped_min_bias" ), Script::ASSERT ) )
+	if ( fabs( total ) < s_ped_min_bias )
 		total = 0;
 	// remember that we're 180 degrees out of phase
 	return total;
@@ -1151,7 +1195,7 @@ float CPedLogicComponent::GetTotalZBias()
 		if ( total <= -1 )
 			return -1;
 	}
-	if ( fabs( total ) < Script::GetFloat( CRCD( 0x4aba9798, "ped_min_bias" ), Script::ASSERT ) )
+	if ( fabs( total ) < s_ped_min_bias )
 		total = 0;
 	// return total;
 	return total;
@@ -1472,7 +1516,7 @@ void CPedLogicComponent::SelectNextWaypoint()
 	
 		int num_valid_low_choices = 0;
 		int num_valid_high_choices = 0;
-		int min_inner_angle = Script::GetInteger( CRCD( 0xfe65d822, "ped_min_inner_path_angle" ), Script::ASSERT );
+		int min_inner_angle = s_ped_min_inner_path_angle;
 		
 		// store the max angle, so we can return the best choice if we don't find any good ones
 		float max_angle = 0.0f;
@@ -1552,7 +1596,7 @@ void CPedLogicComponent::SelectNextWaypoint()
 			// decide if we should pick from a low priority or high priority node
 			if ( num_valid_high_choices && num_valid_low_choices )
 			{			
-				float low_priority_probability = Script::GetFloat( "ped_low_priority_waypoint_probability", Script::ASSERT );
+				float low_priority_probability = s_ped_low_priority_waypoint_probability;
 				Dbg_MsgAssert( low_priority_probability < 1, ( "ped_low_priority_waypoint_probability is %f", low_priority_probability ) );
 				if ( Mth::Rnd( 100 ) <= ( low_priority_probability * 100 ) )
 					find_low_priority = true;
@@ -1911,7 +1955,7 @@ void CPedLogicComponent::GrindUpdate()
 		Dbg_Assert( pAnimComp );
 		pAnimComp->SetWobbleTarget( m_grind_wobble_target, false );
 		m_grind_wobble_target = -m_grind_wobble_target;
-		m_grind_wobble_frames = Script::GetInteger( "ped_skater_grind_wobble_frames", Script::ASSERT );
+		m_grind_wobble_frames = s_ped_skater_grind_wobble_frames;
 	}
 }
 */
@@ -2064,7 +2108,7 @@ Script::CStruct* CPedLogicComponent::GetJumpParams( Script::CStruct* pNodeData,
 	// get the height and gravity
 	float height;
 	pNodeData->GetFloat( CRCD( 0x838da447, "jumpHeight" ), &height, Script::ASSERT );
-	float gravity = Script::GetFloat( CRCD( 0xe224a5d3, "ped_skater_jump_gravity" ), Script::ASSERT );
+	float gravity = s_ped_skater_jump_gravity;
 
 	float time_total;
 
@@ -2075,7 +2119,7 @@ Script::CStruct* CPedLogicComponent::GetJumpParams( Script::CStruct* pNodeData,
 		
 		if ( GetObject()->m_pos[Y] + height < m_wp_to[Y] )
 		{
-			height = m_wp_to[Y] - GetObject()->m_pos[Y] + Script::GetFloat( CRCD( 0x23f14b13, "ped_skater_jump_to_next_node_height_slop" ), Script::ASSERT );						
+			height = m_wp_to[Y] - GetObject()->m_pos[Y] + s_ped_skater_jump_to_next_node_height_slop;						
 			// Script::PrintContents( pNodeData );
 			// Dbg_MsgAssert( 0, ( "JumpToNextNode selected but jumpHeight isn't enough to reach target node." ) );
 		}		
@@ -2130,7 +2174,7 @@ Script::CStruct* CPedLogicComponent::GetJumpParams( Script::CStruct* pNodeData,
 	if ( pNodeData->ContainsFlag( CRCD( 0xb4077854, "RandomSpin" ) ) )
 	{
 		// figure the spin angle based on the time we've got
-		float min_180_time = Script::GetFloat( CRCD( 0x8b381ab1, "ped_skater_min_180_spin_time" ), Script::ASSERT );
+		float min_180_time = s_ped_skater_min_180_spin_time;
 	
 		int mult = (int)( time_total / min_180_time );
 		// cap the rotation to 720 degrees
@@ -2211,13 +2255,13 @@ Script::CStruct* CPedLogicComponent::GetJumpParams( Script::CStruct* pNodeData,
 		// initialize spine angle to current angle between ped and vert
 		Mth::Vector temp_y(0, 1, 0);
 		float spine_start = Mth::GetAngle( m_current_display_matrix[Z], temp_y );
-		m_spine_start_angle = spine_start + Script::GetFloat( CRCD(0x95e91d23,"ped_skater_spine_rotation_slop") );
+		m_spine_start_angle = spine_start + s_ped_skater_spine_rotation_slop;
 	}
 
 	if ( m_flags & PEDLOGIC_DOING_SPINE || m_flags & PEDLOGIC_DOING_VERT_ROTATION )
 	{
 		m_rot_start_matrix = m_current_display_matrix;
-		m_rot_total_time = time_total * Script::GetFloat( CRCD( 0xc1dfc97b, "ped_skater_vert_rotation_time_slop" ), Script::ASSERT );
+		m_rot_total_time = time_total * s_ped_skater_vert_rotation_time_slop;
 		m_rot_current_time = 0.0f;
 	}
 
@@ -2258,8 +2302,8 @@ void CPedLogicComponent::DoGrab( Script::CStruct* pNodeData, bool is_vert )
 		else
 		{
 			// figure out how long before we start to fall
-			float jumpSpeed = Script::GetFloat( CRCD( 0xf1ff758a, "ped_skater_jump_speed" ), Script::ASSERT );
-			float jumpGravity = Script::GetFloat( CRCD( 0xe224a5d3, "ped_skater_jump_gravity" ), Script::ASSERT );
+			float jumpSpeed = s_ped_skater_jump_speed;
+			float jumpGravity = s_ped_skater_jump_gravity;
 			float time = 2 * sqrtf( Mth::Sqr( jumpSpeed ) / Mth::Sqr( jumpGravity ) );
 			pScriptParams->AddInteger( CRCD( 0x66ced87b, "jumpTime" ), time );
 			pScriptParams->AddInteger( CRCD( 0x65b5788d, "is_jumping" ), 0 );
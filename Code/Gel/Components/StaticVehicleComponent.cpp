@@ -99,6 +99,7 @@ void CStaticVehicleComponent::Finalize()
 	Dbg_Assert(p_skeleton_component);
 	Dbg_Assert(p_skeleton_component->GetSkeleton());
 	Mth::Matrix* p_matrices = p_skeleton_component->GetSkeleton()->GetMatrices();
+	p_skeleton_component->GetSkeleton()->InvalidateMatrices();
 	for (int i = 0; i < p_skeleton_component->GetSkeleton()->GetNumBones(); i++)
 	{
 		Mth::Matrix& matrix = p_matrices[i];
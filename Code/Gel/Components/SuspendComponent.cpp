@@ -85,6 +85,8 @@ CSuspendComponent::CSuspendComponent() : CBaseComponent()
 	// however, when you change levels, it needs to be at 3
 	// I'm not sure why - it might be good to look into this later.
 	m_initial_animations = 3;	 	
+	
+	init_update_tiers( NULL );
 }
 
 /******************************************************************/
@@ -122,6 +124,8 @@ void CSuspendComponent::InitFromStructure( Script::CStruct* pParams )
 		m_never_suspend=false;
 	}
 	
+	init_update_tiers( pParams );
+	
 	// suspension can be overridden by the "NeverSuspend" flag
 	if (pParams->ContainsFlag(CRCD(0xcb839dc1,"NeverSuspend")))
 	{
@@ -177,6 +181,34 @@ void CSuspendComponent::InitFromStructure( Script::CStruct* pParams )
 	}
 }
 
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The update rate LOD tiers default to a quarter, a half and three quarters of
+// the way out to the suspend distance, or can be given in feet in the node
+void CSuspendComponent::init_update_tiers( Script::CStruct* pParams )
+{
+	static const uint32 p_tier_params[vNUM_UPDATE_TIERS - 1] =
+	{
+		CRCD(0x6839b094,"UpdateTierDist1"),
+		CRCD(0xf130e12e,"UpdateTierDist2"),
+		CRCD(0x8637d1b8,"UpdateTierDist3"),
+	};
+	
+	for (int i = 0; i < vNUM_UPDATE_TIERS - 1; i++)
+	{
+		float dist = m_suspend_distance * ( i + 1 ) / vNUM_UPDATE_TIERS;
+		if ( pParams && pParams->GetFloat( p_tier_params[i], &dist ))
+		{
+			dist *= 12.0f;
+		}
+		m_update_tier_dist_squared[i] = dist * dist;
+		Dbg_MsgAssert( i == 0 || m_update_tier_dist_squared[i] >= m_update_tier_dist_squared[i - 1], ( "UpdateTierDist%d is less than UpdateTierDist%d", i + 1, i ));
+	}
+}
+
 void	CSuspendComponent::Finalize()
 {
 	// Might be NULL, if we don't have a model
@@ -279,6 +311,7 @@ void CSuspendComponent::GetDebugInfo(Script::CStruct *p_info)
 	p_info->AddFloat(CRCD(0xc86d6795,"m_lod_dist_2"),m_lod_dist[2]);
 	p_info->AddFloat(CRCD(0xbf6a5703,"m_lod_dist_3"),m_lod_dist[3]);
 	
+	p_info->AddInteger(CRCD(0x0f0d3fea,"update_tier"),GetObject()->GetUpdateTier());
 	p_info->AddInteger(CRCD(0xd9872f4b,"SKIPLOGIC_RETURNS"),SkipLogic());
 	p_info->AddInteger(CRCD(0xd55771a6,"SKIPRENDER_RETURNS"),SkipRender());
 #endif				 
@@ -289,7 +322,9 @@ void CSuspendComponent::GetDebugInfo(Script::CStruct *p_info)
 /*                                                                */
 /******************************************************************/
 
-bool CSuspendComponent::should_animate( float *p_dist )
+// With use_update_tier, the distance interleaving is left to the caller,
+// which uses its update rate LOD tier instead
+bool CSuspendComponent::should_animate( float *p_dist, bool use_update_tier )
 {
 	bool should_animate = true;  
 
@@ -314,6 +349,11 @@ bool CSuspendComponent::should_animate( float *p_dist )
 		    should_animate = false;
 		}
 
+		else if (use_update_tier)
+		{
+			// animate, as far as distance goes
+		}
+
 		// update animation intermittently
 		// more so as distance from camera increases
 
@@ -523,6 +563,7 @@ void Manager::s_code( const Tsk::Task< Manager >& task )
 		// Set camera dist to zero for the purposes of LOD
 		p_suspend_component->m_camera_distance_squared = 0;
 		p_suspend_component->m_skip_logic = false;
+		p_suspend_component->GetObject()->SetUpdateTier(0);
 	
 		if (p_suspend_component->m_no_suspend_count)
 		{
@@ -551,6 +592,15 @@ void Manager::s_code( const Tsk::Task< Manager >& task )
 			else
 			{
 				p_suspend_component->m_skip_logic = false;
+				
+				// update rate LOD, for the component types that have opted in to it
+				int tier = 0;
+				while ( tier < vNUM_UPDATE_TIERS - 1
+						&& p_suspend_component->m_camera_distance_squared > p_suspend_component->m_update_tier_dist_squared[tier] )
+				{
+					tier++;
+				}
+				p_suspend_component->GetObject()->SetUpdateTier(tier);
 			}
 		}
 		// suspend or unsuspend the object and its components
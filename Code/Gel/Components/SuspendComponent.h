@@ -86,6 +86,7 @@ private:
 	float							m_suspend_distance;
 	float							m_suspend_distance_squared; // K: For a fast distance-squared check
 	float							m_camera_distance_squared;  // current distance from camera
+	float							m_update_tier_dist_squared[vNUM_UPDATE_TIERS - 1];	// where each update rate LOD tier after the first starts
 	int								m_no_suspend_count;	// number of initial frames we cannot suspend in
 
 	CModelComponent* 				mp_model_component;
@@ -101,8 +102,9 @@ public:
 
 protected:
 	int								m_interleave;	// Mick: counter for interleaving animation at a distance
+	void							init_update_tiers( Script::CStruct* pParams );
 public:  // just for now	
-	bool							should_animate( float *p_dist = NULL );
+	bool							should_animate( float *p_dist = NULL, bool use_update_tier = false );
 };
 
 
@@ -152,7 +152,7 @@ void CVelocityComponent::Update()
 
 		cur_pos = GetObject()->GetPos();
 		vel = GetObject()->GetVel();
-		pos = cur_pos + ( GetObject()->GetVel() * 0.5f * Tmr::FrameLength());
+		pos = cur_pos + ( GetObject()->GetVel() * 0.5f * GetFrameLength());
 		GetObject()->SetPos( pos );
 	}
 }
@@ -69,6 +69,13 @@ extern bool g_CheatsEnabled;
 
 namespace Obj
 {
+
+// Tuning globals, looked up again only when a qb is reloaded (see Script::CTunable)
+static Script::CTunable< int > s_walking_debug_lines( 0xaf90c5fd /* walking_debug_lines */ );
+static Script::CTunable< float > s_start_stand( 0xee13fdb8 /* start_stand */ );
+static Script::CTunable< float > s_physics_min_wallplant_height( 0xd5349cc6 /* Physics_Min_Wallplant_Height */ );
+static Script::CTunable< float > s_physics_disallow_rewallplant_duration( 0x82135dd7 /* Physics_Disallow_Rewallplant_Duration */ );
+static Script::CTunable< float > s_skater_late_jump_slop( 0x4c2b6df3 /* Skater_Late_Jump_Slop */ );
 	const uint32 CWalkComponent::sp_state_names [ CWalkComponent::NUM_WALKING_STATES ] =
 	{
 		CRCC(0x8cf3cb28, "WALKING_GROUND"),
@@ -297,7 +304,7 @@ void CWalkComponent::Update()
 	set_camera_overrides();
 	
 	#ifdef __USER_DAN__
-	if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+	if (s_walking_debug_lines)
 	{
 		Gfx::AddDebugStar(GetObject()->GetPos(), 36.0f, MAKE_RGB(255, 255, 255), 1);
 		if (m_critical_point_offset.LengthSqr() != 0.0f)
@@ -1024,7 +1031,7 @@ void CWalkComponent::calculate_horizontal_speed_and_facing ( float &horizontal_s
 			&& desired_speed < s_get_param(CRCD(0x79d182ad, "walk_speed")))
 		{
 			decel_factor = 1.0f;
-			if (horizontal_speed > Script::GetFloat("start_stand"))
+			if (horizontal_speed > s_start_stand)
 			{
 				m_frame_event = CRCD(0x1d537eff, "Skid");
 			}
@@ -1101,7 +1108,7 @@ bool  CWalkComponent::adjust_horizonal_vel_for_environment (   )
 		if (!mp_contacts[n].in_collision)
 		{
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+			if (s_walking_debug_lines)
 			{
 				feeler.DebugLine(0, 0, 255, 1);
 			}
@@ -1125,7 +1132,7 @@ bool  CWalkComponent::adjust_horizonal_vel_for_environment (   )
 		contact = true;
 		
 		#ifdef __USER_DAN__
-		if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+		if (s_walking_debug_lines)
 		{
 			feeler.DebugLine(255, 0, 0, 1);
 		}
@@ -1498,7 +1505,7 @@ void CWalkComponent::adjust_curb_float_height (   )
 	feeler.m_end = m_pos + s_get_param(CRCD(0x11edcc52, "curb_float_feeler_length")) * feeler_direction;
     feeler.m_end[Y] += 0.5f;
 	#ifdef __USER_DAN__
-	if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+	if (s_walking_debug_lines)
 	{
 		feeler.DebugLine(0, 255, 0, 1);
 	}
@@ -1514,7 +1521,7 @@ void CWalkComponent::adjust_curb_float_height (   )
 		feeler.m_start = feeler.m_end;
 		feeler.m_start[Y] = m_pos[Y] + s_get_param(CRCD(0xcee3a3e1, "snap_up_height"));
 		#ifdef __USER_DAN__
-		if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+		if (s_walking_debug_lines)
 		{
 			feeler.DebugLine(0, 255, 255, 1);
 		}
@@ -2060,15 +2067,15 @@ void CWalkComponent::maybe_wallplant (   )
 	if (m_vertical_vel > 0.0f) return;
 					   	
 	// not when you're too near the ground
-	if (mp_state_component->m_height < Script::GetFloat(CRCD(0xd5349cc6, "Physics_Min_Wallplant_Height"))) return;
+	if (mp_state_component->m_height < s_physics_min_wallplant_height) return;
 
 	// if (Tmr::ElapsedTime(m_state_timestamp) < s_get_param(CRCD(0x2a2d65c, "min_air_before_wallplant"))) return;
 	
 	// last wallplant must not have been too recently
-	if (Tmr::ElapsedTime(mp_core_physics_component->m_last_wallplant_time_stamp) < Script::GetFloat(CRCD(0x82135dd7, "Physics_Disallow_Rewallplant_Duration"))) return;
+	if (Tmr::ElapsedTime(mp_core_physics_component->m_last_wallplant_time_stamp) < s_physics_disallow_rewallplant_duration) return;
 	
 	// no wallplants immediately after you enter air; stops wallplants during the late jump period
-	if (Tmr::ElapsedTime(m_state_timestamp) < Script::GetFloat(CRCD(0x4c2b6df3, "Skater_Late_Jump_Slop"))) return;
+	if (Tmr::ElapsedTime(m_state_timestamp) < s_skater_late_jump_slop) return;
 	
 	// identify the primary contact wall; not that we are ignoring the "feet feeler"
 	int n;
@@ -2097,7 +2104,7 @@ void CWalkComponent::maybe_wallplant (   )
 		if (!feeler.GetCollision())
 		{
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+			if (s_walking_debug_lines)
 			{
 				feeler.DebugLine(255, 255, 0, 0);
 			}
@@ -2107,7 +2114,7 @@ void CWalkComponent::maybe_wallplant (   )
 		else
 		{
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+			if (s_walking_debug_lines)
 			{
 				feeler.DebugLine(255, 0, 255, 0);
 			}
@@ -2345,7 +2352,7 @@ bool CWalkComponent::maybe_jump_low_barrier (   )
 		{
 			jumpable = true;
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+			if (s_walking_debug_lines)
 			{
 				feeler.DebugLine(0, 0, 255, 0);
 			}
@@ -2354,7 +2361,7 @@ bool CWalkComponent::maybe_jump_low_barrier (   )
 		else
 		{
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+			if (s_walking_debug_lines)
 			{
 				feeler.DebugLine(255, 0, 0, 0);
 			}
@@ -2391,7 +2398,7 @@ bool CWalkComponent::maybe_jump_low_barrier (   )
 			if (feeler.GetCollision())
 			{
 				#ifdef __USER_DAN__
-				if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+				if (s_walking_debug_lines)
 				{
 					feeler.DebugLine(255, 0, 0, 0);
 				}
@@ -2401,7 +2408,7 @@ bool CWalkComponent::maybe_jump_low_barrier (   )
 			else
 			{
 				#ifdef __USER_DAN__
-				if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+				if (s_walking_debug_lines)
 				{
 					feeler.DebugLine(0, 255, 0, 0);
 				}
@@ -3091,7 +3098,7 @@ bool CWalkComponent::determine_stand_pos ( const Mth::Vector& proposed_stand_pos
 	{
 		stand_pos = feeler.GetPoint();
 		#ifdef __USER_DAN__
-		if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+		if (s_walking_debug_lines)
 		{
 			feeler.DebugLine(100, 100, 0, 0);
 		}
@@ -3099,7 +3106,7 @@ bool CWalkComponent::determine_stand_pos ( const Mth::Vector& proposed_stand_pos
 		return true;
 	}
 	#ifdef __USER_DAN__
-	if (Script::GetInteger(CRCD(0xaf90c5fd, "walking_debug_lines")))
+	if (s_walking_debug_lines)
 	{
 		feeler.DebugLine(255, 255, 0, 0);
 	}
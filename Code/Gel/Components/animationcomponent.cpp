@@ -5,6 +5,10 @@
 //* CREATION DATE:  10/24/2002
 //****************************************************************************
 
+#include <atomic>
+#include <thread>
+#include <string.h>
+
 #include <gel/components/animationcomponent.h>
 
 #include <gel/components/modelcomponent.h>
@@ -26,6 +30,9 @@
 #include <gel/scripting/utils.h>
 #include <gel/scripting/component.h>
 
+#include <core/thread/jobsystem.h>
+
+#include <gfx/animlod.h>
 #include <gfx/baseanimcontroller.h>
 #include <gfx/bonedanim.h>
 #include <gfx/gfxutils.h>
@@ -86,6 +93,14 @@ CAnimationComponent::CAnimationComponent() : CBaseComponent()
 	m_numProceduralBones = 0;
 
 	mp_proceduralBones = NULL;
+
+	m_pending_pose = -1;
+
+	m_lod_interval = 0;
+	m_lod_frame = 0;
+	mp_lod_poses = NULL;
+	m_lod_newest_pose = -1;
+	m_num_lod_poses = 0;
 }
 
 /******************************************************************/
@@ -95,12 +110,19 @@ CAnimationComponent::CAnimationComponent() : CBaseComponent()
 	
 CAnimationComponent::~CAnimationComponent()
 {
+	cancel_pose();
+	
 	destroy_blend_channels();
 	
 	if ( mp_proceduralBones )
 	{
 		delete[] mp_proceduralBones;
 	}
+	
+	if ( mp_lod_poses )
+	{
+		delete[] mp_lod_poses;
+	}
 }
 
 /******************************************************************/
@@ -938,8 +960,18 @@ void CAnimationComponent::Update()
 	// This call determines whether the object is sufficiently far away that no animation is disabled,
 	// or possibly at an intermediate distance, interleaved. The distance from parent object to camera is cached
 	// for subsequent animation LOD calculations.
+	// The animation LOD, where the skeleton type has one, takes over from the suspend
+	// component's interleaving
 	Dbg_Assert(mp_suspend_component);
-	bool animate = mp_suspend_component->should_animate( &m_parent_object_dist_to_camera );
+	const Gfx::SAnimLOD* p_anim_lod = get_anim_lod();
+	bool animate = mp_suspend_component->should_animate( &m_parent_object_dist_to_camera, HasUpdateTiers() || p_anim_lod );
+	
+	// With the update rate LOD on, the anims above still advance every frame,
+	// but the tier decides how often the pose is worked out
+	if ( animate && !IsUpdateFrame() )
+	{
+		animate = false;
+	}
 	if ( animate )
 	{	
 		update_procedural_bones();
@@ -948,7 +980,15 @@ void CAnimationComponent::Update()
 		// for offscreen objects.
 		if ( ShouldAnimate() )
 		{
-			update_skeleton();
+			if ( p_anim_lod && !update_anim_lod( p_anim_lod ) )
+			{
+				// between poses at this level
+				extrapolate_pose();
+			}
+			else if ( !queue_pose() )
+			{
+				update_skeleton();
+			}
 		}
 	}
 }
@@ -1842,10 +1882,10 @@ uint32 CAnimationComponent::PlayAnim(Script::CStruct *pParams, Script::CScript *
 /*                                                                */
 /******************************************************************/
 
-// static workspace data
-static Gfx::CPose	sBlendPoses[vNUM_DEGENERATE_ANIMS];
-static float		sBlendValues[vNUM_DEGENERATE_ANIMS];
-static Gfx::CPose	sResultPose;
+// static workspace data, a set for each thread, for the animation job phase
+static Gfx::CPose	sBlendPoses[Job::MAX_THREADS][vNUM_DEGENERATE_ANIMS];
+static float		sBlendValues[Job::MAX_THREADS][vNUM_DEGENERATE_ANIMS];
+static Gfx::CPose	sResultPose[Job::MAX_THREADS];
 
 /******************************************************************/
 /*                                                                */
@@ -2072,31 +2112,567 @@ void CAnimationComponent::update_skeleton()
 		}
 
 		// Set the current view distance for the skeleton so that it may decide on an appropriate set of
-		// bones to use in the animation.
-		pSkeleton->SetBoneSkipDistance( m_parent_object_dist_to_camera );
+		// bones to use in the animation.  (The animation LOD has set them already.)
+		if ( !m_lod_interval )
+		{
+			pSkeleton->SetBoneSkipDistance( m_parent_object_dist_to_camera );
+		}
 
 		int numBlendChannels = m_blendChannelList.CountItems();
 
+		if ( numBlendChannels == 1 && update_shared_skeleton( pSkeleton ) )
+		{
+			return;
+		}
+
+		int thread = Job::GetThreadIndex();
+		Gfx::CPose* pBlendPoses = sBlendPoses[thread];
+		float* pBlendValues = sBlendValues[thread];
+
 		for ( int blendChannel = 0; blendChannel < numBlendChannels; blendChannel++ )
 		{
 			// this wil loop through each blend channel's animation channels
-			get_blend_channel( blendChannel, &sBlendPoses[blendChannel], &sBlendValues[blendChannel] );
+			get_blend_channel( blendChannel, &pBlendPoses[blendChannel], &pBlendValues[blendChannel] );
 		}
 
 		// TODO: Here, we could run any controllers that need to act on the final, post-blend pose...
 		if( numBlendChannels > 1 )
 		{
-			blend( &sBlendPoses[0], &sBlendValues[0], pSkeleton->GetNumBones(), &sResultPose, numBlendChannels );
-			pSkeleton->Update( &sResultPose );
+			blend( &pBlendPoses[0], &pBlendValues[0], pSkeleton->GetNumBones(), &sResultPose[thread], numBlendChannels );
+			pSkeleton->Update( &sResultPose[thread] );
 		}
 		else
 		{
 			// In the case that there is just one blend channel, there is no requirement to call the blend
 			// function, which will needlessly copy the quaternion and translation values for each bone from
 			// the sBlendPoses buffer to the sResultPose buffer. Just use the sBlendPoses buffer directly. 
-			pSkeleton->Update( &sBlendPoses[0] );
+			pSkeleton->Update( &pBlendPoses[0] );
+		}
+
+		if ( m_lod_interval > 1 )
+		{
+			record_lod_pose( ( numBlendChannels > 1 ) ? &sResultPose[thread] : &pBlendPoses[0], pSkeleton->GetNumBones() );
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The skeleton type's animation LOD, if it has one
+const Gfx::SAnimLOD* CAnimationComponent::get_anim_lod()
+{
+	const Gfx::SAnimLOD* p_anim_lod = NULL;
+	if ( mp_skeleton_component && mp_skeleton_component->GetSkeleton() )
+	{
+		p_anim_lod = Gfx::GetAnimLOD( mp_skeleton_component->GetSkeletonName() );
+	}
+
+	if ( !p_anim_lod && m_lod_interval )
+	{
+		// turned off from script
+		end_anim_lod();
+	}
+	return p_anim_lod;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Picks the level from how big the object is on screen, and sets the skeleton up for it.
+// True if the pose is to be worked out this frame.
+bool CAnimationComponent::update_anim_lod( const Gfx::SAnimLOD* p_anim_lod )
+{
+	Gfx::CSkeleton* pSkeleton = mp_skeleton_component->GetSkeleton();
+
+	float radius = 0.0f;
+	Nx::CModel* p_model = mp_model_component->GetModel();
+	if ( p_model )
+	{
+		radius = p_model->GetBoundingSphere()[W];
+	}
+
+	float screen_size = Gfx::GetProjectedScreenSize( m_parent_object_dist_to_camera, radius );
+	const Gfx::SAnimLODLevel* p_level = Gfx::GetAnimLODLevel( p_anim_lod, screen_size );
+
+	pSkeleton->SetBoneSkipIndex( p_level->mBoneSkipIndex );
+	pSkeleton->SetAnimQuality( p_level->mQuality );
+
+	m_lod_interval = p_level->mInterval;
+	m_lod_frame = (uint32)Tmr::GetRenderFrame();
+	if ( m_lod_interval == 1 )
+	{
+		// nothing to extrapolate at the full rate, and the poses would be out of date
+		// by the time the level drops again
+		m_num_lod_poses = 0;
+		return true;
+	}
+
+	if ( !mp_lod_poses )
+	{
+		mp_lod_poses = new Gfx::CPose[2];
+		m_num_lod_poses = 0;
+	}
+
+	// Staggered by the object ID, so that they don't all work out their poses on the same frame
+	return (( m_lod_frame + GetObject()->GetID() ) & ( m_lod_interval - 1 )) == 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CAnimationComponent::end_anim_lod()
+{
+	m_lod_interval = 0;
+	m_num_lod_poses = 0;
+	if ( mp_lod_poses )
+	{
+		delete[] mp_lod_poses;
+		mp_lod_poses = NULL;
+	}
+
+	mp_skeleton_component->GetSkeleton()->SetAnimQuality( Gfx::ANIM_QUALITY_NLERP );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// From update_skeleton(), which may be on a job, so it only touches the component
+void CAnimationComponent::record_lod_pose( const Gfx::CPose* pPose, int numBones )
+{
+	if ( !mp_lod_poses )
+	{
+		return;
+	}
+
+	int slot = ( m_lod_newest_pose + 1 ) & 1;
+	memcpy( mp_lod_poses[slot].m_rotations, pPose->m_rotations, numBones * sizeof( Mth::Quat ) );
+	memcpy( mp_lod_poses[slot].m_translations, pPose->m_translations, numBones * sizeof( Mth::Vector ) );
+	m_lod_pose_frame[slot] = m_lod_frame;
+	m_lod_newest_pose = slot;
+	if ( m_num_lod_poses < 2 )
+	{
+		m_num_lod_poses++;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Between poses, carries on the way the last two were going, for up to as long again;
+// after that (the object was off screen, say) it holds the last pose.
+void CAnimationComponent::extrapolate_pose()
+{
+	if ( m_num_lod_poses < 2 || m_pending_pose >= 0 )
+	{
+		return;
+	}
+
+	int newest = m_lod_newest_pose;
+	int oldest = newest ^ 1;
+	int span = (int)( m_lod_pose_frame[newest] - m_lod_pose_frame[oldest] );
+	int since = (int)( m_lod_frame - m_lod_pose_frame[newest] );
+	if ( span <= 0 || since <= 0 || since > span )
+	{
+		return;
+	}
+	float alpha = 1.0f + (float)since / (float)span;
+
+	Gfx::CSkeleton* pSkeleton = mp_skeleton_component->GetSkeleton();
+	Gfx::CPose* pResultPose = &sResultPose[Job::GetThreadIndex()];
+	const Gfx::CPose* pOldPose = &mp_lod_poses[oldest];
+	const Gfx::CPose* pNewPose = &mp_lod_poses[newest];
+
+	int numBones = pSkeleton->GetNumBones();
+	for ( int b = 0; b < numBones; b++ )
+	{
+		Mth::Quat q0 = pOldPose->m_rotations[b];
+		Mth::Quat q1 = pNewPose->m_rotations[b];
+		pResultPose->m_rotations[b] = Mth::FastSlerp( q0, q1, alpha );
+		pResultPose->m_translations[b] = Mth::Lerp( pOldPose->m_translations[b], pNewPose->m_translations[b], alpha );
+	}
+
+	pSkeleton->Update( pResultPose );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The queue for the animation job phase.  Only the main thread adds to it, or takes
+// components out, and never while the phase is running.
+enum
+{
+	vPOSE_PENDING,
+	vPOSE_CLAIMED,				// being worked out, by a job or by whoever wanted its bones
+	vPOSE_DONE,
+};
+
+const int vMAX_PENDING_POSES = 1024;
+const int vPOSE_BATCH_SIZE = 4;
+
+struct SPendingPose
+{
+	CAnimationComponent*	mpComponent;		// NULL once destroyed
+	std::atomic< int >		mState;
+};
+
+static SPendingPose		sp_pending_poses[vMAX_PENDING_POSES];
+static int				s_num_pending_poses = 0;
+static bool				s_parallel_poses = false;
+static bool				s_queueing_poses = false;		// between sBeginPoseFrame() and sEvaluatePendingPoses()
+
+// Pose sharing.  Objects playing the same anim at the same time on the same type of
+// skeleton (crowds of peds, mostly) end up with the same pose, so the first of them to
+// work it out puts it in this table, keyed on everything it depends on (Gfx::SPoseKey),
+// along with its bone matrices, and the rest copy it.  Only for a single blend channel;
+// blends are seldom shared.  The table is emptied at the start of each frame.
+enum
+{
+	vSHARED_POSE_EMPTY,
+	vSHARED_POSE_CLAIMED,		// the key is being written
+	vSHARED_POSE_BUILDING,		// the pose is being worked out
+	vSHARED_POSE_READY,
+};
+
+const int vMAX_SHARED_POSES = 128;			// a power of two
+const int vMAX_SHARED_POSE_PROBES = 8;
+
+struct SSharedPose
+{
+	std::atomic< int >		mState;
+	Gfx::SPoseKey			mKey;
+	bool					mHasMatrices;		// if whoever worked it out had default bones
+	Gfx::CPose				mPose;
+	Mth::Matrix				mpMatrices[Gfx::vMAX_BONES];
+};
+
+static SSharedPose		sp_shared_poses[vMAX_SHARED_POSES];
+static bool				s_pose_sharing = true;
+static float			s_pose_time_quantum = 0.0f;
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static uint32 s_hash_pose_key( const Gfx::SPoseKey& key )
+{
+	uint32 time_bits;
+	memcpy( &time_bits, &key.time, sizeof( time_bits ));
+
+	uint32 hash = key.animName;
+	hash = ( hash ^ key.skeletonName ) * 16777619u;
+	hash = ( hash ^ time_bits ) * 16777619u;
+	hash = ( hash ^ ( key.flags | ( key.skipIndex << 8 ) | ( key.quality << 16 ))) * 16777619u;
+	return hash ^ ( hash >> 16 );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Returns the shared pose with *pBuild false if it's ready to copy, or with *pBuild
+// true if it's new, for the caller to work out and then mark ready.  NULL if someone
+// else is part way through working it out, or there's no room.
+static SSharedPose* s_find_shared_pose( const Gfx::SPoseKey& key, bool* pBuild )
+{
+	uint32 hash = s_hash_pose_key( key );
+	for ( int probe = 0; probe < vMAX_SHARED_POSE_PROBES; probe++ )
+	{
+		SSharedPose* p_shared = &sp_shared_poses[( hash + probe ) & ( vMAX_SHARED_POSES - 1 )];
+
+		int state = vSHARED_POSE_EMPTY;
+		if ( p_shared->mState.compare_exchange_strong( state, vSHARED_POSE_CLAIMED, std::memory_order_acquire ) )
+		{
+			p_shared->mKey = key;
+			p_shared->mState.store( vSHARED_POSE_BUILDING, std::memory_order_release );
+			*pBuild = true;
+			return p_shared;
+		}
+
+		// The key is only a few stores away
+		while ( state == vSHARED_POSE_CLAIMED )
+		{
+			state = p_shared->mState.load( std::memory_order_acquire );
+		}
+
+		if ( memcmp( &p_shared->mKey, &key, sizeof( key )) == 0 )
+		{
+			*pBuild = false;
+			return ( state == vSHARED_POSE_READY ) ? p_shared : NULL;
 		}
 	}
+
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CAnimationComponent::sSetParallelPoses( bool parallel )
+{
+	s_parallel_poses = parallel;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Called by the manager before the object updates; poses are only queued during
+// its update, so that they are sure to be worked out before the frame is rendered
+void CAnimationComponent::sBeginPoseFrame()
+{
+	s_queueing_poses = true;
+
+	for ( int i = 0; i < vMAX_SHARED_POSES; i++ )
+	{
+		sp_shared_poses[i].mState.store( vSHARED_POSE_EMPTY, std::memory_order_relaxed );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// In place of update_skeleton(), from Update(); false if the pose has to be worked out now after all
+bool CAnimationComponent::queue_pose()
+{
+	if ( !s_parallel_poses || !s_queueing_poses || Job::GetNumWorkers() == 0 || Job::IsWorkerThread() )
+	{
+		return false;
+	}
+
+	if ( m_pending_pose >= 0 )
+	{
+		// updated twice in the one frame; the phase will use the latest anim times
+		return true;
+	}
+
+	Dbg_Assert(mp_skeleton_component);
+	Gfx::CSkeleton* pSkeleton = mp_skeleton_component->GetSkeleton();
+	if ( !has_anims() || !pSkeleton || s_num_pending_poses == vMAX_PENDING_POSES )
+	{
+		return false;
+	}
+
+	SPendingPose* p_pose = &sp_pending_poses[s_num_pending_poses];
+	p_pose->mpComponent = this;
+	p_pose->mState.store( vPOSE_PENDING, std::memory_order_relaxed );
+	m_pending_pose = s_num_pending_poses++;
+
+	// The owner is the queue entry rather than the component, which might be
+	// destroyed before the skeleton is
+	pSkeleton->SetPendingPose( s_resolve_pose, p_pose );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CAnimationComponent::cancel_pose()
+{
+	if ( m_pending_pose < 0 )
+	{
+		return;
+	}
+
+	// Otherwise the skeleton goes on calling back into the queue entry, which the next
+	// frame may give to some other component.  When the object is being destroyed, the
+	// skeleton component (and its skeleton) may already have gone, in which case it's
+	// no longer in the object's list, and mp_skeleton_component can't be trusted.
+	CSkeletonComponent* p_skeleton_component = GetSkeletonComponentFromObject( GetObject() );
+	Gfx::CSkeleton* pSkeleton = p_skeleton_component ? p_skeleton_component->GetSkeleton() : NULL;
+	if ( pSkeleton )
+	{
+		pSkeleton->SetPendingPose( NULL, NULL );
+	}
+
+	sp_pending_poses[m_pending_pose].mpComponent = NULL;
+	m_pending_pose = -1;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The skeleton's pending pose hook, and the job's work; works the pose out if nobody
+// has yet, or waits for whoever is.  Working out a pose never reads another skeleton's
+// bones, so nothing can end up waiting on itself.
+void CAnimationComponent::s_resolve_pose( void* p_owner )
+{
+	SPendingPose* p_pose = (SPendingPose*)p_owner;
+	if ( !p_pose->mpComponent )
+	{
+		return;
+	}
+
+	int state = vPOSE_PENDING;
+	if ( p_pose->mState.compare_exchange_strong( state, vPOSE_CLAIMED, std::memory_order_acquire ) )
+	{
+		p_pose->mpComponent->update_skeleton();
+		p_pose->mState.store( vPOSE_DONE, std::memory_order_release );
+		return;
+	}
+
+	// A whole pose can take a while, so don't hog the core the other thread may need
+	while ( p_pose->mState.load( std::memory_order_acquire ) != vPOSE_DONE )
+	{
+		std::this_thread::yield();
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CAnimationComponent::s_evaluate_pose_batch( void* p_data, int begin, int end )
+{
+	for ( int i = begin; i < end; i++ )
+	{
+		s_resolve_pose( &sp_pending_poses[i] );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Called by the manager at the end of its update.  Works out every queued pose on
+// the job system, then takes the hooks off the skeletons, so that from here on they
+// are read as normal.  The model components hold back rendering skeletons that still
+// had a pose pending until after this (CModelComponent::sRenderDeferred()).
+void CAnimationComponent::sEvaluatePendingPoses()
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "The animation job phase must be run from the main thread" ) );
+
+	s_queueing_poses = false;
+	if ( s_num_pending_poses == 0 )
+	{
+		return;
+	}
+
+	Job::ParallelFor( s_evaluate_pose_batch, NULL, s_num_pending_poses, vPOSE_BATCH_SIZE );
+
+	for ( int i = 0; i < s_num_pending_poses; i++ )
+	{
+		CAnimationComponent* p_component = sp_pending_poses[i].mpComponent;
+		if ( !p_component )
+		{
+			continue;
+		}
+
+		Gfx::CSkeleton* pSkeleton = p_component->mp_skeleton_component->GetSkeleton();
+		if ( pSkeleton )
+		{
+			pSkeleton->SetPendingPose( NULL, NULL );
+		}
+		p_component->m_pending_pose = -1;
+		sp_pending_poses[i].mpComponent = NULL;
+	}
+	s_num_pending_poses = 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Rounding the anim times down to a multiple of the quantum gets more of them the
+// same, for a little judder
+void CAnimationComponent::sSetPoseSharing( bool enabled, float timeQuantum )
+{
+	s_pose_sharing = enabled;
+	s_pose_time_quantum = timeQuantum;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Pose sharing's part of update_skeleton(), for a single blend channel; false if the
+// pose has to be worked out as usual
+bool CAnimationComponent::update_shared_skeleton( Gfx::CSkeleton* pSkeleton )
+{
+	if ( !s_pose_sharing )
+	{
+		return false;
+	}
+
+	Gfx::CBlendChannel* pBlendChannel = (Gfx::CBlendChannel*)m_blendChannelList.GetItem( 0 );
+	if ( pBlendChannel->GetBlendValue() <= 0.0f )
+	{
+		return false;
+	}
+
+	Gfx::SPoseKey key;
+	memset( &key, 0, sizeof( key ));
+	key.skeletonName = mp_skeleton_component->GetSkeletonName();
+	key.skipIndex = pSkeleton->GetBoneSkipIndex();
+	key.quality = pSkeleton->GetAnimQuality();
+	if ( !key.skeletonName || !pBlendChannel->GetPoseKey( &key, s_pose_time_quantum ) )
+	{
+		return false;
+	}
+
+	bool build;
+	SSharedPose* p_shared = s_find_shared_pose( key, &build );
+	if ( !p_shared )
+	{
+		return false;
+	}
+
+	int numBones = pSkeleton->GetNumBones();
+	if ( build )
+	{
+		pBlendChannel->GetPoseAt( &p_shared->mPose, key.time );
+		pSkeleton->Update( &p_shared->mPose );
+
+		// Scaled or switched off bones would give everyone else this object's shape
+		p_shared->mHasMatrices = pSkeleton->HasDefaultBones();
+		if ( p_shared->mHasMatrices )
+		{
+			memcpy( p_shared->mpMatrices, pSkeleton->GetMatrices(), numBones * sizeof( Mth::Matrix ));
+		}
+		p_shared->mState.store( vSHARED_POSE_READY, std::memory_order_release );
+	}
+	else if ( p_shared->mHasMatrices && pSkeleton->HasDefaultBones() )
+	{
+		memcpy( pSkeleton->GetMatrices(), p_shared->mpMatrices, numBones * sizeof( Mth::Matrix ));
+		pSkeleton->InvalidateMatrices();
+	}
+	else
+	{
+		pSkeleton->Update( &p_shared->mPose );
+	}
+
+	if ( m_lod_interval > 1 )
+	{
+		record_lod_pose( &p_shared->mPose, numBones );
+	}
+	return true;
 }
 
 /******************************************************************/
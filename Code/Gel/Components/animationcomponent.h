@@ -27,6 +27,7 @@ namespace Gfx
 	class CBonedAnimFrameData;
 	class CPose;
 	class CProceduralBone;
+	struct SAnimLOD;
 }
 
 namespace Script
@@ -87,6 +88,21 @@ public:
 	void 							ToggleFlipState();
 	void							UpdateSkeleton();
 
+public:
+	// The animation job phase.  With it on, Update() doesn't work out the pose
+	// straight away, but queues the component, and at the end of its update the
+	// CCompositeObjectManager evaluates the blend trees and builds the bone matrices
+	// of every queued skeleton at once, on the job system.  Anything that reads one
+	// of those skeletons' bones before then gets the pose worked out on the spot.
+	static void						sSetParallelPoses( bool parallel );
+	static void						sBeginPoseFrame();
+	static void						sEvaluatePendingPoses();
+
+	// Pose sharing, on by default.  Objects whose one blend channel is playing the same
+	// anim at the same time (to within timeQuantum seconds, if it's not 0) on the same
+	// type of skeleton share the one pose and set of bone matrices each frame.
+	static void						sSetPoseSharing( bool enabled, float timeQuantum );
+
 public:
 	// CLIENT FUNCTIONS
 	void				        	PlayPrimarySequence( uint32 index, bool propagate, float start_time = 0.0f, float end_time = 1000.0f, Gfx::EAnimLoopingType loop_type = Gfx::LOOPING_CYCLE, float blend_period = 0.3f, float speed = 1.0f );
@@ -125,6 +141,18 @@ protected:
 protected:
 	bool							has_anims() { return m_animScriptName != 0; }
 	void							update_skeleton();
+	bool							update_shared_skeleton( Gfx::CSkeleton* pSkeleton );
+	bool							queue_pose();
+	void							cancel_pose();
+	static void						s_resolve_pose( void* p_owner );
+	static void						s_evaluate_pose_batch( void* p_data, int begin, int end );
+
+	// Animation LOD, for skeleton types that have it set up (see gfx/animlod.h)
+	const Gfx::SAnimLOD*			get_anim_lod();
+	bool							update_anim_lod( const Gfx::SAnimLOD* p_anim_lod );
+	void							end_anim_lod();
+	void							record_lod_pose( const Gfx::CPose* pPose, int numBones );
+	void							extrapolate_pose();
 
 	void							get_blend_channel( int blendChannel, Gfx::CPose* pResultPose, float* pBlendVal );
 	void							destroy_blend_channels();
@@ -157,6 +185,17 @@ protected:
 
 	float							m_parent_object_dist_to_camera;
 
+	int								m_pending_pose;		// into the pose queue, or -1
+
+	// The animation LOD level's frames between poses (0 with no LOD), and the
+	// last two poses worked out, to extrapolate from in between
+	int								m_lod_interval;
+	uint32							m_lod_frame;		// of this Update()
+	Gfx::CPose*						mp_lod_poses;		// two, once the interval has been more than 1
+	uint32							m_lod_pose_frame[2];
+	int								m_lod_newest_pose;
+	int								m_num_lod_poses;
+
 	// GJ:  The following used to be in the CProceduralAnimController;
 	// however, this data needs to be shared among different blend
 	// channels so I had to move it here.  Maybe there should be a 
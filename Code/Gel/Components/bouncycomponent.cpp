@@ -256,7 +256,7 @@ void CBouncyComponent::Update()
 	Mdl::Skate *	skate_mod =  Mdl::Skate::Instance();
 	uint32 numSkaters = skate_mod->GetNumSkaters( );
 
-	m_time = Tmr::FrameLength();
+	m_time = GetFrameLength();
 
 	if ( !( m_bouncyobj_flags & BOUNCYOBJ_FLAG_PLAYER_COLLISION_OFF ) )
 	{
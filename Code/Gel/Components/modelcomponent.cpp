@@ -8,6 +8,7 @@
 #include <gel/components/modelcomponent.h>
 
 #include <core/string/stringutils.h>
+#include <core/thread/jobsystem.h>
 									
 #include <gel/object/compositeobject.h>
 #include <gel/object/compositeobjectmanager.h>
@@ -43,6 +44,12 @@ namespace Obj
 {
 
 #define vMAX_PATH (512)
+
+// As many as the animation job phase queues poses for
+const int vMAX_DEFERRED_RENDERS = 1024;
+
+static CModelComponent*	sp_deferred_renders[vMAX_DEFERRED_RENDERS];
+static int				s_num_deferred_renders = 0;
     
 /******************************************************************/
 /*                                                                */
@@ -102,6 +109,7 @@ CModelComponent::CModelComponent() : CBaseComponent()
 
 	m_numLODs = 0;
 	m_isLevelObject = false;
+	m_deferred_render = -1;
 	
 	mDisplayOffset.Set();
 }
@@ -115,6 +123,11 @@ CModelComponent::~CModelComponent()
 {
     Dbg_MsgAssert( mp_model, ( "No model" ) );
     Nx::CEngine::sUninitModel( mp_model );
+	
+	if ( m_deferred_render >= 0 )
+	{
+		sp_deferred_renders[m_deferred_render] = NULL;
+	}
 }
 
 /******************************************************************/
@@ -682,71 +695,124 @@ void CModelComponent::Update()
 	{
 		
 		Dbg_MsgAssert(GetObject()->IsFinalized(),("Update() to UnFinalized Composite object %s",Script::FindChecksumName(GetObject()->GetID())));
-	
-		Mth::Matrix theDisplayMatrix;
-
-		GetDisplayMatrixWithExtraRotation( theDisplayMatrix );
-			
-//			theDisplayMatrix = GetObject()->GetDisplayMatrix();
-//			theDisplayMatrix[Mth::POS] = GetObject()->GetPos();
-//			theDisplayMatrix[Mth::POS][W] = 1.0f;
 		
-		// TODO:  The interface between different components
-		// should be more generic, maybe...
-		Gfx::CSkeleton* pSkeleton = NULL;
-		if ( mp_skeleton_component )
+		// Rendering reads the bone matrices, so if the animation job phase has yet to work
+		// the pose out, wait until it has, rather than working it out here on its own
+		if ( m_deferred_render >= 0 )
 		{
-			pSkeleton = mp_skeleton_component->GetSkeleton();
+			return;
+		}
+		Gfx::CSkeleton* pSkeleton = mp_skeleton_component ? mp_skeleton_component->GetSkeleton() : NULL;
+		if ( pSkeleton && pSkeleton->HasPendingPose() && !Job::IsWorkerThread() && s_num_deferred_renders < vMAX_DEFERRED_RENDERS )
+		{
+			m_deferred_render = s_num_deferred_renders;
+			sp_deferred_renders[s_num_deferred_renders++] = this;
+			return;
 		}
 		
-		// default to true, for skeletal cars...
-		bool should_animate = true;
+		render_model();
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CModelComponent::sRenderDeferred()
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "Deferred models must be rendered from the main thread" ) );
 	
-		if ( mp_animation_component )
+	for ( int i = 0; i < s_num_deferred_renders; i++ )
+	{
+		CModelComponent* p_component = sp_deferred_renders[i];
+		if ( !p_component )
 		{
-			// either the animation component should cache this
-			// data rather than doing the visibility test twice,
-			// or it should be able to set some member inside
-			// the model component (CModelComponent::MarkAnimationAsDirty?)
-			should_animate = mp_animation_component->ShouldAnimate();
+			continue;
 		}
-	
-	#ifdef __PLAT_NGPS__
-		// if it has LODs, then hide all the unnecessary ones
-		if ( m_numLODs > 0 )
+		
+		p_component->m_deferred_render = -1;
+		sp_deferred_renders[i] = NULL;
+		
+		// it might have been switched off since
+		if ( p_component->mp_model->GetActive() )
 		{
-			// first hide all the models, including the base one (0)
-			for ( int i = 0; i < m_numLODs + 1; i++ )
-			{
-				mp_model->HideGeom( i, true );
-			}
+			p_component->render_model();
+		}
+	}
+	s_num_deferred_renders = 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CModelComponent::render_model()
+{
+	Mth::Matrix theDisplayMatrix;
+
+	GetDisplayMatrixWithExtraRotation( theDisplayMatrix );
+		
+//			theDisplayMatrix = GetObject()->GetDisplayMatrix();
+//			theDisplayMatrix[Mth::POS] = GetObject()->GetPos();
+//			theDisplayMatrix[Mth::POS][W] = 1.0f;
 	
-			// now go through and unhide the correct one
-			float distanceSqrToCamera = mp_suspend_component->GetDistanceSquaredToCamera();
-			
-	//		printf( "distance to camera: %f feet\n", sqrtf(distanceSqrToCamera)/12.0f );
+	// TODO:  The interface between different components
+	// should be more generic, maybe...
+	Gfx::CSkeleton* pSkeleton = NULL;
+	if ( mp_skeleton_component )
+	{
+		pSkeleton = mp_skeleton_component->GetSkeleton();
+	}
 	
-			bool found = false;
-			for ( int i = 0; i < m_numLODs; i++ )
-			{
-				if ( distanceSqrToCamera < ( m_LODdist[i] * m_LODdist[i] ) )
-				{
-					mp_model->HideGeom( i, false );
-					found = true;
-				}
-			}
-			if ( !found )
+	// default to true, for skeletal cars...
+	bool should_animate = true;
+
+	if ( mp_animation_component )
+	{
+		// either the animation component should cache this
+		// data rather than doing the visibility test twice,
+		// or it should be able to set some member inside
+		// the model component (CModelComponent::MarkAnimationAsDirty?)
+		should_animate = mp_animation_component->ShouldAnimate();
+	}
+
+#ifdef __PLAT_NGPS__
+	// if it has LODs, then hide all the unnecessary ones
+	if ( m_numLODs > 0 )
+	{
+		// first hide all the models, including the base one (0)
+		for ( int i = 0; i < m_numLODs + 1; i++ )
+		{
+			mp_model->HideGeom( i, true );
+		}
+
+		// now go through and unhide the correct one
+		float distanceSqrToCamera = mp_suspend_component->GetDistanceSquaredToCamera();
+		
+//		printf( "distance to camera: %f feet\n", sqrtf(distanceSqrToCamera)/12.0f );
+
+		bool found = false;
+		for ( int i = 0; i < m_numLODs; i++ )
+		{
+			if ( distanceSqrToCamera < ( m_LODdist[i] * m_LODdist[i] ) )
 			{
-				// then the last lod is active
-				mp_model->HideGeom( m_numLODs, false );
+				mp_model->HideGeom( i, false );
+				found = true;
 			}
 		}
-	#endif
-	
-		// TODO:  if it's offscreen, the data shouldn't be copied over either...
-	
-		mp_model->Render( &theDisplayMatrix, !should_animate, pSkeleton );
+		if ( !found )
+		{
+			// then the last lod is active
+			mp_model->HideGeom( m_numLODs, false );
+		}
 	}
+#endif
+
+	// TODO:  if it's offscreen, the data shouldn't be copied over either...
+
+	mp_model->Render( &theDisplayMatrix, !should_animate, pSkeleton );
 }
 
 /******************************************************************/
@@ -98,6 +98,10 @@ public:
 	virtual void			GetDebugInfo(Script::CStruct *p_info);
 	
 	static CBaseComponent*	s_create();
+	
+	// Renders the models whose Update() found their skeleton's pose still waiting for
+	// the animation job phase.  Called by the manager once the phase is done.
+	static void				sRenderDeferred();
 
 public:
 	void					InitModel( Script::CStruct* pParams );
@@ -120,6 +124,7 @@ public:
 protected:
 	void 					init_model_from_level_object( uint32 checksumName );
 	bool					enable_lod(uint32 componentName, float distance);
+	void					render_model();
 
 
 protected:
@@ -184,6 +189,7 @@ protected:
 	
 private:
 	bool				m_isLevelObject;	// True if it's a level object	
+	int					m_deferred_render;	// in the deferred render list, or -1
 	
 };
 
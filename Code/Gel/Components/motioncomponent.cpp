@@ -167,7 +167,7 @@ void CMotionComponent::ProcessWait( Script::CScript * pScript )
 void CMotionComponent::Update()
 {
 
-	m_time = Tmr::FrameLength();	
+	m_time = GetFrameLength();	
 	
 	if ( m_movingobj_status & MOVINGOBJ_STATUS_HOVERING )
 	{
@@ -2038,7 +2038,9 @@ bool CMotionComponent::Move( void )
 {	
 	if ( m_moveto_acceleration )
 	{
-		m_moveto_speed += m_moveto_acceleration * Tmr::FrameRatio( );
+		// the acceleration is per 60th of a second, like Tmr::FrameRatio(), but over all the
+		// frames this update covers
+		m_moveto_speed += m_moveto_acceleration * GetFrameLength() * 60.0f;
 		if ( m_moveto_speed >= m_moveto_speed_target )
 		{
 			m_moveto_speed = m_moveto_speed_target;
@@ -21,6 +21,7 @@
 
 #include <gel/object/compositeobject.h>
 #include <gel/object/compositeobjectmanager.h>
+#include <gel/object/neighbourgrid.h>
 #include <gel/collision/collcache.h>
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/script.h>
@@ -840,9 +841,37 @@ void CRigidBodyComponent::setup_contact_states (   )
 
 void CRigidBodyComponent::handle_skater_collisions (   )
 {
-	for (int n = Mdl::Skate::Instance()->GetNumSkaters(); n--; )
+	// only the local skater ever has its radius boosted (by the vehicle component)
+	float max_radius_boost = 0.0f;
+	CSkater* p_local_skater = Mdl::Skate::Instance()->GetLocalSkater();
+	if (p_local_skater)
 	{
-		CSkater& skater = *Mdl::Skate::Instance()->GetSkater(n);
+		max_radius_boost = Mth::Max(p_local_skater->GetRigidBodyCollisionRadiusBoost(), 0.0f);
+	}
+	
+	// the neighbour grid has the skaters where they were at the start of the frame, so pad the query by as far as
+	// any of them can have gone since; twice their current speed allows for them having been faster earlier in the frame
+	float max_skater_speed = 0.0f;
+	for (uint32 n = Mdl::Skate::Instance()->GetNumSkaters(); n--; )
+	{
+		CSkater* p_skater = Mdl::Skate::Instance()->GetSkater(n);
+		if (p_skater)
+		{
+			max_skater_speed = Mth::Max(max_skater_speed, p_skater->GetVel().Length());
+		}
+	}
+	
+	// a sphere around the collision cylinder
+	float query_radius = sqrtf(Mth::Sqr(m_skater_collision_radius + max_radius_boost)
+		+ Mth::Sqr(m_skater_collision_application_radius + max_radius_boost + s_skater_head_height))
+		+ 2.0f * max_skater_speed * Tmr::FrameLength();
+	
+	SNeighbour p_skaters[vRP_MAX_SKATER_COLLISIONS];
+	int num_skaters = FindNeighbours(m_pos, query_radius, NEIGHBOUR_TYPE(SKATE_TYPE_SKATER), GetObject(), p_skaters, vRP_MAX_SKATER_COLLISIONS);
+	
+	for (int n = num_skaters; n--; )
+	{
+		CSkater& skater = *static_cast< CSkater* >(p_skaters[n].mpObject);
 
 		float radius_boost = skater.GetRigidBodyCollisionRadiusBoost();
 		
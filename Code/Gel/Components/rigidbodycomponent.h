@@ -33,6 +33,7 @@
 #define vRP_DEFAULT_LINEAR_VELOCITY_SLEEP_POINT	   			(10.0f)
 #define vRP_DEFAULT_ANGULAR_VELOCITY_SLEEP_POINT   			(0.4f)
 #define vRP_DEFAULT_IGNORE_SKATER_DURATION					(5.0f / 60.0f)
+#define vRP_MAX_SKATER_COLLISIONS							(8)
 #define vRP_DEFAULT_COLLIDE_MUTE_DELAY						(1000)
 #define vRP_DEFAULT_GLOBAL_COLLIDE_MUTE_DELAY				(100)
 #define vRP_DEFAULT_BOUNCE_VELOCITY_CALLBACK_THRESHOLD		(20.0f)
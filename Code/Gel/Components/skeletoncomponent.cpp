@@ -68,6 +68,8 @@ void CSkeletonComponent::init_skeleton( uint32 skeleton_name )
 	mp_skeleton = new Gfx::CSkeleton( pSkeletonData );   
     Dbg_MsgAssert( mp_skeleton, ( "Couldn't create skeleton" ) );
 
+	m_skeleton_name = skeleton_name;
+
     Dbg_MsgAssert( mp_skeleton->GetNumBones() > 0, ( "Skeleton needs at least one bone" ) );
 }
 
@@ -81,6 +83,7 @@ CSkeletonComponent::CSkeletonComponent() : CBaseComponent()
 	SetType( CRC_SKELETON );
 
     mp_skeleton = NULL;
+	m_skeleton_name = 0;
 }
 
 /******************************************************************/
@@ -61,6 +61,7 @@ public:
 	
     static CBaseComponent*	s_create();
     Gfx::CSkeleton*         GetSkeleton();
+	uint32					GetSkeletonName() const { return m_skeleton_name; }
 
     bool					GetBonePosition( uint32 boneName, Mth::Vector* pBonePos );
 	bool					GetBoneWorldPosition( uint32 boneName, Mth::Vector* pBonePos );
@@ -73,6 +74,7 @@ protected:
 	
 protected:
     Gfx::CSkeleton*         mp_skeleton;
+	uint32					m_skeleton_name;		// the type, eg human
 };
 	
 }
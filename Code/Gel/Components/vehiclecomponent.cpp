@@ -3088,6 +3088,7 @@ void CVehicleComponent::zero_input (   )
 void CVehicleComponent::update_skeleton (   )
 {
 	Mth::Matrix* p_matrices = mp_skeleton_component->GetSkeleton()->GetMatrices();
+	mp_skeleton_component->GetSkeleton()->InvalidateMatrices();
 	for (int i = mp_skeleton_component->GetSkeleton()->GetNumBones(); i--; )
 	{
 		Mth::Matrix& matrix = p_matrices[i];
@@ -178,6 +178,11 @@ protected:
 	void						compress_table();
 	void						set_event_enable(uint32 type, bool state);
 	
+	int							find_first(uint32 type);
+	int							find_next(uint32 type, int index);
+	void						sort_table();
+	void						grow_table(int min_entries);
+	
 #ifdef	__SCRIPT_EVENT_TABLE__		
 	void						pass_event(CEvent *pEvent, Script::CScript *pScript, bool broadcast = false);
 	void						register_all(Script::CScript *p_script);
@@ -208,8 +213,15 @@ protected:
 #ifdef	__NOPT_ASSERT__
 public:
 #endif
+	// Sorted by type, so the handlers for an event are found with a binary search.  Dead
+	// entries keep their type, so they don't upset the order; compress_table() squeezes
+	// them out.  There can be spare room on the end for adding to.  Entries added while
+	// an event is being passed go on the end, as nothing can move then, and the table is
+	// sorted again before the next event.
 	Entry *						mp_tab;
 	int							m_num_entries;
+	int							m_max_entries;
+	bool						m_sorted;
 	bool						m_valid;
 	bool						m_changed;		// set if table changed while running an event
 	int							m_in_immediate_use_counter; // by pass_event()
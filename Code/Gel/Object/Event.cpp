@@ -149,7 +149,9 @@ void CEventListener::event_filter(CEvent *pEvent)
 CEventHandlerTable::CEventHandlerTable()
 {
 	m_num_entries = 0; 
+	m_max_entries = 0;
 	mp_tab = NULL;
+	m_sorted = true;
 	m_valid = true;
 	m_in_immediate_use_counter = 0;
 	m_changed = false;
@@ -216,59 +218,64 @@ void	CEventHandlerTable::AddEvent(uint32 ex, uint32 scr, uint32 group, bool exce
 {
 	Entry *p_entry = NULL;	
 
-// if there is no mp_tab, then we'll need to create a single entry one 
-	if (!mp_tab)
+	// see it it exists, and if so, then simply replace it
+	// failing that, a dead entry of the same type is already in the right place
+	for (int i = find_first(ex); i >= 0; i = find_next(ex, i))
 	{
-		m_num_entries = 1;
-		mp_tab = new Entry[1];
-		p_entry = mp_tab;
+		if (mp_tab[i].script != vDEAD_ENTRY)
+		{
+			p_entry = &mp_tab[i];
+			break;
+		}
+		if (!p_entry)
+		{
+			p_entry = &mp_tab[i];
+		}
+	}
+	
+	if (p_entry)
+	{
+		if (p_entry->p_params)
+		{
+			delete p_entry->p_params;
+		}
+	}
+	else if (m_in_immediate_use_counter)
+	{
+		// An event is being passed through the table, so nothing can move; add it on the end
+		if (m_num_entries == m_max_entries)
+		{
+			grow_table(m_num_entries + 1);
+		}
+		p_entry = &mp_tab[m_num_entries++];
+		m_sorted = false;
 	}
 	else
 	{
-	// otherwise see it it exists, and if so, then simply replace it
-		int i;
-
-		for (i = 0; i<m_num_entries; i++)
+		// make room, by getting rid of dead entries if there are any
+		if (m_num_entries == m_max_entries)
 		{
-			if (mp_tab[i].type == ex)
-			{
-				p_entry = &mp_tab[i];
-				if (p_entry->p_params)
-				{
-					delete p_entry->p_params;
-				}
-				goto GOT_ENTRY;				// goto useful
-			}
+			compress_table();
 		}
-		
-		// check for empty slots, and use them	
-
-		for (i = 0; i<m_num_entries; i++)
+		if (m_num_entries == m_max_entries)
 		{
-			if (mp_tab[i].script == vDEAD_ENTRY)
-			{
-				p_entry = &mp_tab[i];
-				goto GOT_ENTRY;				// goto useful
-			}
+			grow_table(m_num_entries + 1);
+		}
+		if (!m_sorted)
+		{
+			sort_table();
 		}
 		
-		// otherwise, extend the table by one entry
-	
-//		printf ("Allocating new table to extend by one\n");
-		Entry * p_old_tab = mp_tab;
-		mp_tab = new Entry[m_num_entries + 1];
-		for (i=0; i<m_num_entries; i++)
+		// and insert it in order
+		int index = m_num_entries;
+		for ( ; index > 0 && mp_tab[index - 1].type > ex; index--)
 		{
-			mp_tab[i] = p_old_tab[i];
+			mp_tab[index] = mp_tab[index - 1];
 		}
-		delete [] p_old_tab;
-		p_entry = &mp_tab[m_num_entries];
+		p_entry = &mp_tab[index];
 		m_num_entries++;
-	
 	}
 
-GOT_ENTRY:
-
 	Dbg_MsgAssert(p_entry, ("NULL p_entry"));
 
 	p_entry->enabled = true;
@@ -316,6 +323,7 @@ void CEventHandlerTable::add_from_script(Script::CArray *pArray, bool replace)
 			delete [] mp_tab;
 			mp_tab = NULL;
 			m_num_entries = 0;
+			m_max_entries = 0;
 			m_changed = true;
 		}
 		return;
@@ -424,7 +432,8 @@ void CEventHandlerTable::add_from_script(Script::CArray *pArray, bool replace)
 	
 //	printf("Allocating memory for %d new entries\n",new_entries);
 	
-	Entry *p_edit_tab = new Entry[m_num_entries + new_entries];
+	int edit_tab_size = m_num_entries + new_entries;
+	Entry *p_edit_tab = new Entry[edit_tab_size];
 	#ifdef __NOPT_ASSERT__ 
 	int first_edit_entry = m_num_entries;	
 	#endif
@@ -503,29 +512,37 @@ void CEventHandlerTable::add_from_script(Script::CArray *pArray, bool replace)
 	delete [] mp_tab;  					// old table has been coped over, so we can delete it
 	mp_tab = p_edit_tab;				// and make the newly constructed table the active table
 	m_num_entries = new_entry_index;	// set the number of entries to the actual counted entries (not the size of the array)
+	m_max_entries = edit_tab_size;
 	
 	Mem::Manager::sHandle().PopContext();
 	
+	// The new entries were put first, so for a type in both, the new handler is still found first
+	if (m_in_immediate_use_counter)
+	{
+		m_sorted = false;
+	}
+	else
+	{
+		sort_table();
+	}
+	
 }
 
 
 
 
 // doesn't change the array size, just marks entry dead (and deletes p_params struct)
+// The type is left, so the table stays in order
 void CEventHandlerTable::remove_entry(uint32 type)
 {
-	for (int i = 0; i < m_num_entries; i++)
+	for (int i = find_first(type); i >= 0; i = find_next(type, i))
 	{
-		if (mp_tab[i].type == type)
+		mp_tab[i].script = vDEAD_ENTRY;
+		// delete the original parameters, whilst (while!) we are at it
+		if (mp_tab[i].p_params)
 		{
-			mp_tab[i].type = 0;
-			mp_tab[i].script = vDEAD_ENTRY;
-			// delete the original parameters, whilst (while!) we are at it
-			if (mp_tab[i].p_params)
-			{
-				delete mp_tab[i].p_params;
-				mp_tab[i].p_params = NULL;
-			}
+			delete mp_tab[i].p_params;
+			mp_tab[i].p_params = NULL;
 		}
 	}
 	
@@ -557,86 +574,158 @@ void CEventHandlerTable::remove_group(uint32 group)
 
 
 
-// changes size of table, removing dead entries
+// removes the dead entries, sliding the rest down, which keeps them in order
 void CEventHandlerTable::compress_table()
 {
 	if (!mp_tab) return;
 
-	// count up dead entries
-	int num_dead = 0;
-	int in = 0;
-	for (; in < m_num_entries; in++)
+	int out = 0;
+	for (int in = 0; in < m_num_entries; in++)
 	{
-		if (mp_tab[in].script == vDEAD_ENTRY)
-			num_dead++;
-	}
-
-	if (num_dead == 0) return;
-
-	int new_size = m_num_entries - num_dead;
-
-	m_changed = true;
-
-	// Mick - If new table has zero size, then don't allocate it	
-	// just delete the old table, and set it to NULL
-	if ( 0 == new_size)
-	{
-		for (int i = 0; i < m_num_entries; i++)
+		if (mp_tab[in].script != vDEAD_ENTRY)
+		{
+			if (out != in)
+			{
+				mp_tab[out] = mp_tab[in];
+			}
+			out++;
+		}
+		else
 		{
 			// we're about to remove an entry
 			// so delete its params if necessary
-			if ( mp_tab[i].p_params )
+			if ( mp_tab[in].p_params )
 			{
-				delete mp_tab[i].p_params;
-				mp_tab[i].p_params = NULL;
+				delete mp_tab[in].p_params;
+				mp_tab[in].p_params = NULL;
 			}
 		}
+	}
+
+	if (out == m_num_entries) return;
 
+	m_changed = true;
+	m_num_entries = out;
+
+	// Mick - If new table has zero size, then don't keep it	
+	if (0 == m_num_entries)
+	{
 		delete[]	mp_tab;
 		mp_tab = NULL;
-		m_num_entries = 0;
+		m_max_entries = 0;
+		m_sorted = true;
 	}
-	else
+}
+
+
+
+
+void CEventHandlerTable::set_event_enable(uint32 type, bool state)
+{
+	for (int i = find_first(type); i >= 0; i = find_next(type, i))
 	{
-		
-		Mem::Manager::sHandle().PushContext(Mem::Manager::sHandle().FrontEndHeap());
-		Entry *p_new_tab = new Entry[new_size];		
-		Mem::Manager::sHandle().PopContext();
-		
-		int out = 0;
-		for (in = 0; in < m_num_entries; in++)
+		mp_tab[i].enabled = state;
+	}
+}
+
+
+
+
+// Returns the index of the first entry of this type, or -1 if there isn't one
+int CEventHandlerTable::find_first(uint32 type)
+{
+	if (!m_sorted)
+	{
+		return find_next(type, -1);
+	}
+
+	int low = 0;
+	int high = m_num_entries;
+	while (low < high)
+	{
+		int mid = (low + high) >> 1;
+		if (mp_tab[mid].type < type)
 		{
-			if (mp_tab[in].script != vDEAD_ENTRY)
-			{
-				p_new_tab[out++] = mp_tab[in];
-			}
-			else
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+	return (low < m_num_entries && mp_tab[low].type == type) ? low : -1;
+}
+
+
+
+
+// Returns the index of the next entry of this type after 'index', or -1
+int CEventHandlerTable::find_next(uint32 type, int index)
+{
+	if (m_sorted)
+	{
+		index++;
+		return (index < m_num_entries && mp_tab[index].type == type) ? index : -1;
+	}
+
+	for (index++; index < m_num_entries; index++)
+	{
+		if (mp_tab[index].type == type)
+		{
+			return index;
+		}
+	}
+	return -1;
+}
+
+
+
+
+// An insertion sort, as the tables are small, and usually nearly in order already.  It's
+// stable, so handlers of the same type stay in the order they were added in.
+void CEventHandlerTable::sort_table()
+{
+	Dbg_MsgAssert(!m_in_immediate_use_counter, ("Sorting an event handler table while it is in use"));
+
+	for (int i = 1; i < m_num_entries; i++)
+	{
+		if (mp_tab[i].type < mp_tab[i - 1].type)
+		{
+			Entry entry = mp_tab[i];
+			int j = i;
+			for ( ; j > 0 && mp_tab[j - 1].type > entry.type; j--)
 			{
-				// we're about to remove an entry
-				// so delete its params if necessary
-				if ( mp_tab[in].p_params )
-				{
-					delete mp_tab[in].p_params;
-					mp_tab[in].p_params = NULL;
-				}
+				mp_tab[j] = mp_tab[j - 1];
 			}
+			mp_tab[j] = entry;
 		}
-		delete[] mp_tab;
-		mp_tab = p_new_tab;
-		m_num_entries = new_size;
 	}
+	m_sorted = true;
 }
 
 
 
 
-void CEventHandlerTable::set_event_enable(uint32 type, bool state)
+// Reallocates the table with room for at least min_entries, and a few more
+void CEventHandlerTable::grow_table(int min_entries)
 {
+	int max_entries = m_max_entries + 4;
+	if (max_entries < min_entries)
+	{
+		max_entries = min_entries;
+	}
+
+	Mem::Manager::sHandle().PushContext(Mem::Manager::sHandle().FrontEndHeap());
+	Entry *p_new_tab = new Entry[max_entries];
+	Mem::Manager::sHandle().PopContext();
+
 	for (int i = 0; i < m_num_entries; i++)
 	{
-		if (mp_tab[i].type == type)
-			mp_tab[i].enabled = state;
+		p_new_tab[i] = mp_tab[i];
 	}
+	delete [] mp_tab;
+	mp_tab = p_new_tab;
+	m_max_entries = max_entries;
 }
 
 
@@ -667,6 +756,12 @@ void CEventHandlerTable::pass_event(CEvent *pEvent, Script::CScript *pScript, bo
 	}
 	#endif
 	
+	// Entries added while the table was in use are on the end, out of order
+	if (!m_sorted && !m_in_immediate_use_counter)
+	{
+		sort_table();
+	}
+	
 	m_in_immediate_use_counter++;
 
 #ifndef __PLAT_WN32__
@@ -675,12 +770,13 @@ void CEventHandlerTable::pass_event(CEvent *pEvent, Script::CScript *pScript, bo
 #endif
 
 	
-	Entry *p_entry = mp_tab;
-	for (int i = 0; i < m_num_entries; i++)
+	for (int i = find_first(pEvent->GetType()); i >= 0; i = find_next(pEvent->GetType(), i))
 	{  
-		if (p_entry->type == pEvent->GetType() && p_entry->script != vDEAD_ENTRY && p_entry->enabled)
+		Entry *p_entry = mp_tab + i;
+		if (p_entry->script != vDEAD_ENTRY && p_entry->enabled)
 		{
 			
+			uint32 handler_script = p_entry->script;
 			Script::CScript *p_new_script = NULL;
 			Script::CStruct	*p_params = NULL;
 			Script::CStruct	*p_passed_params = NULL;
@@ -739,7 +835,8 @@ void CEventHandlerTable::pass_event(CEvent *pEvent, Script::CScript *pScript, bo
 					delete pFoo;
 				}
 				
-				// the OnException script may alter the table
+				// the OnException script may alter the table, and adding to it can move it
+				p_entry = mp_tab + i;
 				if (p_entry->script != vDEAD_ENTRY)
 				{
 					// Exceptions act like a GOTO, so we just set the script we are running on to this new script
@@ -782,11 +879,9 @@ void CEventHandlerTable::pass_event(CEvent *pEvent, Script::CScript *pScript, bo
 
 			// do logging
 			//pEvent->MarkHandled(pObject->GetID(), p_entry->script);
-			pEvent->MarkHandled(0, p_entry->script);	// receiver id not important
+			pEvent->MarkHandled(0, handler_script);	// receiver id not important
 		}
 
-		p_entry++;
-
 		if (!m_valid)
 		{
 			// Looks like the spawned script deleted the CObject, invalidating this event handler table.
@@ -833,19 +928,23 @@ void CEventHandlerTable::pass_event(CEvent *pEvent, CObject *pObject, bool broad
 			m_changed = false;		
 	}
 	
+	if (!m_sorted && !m_in_immediate_use_counter)
+	{
+		sort_table();
+	}
+	
 	m_in_immediate_use_counter++;
 	
-	Entry *p_entry = mp_tab;
-	for (int i = 0; i < m_num_entries; i++)
+	for (int i = find_first(pEvent->GetType()); i >= 0; i = find_next(pEvent->GetType(), i))
 	{  
+		Entry *p_entry = mp_tab + i;
 		 
 //		if (broadcast && !p_entry->broadcast)
 //		{
-//			p_entry++;
 //			continue;
 //		}		
 	
-		if (p_entry->type == pEvent->GetType() && p_entry->script != vDEAD_ENTRY && p_entry->enabled)
+		if (p_entry->script != vDEAD_ENTRY && p_entry->enabled)
 		{
 			
 			Script::CScript *p_new_script = NULL;
@@ -972,8 +1071,6 @@ void CEventHandlerTable::pass_event(CEvent *pEvent, CObject *pObject, bool broad
 			pEvent->MarkHandled(pObject->GetID(), p_entry->script);
 		}
 
-		p_entry++;
-
 		if (!m_valid)
 		{
 			// Looks like the spawned script deleted the CObject, invalidating this event handler table.
@@ -6,7 +6,9 @@
 //****************************************************************************
 
 #include <gel/object/basecomponent.h>
+#include <gel/object/compositeobject.h>
 #include <gel/scripting/struct.h>
+#include <sys/timer.h>
 
 namespace Obj
 {
@@ -18,6 +20,9 @@ namespace Obj
 	
 CBaseComponent::CBaseComponent()
 {
+	mp_update_tiers = NULL;
+	m_frame_length = 0.0f;
+	m_skipped_time = 0.0f;
 }
 
 /******************************************************************/
@@ -42,6 +47,43 @@ void CBaseComponent::Finalize()
 }
 
 
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Frames between updates, for the tier the object is in
+int CBaseComponent::GetUpdateInterval() const
+{
+	if (!HasUpdateTiers())
+	{
+		return 1;
+	}
+	return mp_update_tiers->mpInterval[mp_object->GetUpdateTier()];
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Objects in the same tier are staggered by ID, so that they don't all
+// update on the same frame
+bool CBaseComponent::IsUpdateFrame() const
+{
+	int interval = GetUpdateInterval();
+	if (interval <= 1)
+	{
+		return true;
+	}
+	return ((uint32)Tmr::GetRenderFrame() + mp_object->GetID()) % interval == 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 void CBaseComponent::RefreshFromStructure( Script::CStruct* pParams )
 {
 	// Default to just calline InitFromStructure()
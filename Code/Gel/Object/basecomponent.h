@@ -25,10 +25,25 @@ namespace Obj
 // Forward declaration
 class CCompositeObject;
 
+enum
+{
+	vNUM_UPDATE_TIERS = 4,		// update rate LOD tiers, 0 is full rate
+};
+
+// How often the components of one type are updated in each update rate LOD tier.
+// Set up with CCompositeObjectManager::SetUpdateTiers().
+struct SUpdateTiers
+{
+	bool				mActive;							// the type has opted in
+	bool				mSkipUpdates;						// Update() is only called on update frames
+	uint8				mpInterval[vNUM_UPDATE_TIERS];		// frames between updates in each tier
+};
+
 // CBaseComponent is a virtual base class for object components
 class CBaseComponent : public Spt::Class
 {
 	friend	class	CCompositeObject;
+	friend	class	CCompositeObjectManager;
 
 	
 public:
@@ -69,6 +84,14 @@ public:
 	virtual void					Hide(bool shouldHide);
 	virtual void					Teleport();
 
+	// Update rate LOD.  GetFrameLength() is the time this Update() covers, which is
+	// more than Tmr::FrameLength() if the updates in between were skipped.  A type that
+	// doesn't skip updates can use IsUpdateFrame() to decide when to do its expensive work.
+	float							GetFrameLength() const {return m_frame_length;}
+	bool							HasUpdateTiers() const {return mp_update_tiers && mp_update_tiers->mActive;}
+	int								GetUpdateInterval() const;
+	bool							IsUpdateFrame() const;
+
 	// Used by the script debugger code to fill in a structure
 	// for transmitting to the monitor.exe utility running on the PC.
 	virtual void					GetDebugInfo(Script::CStruct *p_info);
@@ -86,6 +109,10 @@ private:
 	CBaseComponent * 				mp_next;			// next component in the list
 	CBaseComponent * 				mp_next_same_type;	// next component in the list that is of the same type
 
+	const SUpdateTiers*				mp_update_tiers;	// for this type, from the manager
+	float							m_frame_length;		// time covered by the current Update()
+	float							m_skipped_time;		// frame time since the last Update()
+
 	#ifdef __NOPT_ASSERT__
 	// The time spent (in microseconds) executing ::Update(), for displaying in the script debugger.
 	int								m_update_time;
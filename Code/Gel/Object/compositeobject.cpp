@@ -54,6 +54,7 @@
 
 #include <gel/object/compositeobject.h>
 #include <gel/object/compositeobjectManager.h>
+#include <gel/object/updatetiming.h>
 #include <gel/scripting/script.h>
 #include <gel/scripting/struct.h>
 #include <gel/scripting/array.h>
@@ -83,6 +84,8 @@ CCompositeObject::CCompositeObject()
 
 	mp_component_list = NULL;
 	m_composite_object_flags.ClearAll();
+	m_update_slot = vUPDATE_SLOT_NONE;
+	m_update_tier = 0;
 
 	SetFlags( GetFlags() | vCOMPOSITE);   // Kind of a temp solution for now
 
@@ -142,8 +145,50 @@ void CCompositeObject::Update()
 	Sys::CPUProfiler->PushContext( m_profile_color );
 #endif // __USE_PROFILER__
 
+	if (!UpdateScript())
+	{
+		#	ifdef __USE_PROFILER__
+			Sys::CPUProfiler->PopContext();
+		#	endif // __USE_PROFILER__
+		return;
+	}
+
+	CBaseComponent* pComponent = mp_component_list;
+    while ( pComponent )
+    {
+		UpdateComponent( pComponent );
+
+		// If a component update has killed the object
+		// then we don't process any more components
+		// as they might attempt to fire an event, or reference this object in some way
+		// and it won't be in the tracking system any more
+		if (IsDead())
+		{
+			break;
+		}
+        pComponent = pComponent->mp_next;
+    }
+	#	ifdef __USE_PROFILER__
+		Sys::CPUProfiler->PopContext();
+	#	endif // __USE_PROFILER__
+	
+	FinishUpdate();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The first half of Update(), everything up to the component updates.
+// Also marks the object as having components to update, for the manager's
+// type-major update, which runs them later in phase order.
+bool CCompositeObject::UpdateScript()
+{
 	Dbg_MsgAssert(IsFinalized(),("Update called on UnFinalized Composite object %s",Script::FindChecksumName(GetID())));
 
+	m_composite_object_flags.Clear(CO_COMPONENTS_PENDING);
+
 #ifdef	__NOPT_ASSERT__
 	// GJ:  don't do this if the composite object is paused,
 	// because some lock obj component might be trying
@@ -170,18 +215,13 @@ void CCompositeObject::Update()
 
 	if (m_composite_object_flags.Test(CO_PAUSED))
 	{
-#ifdef __USE_PROFILER__
-	Sys::CPUProfiler->PopContext();
-#endif // __USE_PROFILER__
-		return;
+		return false;
 	}
 
 
 	if (!m_composite_object_flags.Test(CO_SUSPENDED))
 	{
-#ifdef __NOPT_ASSERT__
-		Tmr::CPUCycles time_before=Tmr::GetTimeInCPUCycles();
-#endif
+		uint64 time_before=ReadUpdateTimer();
 		if ( mp_script )
 		{
 			if ( mp_script->Update() == Script::ESCRIPTRETURNVAL_FINISHED )
@@ -206,14 +246,11 @@ void CCompositeObject::Update()
 		// then don't update the components
 		if ( IsDead() )
 		{
-			#	ifdef __USE_PROFILER__
-				Sys::CPUProfiler->PopContext();
-			#	endif // __USE_PROFILER__
-			return;
+			RecordObjectTime(GetType(), ReadUpdateTimer()-time_before);
+			return false;
 		}
 #ifdef __NOPT_ASSERT__
-		// Convert to microseconds by dividing by 150
-		m_total_script_update_time=(Tmr::GetTimeInCPUCycles()-time_before)/150;
+		m_total_script_update_time=(int)UpdateTimerToMicroseconds(ReadUpdateTimer()-time_before);
 #endif
 
 		// transition-only function call,
@@ -221,52 +258,60 @@ void CCompositeObject::Update()
 		// DoGameLogic() function (previously,
 		// this was called by each object's task)
 #ifdef __NOPT_ASSERT__
-		time_before=Tmr::GetTimeInCPUCycles();
+		uint64 time_before_logic=ReadUpdateTimer();
 #endif
 		// Mick:  DoGameLogic is Deprecated, and only exists for a few misc objects
 		// it should eventually be removed
 		DoGameLogic();
 #ifdef __NOPT_ASSERT__
-		// Convert to microseconds by dividing by 150
-		m_do_game_logic_time=(Tmr::GetTimeInCPUCycles()-time_before)/150;
+		m_do_game_logic_time=(int)UpdateTimerToMicroseconds(ReadUpdateTimer()-time_before_logic);
 #endif
+		RecordObjectTime(GetType(), ReadUpdateTimer()-time_before);
 
 	}
 
-	CBaseComponent* pComponent = mp_component_list;
-    while ( pComponent )
-    {
-		if ( ! (pComponent->m_flags.Test(CBaseComponent::BC_NO_UPDATE)))
-		{
-			#ifdef __NOPT_ASSERT__
-			Tmr::CPUCycles time_before_components=Tmr::GetTimeInCPUCycles();
-			#endif
-			
-			pComponent->Update();
-			
-			#ifdef __NOPT_ASSERT__
-			// Convert to microseconds by dividing by 150
-			pComponent->m_update_time=(Tmr::GetTimeInCPUCycles()-time_before_components)/150;
-			#endif
-
-			// If a component update has killed the object
-			// then we don't process any more components
-			// as they might attempt to fire an event, or reference this object in some way
-			// and it won't be in the tracking system any more
-			if (IsDead())
-			{
-				break;
-			}
-			
-			
-		}
-        pComponent = pComponent->mp_next;
-    }
-	#	ifdef __USE_PROFILER__
-		Sys::CPUProfiler->PopContext();
-	#	endif // __USE_PROFILER__
+	m_composite_object_flags.Set(CO_COMPONENTS_PENDING);
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObject::UpdateComponent( CBaseComponent* pComponent )
+{
+	Dbg_MsgAssert(pComponent->GetObject() == this,("Updating component %s of another object",Script::FindChecksumName(pComponent->GetType())));
+	
+	if ( pComponent->m_flags.Test(CBaseComponent::BC_NO_UPDATE))
+	{
+		return;
+	}
+
+	// Update rate LOD; a skipped update's time is added to the next one's
+	float frame_length = Tmr::FrameLength();
+	if ( m_update_tier && pComponent->HasUpdateTiers() && pComponent->mp_update_tiers->mSkipUpdates && !pComponent->IsUpdateFrame())
+	{
+		pComponent->m_skipped_time += frame_length;
+		return;
+	}
+	pComponent->m_frame_length = frame_length + pComponent->m_skipped_time;
+	pComponent->m_skipped_time = 0.0f;
+
+	uint64 time_before_component=ReadUpdateTimer();
+	
+	pComponent->Update();
 	
-	m_composite_object_flags.Clear(CO_TELEPORTED);
+	uint64 ticks=ReadUpdateTimer()-time_before_component;
+	RecordComponentTime(pComponent->GetType(), GetType(), ticks);
+	#ifdef __NOPT_ASSERT__
+	pComponent->m_update_time=(int)UpdateTimerToMicroseconds(ticks);
+	#endif
+
+	if (IsDead())
+	{
+		m_composite_object_flags.Clear(CO_COMPONENTS_PENDING);
+	}
 }
 
 /******************************************************************/
@@ -489,6 +534,22 @@ void CCompositeObject::Finalize()
 	}
 	m_composite_object_flags.Set(CO_FINALIZED);
 
+	// The manager can only update our components type by type if doing so
+	// runs them in the same order as our own list
+	int last_phase = -1;
+	bool by_type = true;
+	for (p_component = mp_component_list; p_component; p_component = p_component->GetNext())
+	{
+		int phase = Obj::CCompositeObjectManager::Instance()->GetUpdatePhase(p_component->GetType());
+		if (phase <= last_phase)
+		{
+			by_type = false;
+			break;
+		}
+		last_phase = phase;
+	}
+	m_composite_object_flags.Set(CO_UPDATE_BY_TYPE, by_type);
+
 	// now that the component is finalized,
 	// update the components that depend
 	// on the position of the object
@@ -43,9 +43,37 @@ public:
 		// Used to indicate the object has been finalized
 		// so we can't add any more components to it
 		CO_FINALIZED,
+		
+		// every component is in the manager's update phase table, in phase order,
+		// so the components can be updated type by type
+		CO_UPDATE_BY_TYPE,
+		
+		// UpdateScript() has run this frame and the components still need updating
+		CO_COMPONENTS_PENDING,
 	};
 
     void 							Update();
+	
+	// Update() in pieces, for CCompositeObjectManager's type-major update.
+	// UpdateScript() returns false if the components should not be updated this frame.
+	bool							UpdateScript();
+	void							UpdateComponent( CBaseComponent* pComponent );
+	void							FinishUpdate()						{ m_composite_object_flags.Clear(CO_COMPONENTS_PENDING); m_composite_object_flags.Clear(CO_TELEPORTED); }
+	bool							CanUpdateByType( void ) const		{ return m_composite_object_flags.Test(CO_UPDATE_BY_TYPE); }
+	bool							ComponentsPending( void ) const		{ return m_composite_object_flags.Test(CO_COMPONENTS_PENDING); }
+	
+	// Where the object is in the manager's update walk (see CCompositeObjectManager::Update)
+	enum
+	{
+		vUPDATE_SLOT_NONE = -1,		// not in the walk
+		vUPDATE_SLOT_DONE = -2,		// already updated this walk
+	};
+	int								GetUpdateSlot( void ) const			{ return m_update_slot; }
+	void							SetUpdateSlot( int slot )			{ m_update_slot = slot; }
+	
+	// Update rate LOD tier, 0 to vNUM_UPDATE_TIERS-1, set by the suspend component
+	int								GetUpdateTier( void ) const			{ return m_update_tier; }
+	void							SetUpdateTier( int tier )			{ Dbg_Assert(tier >= 0 && tier < vNUM_UPDATE_TIERS); m_update_tier = tier; }
 	void 							Pause( bool paused )				{ m_composite_object_flags.Set(CO_PAUSED, paused); }
 	bool 							IsPaused( void )  const  			{ return m_composite_object_flags.Test(CO_PAUSED); }
 	void 							Suspend( bool suspended );
@@ -122,6 +150,9 @@ private:
 	
 	Flags<ECompositeObjectFlags>	m_composite_object_flags;
 	
+	int								m_update_slot;
+	int								m_update_tier;
+	
 	#ifdef __NOPT_ASSERT__
 	// The time (in microseconds) spent executing ::Update(), for displaying in the script debugger.
 	int								m_update_time;		
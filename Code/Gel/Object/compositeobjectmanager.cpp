@@ -11,8 +11,16 @@
 #include <core/list/search.h>
 #include <gel/mainloop.h>
 #include <gel/scripting/struct.h>
+#include <gel/scripting/array.h>
 #include <gel/scripting/symboltable.h>
 #include <gel/scripting/checksum.h>
+#include <sys/trace.h>
+#include <core/thread/jobsystem.h>
+#include <gel/object/deferredcommands.h>
+#include <gel/object/neighbourgrid.h>
+#include <gel/object/updatetiming.h>
+#include <gel/objtrack.h>
+#include <gfx/nxanimcache.h>
 
 #include <sk/modules/frontend/frontend.h>
 
@@ -103,6 +111,62 @@ DefineSingletonClass( CCompositeObjectManager, "Composite Manager" );
 
 CBaseComponent*	CCompositeObjectManager::mp_components_by_type[vMAX_COMPONENTS];
 
+// The order the type-major update runs the component types in.  An object
+// only gets updated that way if its own components are in this order too.
+static const uint32 sp_update_phases[] =
+{
+	// suspend first, as it turns the other components' updates on and off
+	CRC_SUSPEND,
+	
+	// input
+	CRC_INPUT,
+	
+	// physics and movement
+	CRC_PEDLOGIC,
+	CRC_MOTION,
+	CRC_AVOID,
+	CRC_WALK,
+	CRC_VEHICLE,
+	CRC_CARPHYSICS,
+	CRC_STATICVEHICLE,
+	CRC_RIGIDBODY,
+	CRC_BOUNCY,
+	CRC_VELOCITY,
+	CRC_LOCKOBJ,
+	CRC_MOVABLECONTACT,
+	CRC_COLLISION,
+	CRC_COLLIDEANDDIE,
+	CRC_PROJECTILECOLLISION,
+	CRC_TRIGGER,
+	
+	// animation
+	CRC_ANIMATION,
+	CRC_SKELETON,
+	
+	// model and skinning
+	CRC_SETDISPLAYMATRIX,
+	CRC_MODEL,
+	CRC_MODELLIGHTUPDATE,
+	CRC_SHADOW,
+	CRC_PARTICLE,
+	
+	// sound
+	CRC_SOUND,
+	CRC_VEHICLESOUND,
+	CRC_STREAM,
+};
+
+enum
+{
+	vNUM_UPDATE_PHASES = sizeof( sp_update_phases ) / sizeof( sp_update_phases[0] ),
+	vMAX_WALK_OBJECTS = 4096,
+	vPARALLEL_BATCH_SIZE = 16,
+};
+
+// The update walks, see m_walking_objects
+static CCompositeObject* sp_walk_objects[vMAX_WALK_OBJECTS];
+static CBaseComponent* sp_walk_components[vMAX_WALK_OBJECTS];
+
 /******************************************************************/
 /*                                                                */
 /*                                                                */
@@ -197,6 +261,33 @@ CCompositeObjectManager::CCompositeObjectManager()
 	RegisterComponent(CRC_RIDER,				CRiderComponent::s_create);
 	RegisterComponent(CRC_WEAPON,				CWeaponComponent::s_create);
 #	endif
+
+	// Only declare a type here if its Update() writes to nothing outside its own object
+	// except through the calls that defer themselves (see deferredcommands.h)
+	SetParallelSafe(CRC_PARTICLE);
+
+	m_walking_objects = false;
+	m_num_walk_objects = 0;
+	m_walk_component_type = -1;
+	m_num_walk_components = 0;
+	
+	m_update_by_type = false;
+	m_parallel_update = false;
+	m_benchmark_frames = 0;
+	
+	Dbg_MsgAssert((int)vNUM_UPDATE_PHASES <= (int)vMAX_COMPONENTS,("Too many update phases"));
+	for (int phase = 0; phase < vNUM_UPDATE_PHASES; phase++)
+	{
+		m_phase_type_index[phase] = -1;
+		for (uint32 i = 0; i < m_num_components; i++)
+		{
+			if (m_registered_components[i].mComponentID == sp_update_phases[phase])
+			{
+				m_phase_type_index[phase] = i;
+				break;
+			}
+		}
+	}
 }
 
 
@@ -276,7 +367,15 @@ void	CCompositeObjectManager::RegisterComponent(uint32 id, CBaseComponent *(p_cr
 	Dbg_MsgAssert(m_num_components < vMAX_COMPONENTS,("Too many components (%d)",vMAX_COMPONENTS));
 	m_registered_components[m_num_components].mComponentID = id;
 	m_registered_components[m_num_components].mpCreateFunction = p_create_function;
+	m_registered_components[m_num_components].mParallelSafe = false;
+	m_registered_components[m_num_components].mUpdateTiers.mActive = false;
+	m_registered_components[m_num_components].mUpdateTiers.mSkipUpdates = false;
+	for (int tier = 0; tier < vNUM_UPDATE_TIERS; tier++)
+	{
+		m_registered_components[m_num_components].mUpdateTiers.mpInterval[tier] = 1;
+	}
 	m_num_components++;
+	AddTimedComponentType(id);
 
 	// I'm letting the component manager control calling the "register" function
 	// no good reason, just better encapsulation.  Prevents bugs.
@@ -298,7 +397,9 @@ CBaseComponent*		CCompositeObjectManager::CreateComponent(uint32 id)
 	{
 		if (m_registered_components[i].mComponentID == id)
 		{
-			return m_registered_components[i].mpCreateFunction();	
+			CBaseComponent* p_component = m_registered_components[i].mpCreateFunction();
+			p_component->mp_update_tiers = &m_registered_components[i].mUpdateTiers;
+			return p_component;
 		}
 	}
 	Dbg_MsgAssert(0,("Component %s not registered",Script::FindChecksumName(id)));
@@ -312,54 +413,330 @@ CBaseComponent*		CCompositeObjectManager::CreateComponent(uint32 id)
 	
 void CCompositeObjectManager::Update()
 {
+	// Objects can be created and destroyed by the updates.  Rather than walking
+	// m_object_list, and starting again from the top each time it changes, walk a
+	// snapshot of it; RegisterObject() adds to the end, and UnregisterObject()
+	// clears the slot, so every object is visited once.
+	Dbg_MsgAssert(!m_walking_objects,("CCompositeObjectManager::Update() called recursively"));
+	
+	m_num_walk_objects = 0;
 	Lst::Search< CObject > sh;
+	for (CObject* pObject = sh.FirstItem(m_object_list); pObject; pObject = sh.NextItem())
+	{
+		add_to_walk(static_cast< CCompositeObject* >(pObject));
+	}
+	RebuildNeighbourGrid(sp_walk_objects, m_num_walk_objects);
+	CAnimationComponent::sBeginPoseFrame();
+	m_walking_objects = true;
 	
-	uint32 stamp_mask = m_stamp_bit_manager.RequestBit();
+	for (int i = 0; i < m_num_walk_objects; i++)
+	{
+		CCompositeObject* p_composite_object = sp_walk_objects[i];
+		if (!p_composite_object)
+		{
+			continue;
+		}
+		p_composite_object->SetUpdateSlot(CCompositeObject::vUPDATE_SLOT_DONE);
+		
+		#ifdef __NOPT_ASSERT__
+		uint64 time_before = ReadUpdateTimer();
+		CSmtPtr< CObject > p_smart_object = p_composite_object;
+		uint32 obj_id = p_composite_object->GetID(); 
+		#endif
+		
+		if (m_update_by_type && p_composite_object->CanUpdateByType())
+		{
+			// components are done below, by type
+			p_composite_object->UpdateScript();
+		}
+		else
+		{
+			p_composite_object->Update();
+		}
+		
+		#ifdef __NOPT_ASSERT__
+		Dbg_MsgAssert(p_smart_object, ("Object %s has deleted itself in its Update() function", Script::FindChecksumName(obj_id)));
+		p_composite_object->SetUpdateTime((int)UpdateTimerToMicroseconds(ReadUpdateTimer() - time_before));
+		#endif
+	}
 	
-	// clear the appropriate stamp bit
-	for (CObject* pObject = sh.FirstItem(m_object_list); pObject; pObject = sh.NextItem())
+	m_walking_objects = false;
+	
+	if (m_update_by_type)
 	{
-		pObject->ClearStampBit(stamp_mask);
+		update_components_by_type();
 	}
 	
-	// traverse the object list
-	do
+	// The animation job phase; the skeletons the animation components queued
+	CAnimationComponent::sEvaluatePendingPoses();
+	CModelComponent::sRenderDeferred();
+	
+	// Decompress the anims played most this frame, now that no job is reading the cache
+	Nx::UpdateAnimCache();
+	
+	EndUpdateTimingFrame();
+	
+	// Now that nothing is part way through its update
+	CTracker::Instance()->DispatchQueuedEvents();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::add_to_walk( CCompositeObject* p_object )
+{
+	if (m_num_walk_objects == vMAX_WALK_OBJECTS)
 	{
-		// clear the appropriate list changed bit
-		m_list_changed &= ~stamp_mask;
+		Dbg_MsgAssert(0,("More than %d composite objects",vMAX_WALK_OBJECTS));
+		return;
+	}
+	p_object->SetUpdateSlot(m_num_walk_objects);
+	sp_walk_objects[m_num_walk_objects++] = p_object;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::RegisterObject( CObject& obj )
+{
+	CBaseManager::RegisterObject(obj);
+	
+	// Objects created during the walk get updated this frame, as they did when the
+	// walk restarted on a list change.  One that was already updated and is only
+	// being re-registered (ReregisterObject) is not updated again.
+	CCompositeObject* p_object = static_cast< CCompositeObject* >(&obj);
+	if (m_walking_objects && p_object->GetUpdateSlot() == CCompositeObject::vUPDATE_SLOT_NONE)
+	{
+		add_to_walk(p_object);
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::UnregisterObject( CObject& obj )
+{
+	CCompositeObject* p_object = static_cast< CCompositeObject* >(&obj);
+	int slot = p_object->GetUpdateSlot();
+	if (slot >= 0)
+	{
+		Dbg_MsgAssert(m_walking_objects && sp_walk_objects[slot] == p_object,("Bad update slot"));
+		sp_walk_objects[slot] = NULL;
+	}
+	if (!m_walking_objects || slot != CCompositeObject::vUPDATE_SLOT_DONE)
+	{
+		p_object->SetUpdateSlot(CCompositeObject::vUPDATE_SLOT_NONE);
+	}
+	RemoveFromNeighbourGrid(p_object);
+	
+	CBaseManager::UnregisterObject(obj);
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Runs the components of the objects that UpdateScript() was called on, a type at a time.
+// Each type's list is walked from a snapshot, the same way as the objects in Update(); a
+// component destroyed during the walk has its slot cleared by RemoveComponentByType(), and
+// those created during it belong to objects that have not had UpdateScript() called.
+void CCompositeObjectManager::update_components_by_type()
+{
+	for (int phase = 0; phase < vNUM_UPDATE_PHASES; phase++)
+	{
+		int index = m_phase_type_index[phase];
+		if (index < 0)
+		{
+			continue;
+		}
 		
-        CObject* pNextObject = sh.FirstItem(m_object_list);
+		m_num_walk_components = 0;
+		for (CBaseComponent* p_component = mp_components_by_type[index]; p_component; p_component = p_component->GetNextSameType())
+		{
+			if (p_component->GetObject()->ComponentsPending() && !p_component->m_flags.Test(CBaseComponent::BC_NO_UPDATE))
+			{
+				Dbg_MsgAssert(m_num_walk_components < vMAX_WALK_OBJECTS,("More than %d composite objects",vMAX_WALK_OBJECTS));
+				if (m_num_walk_components < vMAX_WALK_OBJECTS)
+				{
+					sp_walk_components[m_num_walk_components++] = p_component;
+				}
+			}
+		}
 		
-		while (pNextObject)
+		if (m_parallel_update && m_registered_components[index].mParallelSafe && Job::GetNumWorkers())
 		{
-			CObject* pObject = pNextObject;
-			pNextObject = sh.NextItem();
+			// nothing is destroyed until the batch is done, so no need to track the walk
+			update_components_in_parallel(m_num_walk_components);
+			continue;
+		}
+		
+		m_walk_component_type = index;
+		for (int i = 0; i < m_num_walk_components; i++)
+		{
+			CBaseComponent* p_component = sp_walk_components[i];
+			if (!p_component)
+			{
+				continue;
+			}
 			
-			if (!pObject->CheckStampBit(stamp_mask))
+			CCompositeObject* p_object = p_component->GetObject();
+			if (!p_object->ComponentsPending())
 			{
-				pObject->SetStampBit(stamp_mask);
-				
-				#ifdef __NOPT_ASSERT__
-				Tmr::CPUCycles time_before = Tmr::GetTimeInCPUCycles();
-				CSmtPtr< CObject > p_smart_object = pObject;
-				uint32 obj_id = pObject->GetID(); 
-				#endif
-				
-				static_cast< CCompositeObject* >(pObject)->Update();
-				
-				#ifdef __NOPT_ASSERT__
-				Dbg_MsgAssert(p_smart_object, ("Object %s has deleted itself in its Update() function", Script::FindChecksumName(obj_id)));
-				// Convert to microseconds by dividing by 150
-				static_cast< CCompositeObject* >(pObject)->SetUpdateTime((Tmr::GetTimeInCPUCycles() - time_before) / 150);
-				#endif
-				
-				if (m_list_changed & stamp_mask) break;
+				// killed by an earlier component
+				continue;
 			}
+			
+			#ifdef __NOPT_ASSERT__
+			uint64 time_before = ReadUpdateTimer();
+			#endif
+			
+			p_object->UpdateComponent(p_component);
+			
+			#ifdef __NOPT_ASSERT__
+			p_object->SetUpdateTime(p_object->GetUpdateTime() + (int)UpdateTimerToMicroseconds(ReadUpdateTimer() - time_before));
+			#endif
 		}
+		m_walk_component_type = -1;
 	}
-	while (m_list_changed & stamp_mask);
 	
-	m_stamp_bit_manager.ReturnBit(stamp_mask);
+	Lst::Search< CObject > sh;
+	for (CObject* pObject = sh.FirstItem(m_object_list); pObject; pObject = sh.NextItem())
+	{
+		CCompositeObject* p_composite_object = static_cast< CCompositeObject* >(pObject);
+		if (p_composite_object->ComponentsPending())
+		{
+			p_composite_object->FinishUpdate();
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_update_component_batch( void *p_data, int begin, int end )
+{
+	for (int i = begin; i < end; i++)
+	{
+		CBaseComponent* p_component = sp_walk_components[i];
+		
+		// keyed by the position in the serial order, so
+		// the deferred commands come out in that order
+		BeginDeferring(i);
+		p_component->GetObject()->UpdateComponent(p_component);
+		EndDeferring();
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Updates the components in sp_walk_components on the job system,
+// then runs whatever they deferred.
+void CCompositeObjectManager::update_components_in_parallel( int num_components )
+{
+	Job::ParallelFor(s_update_component_batch, NULL, num_components, vPARALLEL_BATCH_SIZE);
+	
+	ApplyDeferredCommands();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::SetParallelSafe( uint32 id )
+{
+	for (uint32 i = 0; i < m_num_components; i++)
+	{
+		if (m_registered_components[i].mComponentID == id)
+		{
+			m_registered_components[i].mParallelSafe = true;
+			return;
+		}
+	}
+	Dbg_MsgAssert(0,("Component %s not registered",Script::FindChecksumName(id)));
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int CCompositeObjectManager::GetUpdatePhase( uint32 id ) const
+{
+	for (int phase = 0; phase < vNUM_UPDATE_PHASES; phase++)
+	{
+		if (sp_update_phases[phase] == id)
+		{
+			return phase;
+		}
+	}
+	return -1;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::StartUpdateBenchmark( int frames )
+{
+	Dbg_MsgAssert(frames >= 2,("Need at least two frames to benchmark"));
+	m_benchmark_frames = frames & ~1;
+	m_benchmark_saved_by_type = m_update_by_type;
+	m_benchmark_time[0] = m_benchmark_time[1] = 0;
+	m_benchmark_count[0] = m_benchmark_count[1] = 0;
+	
+	// first half object by object
+	m_update_by_type = false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::update_benchmark( uint64 time )
+{
+	m_benchmark_time[m_update_by_type] += time;
+	m_benchmark_count[m_update_by_type]++;
+	
+	if (--m_benchmark_frames == 0)
+	{
+		Lst::Search< CObject > sh;
+		int num_objects = 0;
+		int num_by_type = 0;
+		for (CObject* pObject = sh.FirstItem(m_object_list); pObject; pObject = sh.NextItem())
+		{
+			num_objects++;
+			if (static_cast< CCompositeObject* >(pObject)->CanUpdateByType())
+			{
+				num_by_type++;
+			}
+		}
+		
+		printf("Composite update benchmark, %d objects (%d can update by type)\n", num_objects, num_by_type);
+		printf("  object by object: %d frames, %d us/frame\n", m_benchmark_count[0], (int)(m_benchmark_time[0] / m_benchmark_count[0]));
+		printf("  by type:          %d frames, %d us/frame\n", m_benchmark_count[1], (int)(m_benchmark_time[1] / m_benchmark_count[1]));
+		
+		m_update_by_type = m_benchmark_saved_by_type;
+	}
+	else if (!m_update_by_type && m_benchmark_frames == m_benchmark_count[0])
+	{
+		// second half by type
+		m_update_by_type = true;
+	}
 }
 
 /******************************************************************/
@@ -418,6 +795,14 @@ void CCompositeObjectManager::s_logic_code ( const Tsk::Task< CCompositeObjectMa
 
 	CCompositeObjectManager& obj_man = task.GetData();
 
+	if (obj_man.m_benchmark_frames)
+	{
+		uint64 time_before = Trace::GetTimeUS();
+		obj_man.Update();
+		obj_man.update_benchmark(Trace::GetTimeUS() - time_before);
+		return;
+	}
+	
 	obj_man.Update();    
 }
 
@@ -476,6 +861,19 @@ void CCompositeObjectManager::RemoveComponentByType( CBaseComponent *p_component
 	{
 		if( m_registered_components[i].mComponentID == id )
 		{
+			// take it out of the by-type update walk, if it's in it
+			if( m_walk_component_type == (int)i )
+			{
+				for( int slot = 0; slot < m_num_walk_components; ++slot )
+				{
+					if( sp_walk_components[slot] == p_component )
+					{
+						sp_walk_components[slot] = NULL;
+						break;
+					}
+				}
+			}
+			
 			if( mp_components_by_type[i] == p_component )
 			{
 				mp_components_by_type[i] = p_component->GetNextSameType();
@@ -503,6 +901,177 @@ void CCompositeObjectManager::RemoveComponentByType( CBaseComponent *p_component
 
 
 
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::SetUpdateTiers( uint32 id, const int* p_intervals, bool skip_updates )
+{
+	for (uint32 i = 0; i < m_num_components; i++)
+	{
+		if (m_registered_components[i].mComponentID == id)
+		{
+			SUpdateTiers& tiers = m_registered_components[i].mUpdateTiers;
+			tiers.mpInterval[0] = 1;
+			for (int tier = 1; tier < vNUM_UPDATE_TIERS; tier++)
+			{
+				Dbg_MsgAssert(p_intervals[tier - 1] >= 1 && p_intervals[tier - 1] <= 255,("Bad update interval %d for %s",p_intervals[tier - 1],Script::FindChecksumName(id)));
+				tiers.mpInterval[tier] = p_intervals[tier - 1];
+			}
+			tiers.mSkipUpdates = skip_updates;
+			tiers.mActive = true;
+			return;
+		}
+	}
+	Dbg_MsgAssert(0,("Component %s not registered",Script::FindChecksumName(id)));
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCompositeObjectManager::ClearUpdateTiers( uint32 id )
+{
+	for (uint32 i = 0; i < m_num_components; i++)
+	{
+		if (m_registered_components[i].mComponentID == id)
+		{
+			// the skipped time is picked up on the next update
+			m_registered_components[i].mUpdateTiers.mActive = false;
+			return;
+		}
+	}
+	Dbg_MsgAssert(0,("Component %s not registered",Script::FindChecksumName(id)));
+}
+
+
+// @script | SetCompositeUpdateByType | Turns the type-major composite object update on or off.
+// With it on, object scripts run first, then each type of component is updated for
+// all objects at once, in phase order. Objects with components outside the phase
+// table, or in a different order, are still updated one at a time.
+// @flag on | Update by type
+// @flag off | Update object by object (the default)
+// @flag parallel | With on, also update the parallel-safe component types on the job system
+bool ScriptSetCompositeUpdateByType( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	if (pParams->ContainsFlag(CRCD(0xf649d637,"on")))
+	{
+		CCompositeObjectManager::Instance()->SetUpdateByType(true);
+		CCompositeObjectManager::Instance()->SetParallelUpdate(pParams->ContainsFlag(CRCD(0x9547cc0e,"parallel")));
+	}
+	else if (pParams->ContainsFlag(CRCD(0xd443a2bc,"off")))
+	{
+		CCompositeObjectManager::Instance()->SetUpdateByType(false);
+		CCompositeObjectManager::Instance()->SetParallelUpdate(false);
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetParallelAnimation | Turns the animation job phase on or off.  With it on,
+// the animation components work out their skeletons' poses on the job system, all at
+// once, at the end of the composite object update, instead of one at a time as they
+// are updated.  Anything that reads a bone before then gets that pose worked out first.
+// @flag on | Work the poses out on the job system
+// @flag off | Work each pose out as its object is updated (the default)
+bool ScriptSetParallelAnimation( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	if (pParams->ContainsFlag(CRCD(0xf649d637,"on")))
+	{
+		CAnimationComponent::sSetParallelPoses(true);
+	}
+	else if (pParams->ContainsFlag(CRCD(0xd443a2bc,"off")))
+	{
+		CAnimationComponent::sSetParallelPoses(false);
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetPoseSharing | Turns pose sharing on or off.  Objects playing the same
+// anim at the same time on the same type of skeleton, with nothing blended in (crowds
+// of peds, mostly), share the one pose and set of bone matrices each frame.  The anim
+// times can be rounded down to a number of frames, so that more of them match.
+// @flag on | Share poses (the default)
+// @flag off | Every object works out its own pose
+// @parmopt int | quantize | 0 | frames (60ths of a second) to round the anim times down to
+bool ScriptSetPoseSharing( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	int quantize = 0;
+	pParams->GetInteger(CRCD(0xea8e9808,"quantize"), &quantize);
+	Dbg_MsgAssert(quantize >= 0,("SetPoseSharing needs quantize of 0 or more"));
+
+	CAnimationComponent::sSetPoseSharing(!pParams->ContainsFlag(CRCD(0xd443a2bc,"off")), quantize / 60.0f);
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | BenchmarkCompositeUpdate | Times the composite object update for the next
+// few frames, the first half object by object and the second half by type, and prints
+// the average time for each. Best run in a level with plenty of peds about.
+// @parmopt int | frames | 600 | Number of frames to time
+bool ScriptBenchmarkCompositeUpdate( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	int frames = 600;
+	pParams->GetInteger(CRCD(0x019176c5,"frames"), &frames);
+	CCompositeObjectManager::Instance()->StartUpdateBenchmark(frames);
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetComponentUpdateTiers | Opts a component type in to the update rate LOD,
+// or out of it. Objects are put in tiers by their distance from the camera (see the
+// UpdateTierDist params of the suspend component), and the type is only updated every
+// so many frames in the farther tiers. Only types that use GetFrameLength() for their
+// time step can skip updates; PedLogic, Motion, Bouncy and Velocity do. Animation keeps
+// advancing its anims every frame, and uses the tiers to decide when to update the skeleton.
+// @parm name | type | The component type, eg PedLogic
+// @parmopt array | intervals | | Frames between updates in tiers 1, 2 and 3, eg [2 4 8]
+// @flag off | Update the type every frame again
+bool ScriptSetComponentUpdateTiers( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	uint32 type = 0;
+	pParams->GetChecksum(CRCD(0x7321a8d6,"type"), &type, Script::ASSERT);
+	
+	if (pParams->ContainsFlag(CRCD(0xd443a2bc,"off")))
+	{
+		CCompositeObjectManager::Instance()->ClearUpdateTiers(type);
+		return true;
+	}
+	
+	Script::CArray* p_array = NULL;
+	pParams->GetArray(CRCD(0xe85eed23,"intervals"), &p_array, Script::ASSERT);
+	Dbg_MsgAssert(p_array->GetSize() == vNUM_UPDATE_TIERS - 1,("SetComponentUpdateTiers needs %d intervals",vNUM_UPDATE_TIERS - 1));
+	
+	int p_intervals[vNUM_UPDATE_TIERS - 1];
+	for (int tier = 0; tier < vNUM_UPDATE_TIERS - 1; tier++)
+	{
+		p_intervals[tier] = p_array->GetInteger(tier);
+	}
+	
+	// the animation can't miss an update, see CAnimationComponent::Update()
+	CCompositeObjectManager::Instance()->SetUpdateTiers(type, p_intervals, type != CRC_ANIMATION);
+	return true;
+}
+
 /******************************************************************/
 /*                                                                */
 /*                                                                */
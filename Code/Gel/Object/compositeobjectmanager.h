@@ -27,6 +27,8 @@ struct	SRegisteredComponent
 {
 	uint32				mComponentID;		   		
 	CBaseComponent*		(*mpCreateFunction)();
+	bool				mParallelSafe;
+	SUpdateTiers		mUpdateTiers;
 };
 
 
@@ -44,6 +46,10 @@ public:
 
 	void 				Update();
 	void 				Pause( bool paused );
+
+	// Keep the update walk in step with objects created and destroyed during it
+	void				RegisterObject( CObject& obj );
+	void				UnregisterObject( CObject& obj );
 	
 	CCompositeObject*	CreateCompositeObject();
 	CCompositeObject* 	CreateCompositeObjectFromNode(Script::CArray *pArray, Script::CStruct *pNodeData, bool finalize=true);
@@ -55,6 +61,39 @@ public:
 	void				AddComponentByType( CBaseComponent *p_component );
 	void				RemoveComponentByType( CBaseComponent *p_component );
 
+	// Type-major update: object scripts still run object by object, but then
+	// all the components of each type are updated together, one type after
+	// another in phase order (input, physics, animation, model, sound).
+	// Only objects whose components are all in the phase table, in that order,
+	// are updated this way; everything else is updated as before.
+	void				SetUpdateByType( bool by_type ) { m_update_by_type = by_type; }
+	bool				GetUpdateByType() const { return m_update_by_type; }
+	int					GetUpdatePhase( uint32 id ) const;	// -1 if not in the phase table
+
+	// Times the next 'frames' updates, half each way, and prints the averages
+	void				StartUpdateBenchmark( int frames );
+
+	// In the type-major update, components of a parallel-safe type are updated on the
+	// job system, in batches.  They may read anything, but only write to their own
+	// object, and anything with global side effects (events, scripts, sounds, killing
+	// objects) is deferred by those systems and run in order after the batch.
+	void				SetParallelSafe( uint32 id );
+	void				SetParallelUpdate( bool parallel ) { m_parallel_update = parallel; }
+
+	// Update rate LOD.  The suspend component puts each object in a tier by its distance
+	// from the camera (tier 0 is the nearest).  A type that opts in here has its Update()
+	// called only every p_intervals[tier-1] frames in tiers 1 and up, staggered across
+	// objects, and GetFrameLength() covers the frames in between.  A type with skip_updates
+	// false is updated every frame, and checks CBaseComponent::IsUpdateFrame() itself.
+	void				SetUpdateTiers( uint32 id, const int* p_intervals, bool skip_updates = true );
+	void				ClearUpdateTiers( uint32 id );
+
+protected:
+	void				add_to_walk( CCompositeObject* p_object );
+	void				update_components_by_type();
+	void				update_components_in_parallel( int num_components );
+	void				update_benchmark( uint64 time );
+	
 protected:
 	static Tsk::Task< CCompositeObjectManager >::Code   	s_logic_code; 
 	Tsk::Task< CCompositeObjectManager >*				    mp_logic_task;	
@@ -63,10 +102,34 @@ protected:
 	SRegisteredComponent									m_registered_components[vMAX_COMPONENTS];
 
 	static CBaseComponent									*mp_components_by_type[vMAX_COMPONENTS];
+
+	// The objects being updated, snapshotted from m_object_list, plus any registered
+	// during the walk.  Objects unregistered during it have their slot cleared.
+	bool													m_walking_objects;
+	int														m_num_walk_objects;
+	
+	// The same for the components of one type during the by-type update
+	int														m_walk_component_type;	// index, or -1
+	int														m_num_walk_components;
+
+	bool													m_update_by_type;
+	bool													m_parallel_update;
+	int														m_phase_type_index[vMAX_COMPONENTS];	// into mp_components_by_type, for each phase
+	
+	int														m_benchmark_frames;
+	bool													m_benchmark_saved_by_type;
+	uint64													m_benchmark_time[2];
+	int														m_benchmark_count[2];
 	
 	DeclareSingletonClass( CCompositeObjectManager );
 };
 
+bool ScriptSetCompositeUpdateByType( Script::CStruct *pParams, Script::CScript *pScript );
+bool ScriptSetParallelAnimation( Script::CStruct *pParams, Script::CScript *pScript );
+bool ScriptSetPoseSharing( Script::CStruct *pParams, Script::CScript *pScript );
+bool ScriptBenchmarkCompositeUpdate( Script::CStruct *pParams, Script::CScript *pScript );
+bool ScriptSetComponentUpdateTiers( Script::CStruct *pParams, Script::CScript *pScript );
+
 }
 
 #endif
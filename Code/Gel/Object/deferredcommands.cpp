@@ -0,0 +1,206 @@
+//****************************************************************************
+//* MODULE:         Gel/Object
+//* FILENAME:       deferredcommands.cpp
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#include <string.h>
+
+#include <gel/object/deferredcommands.h>
+#include <gel/scripting/struct.h>
+#include <gel/scripting/utils.h>
+#include <core/thread/jobsystem.h>
+
+namespace Obj
+{
+
+enum
+{
+	vBUFFER_SIZE = 16384,					// per thread
+	vMAX_COMMANDS = 2048,					// over all threads, per batch
+};
+
+struct SDeferredCommand
+{
+	DeferredCommandFunc		mpFunc;
+	uint32					mKey;
+	uint32					mSize;			// of the data that follows, rounded up
+};
+
+// Each thread only writes to its own buffer, so there is no locking.
+struct alignas( 64 ) SCommandBuffer
+{
+	bool					mDeferring;
+	uint32					mKey;
+	uint32					mUsed;
+	alignas( 16 ) uint8		mpData[vBUFFER_SIZE];
+};
+
+static SCommandBuffer		sp_buffers[Job::MAX_THREADS];
+static SDeferredCommand*	sp_sorted[vMAX_COMMANDS];
+
+static bool s_command_before( const SDeferredCommand* p_a, const SDeferredCommand* p_b )
+{
+	// Commands with the same key all come from the one component,
+	// so the same thread, where they are in order already
+	if (p_a->mKey != p_b->mKey)
+	{
+		return p_a->mKey < p_b->mKey;
+	}
+	return p_a < p_b;
+}
+
+// Shell sort; each thread's commands are mostly in order to start with.
+// (<algorithm> can't be used alongside the operator new in core/defines.h)
+static void s_sort_commands( SDeferredCommand** pp_commands, int num_commands )
+{
+	for (int gap = num_commands / 2; gap > 0; gap /= 2)
+	{
+		for (int i = gap; i < num_commands; i++)
+		{
+			SDeferredCommand* p_command = pp_commands[i];
+			int j = i;
+			for ( ; j >= gap && s_command_before( p_command, pp_commands[j - gap] ); j -= gap)
+			{
+				pp_commands[j] = pp_commands[j - gap];
+			}
+			pp_commands[j] = p_command;
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool DeferringCommands()
+{
+	return sp_buffers[Job::GetThreadIndex()].mDeferring;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void DeferCommand( DeferredCommandFunc func, const void *p_data, int size )
+{
+	SCommandBuffer* p_buffer = &sp_buffers[Job::GetThreadIndex()];
+	Dbg_MsgAssert(p_buffer->mDeferring,("DeferCommand called outside of a parallel update"));
+
+	uint32 aligned_size = ( size + 7 ) & ~7;
+	if (p_buffer->mUsed + sizeof( SDeferredCommand ) + aligned_size > vBUFFER_SIZE)
+	{
+		Dbg_MsgAssert(0,("Deferred command buffer full"));
+		return;
+	}
+
+	SDeferredCommand* p_command = (SDeferredCommand*)( p_buffer->mpData + p_buffer->mUsed );
+	p_command->mpFunc = func;
+	p_command->mKey = p_buffer->mKey;
+	p_command->mSize = aligned_size;
+	memcpy( p_command + 1, p_data, size );
+
+	p_buffer->mUsed += sizeof( SDeferredCommand ) + aligned_size;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int WriteDeferredParams( uint8 *p_command, int headerSize, Script::CStruct *p_params )
+{
+	uint8* p_flag = p_command + headerSize;
+	if (!p_params)
+	{
+		*p_flag = 0;
+		return headerSize + 1;
+	}
+
+	*p_flag = 1;
+	uint32 size = Script::WriteToBuffer( p_params, p_flag + 1, vMAX_DEFERRED_COMMAND_SIZE - headerSize - 1 );
+	return headerSize + 1 + size;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+Script::CStruct* ReadDeferredParams( uint8 *p_command, int headerSize )
+{
+	uint8* p_flag = p_command + headerSize;
+	if (!*p_flag)
+	{
+		return NULL;
+	}
+
+	Script::CStruct* p_params = new Script::CStruct;
+	Script::ReadFromBuffer( p_params, p_flag + 1 );
+	return p_params;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void BeginDeferring( uint32 key )
+{
+	sp_buffers[Job::GetThreadIndex()].mDeferring = true;
+	sp_buffers[Job::GetThreadIndex()].mKey = key;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void EndDeferring()
+{
+	sp_buffers[Job::GetThreadIndex()].mDeferring = false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void ApplyDeferredCommands()
+{
+	Dbg_MsgAssert(!Job::IsWorkerThread(),("Deferred commands must be applied on the main thread"));
+
+	int num_commands = 0;
+	for (int thread = 0; thread < Job::MAX_THREADS; thread++)
+	{
+		SCommandBuffer* p_buffer = &sp_buffers[thread];
+		for (uint32 offset = 0; offset < p_buffer->mUsed; )
+		{
+			SDeferredCommand* p_command = (SDeferredCommand*)( p_buffer->mpData + offset );
+			offset += sizeof( SDeferredCommand ) + p_command->mSize;
+
+			Dbg_MsgAssert(num_commands < vMAX_COMMANDS,("Too many deferred commands"));
+			if (num_commands < vMAX_COMMANDS)
+			{
+				sp_sorted[num_commands++] = p_command;
+			}
+		}
+	}
+
+	s_sort_commands( sp_sorted, num_commands );
+
+	for (int i = 0; i < num_commands; i++)
+	{
+		sp_sorted[i]->mpFunc( sp_sorted[i] + 1 );
+	}
+
+	for (int thread = 0; thread < Job::MAX_THREADS; thread++)
+	{
+		sp_buffers[thread].mUsed = 0;
+	}
+}
+
+}
@@ -0,0 +1,56 @@
+//****************************************************************************
+//* MODULE:         Gel/Object
+//* FILENAME:       deferredcommands.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef __OBJECT_DEFERREDCOMMANDS_H__
+#define __OBJECT_DEFERREDCOMMANDS_H__
+
+#include <core/defines.h>
+
+namespace Script
+{
+	class CStruct;
+}
+
+namespace Obj
+{
+
+// Components that the CCompositeObjectManager updates in parallel can't launch
+// events, run or spawn scripts, play sounds or kill objects directly, as all of
+// those touch global state (and the heap).  While a component is being updated
+// on a job, those calls are recorded into a buffer for the thread instead, and
+// run on the main thread once the whole batch is done.  They are run in the
+// order the components would have been updated in serially, so the result does
+// not depend on which thread got which component.
+
+typedef void (*DeferredCommandFunc)( void *p_data );
+
+enum
+{
+	vMAX_DEFERRED_COMMAND_SIZE = 1024,
+};
+
+// True on a thread that is updating a component in parallel.
+bool				DeferringCommands();
+
+// Copies 'size' bytes from p_data; func gets the copy later on the main thread.
+void				DeferCommand( DeferredCommandFunc func, const void *p_data, int size );
+
+// For commands that carry script parameters.  Flattens p_params (which can be NULL)
+// into p_command after the first headerSize bytes, and returns the size to defer.
+// ReadDeferredParams() gives back a new CStruct, or NULL, for the caller to delete.
+int					WriteDeferredParams( uint8 *p_command, int headerSize, Script::CStruct *p_params );
+Script::CStruct*	ReadDeferredParams( uint8 *p_command, int headerSize );
+
+// Used by the manager.  Commands deferred between BeginDeferring() and EndDeferring()
+// are tagged with 'key', and ApplyDeferredCommands() runs them in key order.
+void				BeginDeferring( uint32 key );
+void				EndDeferring();
+void				ApplyDeferredCommands();
+
+}
+
+#endif
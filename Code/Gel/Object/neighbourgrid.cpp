@@ -0,0 +1,270 @@
+//****************************************************************************
+//* MODULE:         Gel/Object
+//* FILENAME:       neighbourgrid.cpp
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#include <string.h>
+#include <math.h>
+
+#include <gel/object/neighbourgrid.h>
+#include <gel/object/compositeobject.h>
+#include <core/thread/jobsystem.h>
+
+namespace Obj
+{
+
+enum
+{
+	vMAX_ENTRIES = 4096,					// as many as the manager will update
+	vNUM_BUCKETS = 1024,					// must be a power of two
+	vMAX_CELL_SPAN = 8,						// across, for a query; any bigger and every object is tested
+};
+
+// Twenty feet, about the range of the ped avoidance
+static const float vCELL_SIZE = 240.0f;
+static const float vINV_CELL_SIZE = 1.0f / vCELL_SIZE;
+
+struct SEntry
+{
+	CCompositeObject*	mpObject;			// NULL once destroyed
+	uint32				mTypeMask;
+	int					mCellX;
+	int					mCellZ;
+	Mth::Vector			mPos;
+};
+
+// The entries, sorted by bucket; bucket b is sp_entries[sp_bucket_start[b]] up to sp_bucket_start[b + 1]
+static SEntry		sp_entries[vMAX_ENTRIES];
+static uint16		sp_entry_bucket[vMAX_ENTRIES];
+static int			sp_bucket_start[vNUM_BUCKETS + 1];
+static int			s_num_entries = 0;
+
+static inline int s_cell( float coord )
+{
+	return (int)floorf( coord * vINV_CELL_SIZE );
+}
+
+static inline uint32 s_bucket( int cell_x, int cell_z )
+{
+	return ((uint32)cell_x * 73856093u ^ (uint32)cell_z * 19349663u) & ( vNUM_BUCKETS - 1 );
+}
+
+// Adds the entry to the results.  If nearest is set, the results are kept sorted and only
+// the closest are kept, otherwise it stops adding when full.
+static inline void s_add_result( const SEntry* p_entry, float dist_sqr, SNeighbour* p_neighbours, int max_neighbours, int& num_neighbours, bool nearest )
+{
+	int index = num_neighbours;
+	if (nearest)
+	{
+		if (num_neighbours == max_neighbours)
+		{
+			if (dist_sqr >= p_neighbours[max_neighbours - 1].mDistSqr)
+			{
+				return;
+			}
+			--index;
+		}
+		else
+		{
+			++num_neighbours;
+		}
+
+		for ( ; index > 0 && p_neighbours[index - 1].mDistSqr > dist_sqr; --index)
+		{
+			p_neighbours[index] = p_neighbours[index - 1];
+		}
+	}
+	else
+	{
+		if (num_neighbours == max_neighbours)
+		{
+			return;
+		}
+		++num_neighbours;
+	}
+
+	p_neighbours[index].mpObject = p_entry->mpObject;
+	p_neighbours[index].mPos = p_entry->mPos;
+	p_neighbours[index].mDistSqr = dist_sqr;
+}
+
+static inline bool s_test_entry( const SEntry* p_entry, const Mth::Vector& pos, float radius_sqr, uint32 type_mask, const CCompositeObject* p_ignore, float* p_dist_sqr )
+{
+	if (!p_entry->mpObject || !( p_entry->mTypeMask & type_mask ) || p_entry->mpObject == p_ignore)
+	{
+		return false;
+	}
+	*p_dist_sqr = Mth::DistanceSqr( p_entry->mPos, pos );
+	if (*p_dist_sqr > radius_sqr)
+	{
+		return false;
+	}
+
+	// Marked dead, but still in the grid until the object manager deletes it
+	return !p_entry->mpObject->IsDead();
+}
+
+static int s_find( const Mth::Vector& pos, float radius, uint32 type_mask, const CCompositeObject* p_ignore,
+				   SNeighbour* p_neighbours, int max_neighbours, bool nearest )
+{
+	Dbg_MsgAssert(p_neighbours || !max_neighbours,("NULL p_neighbours"));
+
+	int num_neighbours = 0;
+	if (max_neighbours <= 0)
+	{
+		return 0;
+	}
+
+	float radius_sqr = radius * radius;
+	float dist_sqr;
+
+	int min_x = s_cell( pos[X] - radius );
+	int max_x = s_cell( pos[X] + radius );
+	int min_z = s_cell( pos[Z] - radius );
+	int max_z = s_cell( pos[Z] + radius );
+	if (max_x - min_x >= vMAX_CELL_SPAN || max_z - min_z >= vMAX_CELL_SPAN)
+	{
+		for (int i = 0; i < s_num_entries; i++)
+		{
+			if (s_test_entry( &sp_entries[i], pos, radius_sqr, type_mask, p_ignore, &dist_sqr ))
+			{
+				s_add_result( &sp_entries[i], dist_sqr, p_neighbours, max_neighbours, num_neighbours, nearest );
+			}
+		}
+		return num_neighbours;
+	}
+
+	for (int cell_z = min_z; cell_z <= max_z; cell_z++)
+	{
+		for (int cell_x = min_x; cell_x <= max_x; cell_x++)
+		{
+			uint32 bucket = s_bucket( cell_x, cell_z );
+			for (int i = sp_bucket_start[bucket]; i < sp_bucket_start[bucket + 1]; i++)
+			{
+				// Other cells share the bucket; only take the entries in this one, so
+				// an object is never found twice
+				const SEntry* p_entry = &sp_entries[i];
+				if (p_entry->mCellX != cell_x || p_entry->mCellZ != cell_z)
+				{
+					continue;
+				}
+
+				if (s_test_entry( p_entry, pos, radius_sqr, type_mask, p_ignore, &dist_sqr ))
+				{
+					s_add_result( p_entry, dist_sqr, p_neighbours, max_neighbours, num_neighbours, nearest );
+					if (!nearest && num_neighbours == max_neighbours)
+					{
+						return num_neighbours;
+					}
+				}
+			}
+		}
+	}
+
+	return num_neighbours;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int FindNeighbours( const Mth::Vector& pos, float radius, uint32 typeMask, const CCompositeObject* p_ignore,
+					SNeighbour* p_neighbours, int maxNeighbours )
+{
+	return s_find( pos, radius, typeMask, p_ignore, p_neighbours, maxNeighbours, false );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+int FindNearestNeighbours( const Mth::Vector& pos, float radius, uint32 typeMask, const CCompositeObject* p_ignore,
+						   SNeighbour* p_neighbours, int k )
+{
+	return s_find( pos, radius, typeMask, p_ignore, p_neighbours, k, true );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// A counting sort on the bucket, so the whole thing is linear in the number of objects
+void RebuildNeighbourGrid( CCompositeObject* const* pp_objects, int numObjects )
+{
+	Dbg_MsgAssert(!Job::IsWorkerThread(),("The neighbour grid must be rebuilt on the main thread"));
+
+	static SEntry sp_unsorted[vMAX_ENTRIES];
+
+	memset( sp_bucket_start, 0, sizeof( sp_bucket_start ));
+
+	int num_entries = 0;
+	for (int i = 0; i < numObjects; i++)
+	{
+		CCompositeObject* p_object = pp_objects[i];
+		if (!p_object || p_object->IsDead())
+		{
+			continue;
+		}
+		if (num_entries == vMAX_ENTRIES)
+		{
+			Dbg_MsgAssert(0,("More than %d objects in the neighbour grid",vMAX_ENTRIES));
+			break;
+		}
+
+		SEntry* p_entry = &sp_unsorted[num_entries];
+		p_entry->mpObject = p_object;
+		p_entry->mTypeMask = NEIGHBOUR_TYPE( p_object->GetType() );
+		p_entry->mPos = p_object->GetPos();
+		p_entry->mCellX = s_cell( p_entry->mPos[X] );
+		p_entry->mCellZ = s_cell( p_entry->mPos[Z] );
+
+		uint32 bucket = s_bucket( p_entry->mCellX, p_entry->mCellZ );
+		sp_entry_bucket[num_entries++] = bucket;
+		sp_bucket_start[bucket + 1]++;
+	}
+
+	for (int b = 0; b < vNUM_BUCKETS; b++)
+	{
+		sp_bucket_start[b + 1] += sp_bucket_start[b];
+	}
+
+	// Uses the starts as the insert positions, which leaves each one at the end of its bucket
+	for (int i = 0; i < num_entries; i++)
+	{
+		sp_entries[sp_bucket_start[sp_entry_bucket[i]]++] = sp_unsorted[i];
+	}
+	for (int b = vNUM_BUCKETS; b > 0; b--)
+	{
+		sp_bucket_start[b] = sp_bucket_start[b - 1];
+	}
+	sp_bucket_start[0] = 0;
+
+	s_num_entries = num_entries;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Objects are seldom destroyed, so there's no index to find them by
+void RemoveFromNeighbourGrid( CCompositeObject* p_object )
+{
+	Dbg_MsgAssert(!Job::IsWorkerThread(),("Objects must be destroyed on the main thread"));
+
+	for (int i = 0; i < s_num_entries; i++)
+	{
+		if (sp_entries[i].mpObject == p_object)
+		{
+			sp_entries[i].mpObject = NULL;
+			return;
+		}
+	}
+}
+
+}
@@ -0,0 +1,63 @@
+//****************************************************************************
+//* MODULE:         Gel/Object
+//* FILENAME:       neighbourgrid.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef __OBJECT_NEIGHBOURGRID_H__
+#define __OBJECT_NEIGHBOURGRID_H__
+
+#include <core/defines.h>
+#include <core/math.h>
+
+namespace Obj
+{
+
+class CCompositeObject;
+
+// Finds the composite objects near a point, for things like ped avoidance and skater
+// proximity that used to test every object they might care about.
+//
+// The CCompositeObjectManager hashes the position of every object into a grid of cells
+// in the X-Z plane at the start of each update, in one pass over the objects.  Queries
+// only look at the cells the query sphere touches.  The positions are the ones the
+// objects had at the start of the update, so the answer doesn't depend on what order the
+// objects are updated in.  Objects created during the update aren't in it until the next
+// frame.  An object destroyed during the update (killed from script, or by a component)
+// has its entry cleared by UnregisterObject() straight away, on the main thread, so a
+// query never returns a deleted object; objects marked dead but not yet deleted are
+// skipped too.  The returned pointers are only good until something else can destroy
+// objects, so don't keep them.
+//
+// Components updated in parallel defer anything that kills an object (see
+// deferredcommands.h) until the parallel pass is over, so the grid doesn't change
+// while they are querying it.
+
+struct SNeighbour
+{
+	CCompositeObject*	mpObject;
+	Mth::Vector			mPos;			// at the start of the frame
+	float				mDistSqr;		// from the query point, to mPos
+};
+
+// For typeMask, from CObject::GetType()
+#define	NEIGHBOUR_TYPE( type )		( 1u << (( type ) & 31 ))
+#define	vNEIGHBOUR_ALL_TYPES		( 0xffffffff )
+
+// Fills p_neighbours with up to maxNeighbours objects of the given types within radius
+// of pos, in no particular order, skipping p_ignore (which can be NULL).  Returns how many.
+int					FindNeighbours( const Mth::Vector& pos, float radius, uint32 typeMask, const CCompositeObject* p_ignore,
+									SNeighbour* p_neighbours, int maxNeighbours );
+
+// The same, but the k nearest, nearest first.
+int					FindNearestNeighbours( const Mth::Vector& pos, float radius, uint32 typeMask, const CCompositeObject* p_ignore,
+										   SNeighbour* p_neighbours, int k );
+
+// Used by the manager.
+void				RebuildNeighbourGrid( CCompositeObject* const* pp_objects, int numObjects );
+void				RemoveFromNeighbourGrid( CCompositeObject* p_object );
+
+}
+
+#endif
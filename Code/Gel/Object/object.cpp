@@ -42,6 +42,7 @@
 #include <gel/objtrack.h>
 #include <gel/objsearch.h>
 #include <gel/Event.h>
+#include <gel/object/deferredcommands.h>
 
 /*****************************************************************************
 **								  Externals									**
@@ -943,8 +944,25 @@ void CObject::BroadcastEvent(uint32 event, Script::CStruct *pData, float radius)
 	Has the same effect as deleting the CObject, except the actual deletion is deferred until next frame.
 	So that objects can be killed and not mess up list traversal
 */
+static void s_mark_as_dead_deferred( void *p_data )
+{
+	CObject* p_object = CTracker::Instance()->GetObjectFromHandle( *(uint32*)p_data );
+	if ( p_object && !p_object->IsDead() )
+	{
+		p_object->MarkAsDead();
+	}
+}
+
 void CObject::MarkAsDead( void )
 {
+	// killing an object touches the object lists and scripts, so
+	// from a parallel component update it happens after the update
+	if ( DeferringCommands() )
+	{
+		uint32 handle = CTracker::Instance()->GetObjectHandle( m_id );
+		DeferCommand( s_mark_as_dead_deferred, &handle, sizeof( handle ));
+		return;
+	}
 	
 	// make sure we don't continue running anything on this script!
 	if ( mp_script )
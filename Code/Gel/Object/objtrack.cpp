@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include <core/defines.h>
 #include <core/singleton.h>
 
@@ -13,6 +15,8 @@
 #include <gel/scripting/symboltable.h>
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/component.h>
+#include <gel/scripting/utils.h>
+#include <gel/object/deferredcommands.h>
 
 #include <gfx/2D/ScreenElemMan.h>
 
@@ -28,6 +32,15 @@ namespace Obj
 
 
 
+// Where an id's entry goes in the tracker's id table, if nothing else is there.  Ids are
+// mostly checksums, but some (like the skaters') are small numbers, so mix them up.
+static inline uint32 s_id_home(uint32 id, int bits)
+{
+	return (id * 2654435761u) >> (32 - bits);
+}
+
+
+
 CEventLog::CEventLog()
 {
 	m_next_entry = 0;
@@ -252,8 +265,7 @@ DefineSingletonClass( CTracker, "CObject Tracker" );
 void CTracker::addObject(CObject *pObject)
 {
 	Dbg_MsgAssert(pObject->GetID() != 0xFFFFFFFF, ("CObject has no ID"));
-	Dbg_MsgAssert(!mp_hash_table->GetItem(pObject->GetID()), ("CObject with ID %s already in tracking system", Script::FindChecksumName(pObject->GetID())));
-	
+	Dbg_MsgAssert(find_id(pObject->GetID()) < 0, ("CObject with ID %s already in tracking system", Script::FindChecksumName(pObject->GetID())));
 	// if object ID already being used as alias, remove the alias
 	CObject *p_alias_obj = mp_alias_table->GetItem(pObject->GetID());
 	if (p_alias_obj)
@@ -262,7 +274,29 @@ void CTracker::addObject(CObject *pObject)
 		mp_alias_table->FlushItem(pObject->GetID());
 	}
 	
-	mp_hash_table->PutItem(pObject->GetID(), pObject);
+	if (m_first_free_slot == vNO_SLOT && !grow_slots())
+	{
+		// Left untracked, so GetObject() won't find it, rather than writing past the end
+		return;
+	}
+	if ((m_num_objects + 1) * 2 > (1 << m_id_table_bits))
+	{
+		grow_id_table();
+	}
+	
+	uint16 slot = m_first_free_slot;
+	m_first_free_slot = mp_slots[slot].mNextFree;
+	mp_slots[slot].mpObject = pObject;
+	
+	uint32 mask = (1 << m_id_table_bits) - 1;
+	uint32 index = s_id_home(pObject->GetID(), m_id_table_bits);
+	while (mp_id_table[index].mSlot != vNO_SLOT)
+	{
+		index = (index + 1) & mask;
+	}
+	mp_id_table[index].mId = pObject->GetID();
+	mp_id_table[index].mSlot = slot;
+	m_num_objects++;
 #ifdef __DEBUG_OBJ_MAN__
 	printf("*** Added object %s to global tracker\n", Script::FindChecksumName(pObject->GetID()));
 #endif
@@ -273,6 +307,82 @@ void CTracker::addObject(CObject *pObject)
 
 
 
+/*
+	Doubles the number of object slots.  The new ones go on the free list.  Objects don't
+	move, but their slots do, which is fine as nothing outside the tracker points at them.
+	Returns false if there are as many as there can be.
+*/
+bool CTracker::grow_slots()
+{
+	// A handle only has room for 16 bits of slot, and vNO_SLOT is taken, so there's no
+	// going past this
+	if (m_num_slots >= vMAX_SLOTS)
+	{
+		Dbg_MsgAssert(0, ("More than %d objects in tracking system", (int)vMAX_SLOTS));
+		return false;
+	}
+	
+	int num_slots = Mth::Min(m_num_slots * 2, (int)vMAX_SLOTS);
+	
+	Mem::Manager::sHandle().PushContext(Mem::Manager::sHandle().ScriptHeap());
+	SObjectSlot *p_slots = new SObjectSlot[num_slots];
+	Mem::Manager::sHandle().PopContext();
+	
+	memcpy(p_slots, mp_slots, m_num_slots * sizeof(SObjectSlot));
+	for (int i = m_num_slots; i < num_slots; i++)
+	{
+		p_slots[i].mpObject = NULL;
+		p_slots[i].mGeneration = 1;
+		p_slots[i].mNextFree = (i + 1 < num_slots) ? i + 1 : m_first_free_slot;
+	}
+	m_first_free_slot = m_num_slots;
+	
+	delete [] mp_slots;
+	mp_slots = p_slots;
+	m_num_slots = num_slots;
+	return true;
+}
+
+
+
+
+// Doubles the size of the id table, putting every id back in at its new home
+void CTracker::grow_id_table()
+{
+	int old_size = 1 << m_id_table_bits;
+	SIdEntry *p_old_table = mp_id_table;
+	
+	m_id_table_bits++;
+	uint32 mask = (1 << m_id_table_bits) - 1;
+	
+	Mem::Manager::sHandle().PushContext(Mem::Manager::sHandle().ScriptHeap());
+	mp_id_table = new SIdEntry[mask + 1];
+	Mem::Manager::sHandle().PopContext();
+	
+	for (uint32 i = 0; i <= mask; i++)
+	{
+		mp_id_table[i].mSlot = vNO_SLOT;
+	}
+	for (int i = 0; i < old_size; i++)
+	{
+		if (p_old_table[i].mSlot == vNO_SLOT)
+		{
+			continue;
+		}
+		uint32 index = s_id_home(p_old_table[i].mId, m_id_table_bits);
+		while (mp_id_table[index].mSlot != vNO_SLOT)
+		{
+			index = (index + 1) & mask;
+		}
+		mp_id_table[index] = p_old_table[i];
+	}
+	
+	delete [] p_old_table;
+}
+
+
+
+
 /*
 	Ryan Old Comment: The 'newIdOfObjectBeingMomentarilyRemoved' parameter is set if we are just changing the ID of the object,
 	which requires removing it, then adding it again. Otherwise, this parameter will be zero (the id of the skater, fool!)
@@ -282,7 +392,36 @@ void CTracker::addObject(CObject *pObject)
 
 void CTracker::removeObject(CObject *pObject, uint32 newIdOfObjectBeingMomentarilyRemoved, bool momentary_removal)
 {
-	mp_hash_table->FlushItem(pObject->GetID());
+	int index = find_id(pObject->GetID());
+	if (index >= 0)
+	{
+		// Any handles to the object go stale when the generation changes
+		SObjectSlot *p_slot = &mp_slots[mp_id_table[index].mSlot];
+		p_slot->mpObject = NULL;
+		if (++p_slot->mGeneration == 0)
+		{
+			p_slot->mGeneration = 1;
+		}
+		p_slot->mNextFree = m_first_free_slot;
+		m_first_free_slot = mp_id_table[index].mSlot;
+		
+		// Take the id out of the table, moving back any later entries in the same run that
+		// would otherwise be cut off from their home position
+		uint32 mask = (1 << m_id_table_bits) - 1;
+		uint32 hole = index;
+		for (uint32 next = (hole + 1) & mask; mp_id_table[next].mSlot != vNO_SLOT; next = (next + 1) & mask)
+		{
+			uint32 home = s_id_home(mp_id_table[next].mId, m_id_table_bits);
+			if (((next - home) & mask) >= ((next - hole) & mask))
+			{
+				mp_id_table[hole] = mp_id_table[next];
+				hole = next;
+			}
+		}
+		mp_id_table[hole].mSlot = vNO_SLOT;
+		m_num_objects--;
+	}
+	
 	if (momentary_removal)
 	{
 		// go through all the scripts waiting on object, change the ID
@@ -373,7 +512,24 @@ void CTracker::remove_aliases(CObject *pObject)
 
 CTracker::CTracker()
 {
-	mp_hash_table = new Lst::HashTable<CObject>(8);
+	m_num_slots = vINITIAL_SLOTS;
+	mp_slots = new SObjectSlot[m_num_slots];
+	for (int i = 0; i < m_num_slots; i++)
+	{
+		mp_slots[i].mpObject = NULL;
+		mp_slots[i].mGeneration = 1;
+		mp_slots[i].mNextFree = (i + 1 < m_num_slots) ? i + 1 : vNO_SLOT;
+	}
+	m_first_free_slot = 0;
+	
+	m_id_table_bits = vINITIAL_ID_TABLE_BITS;
+	mp_id_table = new SIdEntry[1 << m_id_table_bits];
+	for (int i = 0; i < (1 << m_id_table_bits); i++)
+	{
+		mp_id_table[i].mSlot = vNO_SLOT;
+	}
+	m_num_objects = 0;
+	
 	mp_alias_table = new Lst::HashTable<CObject>(4);
 	mp_event_receiver_table = new Lst::HashTable<CEventReceiverList>(8);	
 	
@@ -385,6 +541,18 @@ CTracker::CTracker()
 
 	m_next_event_script = 0;
 
+	mp_event_queue = new uint8[vEVENT_QUEUE_SIZE];
+	m_event_queue_read = 0;
+	m_event_queue_write = 0;
+	mp_coalesce_table = new SCoalesceEntry[vCOALESCE_TABLE_SIZE];
+	for (int i = 0; i < vCOALESCE_TABLE_SIZE; i++)
+	{
+		mp_coalesce_table[i].mBatch = 0;
+	}
+	m_event_batch = 1;
+	m_num_coalesce_entries = 0;
+	m_dispatching_events = false;
+
 	for (int i = 0; i < vMAX_SCRIPT_ENTRIES; i++) 
 		m_waiting_script_tab[i].mEventType = vDEAD_SCRIPT_ENTRY;
 	
@@ -397,8 +565,11 @@ CTracker::CTracker()
 
 CTracker::~CTracker()
 {
-	Dbg_MsgAssert(mp_hash_table->GetSize(), ("entries still in tracker"));
-	delete mp_hash_table;
+	Dbg_MsgAssert(m_num_objects, ("entries still in tracker"));
+	delete [] mp_coalesce_table;
+	delete [] mp_event_queue;
+	delete [] mp_id_table;
+	delete [] mp_slots;
 }
 
 
@@ -411,12 +582,71 @@ CTracker::~CTracker()
 */
 CObject *CTracker::GetObject(uint32 id)
 {
-	CObject *p_obj = mp_hash_table->GetItem(id);
-	if (!p_obj)
+	int index = find_id(id);
+	if (index >= 0)
 	{
-		p_obj = mp_alias_table->GetItem(id);
+		return mp_slots[mp_id_table[index].mSlot].mpObject;
+	}
+	return mp_alias_table->GetItem(id);
+}
+
+
+
+
+uint32 CTracker::GetObjectHandle(uint32 id)
+{
+	int index = find_id(id);
+	if (index < 0)
+	{
+		return 0;
+	}
+	uint32 slot = mp_id_table[index].mSlot;
+	return ((uint32)mp_slots[slot].mGeneration << vHANDLE_GENERATION_SHIFT) | slot;
+}
+
+
+
+
+CObject *CTracker::GetObjectFromHandle(uint32 handle)
+{
+	uint32 slot = handle & vHANDLE_SLOT_MASK;
+	if (slot >= (uint32)m_num_slots || mp_slots[slot].mGeneration != (handle >> vHANDLE_GENERATION_SHIFT))
+	{
+		return NULL;
+	}
+	return mp_slots[slot].mpObject;
+}
+
+
+
+
+// Returns the index in mp_id_table of the entry for id, or -1
+int CTracker::find_id(uint32 id)
+{
+	uint32 mask = (1 << m_id_table_bits) - 1;
+	for (uint32 index = s_id_home(id, m_id_table_bits); mp_id_table[index].mSlot != vNO_SLOT; index = (index + 1) & mask)
+	{
+		if (mp_id_table[index].mId == id)
+		{
+			return index;
+		}
+	}
+	return -1;
+}
+
+
+
+
+void CTracker::print_objects()
+{
+	printf("Objects in tracker:\n");
+	for (int i = 0; i < m_num_slots; i++)
+	{
+		if (mp_slots[i].mpObject)
+		{
+			printf("    %s [%d]\n", Script::FindChecksumName(mp_slots[i].mpObject->GetID()), i);
+		}
 	}
-	return p_obj;
 }
 
 
@@ -433,7 +663,7 @@ CObject *CTracker::GetObjectByAlias(uint32 aliasId)
 void CTracker::AddAlias(uint32 alias, CObject *pObject)
 {
 	// make sure alias not already being used for object ID
-	Dbg_MsgAssert(!mp_hash_table->GetItem(alias), ("CObject with ID %s already in tracking system", Script::FindChecksumName(alias)));
+	Dbg_MsgAssert(find_id(alias) < 0, ("CObject with ID %s already in tracking system", Script::FindChecksumName(alias)));
 	
 	// if desired alias already being used as alias, remove old one
 	CObject *p_alias_obj = mp_alias_table->GetItem(alias);
@@ -463,7 +693,7 @@ uint32 CTracker::GetFreshId()
 		if (m_id_seed >= 1000000)
 			m_id_seed = 0;
 		uint32 id = Script::GenerateCRC(name_string);
-		if (!mp_hash_table->GetItem(id))
+		if (find_id(id) < 0)
 		{
 			return id;
 		}
@@ -516,8 +746,55 @@ void CTracker::ValidateReceivers()
 
 
 // returns true if event was handled
+struct SDeferredEvent
+{
+	uint32	mType;
+	uint32	mTarget;
+	uint32	mSource;
+	bool	mBroadcast;
+	bool	mQueued;
+	bool	mCoalesce;
+};
+
+static void s_launch_deferred_event( void *p_data )
+{
+	SDeferredEvent* p_event = (SDeferredEvent*)p_data;
+	Script::CStruct* p_params = ReadDeferredParams( (uint8*)p_data, sizeof( SDeferredEvent ));
+	if (p_event->mQueued)
+	{
+		CTracker::Instance()->QueueEvent(p_event->mType, p_event->mTarget, p_event->mSource, p_params, p_event->mBroadcast, p_event->mCoalesce);
+	}
+	else
+	{
+		CTracker::Instance()->LaunchEvent(p_event->mType, p_event->mTarget, p_event->mSource, p_params, p_event->mBroadcast);
+	}
+	delete p_params;
+}
+
+static void s_defer_event( uint32 type, uint32 target, uint32 source, Script::CStruct *pData, bool broadcast, bool queued, bool coalesce )
+{
+	uint8 p_command[vMAX_DEFERRED_COMMAND_SIZE];
+	SDeferredEvent* p_event = (SDeferredEvent*)p_command;
+	p_event->mType = type;
+	p_event->mTarget = target;
+	p_event->mSource = source;
+	p_event->mBroadcast = broadcast;
+	p_event->mQueued = queued;
+	p_event->mCoalesce = coalesce;
+	DeferCommand( s_launch_deferred_event, p_command, WriteDeferredParams( p_command, sizeof( SDeferredEvent ), pData ));
+}
+
 bool CTracker::LaunchEvent(uint32 type, uint32 target, uint32 source, Script::CStruct *pData, bool broadcast)
 {
+	// From a component being updated in parallel, the event is launched after the
+	// update instead.  It can't have been handled yet, so return false.
+	if (DeferringCommands())
+	{
+		s_defer_event(type, target, source, pData, broadcast, false, false);
+		return false;
+	}
+	
+
 //	printf("launch event, type=%s, target=0x%x, source= 0x%x, pData = %p\n", Script::FindChecksumName(type),target,source, pData);
 	
 //	Dbg_MsgAssert(!broadcast,("Don't use the broadcast flag yet!!!"));
@@ -662,7 +939,7 @@ bool CTracker::LaunchEvent(uint32 type, uint32 target, uint32 source, Script::CS
 				{
 					m_event_log.Print(256);
 					#ifdef __NOPT_ASSERT__			
-					mp_hash_table->PrintContents();
+					print_objects();
 					#endif
 				}
 				
@@ -729,6 +1006,169 @@ bool CTracker::LaunchEvent(uint32 type, uint32 target, uint32 source, Script::CS
 
 
 
+// The header of an event in the event queue
+struct SQueuedEvent
+{
+	uint32	mType;
+	uint32	mTarget;
+	uint32	mSource;
+	uint32	mScript;				// that queued it, for the event log
+	uint16	mSize;					// including the data, rounded up to a multiple of 8
+	uint8	mFlags;
+};
+
+enum
+{
+	vQUEUED_BROADCAST		= (1<<0),
+	vQUEUED_DATA			= (1<<1),
+	vQUEUED_PADDING			= (1<<2),		// nothing more until the start of the buffer
+	vMAX_QUEUED_DATA_SIZE	= 1024,
+};
+
+void CTracker::QueueEvent(uint32 type, uint32 target, uint32 source, Script::CStruct *pData, bool broadcast, bool coalesce)
+{
+	// From a component being updated in parallel, the event is queued after the update,
+	// in the order the components would have been updated in serially
+	if (DeferringCommands())
+	{
+		s_defer_event(type, target, source, pData, broadcast, true, coalesce);
+		return;
+	}
+	
+	uint32 script = m_next_event_script;
+	m_next_event_script = 0;
+	
+	// If the table is getting full, just queue it
+	SCoalesceEntry *p_coalesce_entry = NULL;
+	if (coalesce && !pData && m_num_coalesce_entries < vCOALESCE_TABLE_SIZE / 2)
+	{
+		uint32 index = s_id_home(type ^ (target * 0x9e3779b9u) ^ (source * 0x85ebca6bu), vCOALESCE_TABLE_BITS);
+		while (true)
+		{
+			p_coalesce_entry = &mp_coalesce_table[index];
+			if (p_coalesce_entry->mBatch != m_event_batch)
+			{
+				break;
+			}
+			if (p_coalesce_entry->mType == type && p_coalesce_entry->mTarget == target && p_coalesce_entry->mSource == source && p_coalesce_entry->mBroadcast == broadcast)
+			{
+				// already waiting
+				return;
+			}
+			index = (index + 1) & (vCOALESCE_TABLE_SIZE - 1);
+		}
+	}
+	
+	uint8 p_data[vMAX_QUEUED_DATA_SIZE];
+	uint32 data_size = pData ? Script::WriteToBuffer(pData, p_data, vMAX_QUEUED_DATA_SIZE) : 0;
+	uint32 size = (sizeof(SQueuedEvent) + data_size + 7) & ~7;
+	
+	// An event doesn't wrap round the end of the buffer; it goes at the start instead
+	uint32 pos = m_event_queue_write & (vEVENT_QUEUE_SIZE - 1);
+	uint32 pad = (pos + size > vEVENT_QUEUE_SIZE) ? vEVENT_QUEUE_SIZE - pos : 0;
+	if (m_event_queue_write - m_event_queue_read + pad + size > vEVENT_QUEUE_SIZE)
+	{
+		Dbg_MsgAssert(0, ("Event queue full, launching %s now", Script::FindChecksumName(type)));
+		LogEventScript(script);
+		LaunchEvent(type, target, source, pData, broadcast);
+		return;
+	}
+	
+	// Only once it's really waiting, as one launched already can't be coalesced with
+	if (p_coalesce_entry)
+	{
+		p_coalesce_entry->mType = type;
+		p_coalesce_entry->mTarget = target;
+		p_coalesce_entry->mSource = source;
+		p_coalesce_entry->mBroadcast = broadcast;
+		p_coalesce_entry->mBatch = m_event_batch;
+		m_num_coalesce_entries++;
+	}
+	
+	if (pad)
+	{
+		if (pad >= sizeof(SQueuedEvent))
+		{
+			((SQueuedEvent*)(mp_event_queue + pos))->mFlags = vQUEUED_PADDING;
+		}
+		m_event_queue_write += pad;
+		pos = 0;
+	}
+	
+	SQueuedEvent *p_event = (SQueuedEvent*)(mp_event_queue + pos);
+	p_event->mType = type;
+	p_event->mTarget = target;
+	p_event->mSource = source;
+	p_event->mScript = script;
+	p_event->mSize = size;
+	p_event->mFlags = (broadcast ? vQUEUED_BROADCAST : 0) | (pData ? vQUEUED_DATA : 0);
+	memcpy(p_event + 1, p_data, data_size);
+	
+	m_event_queue_write += size;
+}
+
+
+
+
+void CTracker::DispatchQueuedEvents()
+{
+	// Leave them queued until launching is allowed again
+	if (m_dispatching_events || m_block_event_launching)
+	{
+		return;
+	}
+	m_dispatching_events = true;
+	
+	// Events queued by the handlers wait for the next dispatch, so the handlers can't
+	// keep it going forever, and they only coalesce with each other
+	uint32 end = m_event_queue_write;
+	m_event_batch++;
+	m_num_coalesce_entries = 0;
+	
+	Script::CStruct params;
+	while (m_event_queue_read != end)
+	{
+		uint32 pos = m_event_queue_read & (vEVENT_QUEUE_SIZE - 1);
+		SQueuedEvent *p_event = (SQueuedEvent*)(mp_event_queue + pos);
+		if (vEVENT_QUEUE_SIZE - pos < sizeof(SQueuedEvent) || (p_event->mFlags & vQUEUED_PADDING))
+		{
+			m_event_queue_read += vEVENT_QUEUE_SIZE - pos;
+			continue;
+		}
+		
+		// The target may have gone since the event was queued, and LaunchEvent() insists
+		// on it being there
+		bool broadcast = p_event->mFlags & vQUEUED_BROADCAST;
+		if (!broadcast && p_event->mTarget != CEvent::vSYSTEM_EVENT &&
+			!GetObject(p_event->mTarget) && !Script::FindSpawnedScriptWithID(p_event->mTarget))
+		{
+			m_event_queue_read += p_event->mSize;
+			continue;
+		}
+		
+		// The event isn't overwritten until the read position is moved past it
+		bool has_data = p_event->mFlags & vQUEUED_DATA;
+		if (has_data)
+		{
+			Script::ReadFromBuffer(&params, (uint8*)(p_event + 1));
+		}
+		
+		LogEventScript(p_event->mScript);
+		LaunchEvent(p_event->mType, p_event->mTarget, p_event->mSource, has_data ? &params : NULL, broadcast);
+		
+		if (has_data)
+		{
+			params.Clear();
+		}
+		m_event_queue_read += p_event->mSize;
+	}
+	
+	m_dispatching_events = false;
+}
+
+
+
+
 // Call right before calling LaunchEvent()
 void CTracker::LogEventScript(uint32 script)
 {
@@ -1034,9 +1474,23 @@ void CTracker::SuspendScriptUntilEvent(Script::CScript *pScript, uint32 event_ty
 
 #ifndef __PLAT_WN32__	// These script functions are not necessary from PC tools
 
+static void s_launch_event(CTracker *p_tracker, uint32 type, uint32 target, uint32 source, Script::CStruct *pData, bool broadcast, bool queued, bool coalesce)
+{
+	if (queued)
+	{
+		p_tracker->QueueEvent(type, target, source, pData, broadcast, coalesce);
+	}
+	else
+	{
+		p_tracker->LaunchEvent(type, target, source, pData, broadcast);
+	}
+}
+
 // @script | LaunchEvent | 
 // @parm name | type | event type
 // @parm structure | data | 
+// @flag queued | launch it with the other queued events, at the end of the frame
+// @flag coalesce | with queued, don't queue it if it's already waiting (only without data)
 bool ScriptLaunchEvent(Script::CStruct *pParams, Script::CScript *pScript)
 {
 	// Although events aren't necessarily tied to the Screen Element system, it is
@@ -1075,6 +1529,8 @@ bool ScriptLaunchEvent(Script::CStruct *pParams, Script::CScript *pScript)
 	pParams->GetStructure(CRCD(0x520c0c9c,"data"), &pData);
 	
 	bool broadcast = pParams->ContainsFlag(CRCD(0x640e830a,"broadcast"));
+	bool queued = pParams->ContainsFlag(CRCD(0xb3e678ae,"queued"));
+	bool coalesce = pParams->ContainsFlag(CRCD(0x0f6a81fa,"coalesce"));
 	
 	CTracker* p_tracker = CTracker::Instance();	
 	
@@ -1082,7 +1538,7 @@ bool ScriptLaunchEvent(Script::CStruct *pParams, Script::CScript *pScript)
 	if (pParams->GetChecksum(CRCD(0x7321a8d6,"type"), &type))
 	{
 		p_tracker->LogEventScript(pScript->mScriptChecksum);
-		p_tracker->LaunchEvent(type, target, source, pData, broadcast);
+		s_launch_event(p_tracker, type, target, source, pData, broadcast, queued, coalesce);
 	}
 	else
 	{
@@ -1094,7 +1550,7 @@ bool ScriptLaunchEvent(Script::CStruct *pParams, Script::CScript *pScript)
 			for (unsigned n = 0; n < num_events; n++)
 			{
 				p_tracker->LogEventScript(pScript->mScriptChecksum);
-				p_tracker->LaunchEvent(pTypes->GetChecksum(n), target, source, pData, broadcast);
+				s_launch_event(p_tracker, pTypes->GetChecksum(n), target, source, pData, broadcast, queued, coalesce);
 			}
 		}
 		else
@@ -1106,7 +1562,7 @@ bool ScriptLaunchEvent(Script::CStruct *pParams, Script::CScript *pScript)
 				{
 					Dbg_Assert(pComp->mType == ESYMBOLTYPE_NAME);
 					p_tracker->LogEventScript(pScript->mScriptChecksum);
-					p_tracker->LaunchEvent(pComp->mChecksum, target, source, pData, broadcast);
+					s_launch_event(p_tracker, pComp->mChecksum, target, source, pData, broadcast, queued, coalesce);
 				}
 			}
 			else
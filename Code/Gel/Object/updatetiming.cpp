@@ -0,0 +1,518 @@
+//****************************************************************************
+//* MODULE:         Gel/Object
+//* FILENAME:       updatetiming.cpp
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+
+#include <gel/object/updatetiming.h>
+#include <gel/scripting/struct.h>
+#include <gel/scripting/array.h>
+#include <gel/scripting/script.h>
+#include <gel/scripting/checksum.h>
+#include <core/thread/jobsystem.h>
+#include <sys/trace.h>
+
+namespace Obj
+{
+
+enum
+{
+	vMAX_TIMED_COMPONENTS = 128,			// as many as the manager can register
+	vMAX_TIMED_OBJECTS = 16,				// object types; any higher share the last one
+	vNUM_TIMING_SLOTS = vMAX_TIMED_COMPONENTS + vMAX_TIMED_OBJECTS,
+	vSLOT_TABLE_BITS = 8,
+	vSLOT_TABLE_SIZE = 1 << vSLOT_TABLE_BITS,
+	vNUM_HISTOGRAM_BUCKETS = 16,
+	vCALIBRATION_US = 250000,				// how long to watch the timer for before trusting it
+};
+
+// The SKATE_TYPE_s, from sk/modules/skate/skate.h
+static const char* sp_object_type_names[] =
+{
+	"undefined",
+	"skater",
+	"ped",
+	"car",
+	"game_obj",
+	"bouncy_obj",
+	"cassette",
+	"animating_object",
+	"crown",
+	"particle",
+	"replay_dummy",
+	"composite",
+};
+
+struct SCounter
+{
+	uint64				mTicks;
+	uint32				mCount;
+};
+
+// Only written by the one thread, and only read once all the updates are done
+struct alignas( 64 ) SThreadCounters
+{
+	SCounter			mpCounters[vNUM_TIMING_SLOTS];
+};
+
+// Histogram bucket 0 is under 1us for the frame, bucket b is 2^(b-1) up to 2^b us,
+// and the last one is everything over 16ms.
+struct STimingStats
+{
+	uint64				mUpdates;
+	uint32				mFrames;				// that it was updated in
+	double				mTotalUS;
+	float				mMaxUS;
+	float				mLastUS;
+	uint32				mpHistogram[vNUM_HISTOGRAM_BUCKETS];
+};
+
+struct SSlotEntry
+{
+	uint32				mType;
+	int					mSlot;					// -1 if empty
+};
+
+static SThreadCounters	sp_thread_counters[Job::MAX_THREADS];
+static STimingStats		sp_stats[vNUM_TIMING_SLOTS];
+static uint32			sp_component_types[vMAX_TIMED_COMPONENTS];
+static SSlotEntry		sp_slot_table[vSLOT_TABLE_SIZE];
+static int				s_num_components = 0;
+static bool				s_slot_table_ready = false;
+static uint32			s_frames = 0;
+
+static uint64			s_calibration_ticks = 0;
+static uint64			s_calibration_us = 0;
+static float			s_us_per_tick = 0.0f;
+
+static char				sp_log_file[128];
+static int				s_log_interval = 0;
+static int				s_frames_since_log = 0;
+
+static inline int s_object_slot( int objectType )
+{
+	return vMAX_TIMED_COMPONENTS + (( objectType >= 0 && objectType < vMAX_TIMED_OBJECTS ) ? objectType : vMAX_TIMED_OBJECTS - 1 );
+}
+
+static inline uint32 s_type_home( uint32 type )
+{
+	return ( type * 2654435761u ) >> ( 32 - vSLOT_TABLE_BITS );
+}
+
+// Registration is all done before anything is updated, so this is only ever read
+// while components are being updated
+static inline int s_component_slot( uint32 componentType )
+{
+	for (uint32 index = s_type_home( componentType ); ; index = ( index + 1 ) & ( vSLOT_TABLE_SIZE - 1 ))
+	{
+		if (sp_slot_table[index].mSlot < 0 || sp_slot_table[index].mType == componentType)
+		{
+			return sp_slot_table[index].mSlot;
+		}
+	}
+}
+
+static void s_calibrate()
+{
+	uint64 ticks = ReadUpdateTimer();
+	uint64 us = Trace::GetTimeUS();
+	if (!s_calibration_us)
+	{
+		s_calibration_ticks = ticks;
+		s_calibration_us = us;
+		return;
+	}
+
+	// Measured from the first frame, so it only gets more accurate
+	if (us - s_calibration_us >= vCALIBRATION_US && ticks > s_calibration_ticks)
+	{
+		s_us_per_tick = (float)((double)( us - s_calibration_us ) / (double)( ticks - s_calibration_ticks ));
+	}
+}
+
+static int s_histogram_bucket( float us )
+{
+	int bucket = 0;
+	for (uint32 whole_us = (uint32)us; whole_us && bucket < vNUM_HISTOGRAM_BUCKETS - 1; whole_us >>= 1)
+	{
+		bucket++;
+	}
+	return bucket;
+}
+
+// The top of the bucket the 95th percentile frame is in
+static float s_p95( const STimingStats* p_stats )
+{
+	uint32 count = 0;
+	uint32 target = p_stats->mFrames - p_stats->mFrames / 20;
+	for (int bucket = 0; bucket < vNUM_HISTOGRAM_BUCKETS - 1; bucket++)
+	{
+		count += p_stats->mpHistogram[bucket];
+		if (count >= target)
+		{
+			return (float)( 1 << bucket );
+		}
+	}
+	return p_stats->mMaxUS;
+}
+
+static const char* s_slot_name( int slot, char* p_buffer )
+{
+	if (slot < vMAX_TIMED_COMPONENTS)
+	{
+		return Script::FindChecksumName( sp_component_types[slot] );
+	}
+
+	int object_type = slot - vMAX_TIMED_COMPONENTS;
+	if (object_type < (int)( sizeof( sp_object_type_names ) / sizeof( sp_object_type_names[0] )))
+	{
+		return sp_object_type_names[object_type];
+	}
+	sprintf( p_buffer, "type_%d", object_type );
+	return p_buffer;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+float UpdateTimerToMicroseconds( uint64 ticks )
+{
+	return ticks * s_us_per_tick;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void AddTimedComponentType( uint32 componentType )
+{
+	Dbg_MsgAssert(s_num_components < vMAX_TIMED_COMPONENTS,("Too many component types to time"));
+	if (!s_slot_table_ready)
+	{
+		for (int i = 0; i < vSLOT_TABLE_SIZE; i++)
+		{
+			sp_slot_table[i].mSlot = -1;
+		}
+		s_slot_table_ready = true;
+	}
+
+	uint32 index = s_type_home( componentType );
+	while (sp_slot_table[index].mSlot >= 0)
+	{
+		if (sp_slot_table[index].mType == componentType)
+		{
+			return;
+		}
+		index = ( index + 1 ) & ( vSLOT_TABLE_SIZE - 1 );
+	}
+
+	sp_slot_table[index].mType = componentType;
+	sp_slot_table[index].mSlot = s_num_components;
+	sp_component_types[s_num_components++] = componentType;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void RecordComponentTime( uint32 componentType, int objectType, uint64 ticks )
+{
+	if (!s_slot_table_ready)
+	{
+		return;
+	}
+
+	SCounter* p_counters = sp_thread_counters[Job::GetThreadIndex()].mpCounters;
+	int slot = s_component_slot( componentType );
+	if (slot >= 0)
+	{
+		p_counters[slot].mTicks += ticks;
+		p_counters[slot].mCount++;
+	}
+	p_counters[s_object_slot( objectType )].mTicks += ticks;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void RecordObjectTime( int objectType, uint64 ticks )
+{
+	SCounter* p_counter = &sp_thread_counters[Job::GetThreadIndex()].mpCounters[s_object_slot( objectType )];
+	p_counter->mTicks += ticks;
+	p_counter->mCount++;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void EndUpdateTimingFrame()
+{
+	Dbg_MsgAssert(!Job::IsWorkerThread(),("Update timing must be collected on the main thread"));
+
+	s_calibrate();
+
+	for (int slot = 0; slot < vNUM_TIMING_SLOTS; slot++)
+	{
+		uint64 ticks = 0;
+		uint32 count = 0;
+		for (int thread = 0; thread < Job::MAX_THREADS; thread++)
+		{
+			SCounter* p_counter = &sp_thread_counters[thread].mpCounters[slot];
+			ticks += p_counter->mTicks;
+			count += p_counter->mCount;
+			p_counter->mTicks = 0;
+			p_counter->mCount = 0;
+		}
+
+		// Until the timer is calibrated, the times are thrown away
+		if (!count || s_us_per_tick == 0.0f)
+		{
+			continue;
+		}
+
+		float us = UpdateTimerToMicroseconds( ticks );
+		STimingStats* p_stats = &sp_stats[slot];
+		p_stats->mUpdates += count;
+		p_stats->mFrames++;
+		p_stats->mTotalUS += us;
+		p_stats->mLastUS = us;
+		if (us > p_stats->mMaxUS)
+		{
+			p_stats->mMaxUS = us;
+		}
+		p_stats->mpHistogram[s_histogram_bucket( us )]++;
+	}
+
+	if (s_us_per_tick != 0.0f)
+	{
+		s_frames++;
+	}
+
+	if (s_log_interval && ++s_frames_since_log >= s_log_interval)
+	{
+		s_frames_since_log = 0;
+		WriteUpdateTiming( sp_log_file );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void ResetUpdateTiming()
+{
+	memset( sp_stats, 0, sizeof( sp_stats ));
+	s_frames = 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// CSV, or JSON if the file name ends in .json.  avg_frame_us is over all the frames
+// timed, avg_update_us is per update, and h0 to h15 are the histogram buckets.
+bool WriteUpdateTiming( const char* p_fileName )
+{
+	FILE* p_file = fopen( p_fileName, "w" );
+	if (!p_file)
+	{
+		Dbg_Message( "Could not open %s for the update timing", p_fileName );
+		return false;
+	}
+
+	const char* p_ext = strrchr( p_fileName, '.' );
+	bool json = p_ext && ( !strcmp( p_ext, ".json" ) || !strcmp( p_ext, ".JSON" ));
+
+	if (json)
+	{
+		fprintf( p_file, "{\"frames\":%u,\"types\":[", s_frames );
+	}
+	else
+	{
+		fprintf( p_file, "kind,name,updates,frames,avg_frame_us,avg_update_us,p95_us,max_us,last_us" );
+		for (int bucket = 0; bucket < vNUM_HISTOGRAM_BUCKETS; bucket++)
+		{
+			fprintf( p_file, ",h%d", bucket );
+		}
+		fprintf( p_file, "\n" );
+	}
+
+	bool first = true;
+	char p_name[32];
+	for (int slot = 0; slot < vNUM_TIMING_SLOTS; slot++)
+	{
+		const STimingStats* p_stats = &sp_stats[slot];
+		if (!p_stats->mFrames)
+		{
+			continue;
+		}
+
+		const char* p_kind = ( slot < vMAX_TIMED_COMPONENTS ) ? "component" : "object";
+		double avg_frame_us = s_frames ? p_stats->mTotalUS / s_frames : 0.0;
+		double avg_update_us = p_stats->mTotalUS / p_stats->mUpdates;
+		if (json)
+		{
+			fprintf( p_file, "%s\n{\"kind\":\"%s\",\"name\":\"%s\",\"updates\":%llu,\"frames\":%u,\"avg_frame_us\":%.2f,\"avg_update_us\":%.3f,\"p95_us\":%.0f,\"max_us\":%.2f,\"last_us\":%.2f,\"histogram\":[",
+					 first ? "" : ",", p_kind, s_slot_name( slot, p_name ), (unsigned long long)p_stats->mUpdates, p_stats->mFrames,
+					 avg_frame_us, avg_update_us, s_p95( p_stats ), p_stats->mMaxUS, p_stats->mLastUS );
+			for (int bucket = 0; bucket < vNUM_HISTOGRAM_BUCKETS; bucket++)
+			{
+				fprintf( p_file, "%s%u", bucket ? "," : "", p_stats->mpHistogram[bucket] );
+			}
+			fprintf( p_file, "]}" );
+		}
+		else
+		{
+			fprintf( p_file, "%s,%s,%llu,%u,%.2f,%.3f,%.0f,%.2f,%.2f",
+					 p_kind, s_slot_name( slot, p_name ), (unsigned long long)p_stats->mUpdates, p_stats->mFrames,
+					 avg_frame_us, avg_update_us, s_p95( p_stats ), p_stats->mMaxUS, p_stats->mLastUS );
+			for (int bucket = 0; bucket < vNUM_HISTOGRAM_BUCKETS; bucket++)
+			{
+				fprintf( p_file, ",%u", p_stats->mpHistogram[bucket] );
+			}
+			fprintf( p_file, "\n" );
+		}
+		first = false;
+	}
+
+	if (json)
+	{
+		fprintf( p_file, "\n]}\n" );
+	}
+	fclose( p_file );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | GetUpdateTiming | Gets the update timing so far, as two arrays of structures,
+// components and objects (by object type).  Each has the type, updates, frames,
+// avg_frame_us, avg_update_us, p95_us, max_us, last_us and the histogram of the time
+// per frame (bucket 0 is under 1us, bucket b is 2^(b-1) up to 2^b us).
+bool ScriptGetUpdateTiming( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	for (int kind = 0; kind < 2; kind++)
+	{
+		int first_slot = kind ? vMAX_TIMED_COMPONENTS : 0;
+		int end_slot = kind ? vNUM_TIMING_SLOTS : vMAX_TIMED_COMPONENTS;
+
+		int num_timed = 0;
+		for (int slot = first_slot; slot < end_slot; slot++)
+		{
+			if (sp_stats[slot].mFrames)
+			{
+				num_timed++;
+			}
+		}
+
+		Script::CArray* p_array = new Script::CArray;
+		p_array->SetSizeAndType( num_timed, ESYMBOLTYPE_STRUCTURE );
+
+		int index = 0;
+		for (int slot = first_slot; slot < end_slot; slot++)
+		{
+			const STimingStats* p_stats = &sp_stats[slot];
+			if (!p_stats->mFrames)
+			{
+				continue;
+			}
+
+			Script::CStruct* p_struct = new Script::CStruct;
+			if (kind)
+			{
+				char p_name[32];
+				p_struct->AddInteger( CRCD(0x7321a8d6,"type"), slot - vMAX_TIMED_COMPONENTS );
+				p_struct->AddString( CRCD(0xa1dc81f9,"name"), s_slot_name( slot, p_name ));
+			}
+			else
+			{
+				p_struct->AddChecksum( CRCD(0x7321a8d6,"type"), sp_component_types[slot] );
+			}
+			p_struct->AddInteger( CRCD(0xbab7eccf,"updates"), (int)p_stats->mUpdates );
+			p_struct->AddInteger( CRCD(0x019176c5,"frames"), p_stats->mFrames );
+			p_struct->AddFloat( CRCD(0x80bfd45d,"avg_frame_us"), s_frames ? (float)( p_stats->mTotalUS / s_frames ) : 0.0f );
+			p_struct->AddFloat( CRCD(0x8f52e649,"avg_update_us"), (float)( p_stats->mTotalUS / p_stats->mUpdates ));
+			p_struct->AddFloat( CRCD(0xd27f4541,"p95_us"), s_p95( p_stats ));
+			p_struct->AddFloat( CRCD(0x0c2a50ee,"max_us"), p_stats->mMaxUS );
+			p_struct->AddFloat( CRCD(0x4ba6b383,"last_us"), p_stats->mLastUS );
+
+			Script::CArray* p_histogram = new Script::CArray;
+			p_histogram->SetSizeAndType( vNUM_HISTOGRAM_BUCKETS, ESYMBOLTYPE_INTEGER );
+			for (int bucket = 0; bucket < vNUM_HISTOGRAM_BUCKETS; bucket++)
+			{
+				p_histogram->SetInteger( bucket, p_stats->mpHistogram[bucket] );
+			}
+			p_struct->AddArrayPointer( CRCD(0xd9d92207,"histogram"), p_histogram );
+
+			p_array->SetStructure( index++, p_struct );
+		}
+
+		pScript->GetParams()->AddArrayPointer( kind ? CRCD(0x4de5330c,"objects") : CRCD(0x11b70a02,"components"), p_array );
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | WriteUpdateTiming | Writes the update timing so far to a file, as CSV, or
+// JSON if the name ends in .json
+// @parmopt string | file | "update_timing.csv" | File to write to
+// @parmopt int | every | | Keep writing it, every so many frames
+// @flag off | Stop writing it every so many frames
+bool ScriptWriteUpdateTiming( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	if (pParams->ContainsFlag( CRCD(0xd443a2bc,"off") ))
+	{
+		s_log_interval = 0;
+		return true;
+	}
+
+	const char* p_file_name = "update_timing.csv";
+	pParams->GetString( CRCD(0x7360c9ef,"file"), &p_file_name );
+
+	int every = 0;
+	if (pParams->GetInteger( CRCD(0x5c97d4b8,"every"), &every ) && every > 0)
+	{
+		strncpy( sp_log_file, p_file_name, sizeof( sp_log_file ) - 1 );
+		sp_log_file[sizeof( sp_log_file ) - 1] = 0;
+		s_log_interval = every;
+		s_frames_since_log = 0;
+		return true;
+	}
+
+	return WriteUpdateTiming( p_file_name );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | ResetUpdateTiming | Clears the update timing collected so far
+bool ScriptResetUpdateTiming( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	ResetUpdateTiming();
+	return true;
+}
+
+}
@@ -0,0 +1,68 @@
+//****************************************************************************
+//* MODULE:         Gel/Object
+//* FILENAME:       updatetiming.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef __OBJECT_UPDATETIMING_H__
+#define __OBJECT_UPDATETIMING_H__
+
+#include <core/defines.h>
+
+#if defined( __i386__ ) || defined( __x86_64__ )
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
+namespace Obj
+{
+
+// Times the composite object updates in every build, by component type and by object
+// type, cheaply enough to leave on.  Each update is timed with the CPU's time stamp
+// counter, which is calibrated against the wall clock over the first few frames.  The
+// times are added up per thread, so components updated in parallel can be timed too,
+// and once a frame the totals go into a histogram for each type.  Scripts can read the
+// results with GetUpdateTiming, and WriteUpdateTiming saves them as CSV or JSON, once
+// or every so many frames.
+
+// Ticks of the update timer; only the differences mean anything.
+inline uint64		ReadUpdateTimer()
+{
+#if defined( __i386__ ) || defined( __x86_64__ )
+	return __rdtsc();
+#else
+	return (uint64)std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// 0 until the timer has been calibrated.
+float				UpdateTimerToMicroseconds( uint64 ticks );
+
+// Called by the manager as it registers each component type.
+void				AddTimedComponentType( uint32 componentType );
+
+// From any thread.  The component's time counts towards its object's type too.
+void				RecordComponentTime( uint32 componentType, int objectType, uint64 ticks );
+void				RecordObjectTime( int objectType, uint64 ticks );
+
+// Called by the manager once a frame, after all the updates.
+void				EndUpdateTimingFrame();
+
+void				ResetUpdateTiming();
+bool				WriteUpdateTiming( const char* p_fileName );
+
+bool				ScriptGetUpdateTiming( Script::CStruct *pParams, Script::CScript *pScript );
+bool				ScriptWriteUpdateTiming( Script::CStruct *pParams, Script::CScript *pScript );
+bool				ScriptResetUpdateTiming( Script::CStruct *pParams, Script::CScript *pScript );
+
+}
+
+#endif
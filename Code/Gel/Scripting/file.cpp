@@ -15,6 +15,7 @@
 #include <gel/scripting/checksum.h>
 #include <core/crc.h> // For Crc::GenerateCRCFromString
 #include <sys/file/pip.h>
+#include <sys/trace.h>
 
 namespace Script
 {
@@ -61,6 +62,8 @@ void LoadQB(const char *p_fileName, EBoolAssertIfDuplicateSymbols assertIfDuplic
 	Dbg_MsgAssert(strcmp(p_fileName+strlen(p_fileName)-3,".qb")==0,("File does not have extension .qb. File %s",p_fileName));
 #endif __PLAT_NGC__
 
+	Trace::CScope trace("script","LoadQB",p_fileName);
+
 	// Mick - Pip::Load is not going to load it from a Pip::Pre, just a regular pre
 	// so I'm sticking it on the top-down heap to avoid fragmentation							  
 	Mem::Manager::sHandle().PushContext(Mem::Manager::sHandle().TopDownHeap());
@@ -68,7 +71,10 @@ void LoadQB(const char *p_fileName, EBoolAssertIfDuplicateSymbols assertIfDuplic
 	Mem::Manager::sHandle().PopContext();
 		
 	// Parse the QB, which creates all the symbols defined within it.
-	ParseQB(p_fileName,p_qb,assertIfDuplicateSymbols);
+	{
+		Trace::CScope parse_trace("script","ParseQB",p_fileName);
+		ParseQB(p_fileName,p_qb,assertIfDuplicateSymbols);
+	}
 	
 	Pip::Unload(p_fileName);	
 
@@ -91,6 +97,7 @@ void LoadQBFromMemory(const char* p_fileName, uint8* p_qb, EBoolAssertIfDuplicat
 	// the node array (it's a 50K memory hog on
 	// the script heap, and it's really only
 	// needed for doing prefix stuff anyway)
+	Trace::CScope trace("script","ParseQB",p_fileName);
 	ParseQB(p_fileName,p_qb,assertIfDuplicateSymbols,false);
 
 	RemoveChecksumNameLookupHashTable();
@@ -98,6 +105,22 @@ void LoadQBFromMemory(const char* p_fileName, uint8* p_qb, EBoolAssertIfDuplicat
 	restart_dirty_scripts();
 }
 
+// Re-parses a QB that the caller has already read into memory, eg the hot reloader,
+// which reads the loose file itself so as not to get a stale copy out of a PRE.
+// Symbols are replaced in place and flagged with mGotReloaded, and scripts that were
+// running the old versions get restarted. Unlike LoadQBFromMemory this leaves the
+// checksum name lookup table for the caller, in case the QB had a NodeArray in it.
+void ReloadQB(const char* p_fileName, uint8* p_qb)
+{
+	Dbg_MsgAssert(p_fileName,("NULL p_fileName"));
+	Dbg_MsgAssert(p_qb,("NULL p_qb"));
+
+	Trace::CScope trace("script","ParseQB",p_fileName);
+	ParseQB(p_fileName,p_qb,NO_ASSERT_IF_DUPLICATE_SYMBOLS);
+
+	restart_dirty_scripts();
+}
+
 // TODO: Need another UnloadQB in the game-specific script namespace, which will call this UnloadQB
 // and then do any game-specific stuff that needs to be done when a qb is unloaded, such as 
 // resetting the node name hash table & prefix info.
@@ -30,6 +30,7 @@
 #ifdef	__SCRIPT_EVENT_TABLE__		
 #include <gel/Event.h>
 #include <gel/objtrack.h>
+#include <gel/object/deferredcommands.h>
 #endif
 
 //char foo[sizeof(Script::SReturnAddress)/0];
@@ -2991,9 +2992,50 @@ static const char *sGetRunScriptName(uint32 scriptChecksum, const char *p_script
 }	
 #endif
 
+struct SDeferredRunScript
+{
+	uint32	mScriptChecksum;
+	uint32	mObjectHandle;
+	bool	mHasObject;
+	bool	mNetScript;
+};
+
+static void s_run_deferred_script( void *p_data )
+{
+	SDeferredRunScript* p_run = (SDeferredRunScript*)p_data;
+	
+	Obj::CObject* p_object = NULL;
+	if (p_run->mHasObject)
+	{
+		// don't run it if the object has gone in the meantime
+		p_object = Obj::CTracker::Instance()->GetObjectFromHandle(p_run->mObjectHandle);
+		if (!p_object)
+		{
+			return;
+		}
+	}
+	
+	CStruct* p_params = Obj::ReadDeferredParams((uint8*)p_data, sizeof(SDeferredRunScript));
+	RunScript(p_run->mScriptChecksum, p_params, p_object, p_run->mNetScript);
+	delete p_params;
+}
+
 // Used for running a simple script from start to end.
 void RunScript(uint32 scriptChecksum, CStruct *p_params, Obj::CObject *p_object, bool netScript, const char *p_scriptName )
 {
+	// From a component being updated in parallel, the script is run after the update.
+	if (Obj::DeferringCommands())
+	{
+		uint8 p_command[Obj::vMAX_DEFERRED_COMMAND_SIZE];
+		SDeferredRunScript* p_run = (SDeferredRunScript*)p_command;
+		p_run->mScriptChecksum = scriptChecksum;
+		p_run->mObjectHandle = p_object ? Obj::CTracker::Instance()->GetObjectHandle(p_object->GetID()) : 0;
+		p_run->mHasObject = p_object != NULL;
+		p_run->mNetScript = netScript;
+		Obj::DeferCommand(s_run_deferred_script, p_command, Obj::WriteDeferredParams(p_command, sizeof(SDeferredRunScript), p_params));
+		return;
+	}
+	
 	// First, see what type of symbol scriptChecksum is referring to.
     CSymbolTableEntry *p_entry=Resolve(scriptChecksum);
 	if (!p_entry)
@@ -3279,9 +3321,37 @@ CScript *GetScriptWithUniqueId(uint32 id)
 	return NULL;
 }
 
+struct SDeferredSpawnScript
+{
+	uint32	mScriptChecksum;
+	uint32	mCallbackScript;
+	int		mNode;
+	uint32	mId;
+	bool	mNetEnabled;
+	bool	mPermanent;
+	bool	mNotSessionSpecific;
+	bool	mPauseWithObject;
+	int		mCallbackParamsOffset;
+};
+
+static void s_spawn_deferred_script( void *p_data )
+{
+	SDeferredSpawnScript* p_spawn = (SDeferredSpawnScript*)p_data;
+	CStruct* p_script_params = Obj::ReadDeferredParams((uint8*)p_data, sizeof(SDeferredSpawnScript));
+	CStruct* p_callback_params = Obj::ReadDeferredParams((uint8*)p_data, p_spawn->mCallbackParamsOffset);
+	
+	SpawnScript(p_spawn->mScriptChecksum, p_script_params, p_spawn->mCallbackScript, p_callback_params, p_spawn->mNode, p_spawn->mId,
+				p_spawn->mNetEnabled, p_spawn->mPermanent, p_spawn->mNotSessionSpecific, p_spawn->mPauseWithObject);
+	
+	delete p_script_params;
+	delete p_callback_params;
+}
+
 // Called from ScriptSpawnScript in cfuncs.cpp
 // also called by the triggering code in skater.cpp
 // returns the new script if sucessful, asserts if not
+// (returns NULL when called from a component being updated in parallel,
+// as the script is only spawned after the update)
 // optional "node" parameter is the node number that is
 // responsible for spawning this script.
 // Also now takes an optional Id, to allow individual spawned script instances to be killed.
@@ -3290,6 +3360,23 @@ CScript* SpawnScript(uint32 scriptChecksum, CStruct *p_scriptParams, uint32 call
 {
 	Dbg_MsgAssert(scriptChecksum,("Zero checksum sent to SpawnScript"));
 	
+	if (Obj::DeferringCommands())
+	{
+		uint8 p_command[Obj::vMAX_DEFERRED_COMMAND_SIZE];
+		SDeferredSpawnScript* p_spawn = (SDeferredSpawnScript*)p_command;
+		p_spawn->mScriptChecksum = scriptChecksum;
+		p_spawn->mCallbackScript = callbackScript;
+		p_spawn->mNode = node;
+		p_spawn->mId = id;
+		p_spawn->mNetEnabled = netEnabled;
+		p_spawn->mPermanent = permanent;
+		p_spawn->mNotSessionSpecific = not_session_specific;
+		p_spawn->mPauseWithObject = pause_with_object;
+		p_spawn->mCallbackParamsOffset = Obj::WriteDeferredParams(p_command, sizeof(SDeferredSpawnScript), p_scriptParams);
+		Obj::DeferCommand(s_spawn_deferred_script, p_command, Obj::WriteDeferredParams(p_command, p_spawn->mCallbackParamsOffset, p_callbackParams));
+		return NULL;
+	}
+	
     CSymbolTableEntry *p_entry=Resolve(scriptChecksum);
     if (p_entry)
     {
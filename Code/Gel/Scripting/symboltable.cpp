@@ -49,6 +49,9 @@ void CSymbolTableEntry::Reset()
 
 static CSymbolTableEntry *sp_hash_table=NULL;
 
+// Starts at 1 so that every CTunable looks its symbol up on the first read.
+uint32 gSymbolTableVersion=1;
+
 void CreateSymbolHashTable()
 {
 	Dbg_MsgAssert(sp_hash_table==NULL,("sp_hash_table not NULL ?"));
@@ -60,6 +63,7 @@ void DestroySymbolHashTable()
 	Dbg_MsgAssert(sp_hash_table!=NULL,("sp_hash_table is NULL ?"));
 	delete[] sp_hash_table;
 	sp_hash_table=NULL;
+	++gSymbolTableVersion;
 }
 
 // Searches for the symbol with the passed Checksum.
@@ -267,6 +271,8 @@ void RemoveSymbol(CSymbolTableEntry *p_sym)
 	Dbg_MsgAssert(p_sym->mUsed,("Tried to call RemoveSymbol on an unused CSymbolTableEntry"));
 	Dbg_MsgAssert(sp_hash_table!=NULL,("sp_hash_table is NULL ?"));
 
+	++gSymbolTableVersion;
+	
 	// Get the head pointer of the list that p_sym is in (or should be in) 
     CSymbolTableEntry *p_head=&sp_hash_table[ p_sym->mNameChecksum & ((1<<NUM_HASH_BITS)-1) ];
 
@@ -343,6 +349,9 @@ CSymbolTableEntry *CreateNewSymbolEntry(uint32 checksum)
 	Dbg_MsgAssert(sp_hash_table!=NULL,("sp_hash_table is NULL ?"));
     CSymbolTableEntry *p_sym=&sp_hash_table[ checksum & ((1<<NUM_HASH_BITS)-1) ];
 
+	// Whatever gets stored in it, the value of the symbol has changed
+	++gSymbolTableVersion;
+
     // If nothing in here, use this one.
     if (!p_sym->mUsed)
     {
@@ -542,6 +551,18 @@ int GetInteger(const char *p_name, EAssertType assert)
 	return GetInteger(Crc::GenerateCRCFromString(p_name),assert);
 }
 
+template<> void CTunable< float >::refresh() const
+{
+	m_value=GetFloat(m_checksum,m_assert);
+	m_version=gSymbolTableVersion;
+}
+
+template<> void CTunable< int >::refresh() const
+{
+	m_value=GetInteger(m_checksum,m_assert);
+	m_version=gSymbolTableVersion;
+}
+
 uint32 GetChecksum(uint32 checksum, EAssertType assert)
 {
     CSymbolTableEntry *p_entry=Resolve(checksum);
@@ -153,6 +153,48 @@ CArray *GetArray(const char *p_name, EAssertType assert=NO_ASSERT);
 bool (*GetCFunc(uint32 checksum, EAssertType assert=NO_ASSERT))(CStruct *, CScript *);
 bool (*GetCFunc(const char *p_name, EAssertType assert=NO_ASSERT))(CStruct *, CScript *);
 
+// Incremented whenever a symbol is created or removed. A qb reload, or the Change command,
+// always creates the symbol afresh (see mGotReloaded), so code that caches the values of
+// symbols can compare this against the version it cached them at.
+extern uint32 gSymbolTableVersion;
+
+// A script global read by hot code, every frame or more. The symbol is looked up on the
+// first read, and after that only when the symbol table has changed, so reading one is a
+// compare rather than a hash table search. T is float or int. Declare them static, giving
+// the checksum as a plain number, as CRCD can't be used that early on:
+//
+//   static Script::CTunable< float > s_range( 0x7a78f471 /* ped_avoid_ped_range */ );
+//   ...
+//   if ( d <= s_range )
+//
+// Symbols are only ever changed on the main thread.
+template< class T > class CTunable
+{
+public:
+	CTunable( uint32 checksum, EAssertType assert=NO_ASSERT ) : m_checksum( checksum ), m_assert( assert ), m_version( 0 ) {}
+
+	T Get() const
+	{
+		if ( m_version != gSymbolTableVersion )
+		{
+			refresh();
+		}
+		return m_value;
+	}
+	operator T() const { return Get(); }
+
+private:
+	void refresh() const;
+
+	uint32 m_checksum;
+	EAssertType m_assert;
+	mutable uint32 m_version;
+	mutable T m_value;
+};
+
+template<> void CTunable< float >::refresh() const;
+template<> void CTunable< int >::refresh() const;
+
 ///////////////////////////////////////////////////////////////////////////////////
 // TODO: Remove these next functions at some point.
 // They are only included to provide back compatibility with the old code without
@@ -27,6 +27,8 @@
 **							  	  Includes									**
 *****************************************************************************/
 
+#include <string.h>
+
 #include <core/defines.h>
 
 #include <gfx/nxviewman.h>
@@ -37,6 +39,7 @@
 #include <gel/scripting/symboltable.h>
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/struct.h>
+#include <gel/object/deferredcommands.h>
 
 #include <modules/frontend/frontend.h>  // until gametimer is moved into lower level stuff..
 
@@ -986,8 +989,64 @@ void CSfxManager::TweakVolumeAndPitch( sVolume *p_vol, float *pitch, WaveTableEn
 /* voice shouldn't be stopped									  */
 /*																  */
 /******************************************************************/
+struct SDeferredPlaySound
+{
+	enum
+	{
+		vMAX_NAME_LEN = 64
+	};
+	
+	uint32			mChecksum;
+	sVolume			mVolume;
+	float			mPitch;
+	uint32			mControlID;
+	bool			mHasUpdateInfo;
+	SoundUpdateInfo	mUpdateInfo;
+	bool			mHasName;
+	char			mpName[vMAX_NAME_LEN];
+};
+
+static void s_play_deferred_sound( void *p_data )
+{
+	SDeferredPlaySound* p_play = (SDeferredPlaySound*)p_data;
+	CSfxManager::Instance()->PlaySound( p_play->mChecksum, &p_play->mVolume, p_play->mPitch, p_play->mControlID,
+										p_play->mHasUpdateInfo ? &p_play->mUpdateInfo : NULL,
+										p_play->mHasName ? p_play->mpName : NULL );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 uint32 CSfxManager::PlaySound( uint32 checksum, sVolume *p_vol, float pitch, uint32 controlID, SoundUpdateInfo *pUpdateInfo, const char *pSoundName )
 {
+	// From a component being updated in parallel, the sound is started after the update,
+	// so there is no voice to return an ID for yet.
+	if( Obj::DeferringCommands())
+	{
+		Dbg_Assert( p_vol );
+		
+		SDeferredPlaySound play;
+		play.mChecksum		= checksum;
+		play.mVolume		= *p_vol;
+		play.mPitch			= pitch;
+		play.mControlID		= controlID;
+		play.mHasUpdateInfo	= pUpdateInfo != NULL;
+		if( pUpdateInfo )
+		{
+			play.mUpdateInfo = *pUpdateInfo;
+		}
+		play.mHasName		= pSoundName != NULL;
+		if( pSoundName )
+		{
+			strncpy( play.mpName, pSoundName, SDeferredPlaySound::vMAX_NAME_LEN - 1 );
+			play.mpName[SDeferredPlaySound::vMAX_NAME_LEN - 1] = 0;
+		}
+		Obj::DeferCommand( s_play_deferred_sound, &play, sizeof( play ));
+		return 0;
+	}
+	
 	if( NoSoundPlease())
 		return 0;
 
@@ -159,6 +159,13 @@ public:
 
 	CObject *					GetObject(uint32 id);
 	
+	// A handle names one tracked object, for as long as it is tracked.  It's the object's
+	// slot in the tracker and the generation of the slot, so getting the object back is two
+	// compares, with no search, and a later object with the same id (or the same slot)
+	// won't be mistaken for it.  Handles are never 0, so 0 can mean "no object".
+	uint32						GetObjectHandle(uint32 id);
+	CObject *					GetObjectFromHandle(uint32 handle);
+	
 	// See the menu document for a description of aliases
 	CObject *					GetObjectByAlias(uint32 aliasId);
 	void						AddAlias(uint32 alias, CObject *pObject);
@@ -173,6 +180,13 @@ public:
 	bool						LaunchEvent(uint32 type, uint32 target = CEvent::vSYSTEM_EVENT, uint32 source = CEvent::vSYSTEM_EVENT, Script::CStruct *pData = NULL, bool broadcast=false);
 	void						BlockEventLaunching(bool block) {m_block_event_launching = block;}
 	
+	// Queued events aren't launched straight away, but all together, in the order they were
+	// queued, at the next DispatchQueuedEvents(), which the game calls once a frame.  So the
+	// handlers don't run in the middle of whatever queued the event.  With coalesce, an event
+	// with no data isn't queued if the same one (type, target, source) is already waiting.
+	void						QueueEvent(uint32 type, uint32 target = CEvent::vSYSTEM_EVENT, uint32 source = CEvent::vSYSTEM_EVENT, Script::CStruct *pData = NULL, bool broadcast=false, bool coalesce=false);
+	void						DispatchQueuedEvents();
+	
 	void 						LogEventScript(uint32 script = 0);
 	void						LogEventHandled(CEvent *pEvent, uint32 receiverID = 0, uint32 script = 0);
 	void						LogEventRead(CEvent *pEvent, uint32 receiverID = 0, uint32 script = 0);
@@ -207,9 +221,46 @@ private:
 
 	void						remove_aliases(CObject *pObject);
 	
+	int							find_id(uint32 id);
+	bool						grow_slots();
+	void						grow_id_table();
+	void						print_objects();
+	
 	int							m_id_seed;
 	
-	Lst::HashTable<CObject> *	mp_hash_table;
+	// Tracked objects, by id.  The objects live in slots that don't move while they are
+	// tracked, and the ids are in an open addressed (linear probing) table that gives the
+	// slot for each one.  Both tables double in size when they fill up; the id table is
+	// never more than half full.
+	enum
+	{
+		vINITIAL_SLOTS			= 4096,
+		vINITIAL_ID_TABLE_BITS	= 13,
+		vMAX_SLOTS				= 0xffff,		// a slot has to fit in a handle
+		vNO_SLOT				= 0xffff,
+		vHANDLE_SLOT_MASK		= 0xffff,
+		vHANDLE_GENERATION_SHIFT	= 16,
+	};
+	
+	struct SObjectSlot
+	{
+		CObject *				mpObject;				// NULL if free
+		uint16					mGeneration;			// never 0
+		uint16					mNextFree;
+	};
+	
+	struct SIdEntry
+	{
+		uint32					mId;
+		uint16					mSlot;					// vNO_SLOT if the entry is empty
+	};
+	
+	SObjectSlot *				mp_slots;
+	int							m_num_slots;
+	SIdEntry *					mp_id_table;
+	int							m_id_table_bits;
+	uint16						m_first_free_slot;
+	int							m_num_objects;
 	Lst::HashTable<CObject> *	mp_alias_table;
 
 // The hash table of event listeners is keyed off the "type" of the event
@@ -228,6 +279,33 @@ private:
 	CEventLog					m_event_log;
 	uint32						m_next_event_script;
 	
+	// The queued events, in a ring buffer.  Each one is an SQueuedEvent followed by its data
+	// flattened with Script::WriteToBuffer().  The read and write positions only go up, and
+	// are wrapped when used.
+	enum
+	{
+		vEVENT_QUEUE_SIZE		= 32768,		// a power of two
+		vCOALESCE_TABLE_BITS	= 8,
+		vCOALESCE_TABLE_SIZE	= 1 << vCOALESCE_TABLE_BITS,
+	};
+	
+	struct SCoalesceEntry
+	{
+		uint32					mType;
+		uint32					mTarget;
+		uint32					mSource;
+		uint32					mBatch;					// the entry is empty unless this is m_event_batch
+		bool					mBroadcast;
+	};
+	
+	uint8 *						mp_event_queue;
+	uint32						m_event_queue_read;
+	uint32						m_event_queue_write;
+	SCoalesceEntry *			mp_coalesce_table;
+	uint32						m_event_batch;			// the events queued since the last dispatch
+	int							m_num_coalesce_entries;
+	bool						m_dispatching_events;
+	
 	// Used to keep track of of scripts that are suspended while waiting for an event.
 	// No pointers to scripts are kept, in case scripts are destroyed.
 	struct WaitingScriptEntry
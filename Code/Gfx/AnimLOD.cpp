@@ -0,0 +1,183 @@
+//****************************************************************************
+//* MODULE:			Gfx
+//* FILENAME:		AnimLOD.cpp
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#include <math.h>
+
+#include <gfx/animlod.h>
+
+#include <core/math.h>
+
+#include <gel/scripting/array.h>
+#include <gel/scripting/checksum.h>
+#include <gel/scripting/script.h>
+#include <gel/scripting/struct.h>
+
+#include <gfx/camera.h>
+#include <gfx/nxviewman.h>
+
+namespace Gfx
+{
+
+/*****************************************************************************
+**								Private Data								**
+*****************************************************************************/
+
+enum
+{
+	vMAX_ANIM_LOD_TYPES = 16,
+};
+
+static SAnimLOD		sp_anim_lods[vMAX_ANIM_LOD_TYPES];
+static int			s_num_anim_lods = 0;
+
+/*****************************************************************************
+**							   Public Functions								**
+*****************************************************************************/
+
+const SAnimLOD* GetAnimLOD( uint32 skeletonName )
+{
+	for ( int i = 0; i < s_num_anim_lods; i++ )
+	{
+		if ( sp_anim_lods[i].mSkeletonName == skeletonName )
+		{
+			return &sp_anim_lods[i];
+		}
+	}
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+const SAnimLODLevel* GetAnimLODLevel( const SAnimLOD* pLOD, float screenSize )
+{
+	Dbg_Assert( pLOD && pLOD->mNumLevels > 0 );
+
+	for ( int i = 0; i < pLOD->mNumLevels - 1; i++ )
+	{
+		if ( screenSize >= pLOD->mpLevels[i].mMinScreenSize )
+		{
+			return &pLOD->mpLevels[i];
+		}
+	}
+	return &pLOD->mpLevels[pLOD->mNumLevels - 1];
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+float GetProjectedScreenSize( float distSqr, float radius )
+{
+	Gfx::Camera* p_camera = Nx::CViewportManager::sGetActiveCamera( 0 );
+	if ( !p_camera || distSqr <= radius * radius )
+	{
+		// no camera, or it's inside the sphere
+		return 1.0f;
+	}
+
+	float half_width = sqrtf( distSqr ) * tanf( Mth::DegToRad( p_camera->GetAdjustedHFOV() * 0.5f ) );
+	return radius / half_width;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetAnimLOD | Sets up the animation LOD for a type of skeleton.  Each level
+// applies to objects that cover at least so much of the screen width, and the last
+// level to anything smaller.  In place of the distance based LOD, the level picks how
+// often the pose is worked out (the pose is extrapolated from the last two in between),
+// the bone skip level from the skeleton's LOD file, and how the keys are interpolated.
+// @parm name | skeleton | The skeleton type, eg human
+// @parmopt array | levels | | Up to four structures, largest first, each with a size (the
+// fraction of the screen width, eg 0.25), an interval (1, 2 or 4 frames between poses),
+// bones (the bone skip level, 0 for all the bones) and a quality (slerp, nlerp or nearest)
+// @flag off | Back to the distance based LOD for the type
+bool ScriptSetAnimLOD( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	uint32 skeleton_name;
+	pParams->GetChecksum( CRCD(0x222756d5,"skeleton"), &skeleton_name, Script::ASSERT );
+
+	SAnimLOD* p_lod = (SAnimLOD*)GetAnimLOD( skeleton_name );
+
+	if ( pParams->ContainsFlag( CRCD(0xd443a2bc,"off") ) )
+	{
+		if ( p_lod )
+		{
+			*p_lod = sp_anim_lods[--s_num_anim_lods];
+		}
+		return true;
+	}
+
+	Script::CArray* p_levels;
+	pParams->GetArray( CRCD(0x60d59be6,"levels"), &p_levels, Script::ASSERT );
+	Dbg_MsgAssert( p_levels->GetSize() > 0 && p_levels->GetSize() <= vMAX_ANIM_LOD_LEVELS, ( "SetAnimLOD needs 1 to %d levels", vMAX_ANIM_LOD_LEVELS ) );
+
+	if ( !p_lod )
+	{
+		if ( s_num_anim_lods == vMAX_ANIM_LOD_TYPES )
+		{
+			Dbg_MsgAssert( 0, ( "Too many skeleton types with an animation LOD" ) );
+			return false;
+		}
+		p_lod = &sp_anim_lods[s_num_anim_lods++];
+	}
+
+	p_lod->mSkeletonName = skeleton_name;
+	p_lod->mNumLevels = 0;
+	for ( uint32 i = 0; i < p_levels->GetSize() && i < vMAX_ANIM_LOD_LEVELS; i++ )
+	{
+		Script::CStruct* p_level_params = p_levels->GetStructure( i );
+		SAnimLODLevel* p_level = &p_lod->mpLevels[p_lod->mNumLevels++];
+
+		p_level->mMinScreenSize = 0.0f;
+		p_level_params->GetFloat( CRCD(0x083fdb95,"size"), &p_level->mMinScreenSize );
+
+		int interval = 1;
+		p_level_params->GetInteger( CRCD(0xe6391034,"interval"), &interval );
+		Dbg_MsgAssert( interval == 1 || interval == 2 || interval == 4, ( "SetAnimLOD interval must be 1, 2 or 4, not %d", interval ) );
+		p_level->mInterval = ( interval >= 4 ) ? 4 : ( interval >= 2 ) ? 2 : 1;
+
+		int bones = 0;
+		p_level_params->GetInteger( CRCD(0x2aa592d4,"bones"), &bones );
+		p_level->mBoneSkipIndex = ( bones > 0 ) ? bones : 0;
+
+		uint32 quality = CRCD(0x6d3feaf6,"nlerp");
+		p_level_params->GetChecksum( CRCD(0x834df4ef,"quality"), &quality );
+		switch ( quality )
+		{
+			case CRCC(0xf54fb9c5,"slerp"):
+				p_level->mQuality = ANIM_QUALITY_SLERP;
+				break;
+			case CRCC(0x992129e1,"nearest"):
+				p_level->mQuality = ANIM_QUALITY_NEAREST;
+				break;
+			case CRCC(0x6d3feaf6,"nlerp"):
+				p_level->mQuality = ANIM_QUALITY_NLERP;
+				break;
+			default:
+				Dbg_MsgAssert( 0, ( "SetAnimLOD quality must be slerp, nlerp or nearest, not %s", Script::FindChecksumName( quality ) ) );
+				p_level->mQuality = ANIM_QUALITY_NLERP;
+				break;
+		}
+
+		Dbg_MsgAssert( i == 0 || p_level->mMinScreenSize <= p_lod->mpLevels[i - 1].mMinScreenSize, ( "SetAnimLOD levels must be largest first" ) );
+	}
+
+	return true;
+}
+
+} // namespace Gfx
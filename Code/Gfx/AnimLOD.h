@@ -0,0 +1,76 @@
+//****************************************************************************
+//* MODULE:			Gfx
+//* FILENAME:		AnimLOD.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef __GFX_ANIMLOD_H
+#define __GFX_ANIMLOD_H
+
+/*****************************************************************************
+**								Includes									**
+*****************************************************************************/
+
+#include <core/defines.h>
+#include <core/support.h>
+
+#include <gfx/bonedanimtypes.h>
+
+/*****************************************************************************
+**								Defines									**
+*****************************************************************************/
+
+namespace Script
+{
+	class CScript;
+	class CStruct;
+}
+
+namespace Gfx
+{
+
+// Animation LOD, set up per skeleton type from script with SetAnimLOD.  The projected
+// screen size of an object picks a level, which says how often its pose is worked out
+// (with the pose extrapolated from the last two in between), which of the skeleton's
+// bone skip levels is used, and how the keys are interpolated.  Skeleton types with no
+// levels set up keep the distance based LOD in the suspend component and the skeleton.
+
+enum
+{
+	vMAX_ANIM_LOD_LEVELS = 4,
+};
+
+struct SAnimLODLevel
+{
+	float			mMinScreenSize;		// fraction of the screen width the bounding sphere covers
+	int				mInterval;			// frames between poses; 1, 2 or 4
+	uint32			mBoneSkipIndex;		// into the skeleton's bone skip list
+	EAnimQuality	mQuality;
+};
+
+struct SAnimLOD
+{
+	uint32			mSkeletonName;
+	int				mNumLevels;
+	SAnimLODLevel	mpLevels[vMAX_ANIM_LOD_LEVELS];	// largest first
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// NULL if the skeleton type has no levels set up
+const SAnimLOD*			GetAnimLOD( uint32 skeletonName );
+
+// The first level the size is at least as big as; the last level covers anything smaller
+const SAnimLODLevel*	GetAnimLODLevel( const SAnimLOD* pLOD, float screenSize );
+
+// How much of the screen width a sphere covers, seen from the active camera
+float					GetProjectedScreenSize( float distSqr, float radius );
+
+bool					ScriptSetAnimLOD( Script::CStruct* pParams, Script::CScript* pScript );
+
+} // namespace Gfx
+
+#endif	// __GFX_ANIMLOD_H
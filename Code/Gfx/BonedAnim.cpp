@@ -9,19 +9,26 @@
 **							  	  Includes									**
 *****************************************************************************/
 
+#include <string.h>
+
 #include <gfx/bonedanim.h>
 
 #include <gfx/bonedanimtypes.h>
 #include <gfx/nxquickanim.h>
+#include <gfx/nxanimcache.h>
+#include <gfx/pose.h>
 #include <sys/file/AsyncFilesys.h>
 #include <sys/file/filesys.h>
 #include <sys/mem/memman.h>
 #include <gel/object.h>
 #include <gel/scripting/script.h>
+#include <gel/scripting/struct.h>
 #include <gel/scripting/checksum.h>
 #include <sys/config/config.h>
 #include <core/string/stringutils.h>
 #include <sys/file/pip.h>
+#include <sys/trace.h>
+#include <gel/assman/assman.h>
 
 #ifdef __PLAT_NGC__
 #include <dolphin.h>
@@ -37,6 +44,12 @@
 #define __ARAM__
 #endif
 
+// Dequantize and interpolate the compressed keys four bones at a time
+#if ( defined( __SSE2__ ) || defined( _M_X64 ) ) && !defined( __ARAM__ )
+#define __SIMD_ANIM_DECODE__
+#include <emmintrin.h>
+#endif
+
 #ifdef __PLAT_NGC__
 #define _16(a) (((a>>8)&0x00ff)|((a<<8)&0xff00))
 #define _32(a) (((a>>24)&0x000000ff)|((a>>8)&0x0000ff00)|((a<<8)&0x00ff0000)|((a<<24)&0xff000000)) 
@@ -116,6 +129,11 @@ struct SHiResAnimFramePointers
 // to be phased out...
 #define nxBONEDANIMFLAGS_OLDPARTIALANIM		(1<<18)
 
+// written by tools/ska_recompress.py:  each bone keeps only the keys it needs to stay
+// within an error bound, so they're at irregular times and a bone's last key can be well
+// before the end of the anim (it's held from then on).  The keys are encoded as usual.
+#define nxBONEDANIMFLAGS_REDUCEDKEYS		(1<<17)
+
 /*****************************************************************************
 **								 Private Data								**
 *****************************************************************************/
@@ -609,7 +627,7 @@ inline void interpolate_t_frame(Mth::Vector* p_out, CAnimTKey* p_in1, CAnimTKey*
 /*                                                                */
 /******************************************************************/
 						  
-inline void interpolate_standard_q_frame(Mth::Quat* p_out, CStandardAnimQKey* p_in1, CStandardAnimQKey* p_in2, float alpha)
+inline void interpolate_standard_q_frame(Mth::Quat* p_out, CStandardAnimQKey* p_in1, CStandardAnimQKey* p_in2, float alpha, bool trueSlerp = false)
 {
 	if ( alpha == 0.0f )
 	{
@@ -631,6 +649,12 @@ inline void interpolate_standard_q_frame(Mth::Quat* p_out, CStandardAnimQKey* p_
 	get_rotation_from_standard_key( p_in1, &qIn1 );
 	get_rotation_from_standard_key( p_in2, &qIn2 );
 
+	if ( trueSlerp )
+	{
+		*p_out = Mth::Slerp( qIn1, qIn2, alpha );
+		return;
+	}
+
 	// Faster slerp, stolen from game developer magazine.
 	*p_out = Mth::FastSlerp( qIn1, qIn2, alpha );
 }
@@ -640,6 +664,21 @@ inline void interpolate_standard_q_frame(Mth::Quat* p_out, CStandardAnimQKey* p_
 /*                                                                */
 /******************************************************************/
 
+// The animation LOD's nearest key quality snaps the alpha to whichever key is closer
+inline float get_quality_alpha( uint32 quality, float alpha )
+{
+	if ( quality == ANIM_QUALITY_NEAREST )
+	{
+		return ( alpha < 0.5f ) ? 0.0f : 1.0f;
+	}
+	return alpha;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 inline void interpolate_standard_t_frame(Mth::Vector* p_out, CStandardAnimTKey* p_in1, CStandardAnimTKey* p_in2, float alpha)
 {
 	if ( alpha == 0.0f )
@@ -1035,6 +1074,10 @@ bool CBonedAnimFrameData::plat_read_compressed_stream(uint8* pData, bool delete_
 	Dbg_Assert( mp_perBoneFrames == NULL );
 	Dbg_Assert( mp_qFrames );
 	Dbg_Assert( mp_tFrames );
+
+#ifndef __ARAM__
+	build_key_seek_table();
+#endif		// __ARAM__
     
 	// dma to aram here...
 	plat_dma_to_aram( qAllocSize, tAllocSize );
@@ -1070,6 +1113,7 @@ bool CBonedAnimFrameData::plat_read_compressed_stream(uint8* pData, bool delete_
 	}		
 
 	m_num_customKeys = pThePlatformHeader->numCustomAnimKeys;
+	m_customKeyIndex.Build( mpp_customAnimKeyList, m_num_customKeys );
 
 #ifdef __ARAM__
 	if ( delete_buffer )
@@ -1218,6 +1262,7 @@ bool CBonedAnimFrameData::plat_read_stream(uint8* pData, bool delete_buffer)
 	}		
 
 	m_num_customKeys = pThePlatformHeader->numCustomAnimKeys;
+	m_customKeyIndex.Build( mpp_customAnimKeyList, m_num_customKeys );
 
 #ifdef __ARAM__
 	if ( delete_buffer )
@@ -1316,6 +1361,7 @@ CBonedAnimFrameData::CBonedAnimFrameData()
 
 	mp_perBoneQFrameSize = NULL;
 	mp_perBoneTFrameSize = NULL;
+	mp_keySeekTable = NULL;
 
 	m_printDebugInfo = false;
 
@@ -1346,6 +1392,14 @@ CBonedAnimFrameData::~CBonedAnimFrameData()
 		Mem::Free( mpp_customAnimKeyList );
 	}
 
+	if ( mp_keySeekTable )
+	{
+		Mem::Free( mp_keySeekTable );
+	}
+
+	// drop the anim cache's decompressed copy, if it has one
+	Nx::ForgetDecompressedAnim( this );
+
 	if ( m_pipped )
 	{
 		Pip::Unload( m_fileNameCRC );
@@ -1384,14 +1438,14 @@ CBonedAnimFrameData::~CBonedAnimFrameData()
 /*                                                                */
 /******************************************************************/
 	
-bool CBonedAnimFrameData::Load(uint32* pData, int file_size, bool assertOnFail)
+bool CBonedAnimFrameData::Load(uint32* pData, int file_size, bool assertOnFail, uint32 fileNameCRC)
 {
 	// TODO:  We should read in the entire file into memory first, because
 	// using streams is slow.
 
 	Dbg_Assert( !m_dataLoaded );
 
-	m_fileNameCRC = 0;
+	m_fileNameCRC = fileNameCRC;
 
 	Dbg_MsgAssert( pData, ( "No data pointer specified" ) );
 	Dbg_MsgAssert(file_size, ("Anim file size is 0"));
@@ -1597,6 +1651,7 @@ bool CBonedAnimFrameData::PostLoad(bool assertOnFail, int file_size, bool delete
 	// so that we don't have to do it at runtime...
 	Dbg_MsgAssert( pTheHeader->flags & nxBONEDANIMFLAGS_COMPRESSEDTIME, ( "Expected the anim times to be in frames" ) );
 	Dbg_MsgAssert( pTheHeader->flags & nxBONEDANIMFLAGS_PREROTATEDROOT, ( "Expected the root bones to be prerotated" ) );
+	Dbg_MsgAssert( !( pTheHeader->flags & nxBONEDANIMFLAGS_REDUCEDKEYS ) || ( pTheHeader->flags & nxBONEDANIMFLAGS_USECOMPRESSTABLE ), ( "Only compressed anims can have reduced keys" ) );
 
 	// some debugging information
 //	Dbg_Message( "Loading animation %s", p_fileName );
@@ -1655,6 +1710,50 @@ inline float get_alpha( float timeStamp1, float timeStamp2, float time )
 	return (( time - timeStamp1 ) / ( timeStamp2 - timeStamp1 ));
 }
 
+enum
+{
+	vMAX_CURSOR_BONES = 64,				// as many as SQuickAnimPointers has room for
+};
+
+// The bones whose playback cursor can be trusted.  Once invalidated, the cursor
+// may be for some other anim entirely.
+inline uint64 get_cursor_bones( Nx::CQuickAnim* pQuickAnim )
+{
+	if ( !pQuickAnim )
+	{
+		return 0;
+	}
+
+	if ( !pQuickAnim->m_quickAnimPointers.valid )
+	{
+		pQuickAnim->m_quickAnimPointers.cursorBones = 0;
+	}
+	return pQuickAnim->m_quickAnimPointers.cursorBones;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// True if the time is still between the keys a cursor found last time
+inline bool get_cursor_alpha( short startTimestamp, short endTimestamp, float timeStamp, float* pAlpha )
+{
+	float start_time = timeDown( startTimestamp );
+	float end_time = timeDown( endTimestamp );
+	if ( timeStamp >= start_time && timeStamp <= end_time && start_time < end_time )
+	{
+		*pAlpha = get_alpha( start_time, end_time, timeStamp );
+		return true;
+	}
+	return false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 // THE FOLLOWING 2 FUNCTIONS SHOULD BE REFACTORED?
 
 /******************************************************************/
@@ -1754,11 +1853,23 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 	void * p_bone_frames = mp_perBoneFrames;
 #endif		// __aram__
 
+	// These keys are all the same size, so the cursor is just the index of the start key
+	uint64 cursor_bones = get_cursor_bones( pQuickAnim );
+
 	for ( int i = 0; i < m_numBones; i++ )
 	{
 		int numQKeys = get_num_qkeys( p_bone_frames, i );
 		int numTKeys = get_num_tkeys( p_bone_frames, i );
 
+		bool use_cursor = pQuickAnim && i < vMAX_CURSOR_BONES;
+		int first_q = 0;
+		int first_t = 0;
+		if ( use_cursor && ( cursor_bones & ( (uint64)1 << i ) ) )
+		{
+			first_q = pQuickAnim->m_quickAnimPointers.quickQIndex[i];
+			first_t = pQuickAnim->m_quickAnimPointers.quickTIndex[i];
+		}
+
 #ifdef __ARAM__
 		int q_off = 0;
 		{
@@ -1785,7 +1896,13 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 		}
 #endif		// __ARAM__
 
-		for ( int j = 0; j < numQKeys; j++ )
+		// step back, if playing backwards or it's looped
+		while ( first_q > 0 && qTimeStamp < timeDown(pCurrentQFrame[first_q].timestamp) )
+		{
+			first_q--;
+		}
+
+		for ( int j = first_q; j < numQKeys; j++ )
 		{
 			if ( j == (numQKeys-1) )
 			{
@@ -1793,6 +1910,7 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 				pStartQFrame = pCurrentQFrame + j;
 				pEndQFrame = pCurrentQFrame + j;
 				qAlpha = 0.0f;
+				first_q = j;
 				break;
 			}
 			else if ( qTimeStamp >= timeDown(pCurrentQFrame[j].timestamp) 
@@ -1801,6 +1919,7 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 				pStartQFrame = pCurrentQFrame + j;
 				pEndQFrame = pCurrentQFrame + j + 1;
 				qAlpha = get_alpha( timeDown(pStartQFrame->timestamp), timeDown(pEndQFrame->timestamp), qTimeStamp );
+				first_q = j;
 				break;
 			}
 		}
@@ -1837,7 +1956,12 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 		}
 #endif		// __ARAM__
 
-		for ( int j = 0; j < numTKeys; j++ )
+		while ( first_t > 0 && tTimeStamp < timeDown(pCurrentTFrame[first_t].timestamp) )
+		{
+			first_t--;
+		}
+
+		for ( int j = first_t; j < numTKeys; j++ )
 		{
 			if ( j == (numTKeys-1) )
 			{
@@ -1845,6 +1969,7 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 				pStartTFrame = pCurrentTFrame + j;
 				pEndTFrame = pCurrentTFrame + j;
 				tAlpha = 0.0f;
+				first_t = j;
 				break;
 			}
 			else if ( tTimeStamp >= timeDown(pCurrentTFrame[j].timestamp) 
@@ -1853,9 +1978,17 @@ bool CBonedAnimFrameData::GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth
 				pStartTFrame = pCurrentTFrame + j;
 				pEndTFrame = pCurrentTFrame + j + 1;
 				tAlpha = get_alpha( timeDown(pStartTFrame->timestamp), timeDown(pEndTFrame->timestamp), tTimeStamp );
+				first_t = j;
 				break;
 			}
 		}
+
+		if ( use_cursor )
+		{
+			pQuickAnim->m_quickAnimPointers.quickQIndex[i] = first_q;
+			pQuickAnim->m_quickAnimPointers.quickTIndex[i] = first_t;
+			pQuickAnim->m_quickAnimPointers.cursorBones |= ( (uint64)1 << i );
+		}
 		
 		// theStartFrame and theEndFrame should contain the
 		// two closest keyframes here.  now interpolate between them
@@ -2050,6 +2183,616 @@ inline char * get_compressed_t_frame( char* pData, CStandardAnimTKey* pReturnDat
 /*                                                                */
 /******************************************************************/
 
+// The compressed keys are different sizes, so they can only be read forwards.  To step
+// back, the key seek table has the offset and time of every vKEY_SEEK_STRIDE'th key of
+// each bone:  first the index of each bone's first entry, for the Q keys then the T keys,
+// with one more at the end of each, then the entries themselves.
+enum
+{
+	vKEY_SEEK_STRIDE = 8,
+};
+
+struct SKeySeekEntry
+{
+	uint16				offset;				// from the bone's first key
+	uint16				timestamp;
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+inline SKeySeekEntry* get_key_seek_entries( void* pTable, int numBones, int boneIndex, bool tKeys )
+{
+	uint16* p_first = (uint16*)pTable;
+	SKeySeekEntry* p_entries = (SKeySeekEntry*)( p_first + ( ( ( numBones + 1 ) * 2 + 1 ) & ~1 ) );
+	return p_entries + p_first[( tKeys ? numBones + 1 : 0 ) + boneIndex];
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Moves a cursor back from the key at keyIndex to the last seek table entry at or before
+// timeStamp, or to the bone's first key if there's no table.  Returns the new key index.
+inline int seek_key_back( void* pTable, int numBones, int boneIndex, bool tKeys, int keyIndex, float timeStamp, char* pBoneStart, char** ppKey )
+{
+	if ( !pTable )
+	{
+		*ppKey = pBoneStart;
+		return 0;
+	}
+
+	SKeySeekEntry* p_entries = get_key_seek_entries( pTable, numBones, boneIndex, tKeys );
+	int entry = keyIndex / vKEY_SEEK_STRIDE;
+	while ( entry > 0 && timeDown( p_entries[entry].timestamp ) > timeStamp )
+	{
+		entry--;
+	}
+
+	*ppKey = pBoneStart + p_entries[entry].offset;
+	return entry * vKEY_SEEK_STRIDE;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+#ifndef __ARAM__
+void CBonedAnimFrameData::build_key_seek_table()
+{
+	Dbg_Assert( !mp_keySeekTable );
+
+	int num_first = ( ( m_numBones + 1 ) * 2 + 1 ) & ~1;
+	int num_entries = 0;
+	for ( int pass = 0; pass < 2; pass++ )
+	{
+		uint16* p_first = (uint16*)mp_keySeekTable;
+		SKeySeekEntry* p_entry = pass ? (SKeySeekEntry*)( p_first + num_first ) : NULL;
+		int entry = 0;
+
+		for ( int tKeys = 0; tKeys < 2; tKeys++ )
+		{
+			char* p_key = tKeys ? mp_tFrames : mp_qFrames;
+			uint16* p_sizes = tKeys ? mp_perBoneTFrameSize : mp_perBoneQFrameSize;
+			for ( int i = 0; i < m_numBones; i++ )
+			{
+				if ( pass )
+				{
+					*p_first++ = entry;
+				}
+
+				char* p_bone_start = p_key;
+				char* p_bone_end = p_key + p_sizes[i];
+				for ( int k = 0; p_key < p_bone_end; k++ )
+				{
+					char* p_this_key = p_key;
+					uint16 timestamp;
+					if ( tKeys )
+					{
+						CStandardAnimTKey key;
+						p_key = get_compressed_t_frame( p_key, &key );
+						timestamp = key.timestamp;
+					}
+					else
+					{
+						CStandardAnimQKey key;
+						p_key = get_compressed_q_frame( p_key, &key );
+						timestamp = key.timestamp;
+					}
+
+					if ( ( k % vKEY_SEEK_STRIDE ) == 0 )
+					{
+						if ( pass )
+						{
+							p_entry[entry].offset = p_this_key - p_bone_start;
+							p_entry[entry].timestamp = timestamp;
+						}
+						entry++;
+					}
+				}
+			}
+
+			if ( pass )
+			{
+				*p_first++ = entry;
+			}
+		}
+
+		if ( !pass )
+		{
+			num_entries = entry;
+			mp_keySeekTable = Mem::Malloc( num_first * sizeof( uint16 ) + num_entries * sizeof( SKeySeekEntry ) );
+		}
+	}
+}
+#endif		// __ARAM__
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+SDecompressedKeys* CBonedAnimFrameData::Decompress() const
+{
+#ifdef __ARAM__
+	// the keys are in ARAM
+	return NULL;
+#else
+	if ( !UsesCompressTable() || !m_dataLoaded )
+	{
+		return NULL;
+	}
+
+	int num_keys[2] = { 0, 0 };
+	for ( int tKeys = 0; tKeys < 2; tKeys++ )
+	{
+		char* p_key = tKeys ? mp_tFrames : mp_qFrames;
+		uint16* p_sizes = tKeys ? mp_perBoneTFrameSize : mp_perBoneQFrameSize;
+		char* p_end = p_key;
+		for ( int i = 0; i < m_numBones; i++ )
+		{
+			p_end += p_sizes[i];
+		}
+		while ( p_key < p_end )
+		{
+			CStandardAnimQKey q_key;
+			CStandardAnimTKey t_key;
+			p_key = tKeys ? get_compressed_t_frame( p_key, &t_key ) : get_compressed_q_frame( p_key, &q_key );
+			num_keys[tKeys]++;
+		}
+	}
+
+	// Each array starts on a 16 byte boundary
+	int num_first = m_numBones + 1;
+	uint32 q_floats = ( num_keys[0] + 3 ) & ~3;
+	uint32 t_floats = ( num_keys[1] + 3 ) & ~3;
+	uint32 header_size = ( sizeof( SDecompressedKeys ) + num_first * 2 * sizeof( uint32 ) + 15 ) & ~15;
+	uint32 size = header_size + ( q_floats * 5 + t_floats * 4 ) * sizeof( float );
+
+	uint8* p_block = (uint8*)Mem::Malloc( size );
+	SDecompressedKeys* p_keys = (SDecompressedKeys*)p_block;
+	p_keys->size = size;
+	p_keys->numBones = m_numBones;
+	p_keys->pQFirst = (uint32*)( p_keys + 1 );
+	p_keys->pTFirst = p_keys->pQFirst + num_first;
+
+	float* p_float = (float*)( p_block + header_size );
+	p_keys->pQTime = p_float;	p_float += q_floats;
+	p_keys->pQX = p_float;		p_float += q_floats;
+	p_keys->pQY = p_float;		p_float += q_floats;
+	p_keys->pQZ = p_float;		p_float += q_floats;
+	p_keys->pQW = p_float;		p_float += q_floats;
+	p_keys->pTTime = p_float;	p_float += t_floats;
+	p_keys->pTX = p_float;		p_float += t_floats;
+	p_keys->pTY = p_float;		p_float += t_floats;
+	p_keys->pTZ = p_float;
+
+	char* p_key = mp_qFrames;
+	int k = 0;
+	for ( int i = 0; i < m_numBones; i++ )
+	{
+		p_keys->pQFirst[i] = k;
+		char* p_bone_end = p_key + mp_perBoneQFrameSize[i];
+		while ( p_key < p_bone_end )
+		{
+			CStandardAnimQKey key;
+			Mth::Quat q;
+			p_key = get_compressed_q_frame( p_key, &key );
+			get_rotation_from_standard_key( &key, &q );
+			p_keys->pQTime[k] = timeDown( key.timestamp );
+			p_keys->pQX[k] = q[X];
+			p_keys->pQY[k] = q[Y];
+			p_keys->pQZ[k] = q[Z];
+			p_keys->pQW[k] = q[W];
+			k++;
+		}
+	}
+	p_keys->pQFirst[m_numBones] = k;
+
+	p_key = mp_tFrames;
+	k = 0;
+	for ( int i = 0; i < m_numBones; i++ )
+	{
+		p_keys->pTFirst[i] = k;
+		char* p_bone_end = p_key + mp_perBoneTFrameSize[i];
+		while ( p_key < p_bone_end )
+		{
+			CStandardAnimTKey key;
+			Mth::Vector t;
+			p_key = get_compressed_t_frame( p_key, &key );
+			get_translation_from_standard_key( &key, &t );
+			p_keys->pTTime[k] = timeDown( key.timestamp );
+			p_keys->pTX[k] = t[X];
+			p_keys->pTY[k] = t[Y];
+			p_keys->pTZ[k] = t[Z];
+			k++;
+		}
+	}
+	p_keys->pTFirst[m_numBones] = k;
+
+	return p_keys;
+#endif		// __ARAM__
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Finds the key at or before the time in one bone's decompressed keys, and the alpha
+// to the key after it, trying the pair the last search found (and the pair after
+// that) before searching.  The hint may be left over from another anim, so it's checked.
+inline int find_decompressed_key( const float* pTimes, int numKeys, int hint, float timeStamp, float* pAlpha )
+{
+	*pAlpha = 0.0f;
+
+	if ( numKeys < 2 || timeStamp <= pTimes[0] )
+	{
+		return 0;
+	}
+	if ( timeStamp >= pTimes[numKeys - 1] )
+	{
+		// last frame
+		return numKeys - 1;
+	}
+
+	// From here on pTimes[0] < timeStamp < pTimes[numKeys - 1], so there is such a pair
+	int k = hint;
+	if ( k >= numKeys - 1 || timeStamp < pTimes[k] || timeStamp >= pTimes[k + 1] )
+	{
+		k++;
+		if ( k >= numKeys - 1 || timeStamp < pTimes[k] || timeStamp >= pTimes[k + 1] )
+		{
+			int lo = 0;
+			int hi = numKeys - 1;
+			while ( hi - lo > 1 )
+			{
+				int mid = ( lo + hi ) >> 1;
+				if ( pTimes[mid] <= timeStamp )
+				{
+					lo = mid;
+				}
+				else
+				{
+					hi = mid;
+				}
+			}
+			k = lo;
+		}
+	}
+
+	*pAlpha = get_alpha( pTimes[k], pTimes[k + 1], timeStamp );
+	return k;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+inline void interpolate_decompressed_q_frame( Mth::Quat* p_out, const SDecompressedKeys* p_keys, int k, float alpha, bool trueSlerp )
+{
+	Mth::Quat qIn1( p_keys->pQX[k], p_keys->pQY[k], p_keys->pQZ[k], p_keys->pQW[k] );
+	if ( alpha == 0.0f )
+	{
+		*p_out = qIn1;
+		return;
+	}
+
+	Mth::Quat qIn2( p_keys->pQX[k + 1], p_keys->pQY[k + 1], p_keys->pQZ[k + 1], p_keys->pQW[k + 1] );
+	if ( alpha == 1.0f )
+	{
+		*p_out = qIn2;
+		return;
+	}
+
+	if ( trueSlerp )
+	{
+		*p_out = Mth::Slerp( qIn1, qIn2, alpha );
+		return;
+	}
+
+	*p_out = Mth::FastSlerp( qIn1, qIn2, alpha );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+inline void interpolate_decompressed_t_frame( Mth::Vector* p_out, const SDecompressedKeys* p_keys, int k, float alpha )
+{
+	Mth::Vector tIn1( p_keys->pTX[k], p_keys->pTY[k], p_keys->pTZ[k], 1.0f );
+	if ( alpha == 0.0f )
+	{
+		*p_out = tIn1;
+		return;
+	}
+
+	Mth::Vector tIn2( p_keys->pTX[k + 1], p_keys->pTY[k + 1], p_keys->pTZ[k + 1], 1.0f );
+	if ( alpha == 1.0f )
+	{
+		*p_out = tIn2;
+		return;
+	}
+
+	*p_out = Mth::Lerp( tIn1, tIn2, alpha );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The same as GetCompressedInterpolatedFrames(), from the anim cache's decompressed keys
+bool CBonedAnimFrameData::GetDecompressedInterpolatedFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* pQuickAnim )
+{
+    Dbg_Assert( pRotations );
+    Dbg_Assert( pTranslations );
+	Dbg_Assert( pQuickAnim );
+
+	SQuickAnimPointers* p_cursor = &pQuickAnim->m_quickAnimPointers;
+	const SDecompressedKeys* p_keys = p_cursor->pDecompressed;
+	Dbg_MsgAssert( p_keys && p_keys->numBones == m_numBones, ( "Decompressed keys don't match the anim" ) );
+
+	float timeStamp = time * 60.0f;
+
+	uint32 skip_index_mask = p_cursor->valid ? ( 1 << p_cursor->skipIndex ) : 0;
+	bool trueSlerp = ( p_cursor->quality == ANIM_QUALITY_SLERP );
+
+	for ( int i = 0; i < m_numBones; i++ )
+	{
+		bool skip_this_bone = ( skip_index_mask ) ? (( p_cursor->pSkipList[i] & skip_index_mask ) > 0 ) : false;
+
+		if ( m_flags & nxBONEDANIMFLAGS_PARTIALANIM )
+		{
+			uint32* pBoneMask = ( mp_partialAnimData + 1 ) + ( i / 32 );
+			skip_this_bone = ( ( (*pBoneMask) & ( 1 << (i%32) ) ) == 0 );
+		}
+
+		if ( !skip_this_bone )
+		{
+			float qAlpha;
+			float tAlpha;
+
+			bool use_cursor = i < vMAX_CURSOR_BONES;
+
+			int q_first = p_keys->pQFirst[i];
+			int q_index = find_decompressed_key( p_keys->pQTime + q_first, p_keys->pQFirst[i + 1] - q_first,
+												 ( use_cursor && p_cursor->valid ) ? p_cursor->quickQIndex[i] : 0, timeStamp, &qAlpha );
+
+			int t_first = p_keys->pTFirst[i];
+			int t_index = find_decompressed_key( p_keys->pTTime + t_first, p_keys->pTFirst[i + 1] - t_first,
+												 ( use_cursor && p_cursor->valid ) ? p_cursor->quickTIndex[i] : 0, timeStamp, &tAlpha );
+
+			if ( use_cursor )
+			{
+				p_cursor->quickQIndex[i] = q_index;
+				p_cursor->quickTIndex[i] = t_index;
+			}
+
+			interpolate_decompressed_q_frame( pRotations, p_keys, q_first + q_index, get_quality_alpha( p_cursor->quality, qAlpha ), trueSlerp );
+			interpolate_decompressed_t_frame( pTranslations, p_keys, t_first + t_index, get_quality_alpha( p_cursor->quality, tAlpha ) );
+		}
+
+		pRotations++;
+		pTranslations++;
+	}
+
+	// The compressed keys' cursor hasn't been kept up
+	p_cursor->cursorBones = 0;
+
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+#ifdef __SIMD_ANIM_DECODE__
+
+static bool s_simd_anim_decode = true;
+
+// The keys for up to four bones, one bone per lane, waiting to be dequantized
+// and interpolated together
+struct SKeyBatch
+{
+	__m128i				q1[3];				// x, y, z of the start keys
+	__m128i				q2[3];				// and the end keys
+	__m128i				qSign1;				// all bits set where W is negative
+	__m128i				qSign2;
+	__m128				qAlpha;
+	__m128i				t1[3];
+	__m128i				t2[3];
+	__m128				tAlpha;
+	Mth::Quat*			pRotations[4];
+	Mth::Vector*		pTranslations[4];
+	int					count;
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Rebuilds W the same way as get_rotation_from_standard_key(), including ignoring
+// the sign bit of the identity rotation
+inline __m128 rebuild_quat_w( __m128 x, __m128 y, __m128 z, __m128i qx, __m128i qy, __m128i qz, __m128i sign )
+{
+	__m128 sum = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( _mm_set1_ps( 1.0f ), _mm_mul_ps( x, x )), _mm_mul_ps( y, y )), _mm_mul_ps( z, z ));
+	__m128 w = _mm_sqrt_ps( _mm_max_ps( sum, _mm_setzero_ps()));
+
+	__m128i zero = _mm_setzero_si128();
+	__m128i identity = _mm_and_si128( _mm_and_si128( _mm_cmpeq_epi32( qx, zero ), _mm_cmpeq_epi32( qy, zero )), _mm_cmpeq_epi32( qz, zero ));
+	__m128i sign_bit = _mm_andnot_si128( identity, _mm_and_si128( sign, _mm_set1_epi32( 0x80000000 )));
+	return _mm_xor_ps( w, _mm_castsi128_ps( sign_bit ));
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Picks a where mask is set, otherwise b
+inline __m128 select_ps( __m128 mask, __m128 a, __m128 b )
+{
+	return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ));
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Does what interpolate_standard_q_frame() and interpolate_standard_t_frame() do,
+// for all the bones in the batch at once, with the operations in the same order,
+// so the results match.
+static void flush_key_batch( SKeyBatch* pBatch )
+{
+	const __m128 quat_scale = _mm_set1_ps( 1.0f / 16384.0f );
+	const __m128 trans_scale = _mm_set1_ps( 1.0f / 32.0f );
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	// ROTATIONS
+
+	__m128 x1 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->q1[0] ), quat_scale );
+	__m128 y1 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->q1[1] ), quat_scale );
+	__m128 z1 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->q1[2] ), quat_scale );
+	__m128 w1 = rebuild_quat_w( x1, y1, z1, pBatch->q1[0], pBatch->q1[1], pBatch->q1[2], pBatch->qSign1 );
+
+	__m128 x2 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->q2[0] ), quat_scale );
+	__m128 y2 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->q2[1] ), quat_scale );
+	__m128 z2 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->q2[2] ), quat_scale );
+	__m128 w2 = rebuild_quat_w( x2, y2, z2, pBatch->q2[0], pBatch->q2[1], pBatch->q2[2], pBatch->qSign2 );
+
+	// Mth::FastSlerp(), which is a normalized lerp, taking the shorter way round
+	__m128 dot = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x1, x2 ), _mm_mul_ps( y1, y2 )), _mm_mul_ps( z1, z2 )), _mm_mul_ps( w1, w2 ));
+	__m128 flip = _mm_and_ps( _mm_cmplt_ps( dot, zero ), _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 )));
+
+	__m128 alpha = pBatch->qAlpha;
+	__m128 lx = _mm_add_ps( x1, _mm_mul_ps( _mm_sub_ps( _mm_xor_ps( x2, flip ), x1 ), alpha ));
+	__m128 ly = _mm_add_ps( y1, _mm_mul_ps( _mm_sub_ps( _mm_xor_ps( y2, flip ), y1 ), alpha ));
+	__m128 lz = _mm_add_ps( z1, _mm_mul_ps( _mm_sub_ps( _mm_xor_ps( z2, flip ), z1 ), alpha ));
+	__m128 lw = _mm_add_ps( w1, _mm_mul_ps( _mm_sub_ps( _mm_xor_ps( w2, flip ), w1 ), alpha ));
+
+	__m128 len_sqr = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( lx, lx ), _mm_mul_ps( ly, ly )), _mm_mul_ps( lz, lz )), _mm_mul_ps( lw, lw ));
+	__m128 len = _mm_div_ps( one, _mm_sqrt_ps( len_sqr ));
+
+	// At the keys themselves, the key is used as it is
+	__m128 at_start = _mm_cmpeq_ps( alpha, zero );
+	__m128 at_end = _mm_cmpeq_ps( alpha, one );
+	__m128 qx = select_ps( at_start, x1, select_ps( at_end, x2, _mm_mul_ps( lx, len )));
+	__m128 qy = select_ps( at_start, y1, select_ps( at_end, y2, _mm_mul_ps( ly, len )));
+	__m128 qz = select_ps( at_start, z1, select_ps( at_end, z2, _mm_mul_ps( lz, len )));
+	__m128 qw = select_ps( at_start, w1, select_ps( at_end, w2, _mm_mul_ps( lw, len )));
+
+	_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+	__m128 p_quats[4] = { qx, qy, qz, qw };
+
+	// TRANSLATIONS
+
+	__m128 tx1 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->t1[0] ), trans_scale );
+	__m128 ty1 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->t1[1] ), trans_scale );
+	__m128 tz1 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->t1[2] ), trans_scale );
+	__m128 tx2 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->t2[0] ), trans_scale );
+	__m128 ty2 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->t2[1] ), trans_scale );
+	__m128 tz2 = _mm_mul_ps( _mm_cvtepi32_ps( pBatch->t2[2] ), trans_scale );
+
+	alpha = pBatch->tAlpha;
+	at_start = _mm_cmpeq_ps( alpha, zero );
+	at_end = _mm_cmpeq_ps( alpha, one );
+	__m128 tx = select_ps( at_start, tx1, select_ps( at_end, tx2, _mm_add_ps( tx1, _mm_mul_ps( _mm_sub_ps( tx2, tx1 ), alpha ))));
+	__m128 ty = select_ps( at_start, ty1, select_ps( at_end, ty2, _mm_add_ps( ty1, _mm_mul_ps( _mm_sub_ps( ty2, ty1 ), alpha ))));
+	__m128 tz = select_ps( at_start, tz1, select_ps( at_end, tz2, _mm_add_ps( tz1, _mm_mul_ps( _mm_sub_ps( tz2, tz1 ), alpha ))));
+	__m128 tw = one;
+
+	_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+	__m128 p_trans[4] = { tx, ty, tz, tw };
+
+	// Quats and vectors are four floats, but the callers' arrays aren't always aligned
+	for ( int lane = 0; lane < pBatch->count; lane++ )
+	{
+		_mm_storeu_ps( &(*pBatch->pRotations[lane])[X], p_quats[lane] );
+		_mm_storeu_ps( &(*pBatch->pTranslations[lane])[X], p_trans[lane] );
+	}
+
+	pBatch->count = 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static inline void set_lane( __m128i* pVector, int lane, int value )
+{
+	((int*)pVector)[lane] = value;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The lanes past the end of a part full batch are left with whatever they had, which is
+// harmless, as they are never written out
+inline void add_to_key_batch( SKeyBatch* pBatch, CStandardAnimQKey* pStartQ, CStandardAnimQKey* pEndQ, float qAlpha,
+							  CStandardAnimTKey* pStartT, CStandardAnimTKey* pEndT, float tAlpha,
+							  Mth::Quat* pRotation, Mth::Vector* pTranslation )
+{
+	int lane = pBatch->count;
+	if ( lane == 0 )
+	{
+		// so the unused lanes don't hold NaNs
+		memset( pBatch, 0, offsetof( SKeyBatch, pRotations ));
+	}
+
+	set_lane( &pBatch->q1[0], lane, pStartQ->qx );
+	set_lane( &pBatch->q1[1], lane, pStartQ->qy );
+	set_lane( &pBatch->q1[2], lane, pStartQ->qz );
+	set_lane( &pBatch->qSign1, lane, pStartQ->signBit ? -1 : 0 );
+	set_lane( &pBatch->q2[0], lane, pEndQ->qx );
+	set_lane( &pBatch->q2[1], lane, pEndQ->qy );
+	set_lane( &pBatch->q2[2], lane, pEndQ->qz );
+	set_lane( &pBatch->qSign2, lane, pEndQ->signBit ? -1 : 0 );
+	((float*)&pBatch->qAlpha)[lane] = qAlpha;
+
+	set_lane( &pBatch->t1[0], lane, pStartT->tx );
+	set_lane( &pBatch->t1[1], lane, pStartT->ty );
+	set_lane( &pBatch->t1[2], lane, pStartT->tz );
+	set_lane( &pBatch->t2[0], lane, pEndT->tx );
+	set_lane( &pBatch->t2[1], lane, pEndT->ty );
+	set_lane( &pBatch->t2[2], lane, pEndT->tz );
+	((float*)&pBatch->tAlpha)[lane] = tAlpha;
+
+	pBatch->pRotations[lane] = pRotation;
+	pBatch->pTranslations[lane] = pTranslation;
+
+	if ( ++pBatch->count == 4 )
+	{
+		flush_key_batch( pBatch );
+	}
+}
+
+#endif		// __SIMD_ANIM_DECODE__
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool CBonedAnimFrameData::GetCompressedInterpolatedFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* pQuickAnim )
 {
     Dbg_Assert( pRotations );
@@ -2113,6 +2856,15 @@ bool CBonedAnimFrameData::GetCompressedInterpolatedFrames(Mth::Quat* pRotations,
 	// Precalculate the skip index mask for speed.
 	uint32 skip_index_mask = ( pQuickAnim && pQuickAnim->m_quickAnimPointers.valid ) ? ( 1 << pQuickAnim->m_quickAnimPointers.skipIndex ) : 0;
 
+	uint64 cursor_bones = get_cursor_bones( pQuickAnim );
+
+	uint32 quality = pQuickAnim ? pQuickAnim->m_quickAnimPointers.quality : ANIM_QUALITY_NLERP;
+
+#ifdef __SIMD_ANIM_DECODE__
+	SKeyBatch key_batch;
+	key_batch.count = 0;
+#endif		// __SIMD_ANIM_DECODE__
+
 	for ( int i = 0; i < m_numBones; i++ )
 	{
 		// See if the QuickAnim data indicates that this bone may be skipped.
@@ -2131,6 +2883,8 @@ bool CBonedAnimFrameData::GetCompressedInterpolatedFrames(Mth::Quat* pRotations,
 
 		if( !skip_this_bone )
 		{
+			bool use_cursor = pQuickAnim && i < vMAX_CURSOR_BONES;
+
 			float qAlpha = 0.0f;
 			float tAlpha = 0.0f;
 
@@ -2140,136 +2894,194 @@ bool CBonedAnimFrameData::GetCompressedInterpolatedFrames(Mth::Quat* pRotations,
 			char* pNextTFrame = pCurrentTFrame;
     		char* pNextTBone = pCurrentTFrame + *pTSizes;
 
-			if ( pQuickAnim && pQuickAnim->m_quickAnimPointers.valid )
-			{
-				pNextQFrame = pQuickAnim->m_quickAnimPointers.pQuickQKey[i];
-				pNextTFrame = pQuickAnim->m_quickAnimPointers.pQuickTKey[i];
-			}
-	 
-#ifdef __ARAM__
-			int q_off = 0;
+			int q_index = 0;
+			int t_index = 0;
+			bool q_found = false;
+			bool t_found = false;
+
+			// Start from the keys the last search for this bone found.  If the time is still between
+			// them, there's nothing to read; if it's earlier, step back through the seek table first.
+			if ( use_cursor && ( cursor_bones & ( (uint64)1 << i ) ) )
 			{
-				// DMA this q track.
-				uint aligned_off = ( (int)pNextQFrame & ~31 );
-				uint size = ( ( *pQSizes - ( aligned_off - (int)pCurrentQFrame ) ) + 31 ) & ~31;
-				DCFlushRange ( qqq, size );
-				framecount_size = size;
-				framecount_active = 1;
-				ARQPostRequest	(	&framecount_request,
-									0x55555555,											// Owner.
-									ARQ_TYPE_ARAM_TO_MRAM,								// Type.
-									ARQ_PRIORITY_HIGH,									// Priority.
-									(u32)aligned_off,									// Source.
-									(uint32)qqq,										// Dest.
-									size,												// Length.
-									arqCallback );										// Callback
-				q_off = (int)pNextQFrame - aligned_off;
+				SQuickAnimPointers* p_cursor = &pQuickAnim->m_quickAnimPointers;
+
+				*pStartQFrame = p_cursor->theStartQKey[i];
+				*pEndQFrame = p_cursor->theEndQKey[i];
+				pNextQFrame = p_cursor->pQuickQKey[i];
+				q_index = p_cursor->quickQIndex[i];
+				q_found = get_cursor_alpha( pStartQFrame->timestamp, pEndQFrame->timestamp, qTimeStamp, &qAlpha );
+				if ( !q_found && qTimeStamp < timeDown( pStartQFrame->timestamp ) )
+				{
+					q_index = seek_key_back( mp_keySeekTable, m_numBones, i, false, q_index, qTimeStamp, pCurrentQFrame, &pNextQFrame );
+				}
+
+				*pStartTFrame = p_cursor->theStartTKey[i];
+				*pEndTFrame = p_cursor->theEndTKey[i];
+				pNextTFrame = p_cursor->pQuickTKey[i];
+				t_index = p_cursor->quickTIndex[i];
+				t_found = get_cursor_alpha( pStartTFrame->timestamp, pEndTFrame->timestamp, tTimeStamp, &tAlpha );
+				if ( !t_found && tTimeStamp < timeDown( pStartTFrame->timestamp ) )
+				{
+					t_index = seek_key_back( mp_keySeekTable, m_numBones, i, true, t_index, tTimeStamp, pCurrentTFrame, &pNextTFrame );
+				}
 			}
-#endif		// __ARAM__
 
-			while ( 1 )
+			if ( !q_found )
 			{
-				if ( pQuickAnim )
+#ifdef __ARAM__
+				int q_off = 0;
 				{
-					pQuickAnim->m_quickAnimPointers.pQuickQKey[i] = (char*)pNextQFrame;
+					// DMA this q track.
+					uint aligned_off = ( (int)pNextQFrame & ~31 );
+					uint size = ( ( *pQSizes - ( aligned_off - (int)pCurrentQFrame ) ) + 31 ) & ~31;
+					DCFlushRange ( qqq, size );
+					framecount_size = size;
+					framecount_active = 1;
+					ARQPostRequest	(	&framecount_request,
+										0x55555555,											// Owner.
+										ARQ_TYPE_ARAM_TO_MRAM,								// Type.
+										ARQ_PRIORITY_HIGH,									// Priority.
+										(u32)aligned_off,									// Source.
+										(uint32)qqq,										// Dest.
+										size,												// Length.
+										arqCallback );										// Callback
+					q_off = (int)pNextQFrame - aligned_off;
 				}
+#endif		// __ARAM__
+
+				while ( 1 )
+				{
+					if ( use_cursor )
+					{
+						pQuickAnim->m_quickAnimPointers.pQuickQKey[i] = (char*)pNextQFrame;
+						pQuickAnim->m_quickAnimPointers.quickQIndex[i] = q_index;
+					}
 
-#				ifdef __ARAM__
-				while ( framecount_active );
-#				endif		// __ARAM__
+#					ifdef __ARAM__
+					while ( framecount_active );
+#					endif		// __ARAM__
 
 #ifdef __ARAM__
-				int bytes = get_compressed_q_frame( &qqq[q_off], pStartQFrame );
-				q_off += bytes;
-				pNextQFrame = &pNextQFrame[bytes];
+					int bytes = get_compressed_q_frame( &qqq[q_off], pStartQFrame );
+					q_off += bytes;
+					pNextQFrame = &pNextQFrame[bytes];
 #else
-				pNextQFrame = get_compressed_q_frame( pNextQFrame, pStartQFrame );
+					pNextQFrame = get_compressed_q_frame( pNextQFrame, pStartQFrame );
 #endif		// __ARAM__
-				if ( pNextQFrame >= pNextQBone )
-				{
-					// last frame
-					*pEndQFrame = *pStartQFrame;
-					qAlpha = 0.0f;
-					break;
-				}
+					if ( pNextQFrame >= pNextQBone )
+					{
+						// last frame
+						*pEndQFrame = *pStartQFrame;
+						qAlpha = 0.0f;
+						break;
+					}
 
 #ifdef __ARAM__
-				get_compressed_q_frame( &qqq[q_off], pEndQFrame );
+					get_compressed_q_frame( &qqq[q_off], pEndQFrame );
 #else
-				get_compressed_q_frame( pNextQFrame, pEndQFrame );
+					get_compressed_q_frame( pNextQFrame, pEndQFrame );
 #endif		// __ARAM__
-				if ( qTimeStamp >= timeDown(pStartQFrame->timestamp) && qTimeStamp <= timeDown(pEndQFrame->timestamp) )
-				{
-					qAlpha = get_alpha( timeDown(pStartQFrame->timestamp), timeDown(pEndQFrame->timestamp), qTimeStamp );
-					break;
+					if ( qTimeStamp >= timeDown(pStartQFrame->timestamp) && qTimeStamp <= timeDown(pEndQFrame->timestamp) )
+					{
+						qAlpha = get_alpha( timeDown(pStartQFrame->timestamp), timeDown(pEndQFrame->timestamp), qTimeStamp );
+						break;
+					}
+					q_index++;
 				}
 			}
 
-			// theStartFrame and theEndFrame should contain the
-			// two closest keyframes here.  now interpolate between them
-			// TODO:  we might be able to cache some of this data...
-			interpolate_standard_q_frame( pRotations, pStartQFrame, pEndQFrame, qAlpha );
-			
-#ifdef __ARAM__
-			int t_off = 0;
+			if ( !t_found )
 			{
-				// DMA this q track.
-				int aligned_off = ( (int)pNextTFrame & ~31 );
-				int size = ( ( *pTSizes - ( aligned_off - (int)pCurrentTFrame ) ) + 31 ) & ~31;
-				DCFlushRange ( qqq, size );
-				framecount_size = size;
-				framecount_active = 1;
-				ARQPostRequest	(	&framecount_request,
-									0x55555555,											// Owner.
-									ARQ_TYPE_ARAM_TO_MRAM,								// Type.
-									ARQ_PRIORITY_HIGH,									// Priority.
-									(u32)aligned_off,									// Source.
-									(uint32)qqq,										// Dest.
-									size,												// Length.
-									arqCallback );										// Callback
-				t_off = (int)pNextTFrame - aligned_off;
-			}
+#ifdef __ARAM__
+				int t_off = 0;
+				{
+					// DMA this q track.
+					int aligned_off = ( (int)pNextTFrame & ~31 );
+					int size = ( ( *pTSizes - ( aligned_off - (int)pCurrentTFrame ) ) + 31 ) & ~31;
+					DCFlushRange ( qqq, size );
+					framecount_size = size;
+					framecount_active = 1;
+					ARQPostRequest	(	&framecount_request,
+										0x55555555,											// Owner.
+										ARQ_TYPE_ARAM_TO_MRAM,								// Type.
+										ARQ_PRIORITY_HIGH,									// Priority.
+										(u32)aligned_off,									// Source.
+										(uint32)qqq,										// Dest.
+										size,												// Length.
+										arqCallback );										// Callback
+					t_off = (int)pNextTFrame - aligned_off;
+				}
 #endif		// __ARAM__
 
-			while ( 1 )
-			{
-				if ( pQuickAnim )
+				while ( 1 )
 				{
-					pQuickAnim->m_quickAnimPointers.pQuickTKey[i] = (char*)pNextTFrame;
-				}
+					if ( use_cursor )
+					{
+						pQuickAnim->m_quickAnimPointers.pQuickTKey[i] = (char*)pNextTFrame;
+						pQuickAnim->m_quickAnimPointers.quickTIndex[i] = t_index;
+					}
 
-#				ifdef __ARAM__
-				while ( framecount_active );
-#				endif		// __ARAM__
+#					ifdef __ARAM__
+					while ( framecount_active );
+#					endif		// __ARAM__
 
 #ifdef __ARAM__
-				int bytes = get_compressed_t_frame( &qqq[t_off], pStartTFrame );
-				t_off += bytes;
-				pNextTFrame = &pNextTFrame[bytes];
+					int bytes = get_compressed_t_frame( &qqq[t_off], pStartTFrame );
+					t_off += bytes;
+					pNextTFrame = &pNextTFrame[bytes];
 #else
-				pNextTFrame = get_compressed_t_frame( pNextTFrame, pStartTFrame );
+					pNextTFrame = get_compressed_t_frame( pNextTFrame, pStartTFrame );
 #endif		// __ARAM__
-				if ( pNextTFrame >= pNextTBone )
-				{
-					// last frame
-					*pEndTFrame = *pStartTFrame;
-					tAlpha = 0.0f;
-					break;
-				}
+					if ( pNextTFrame >= pNextTBone )
+					{
+						// last frame
+						*pEndTFrame = *pStartTFrame;
+						tAlpha = 0.0f;
+						break;
+					}
 
 #ifdef __ARAM__
-				get_compressed_t_frame( &qqq[t_off], pEndTFrame );
+					get_compressed_t_frame( &qqq[t_off], pEndTFrame );
 #else
-				get_compressed_t_frame( pNextTFrame, pEndTFrame );
+					get_compressed_t_frame( pNextTFrame, pEndTFrame );
 #endif		// __ARAM__
-				if ( tTimeStamp >= timeDown(pStartTFrame->timestamp) && tTimeStamp <= timeDown(pEndTFrame->timestamp) )
-				{
-					tAlpha = get_alpha( timeDown(pStartTFrame->timestamp), timeDown(pEndTFrame->timestamp), tTimeStamp );
-					break;
+					if ( tTimeStamp >= timeDown(pStartTFrame->timestamp) && tTimeStamp <= timeDown(pEndTFrame->timestamp) )
+					{
+						tAlpha = get_alpha( timeDown(pStartTFrame->timestamp), timeDown(pEndTFrame->timestamp), tTimeStamp );
+						break;
+					}
+					t_index++;
 				}
 			}
 
-			interpolate_standard_t_frame( pTranslations, pStartTFrame, pEndTFrame, tAlpha );
+			if ( use_cursor )
+			{
+				SQuickAnimPointers* p_cursor = &pQuickAnim->m_quickAnimPointers;
+				p_cursor->theStartQKey[i] = *pStartQFrame;
+				p_cursor->theEndQKey[i] = *pEndQFrame;
+				p_cursor->theStartTKey[i] = *pStartTFrame;
+				p_cursor->theEndTKey[i] = *pEndTFrame;
+				p_cursor->cursorBones |= ( (uint64)1 << i );
+			}
+
+			qAlpha = get_quality_alpha( quality, qAlpha );
+			tAlpha = get_quality_alpha( quality, tAlpha );
+
+#ifdef __SIMD_ANIM_DECODE__
+			// the batch only does the normalized lerp
+			if ( s_simd_anim_decode && quality != ANIM_QUALITY_SLERP )
+			{
+				add_to_key_batch( &key_batch, pStartQFrame, pEndQFrame, qAlpha, pStartTFrame, pEndTFrame, tAlpha, pRotations, pTranslations );
+			}
+			else
+#endif		// __SIMD_ANIM_DECODE__
+			{
+				// theStartFrame and theEndFrame should contain the
+				// two closest keyframes here.  now interpolate between them
+				// TODO:  we might be able to cache some of this data...
+				interpolate_standard_q_frame( pRotations, pStartQFrame, pEndQFrame, qAlpha, quality == ANIM_QUALITY_SLERP );
+				interpolate_standard_t_frame( pTranslations, pStartTFrame, pEndTFrame, tAlpha );
+			}
 		}
 		
 		pCurrentQFrame += *pQSizes;
@@ -2279,6 +3091,13 @@ bool CBonedAnimFrameData::GetCompressedInterpolatedFrames(Mth::Quat* pRotations,
 		pRotations++;
 		pTranslations++;
 	}
+
+#ifdef __SIMD_ANIM_DECODE__
+	if ( key_batch.count )
+	{
+		flush_key_batch( &key_batch );
+	}
+#endif		// __SIMD_ANIM_DECODE__
 	return true;
 }
 
@@ -2292,6 +3111,11 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 	if ( m_flags & nxBONEDANIMFLAGS_USECOMPRESSTABLE )
 	{
 		// new partial anims now use the standard GetCompressedInterpolatedFrames function
+		if ( pQuickAnim && pQuickAnim->m_quickAnimPointers.pDecompressed )
+		{
+			// the anim cache's shared copy
+			return GetDecompressedInterpolatedFrames(pRotations, pTranslations, time, pQuickAnim);
+		}
 		return GetCompressedInterpolatedFrames(pRotations, pTranslations, time, pQuickAnim);
 	}
 
@@ -2308,6 +3132,8 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 	float qAlpha = 0.0f;
 	float tAlpha = 0.0f;
 
+	uint32 quality = pQuickAnim ? pQuickAnim->m_quickAnimPointers.quality : ANIM_QUALITY_NLERP;
+
 	// DMA the animation data here.
 #ifdef __ARAM__
 	int		size;
@@ -2390,11 +3216,23 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 	void * p_bone_frames = mp_perBoneFrames;
 #endif		// __aram__
 
+	// These keys are all the same size, so the cursor is just the index of the start key
+	uint64 cursor_bones = get_cursor_bones( pQuickAnim );
+
 	for ( int i = 0; i < m_numBones; i++ )
 	{
 		int numQKeys = get_num_qkeys( p_bone_frames, i );
 		int numTKeys = get_num_tkeys( p_bone_frames, i );
 
+		bool use_cursor = pQuickAnim && i < vMAX_CURSOR_BONES;
+		int first_q = 0;
+		int first_t = 0;
+		if ( use_cursor && ( cursor_bones & ( (uint64)1 << i ) ) )
+		{
+			first_q = pQuickAnim->m_quickAnimPointers.quickQIndex[i];
+			first_t = pQuickAnim->m_quickAnimPointers.quickTIndex[i];
+		}
+
 #ifdef __ARAM__
 		int q_off = 0;
 		{
@@ -2421,7 +3259,13 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 		}
 #endif		// __ARAM__
 
-		for ( int j = 0; j < numQKeys; j++ )
+		// step back, if playing backwards or it's looped
+		while ( first_q > 0 && qTimeStamp < timeDown(pCurrentQFrame[first_q].timestamp) )
+		{
+			first_q--;
+		}
+
+		for ( int j = first_q; j < numQKeys; j++ )
 		{
 			if ( j == (numQKeys-1) )
 			{
@@ -2429,6 +3273,7 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 				pStartQFrame = pCurrentQFrame + j;
 				pEndQFrame = pCurrentQFrame + j;
 				qAlpha = 0.0f;
+				first_q = j;
 				break;
 			}
 			else if ( qTimeStamp >= timeDown(pCurrentQFrame[j].timestamp) 
@@ -2437,6 +3282,7 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 				pStartQFrame = pCurrentQFrame + j;
 				pEndQFrame = pCurrentQFrame + j + 1;
 				qAlpha = get_alpha( timeDown(pStartQFrame->timestamp), timeDown(pEndQFrame->timestamp), qTimeStamp );
+				first_q = j;
 				break;
 			}
 		}
@@ -2444,7 +3290,7 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 		interpolate_q_frame( pRotations, 
 						 pStartQFrame, 
 						 pEndQFrame,
-						 qAlpha,
+						 get_quality_alpha( quality, qAlpha ),
 						 is_hires() );
 
 #ifdef __ARAM__
@@ -2473,7 +3319,12 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 		}
 #endif		// __ARAM__
 
-		for ( int j = 0; j < numTKeys; j++ )
+		while ( first_t > 0 && tTimeStamp < timeDown(pCurrentTFrame[first_t].timestamp) )
+		{
+			first_t--;
+		}
+
+		for ( int j = first_t; j < numTKeys; j++ )
 		{
 			if ( j == (numTKeys-1) )
 			{
@@ -2481,6 +3332,7 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 				pStartTFrame = pCurrentTFrame + j;
 				pEndTFrame = pCurrentTFrame + j;
 				tAlpha = 0.0f;
+				first_t = j;
 				break;
 			}
 			else if ( tTimeStamp >= timeDown(pCurrentTFrame[j].timestamp) 
@@ -2489,9 +3341,17 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 				pStartTFrame = pCurrentTFrame + j;
 				pEndTFrame = pCurrentTFrame + j + 1;
 				tAlpha = get_alpha( timeDown(pStartTFrame->timestamp), timeDown(pEndTFrame->timestamp), tTimeStamp );
+				first_t = j;
 				break;
 			}
 		}
+
+		if ( use_cursor )
+		{
+			pQuickAnim->m_quickAnimPointers.quickQIndex[i] = first_q;
+			pQuickAnim->m_quickAnimPointers.quickTIndex[i] = first_t;
+			pQuickAnim->m_quickAnimPointers.cursorBones |= ( (uint64)1 << i );
+		}
 		
 		// theStartFrame and theEndFrame should contain the
 		// two closest keyframes here.  now interpolate between them
@@ -2499,7 +3359,7 @@ bool CBonedAnimFrameData::GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vect
 		interpolate_t_frame( pTranslations, 
 							 pStartTFrame, 
 							 pEndTFrame,
-							 tAlpha,
+							 get_quality_alpha( quality, tAlpha ),
 							 is_hires() );
 
 #if 0
@@ -2606,7 +3466,7 @@ bool CBonedAnimFrameData::ResetCustomKeys()
 /*                                                                */
 /******************************************************************/
 
-bool CBonedAnimFrameData::ProcessCustomKeys( float startTime, float endTime, Obj::CObject* pObject, bool inclusive )
+bool CBonedAnimFrameData::ProcessCustomKeys( float startTime, float endTime, Obj::CObject* pObject, bool inclusive, int* pCursor )
 {
 	// for each key,
 	// see if it's between the start and end time
@@ -2616,20 +3476,7 @@ bool CBonedAnimFrameData::ProcessCustomKeys( float startTime, float endTime, Obj
 	startTime *= 60.0f;
 	endTime *= 60.0f;
 
-	int customKeyCount = get_num_customkeys();
-	for ( int i = 0; i < customKeyCount; i++ )
-	{
-		CCustomAnimKey* pKey = get_custom_key(i);
-		if ( pKey->WithinRange( startTime, endTime, inclusive ) )
-		{
-//			printf( "Processing key at %f (%f %f)\n", custom_key_time, startTime, endTime );
-			pKey->ProcessKey( pObject );
-		}
-		else
-		{
-//			printf( "Not processing key at %f (%f %f)\n", custom_key_time, startTime, endTime );
-		}
-	}
+	m_customKeyIndex.ProcessKeys( startTime, endTime, inclusive, pObject, pCursor );
 
 	return true;
 }
@@ -2639,6 +3486,130 @@ bool CBonedAnimFrameData::ProcessCustomKeys( float startTime, float endTime, Obj
 /*                                                                */
 /******************************************************************/
 
+bool CBonedAnimFrameData::UsesCompressTable() const
+{
+	return ( m_flags & nxBONEDANIMFLAGS_USECOMPRESSTABLE ) && !is_hires();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void SetSimdAnimDecode( bool enabled )
+{
+#ifdef __SIMD_ANIM_DECODE__
+	s_simd_anim_decode = enabled;
+#endif		// __SIMD_ANIM_DECODE__
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | BenchmarkAnimDecode | Decodes every compressed anim loaded under the given
+// reference checksum (the anims that LoadAnim was given it as its ref), at a number of
+// times through each one, once with the scalar decode and once four bones at a time,
+// and prints how long each took and the biggest difference between them.  Also
+// returns them as max_quat_error, max_trans_error, scalar_us and simd_us.  Returns false,
+// and sets none of them, if no compressed anims are loaded under the checksum.
+// @parm name | anims | the reference checksum the anims were loaded with
+// @parmopt int | samples | 64 | times per anim
+bool ScriptBenchmarkAnimDecode( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	uint32 group = 0;
+	pParams->GetChecksum( CRCD(0x182f13ec,"anims"), &group, Script::ASSERT );
+
+	int samples = 64;
+	pParams->GetInteger( CRCD(0xe66da888,"samples"), &samples );
+	Dbg_MsgAssert( samples > 0, ( "BenchmarkAnimDecode needs at least one sample" ) );
+
+	Mth::Quat* p_scalar_q = new Mth::Quat[vMAX_BONES];
+	Mth::Vector* p_scalar_t = new Mth::Vector[vMAX_BONES];
+	Mth::Quat* p_simd_q = new Mth::Quat[vMAX_BONES];
+	Mth::Vector* p_simd_t = new Mth::Vector[vMAX_BONES];
+
+	float max_quat_error = 0.0f;
+	float max_trans_error = 0.0f;
+	uint64 scalar_us = 0;
+	uint64 simd_us = 0;
+	int num_anims = 0;
+
+#ifdef __SIMD_ANIM_DECODE__
+	bool was_enabled = s_simd_anim_decode;
+#endif		// __SIMD_ANIM_DECODE__
+
+	Ass::CAssMan* ass_man = Ass::CAssMan::Instance();
+	int count = ass_man->CountGroup( group );
+	for ( int n = 0; n < count; n++ )
+	{
+		CBonedAnimFrameData* p_anim = (CBonedAnimFrameData*)ass_man->GetNthInGroup( group, n );
+		if ( !p_anim || !p_anim->LoadFinished() || !p_anim->UsesCompressTable() || p_anim->GetNumBones() > vMAX_BONES )
+		{
+			continue;
+		}
+		num_anims++;
+
+		float step = p_anim->GetDuration() / samples;
+		for ( int s = 0; s < samples; s++ )
+		{
+			float time = s * step;
+
+			SetSimdAnimDecode( false );
+			uint64 start = Trace::GetTimeUS();
+			p_anim->GetCompressedInterpolatedFrames( p_scalar_q, p_scalar_t, time );
+			uint64 mid = Trace::GetTimeUS();
+			SetSimdAnimDecode( true );
+			p_anim->GetCompressedInterpolatedFrames( p_simd_q, p_simd_t, time );
+			uint64 end = Trace::GetTimeUS();
+
+			scalar_us += mid - start;
+			simd_us += end - mid;
+
+			for ( int i = 0; i < p_anim->GetNumBones(); i++ )
+			{
+				for ( int c = X; c <= W; c++ )
+				{
+					float quat_error = fabsf( p_scalar_q[i][c] - p_simd_q[i][c] );
+					float trans_error = fabsf( p_scalar_t[i][c] - p_simd_t[i][c] );
+					max_quat_error = ( quat_error > max_quat_error ) ? quat_error : max_quat_error;
+					max_trans_error = ( trans_error > max_trans_error ) ? trans_error : max_trans_error;
+				}
+			}
+		}
+	}
+
+#ifdef __SIMD_ANIM_DECODE__
+	s_simd_anim_decode = was_enabled;
+#else
+	printf( "BenchmarkAnimDecode: no SIMD decode on this platform, both passes are scalar\n" );
+#endif		// __SIMD_ANIM_DECODE__
+
+	// Zero times and errors would look like a pass
+	if ( num_anims )
+	{
+		printf( "BenchmarkAnimDecode: %d anims x %d samples, scalar %d us, simd %d us, max error quat %g trans %g\n",
+				num_anims, samples, (int)scalar_us, (int)simd_us, max_quat_error, max_trans_error );
+
+		pScript->GetParams()->AddFloat( CRCD(0xcef86916,"max_quat_error"), max_quat_error );
+		pScript->GetParams()->AddFloat( CRCD(0xa04fa77e,"max_trans_error"), max_trans_error );
+		pScript->GetParams()->AddInteger( CRCD(0x458bc93b,"scalar_us"), (int)scalar_us );
+		pScript->GetParams()->AddInteger( CRCD(0xb9aaa3b5,"simd_us"), (int)simd_us );
+	}
+	else
+	{
+		printf( "BenchmarkAnimDecode: no compressed anims are loaded under %s\n", Script::FindChecksumName( group ) );
+	}
+
+	delete[] p_scalar_q;
+	delete[] p_scalar_t;
+	delete[] p_simd_q;
+	delete[] p_simd_t;
+
+	return num_anims > 0;
+}
+
 } // namespace Gfx
 
 
@@ -40,6 +40,12 @@ namespace Obj
 	class CObject;
 }
 
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
 namespace File
 {
 	class CAsyncFileHandle;
@@ -51,6 +57,7 @@ namespace Gfx
 	class CAnimTKey;
 	struct SAnimCustomKey;
 	struct SQuickAnimPointers;
+	struct SDecompressedKeys;
 
 /*****************************************************************************
 **							   Class Definitions							**
@@ -64,20 +71,28 @@ public:
     ~CBonedAnimFrameData();
 
 public:
-    bool    			   	Load(uint32* pData, int file_size, bool assertOnFail);
+    bool    			   	Load(uint32* pData, int file_size, bool assertOnFail, uint32 fileNameCRC = 0);
     bool    			   	Load(const char* p_fileName, bool assertOnFail, bool async, bool use_pip = false);
     bool    			   	PostLoad(bool assertOnFail, int file_size, bool delete_buffer = true);
 	bool					LoadFinished();
 	bool					IsValidTime(float time);
 	float					GetDuration();
+	uint32					GetFileNameCRC() const;
 	int						GetNumBones();
 	uint32					GetBoneName( int index );
     bool				    GetInterpolatedFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* = NULL);
     bool				    GetCompressedInterpolatedFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* = NULL);
     bool				    GetCompressedInterpolatedPartialFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* = NULL);
+    bool				    GetDecompressedInterpolatedFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* pQuickAnim);
     bool				    GetInterpolatedCameraFrames(Mth::Quat* pRotations, Mth::Vector* pTranslations, float time, Nx::CQuickAnim* = NULL);
 	bool					ResetCustomKeys( void );
-	bool					ProcessCustomKeys( float startTimeInclusive, float endTimeExclusive, Obj::CObject* pObject, bool endInclusive = false );
+	// pCursor, if there is one, is the caller's own, to speed up finding the keys next time
+	bool					ProcessCustomKeys( float startTimeInclusive, float endTimeExclusive, Obj::CObject* pObject, bool endInclusive = false, int* pCursor = NULL );
+	bool					UsesCompressTable() const;
+
+	// A new copy of the keys for the anim cache, in one block for Mem::Free(),
+	// or NULL if the anim isn't compressed in a way it can decompress
+	SDecompressedKeys*		Decompress() const;
 
 	CAnimQKey*				GetQFrames( void ) { return (CAnimQKey*)mp_qFrames; }
 	CAnimTKey*				GetTFrames( void ) { return (CAnimTKey*)mp_tFrames; }
@@ -93,6 +108,7 @@ protected:
 	void					set_num_qkeys( int boneIndex, int numKeys );
 	void					set_num_tkeys( int boneIndex, int numKeys );
 	bool					is_hires() const;
+	void					build_key_seek_table();
 
 	static void 			async_callback(File::CAsyncFileHandle *, File::EAsyncFunctionType function,
 										   int result, unsigned int arg0, unsigned int arg1);
@@ -130,9 +146,13 @@ protected:
 
 	// custom keys (for cameras, changing parent bones, etc.)
 	CCustomAnimKey** 		mpp_customAnimKeyList;
+	CCustomAnimKeyIndex		m_customKeyIndex;
 
 	uint16*					mp_perBoneQFrameSize;
 	uint16*					mp_perBoneTFrameSize;
+
+	// every few keys of each bone's compressed keys, so playback can step backwards
+	void*					mp_keySeekTable;
 	
 	short					m_num_qFrames;
 	short					m_num_tFrames;
@@ -162,6 +182,10 @@ protected:
 bool InitQ48Table( const char* pFileName, bool assertOnFail = true );
 bool InitT48Table( const char* pFileName, bool assertOnFail = true );
 
+// Whether compressed anims are decoded four bones at a time, where the platform can
+void SetSimdAnimDecode( bool enabled );
+bool ScriptBenchmarkAnimDecode( Script::CStruct *pParams, Script::CScript *pScript );
+
 /*****************************************************************************
 **								Inline Functions							**
 *****************************************************************************/
@@ -176,6 +200,16 @@ inline float CBonedAnimFrameData::GetDuration()
 	return m_duration;
 }
 
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+inline uint32 CBonedAnimFrameData::GetFileNameCRC() const
+{
+	return m_fileNameCRC;
+}
+
 /******************************************************************/
 /*                                                                */
 /*                                                                */
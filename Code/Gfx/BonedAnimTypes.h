@@ -82,19 +82,55 @@ public:
     float           tz;
 };
 
+// A compressed anim's keys, decompressed by the anim cache (see Nx::UpdateAnimCache())
+// and shared by every object playing it.  One array per channel; bone i's rotation
+// keys are entries pQFirst[i] up to pQFirst[i + 1] of the rotation arrays, and the
+// same for the translations.  Times are in 60ths of a second, like the timestamps.
+struct SDecompressedKeys
+{
+	uint32				size;					// of the whole block, this included
+	int					numBones;
+	uint32*				pQFirst;				// numBones + 1 of each
+	uint32*				pTFirst;
+	float*				pQTime;
+	float*				pQX;
+	float*				pQY;
+	float*				pQZ;
+	float*				pQW;
+	float*				pTTime;
+	float*				pTX;
+	float*				pTY;
+	float*				pTZ;
+};
+
+// A playback cursor per bone:  where the last search for each bone's keys ended up,
+// and the keys it found, so the next search can start from there, in either direction
 struct SQuickAnimPointers
 {
 	char* 				pQuickQKey[64];
 	char*				pQuickTKey[64];
+	uint16				quickQIndex[64];		// of the key that pQuickQKey points to
+	uint16				quickTIndex[64];
 	CStandardAnimQKey	theStartQKey[64];
 	CStandardAnimQKey	theEndQKey[64];
 	CStandardAnimTKey	theStartTKey[64];
 	CStandardAnimTKey	theEndTKey[64];
+	uint64				cursorBones;			// bit per bone, set once the above are filled in since valid was last cleared
 //	char				qSkip[64];
 //	char				tSkip[64];
 	bool				valid;
 	uint32*				pSkipList;
 	uint32				skipIndex;
+	uint32				quality;				// EAnimQuality
+	const SDecompressedKeys*	pDecompressed;	// the shared decompressed keys, if the anim cache has them
+};
+
+// How the keys either side of the time are combined; picked per object by the animation LOD
+enum EAnimQuality
+{
+	ANIM_QUALITY_NLERP			= 0,	// normalized lerp of the rotations, Mth::FastSlerp (the default)
+	ANIM_QUALITY_SLERP,					// true slerp, for close ups
+	ANIM_QUALITY_NEAREST,				// whichever key is nearer, no interpolation
 };
 
 // NOTE: if you change this enum, update the CAnimChannel::GetDebugInfo switch statement!	
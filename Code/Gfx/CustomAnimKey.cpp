@@ -37,6 +37,10 @@ namespace Gfx
 **								   Defines									**
 *****************************************************************************/
 
+// WithinRange() can take keys this many frames either side of the range
+// (the camera keys take the frame before), so the index looks that far out
+#define vCUSTOM_KEY_RANGE_SLACK		2.0f
+
 /*****************************************************************************
 **								Private Types								**
 *****************************************************************************/
@@ -689,4 +693,175 @@ CCustomAnimKey* ReadCustomAnimKey( uint8** pData )
 /*                                                                */
 /******************************************************************/
 
+CCustomAnimKeyIndex::CCustomAnimKeyIndex()
+{
+	mpp_keys = NULL;
+	mp_frames = NULL;
+	m_numKeys = 0;
+	m_sorted = true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CCustomAnimKeyIndex::~CCustomAnimKeyIndex()
+{
+	Clear();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCustomAnimKeyIndex::Clear()
+{
+	delete[] mpp_keys;
+	delete[] mp_frames;
+	mpp_keys = NULL;
+	mp_frames = NULL;
+	m_numKeys = 0;
+	m_sorted = true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCustomAnimKeyIndex::Build( CCustomAnimKey** ppKeys, int numKeys )
+{
+	Clear();
+
+	if ( numKeys <= 0 )
+	{
+		return;
+	}
+
+	mpp_keys = new CCustomAnimKey*[numKeys];
+	mp_frames = new int[numKeys];
+	m_numKeys = numKeys;
+
+	for ( int i = 0; i < numKeys; i++ )
+	{
+		mpp_keys[i] = ppKeys[i];
+		mp_frames[i] = ppKeys[i]->GetFrame();
+		if ( i && mp_frames[i] < mp_frames[i - 1] )
+		{
+			// the order they're given in is the order they're processed
+			// in, so they can't be sorted without changing what happens
+			m_sorted = false;
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCustomAnimKeyIndex::Build( Lst::Head<CCustomAnimKey>* pKeyList )
+{
+	Clear();
+
+	int numKeys = pKeyList->CountItems();
+	if ( !numKeys )
+	{
+		return;
+	}
+
+	CCustomAnimKey** ppKeys = new CCustomAnimKey*[numKeys];
+	int i = 0;
+	for ( Lst::Node<CCustomAnimKey>* pNode = pKeyList->FirstItem(); pNode; pNode = pNode->GetNext() )
+	{
+		ppKeys[i++] = pNode->GetData();
+	}
+
+	Build( ppKeys, numKeys );
+
+	delete[] ppKeys;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The first key at or after the given frame
+int CCustomAnimKeyIndex::find_first( float frame, int* pCursor ) const
+{
+	if ( pCursor )
+	{
+		int cursor = *pCursor;
+		if ( cursor >= 0 && cursor <= m_numKeys
+			 && ( cursor == m_numKeys || (float)mp_frames[cursor] >= frame )
+			 && ( cursor == 0 || (float)mp_frames[cursor - 1] < frame ) )
+		{
+			return cursor;
+		}
+	}
+
+	int low = 0;
+	int high = m_numKeys;
+	while ( low < high )
+	{
+		int mid = ( low + high ) >> 1;
+		if ( (float)mp_frames[mid] < frame )
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	if ( pCursor )
+	{
+		*pCursor = low;
+	}
+	return low;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CCustomAnimKeyIndex::ProcessKeys( float startFrame, float endFrame, bool inclusive, Obj::CObject* pObject, int* pCursor )
+{
+	if ( !m_sorted )
+	{
+		for ( int i = 0; i < m_numKeys; i++ )
+		{
+			if ( mpp_keys[i]->WithinRange( startFrame, endFrame, inclusive ) )
+			{
+				mpp_keys[i]->ProcessKey( pObject );
+			}
+		}
+		return;
+	}
+
+	// WithinRange() works out the direction, so look both ways
+	float lowFrame = ( startFrame < endFrame ) ? startFrame : endFrame;
+	float highFrame = ( startFrame < endFrame ) ? endFrame : startFrame;
+	lowFrame -= vCUSTOM_KEY_RANGE_SLACK;
+	highFrame += vCUSTOM_KEY_RANGE_SLACK;
+
+	for ( int i = find_first( lowFrame, pCursor ); i < m_numKeys && (float)mp_frames[i] <= highFrame; i++ )
+	{
+		if ( mpp_keys[i]->WithinRange( startFrame, endFrame, inclusive ) )
+		{
+			mpp_keys[i]->ProcessKey( pObject );
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 } // namespace Gfx
@@ -65,6 +65,7 @@ public:
 	CCustomAnimKey( int time );
 	virtual bool	WithinRange( float startFrame, float endFrame, bool inclusive = false );
 	void			SetActive( bool active );
+	int				GetFrame() const { return m_frame; }
 
 public:
 	bool			ProcessKey( Obj::CObject* pObject );
@@ -97,6 +98,45 @@ protected:
 	Script::CStruct*	mp_eventParams;
 };
 
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// class CCustomAnimKeyIndex
+// The frames of a set of custom keys, in order, so the keys due in a range of
+// frames can be found with a binary search rather than by testing every key.
+// The keys still get the final say through WithinRange(), and get processed in
+// the order they were given, so it does exactly what testing them all would.
+// Keys not given in time order are just tested one after another.
+class CCustomAnimKeyIndex
+{
+public:
+	CCustomAnimKeyIndex();
+	~CCustomAnimKeyIndex();
+
+public:
+	void				Build( CCustomAnimKey** ppKeys, int numKeys );
+	void				Build( Lst::Head<CCustomAnimKey>* pKeyList );
+	void				Clear();
+
+	int					GetNumKeys() const { return m_numKeys; }
+	CCustomAnimKey*		GetKey( int index ) const { return mpp_keys[index]; }
+
+	// pCursor, which can be NULL, remembers where the last search for this
+	// channel ended up, which is usually where the next one ends up too
+	void				ProcessKeys( float startFrame, float endFrame, bool inclusive, Obj::CObject* pObject, int* pCursor = NULL );
+
+protected:
+	int					find_first( float frame, int* pCursor ) const;
+
+protected:
+	CCustomAnimKey**	mpp_keys;
+	int*				mp_frames;
+	int					m_numKeys;
+	bool				m_sorted;
+};
+
 /*****************************************************************************
 **							 Private Declarations							**
 *****************************************************************************/
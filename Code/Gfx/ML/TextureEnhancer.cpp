@@ -6,11 +6,42 @@
 #include <string.h>
 #include <time.h>
 
+#include <core/crc.h>
+#include <sys/file/assetcache.h>
+
 namespace Gfx
 {
 namespace ML
 {
 
+// Bump this whenever an enhancement algorithm changes its output,
+// so that results cached by older builds are no longer picked up.
+#define TEXTURE_ENHANCER_CACHE_VERSION 2
+
+// Header of a cached enhancement result, followed by the RGBA8 pixels.
+struct SCachedEnhancement
+{
+    int width;
+    int height;
+    int channels;
+};
+
+// Checksum of every setting that affects the enhanced output.
+static uint32 GetConfigChecksum(const TextureEnhanceConfig& config)
+{
+    int values[8];
+    values[0] = (config.enableUpscaling ? 1 : 0) | (config.enableSharpening ? 2 : 0) |
+                (config.enableColorEnhance ? 4 : 0) | (config.enableDenoise ? 8 : 0);
+    values[1] = config.upscaleFactor;
+    values[2] = (int)(config.sharpenStrength * 1000.0f);
+    values[3] = (int)(config.colorEnhanceStrength * 1000.0f);
+    values[4] = (int)(config.denoiseStrength * 1000.0f);
+    values[5] = config.minTextureSize;
+    values[6] = config.maxTextureSize;
+    values[7] = 0;
+    return Crc::GenerateCRCCaseSensitive((const char*)values, sizeof(values));
+}
+
 // Global texture enhancer instance
 static CTextureEnhancer* s_pTextureEnhancer = nullptr;
 
@@ -155,6 +186,7 @@ void CTextureEnhancer::Shutdown()
     printf("TextureEnhancer: Shutdown complete\n");
     printf("  Total textures processed: %d\n", m_stats.texturesProcessed);
     printf("  Total processing time: %.2f ms\n", m_stats.totalProcessingTimeMs);
+    printf("  Served from asset cache: %d\n", m_stats.cacheHits);
     if (m_stats.texturesProcessed > 0)
     {
         printf("  Average processing time: %.2f ms per texture\n", m_stats.avgProcessingTimeMs);
@@ -186,6 +218,32 @@ bool CTextureEnhancer::EnhanceTexture(uint8* textureData, int& width, int& heigh
     if (!ShouldEnhanceTexture(width, height))
         return false;
     
+    // The enhancement passes are far slower than a disk read, so try the persistent
+    // asset cache first. The key covers the source pixels, dimensions and settings.
+    uint32 sourceSize = width * height * channels;
+    uint32 params[4] = { GetConfigChecksum(m_config), (uint32)width, (uint32)height, (uint32)channels };
+    AssetCache::SKey cacheKey = AssetCache::MakeKey(Crc::GenerateCRCFromString("TextureEnhancer"),
+                                                    TEXTURE_ENHANCER_CACHE_VERSION,
+                                                    AssetCache::HashParams(params, 4),
+                                                    textureData, sourceSize);
+    uint32 cachedSize = 0;
+    const SCachedEnhancement* cached = (const SCachedEnhancement*)AssetCache::Lookup(cacheKey, &cachedSize);
+    if (cached)
+    {
+        uint32 pixelBytes = cached->width * cached->height * cached->channels;
+        if (cachedSize == sizeof(SCachedEnhancement) + pixelBytes)
+        {
+            enhancedWidth = width = cached->width;
+            enhancedHeight = height = cached->height;
+            *enhancedData = new uint8[pixelBytes];
+            memcpy(*enhancedData, cached + 1, pixelBytes);
+            AssetCache::Release(cached);
+            m_stats.cacheHits++;
+            return true;
+        }
+        AssetCache::Release(cached);
+    }
+
     clock_t startTime = clock();
     bool enhanced = false;
     
@@ -281,6 +339,16 @@ bool CTextureEnhancer::EnhanceTexture(uint8* textureData, int& width, int& heigh
         
         width = enhancedWidth;
         height = enhancedHeight;
+
+        uint32 pixelBytes = current.width * current.height * current.channels;
+        uint8* blob = new uint8[sizeof(SCachedEnhancement) + pixelBytes];
+        SCachedEnhancement* header = (SCachedEnhancement*)blob;
+        header->width = current.width;
+        header->height = current.height;
+        header->channels = current.channels;
+        memcpy(header + 1, *enhancedData, pixelBytes);
+        AssetCache::Store(cacheKey, blob, sizeof(SCachedEnhancement) + pixelBytes);
+        delete[] blob;
     }
     
     // Cleanup
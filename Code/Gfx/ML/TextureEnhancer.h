@@ -54,6 +54,7 @@ struct TextureEnhanceStats
     int texturesSharpened;
     int texturesColorEnhanced;
     int texturesDenoised;
+    int cacheHits;               // Results served from the persistent asset cache
     
     float totalProcessingTimeMs;
     float avgProcessingTimeMs;
@@ -64,6 +65,7 @@ struct TextureEnhanceStats
         , texturesSharpened(0)
         , texturesColorEnhanced(0)
         , texturesDenoised(0)
+        , cacheHits(0)
         , totalProcessingTimeMs(0.0f)
         , avgProcessingTimeMs(0.0f)
     {}
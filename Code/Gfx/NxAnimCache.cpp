@@ -7,14 +7,22 @@
 
 #include <gfx/nxanimcache.h>
 
+#include <atomic>
+
 #include <gel/assman/assman.h>
 
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/script.h>
+#include <gel/scripting/struct.h>
 
 #include <gfx/bonedanim.h>
+#include <gfx/bonedanimtypes.h>
 #include <gfx/nx.h>
 
+#include <core/thread/jobsystem.h>
+#include <sys/mem/memman.h>
+#include <sys/timer.h>
+
 namespace Nx
 {
 
@@ -22,6 +30,96 @@ namespace Nx
 **							   Private Functions							**
 *****************************************************************************/
 
+enum
+{
+	vMAX_CACHED_ANIMS = 256,				// anims being played, or still decompressed
+	vMAX_DECOMPRESS_PER_FRAME = 2,
+	vDEFAULT_ANIM_CACHE_BUDGET = 2 * 1024 * 1024,
+};
+
+struct SAnimCacheEntry
+{
+	uint32						mAnimName;			// 0 if the entry is free
+	int							mRefCount;			// quick anims playing it
+	Gfx::CBonedAnimFrameData*	mpFrameData;		// that mpKeys was decompressed from
+	Gfx::SDecompressedKeys*		mpKeys;
+	uint32						mLastUsed;			// render frame
+	uint32						mSize;				// of the decompressed keys, once known
+	bool						mUncompressable;	// not in a form that can be decompressed
+	std::atomic<uint32>			mUses;				// since the last UpdateAnimCache()
+};
+
+static SAnimCacheEntry		sp_anim_cache[vMAX_CACHED_ANIMS];
+static uint32				s_budget = vDEFAULT_ANIM_CACHE_BUDGET;
+static uint32				s_bytes_used = 0;
+static std::atomic<uint32>	s_hits( 0 );
+static std::atomic<uint32>	s_misses( 0 );
+static uint32				s_decompressions = 0;
+static uint32				s_evictions = 0;
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_evict( SAnimCacheEntry* p_entry )
+{
+	if ( p_entry->mpKeys )
+	{
+		s_bytes_used -= p_entry->mpKeys->size;
+		s_evictions++;
+		Mem::Free( p_entry->mpKeys );
+		p_entry->mpKeys = NULL;
+	}
+	p_entry->mpFrameData = NULL;
+
+	if ( p_entry->mRefCount == 0 )
+	{
+		p_entry->mAnimName = 0;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The decompressed entry used longest ago, out of those last used before the given frame
+static SAnimCacheEntry* s_find_lru( uint32 beforeFrame )
+{
+	SAnimCacheEntry* p_lru = NULL;
+	for ( int i = 0; i < vMAX_CACHED_ANIMS; i++ )
+	{
+		SAnimCacheEntry* p_entry = &sp_anim_cache[i];
+		if ( p_entry->mpKeys && p_entry->mLastUsed < beforeFrame && ( !p_lru || p_entry->mLastUsed < p_lru->mLastUsed ) )
+		{
+			p_lru = p_entry;
+		}
+	}
+	return p_lru;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Evicts until there's room, but never anything used this frame, which would only have
+// to be decompressed again
+static bool s_make_room( uint32 size, uint32 frame )
+{
+	while ( s_bytes_used + size > s_budget )
+	{
+		SAnimCacheEntry* p_lru = s_find_lru( frame );
+		if ( !p_lru )
+		{
+			return false;
+		}
+		s_evict( p_lru );
+	}
+	return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Stub versions of all platform specific functions are provided here:
 // so engine implementors can leave certain functionality until later
@@ -57,4 +155,312 @@ Gfx::CBonedAnimFrameData* GetCachedAnim( uint32 animChecksum, bool assertOnFail
 /*                                                                */
 /******************************************************************/
 
+int AcquireAnimCacheEntry( uint32 animChecksum )
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "Anim cache entries must be acquired on the main thread" ) );
+
+	if ( animChecksum == 0 )
+	{
+		return -1;
+	}
+
+	int free_entry = -1;
+	int unused_entry = -1;
+	for ( int i = 0; i < vMAX_CACHED_ANIMS; i++ )
+	{
+		SAnimCacheEntry* p_entry = &sp_anim_cache[i];
+		if ( p_entry->mAnimName == animChecksum )
+		{
+			p_entry->mRefCount++;
+			return i;
+		}
+		if ( p_entry->mAnimName == 0 )
+		{
+			free_entry = ( free_entry < 0 ) ? i : free_entry;
+		}
+		else if ( p_entry->mRefCount == 0 )
+		{
+			// nobody's playing it, but it's decompressed; the least recently used of those can go
+			if ( unused_entry < 0 || p_entry->mLastUsed < sp_anim_cache[unused_entry].mLastUsed )
+			{
+				unused_entry = i;
+			}
+		}
+	}
+
+	if ( free_entry < 0 )
+	{
+		if ( unused_entry < 0 )
+		{
+			return -1;
+		}
+		s_evict( &sp_anim_cache[unused_entry] );
+		free_entry = unused_entry;
+	}
+
+	SAnimCacheEntry* p_entry = &sp_anim_cache[free_entry];
+	p_entry->mAnimName = animChecksum;
+	p_entry->mRefCount = 1;
+	p_entry->mpFrameData = NULL;
+	p_entry->mpKeys = NULL;
+	p_entry->mLastUsed = 0;
+	p_entry->mSize = 0;
+	p_entry->mUncompressable = false;
+	p_entry->mUses = 0;
+	return free_entry;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void ReleaseAnimCacheEntry( int entry )
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "Anim cache entries must be released on the main thread" ) );
+
+	if ( entry < 0 )
+	{
+		return;
+	}
+
+	SAnimCacheEntry* p_entry = &sp_anim_cache[entry];
+	Dbg_MsgAssert( p_entry->mRefCount > 0, ( "Anim cache entry %d released too many times", entry ) );
+	p_entry->mRefCount--;
+
+	// Keep the decompressed keys until they're evicted, in case it's played again
+	if ( p_entry->mRefCount == 0 && !p_entry->mpKeys )
+	{
+		p_entry->mAnimName = 0;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+const Gfx::SDecompressedKeys* GetDecompressedAnim( int entry, Gfx::CBonedAnimFrameData* pFrameData )
+{
+	if ( entry < 0 )
+	{
+		return NULL;
+	}
+
+	SAnimCacheEntry* p_entry = &sp_anim_cache[entry];
+	p_entry->mUses.fetch_add( 1, std::memory_order_relaxed );
+
+	if ( p_entry->mpKeys && p_entry->mpFrameData == pFrameData )
+	{
+		s_hits.fetch_add( 1, std::memory_order_relaxed );
+		return p_entry->mpKeys;
+	}
+
+	s_misses.fetch_add( 1, std::memory_order_relaxed );
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void ForgetDecompressedAnim( Gfx::CBonedAnimFrameData* pFrameData )
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "Anims must be unloaded on the main thread" ) );
+
+	for ( int i = 0; i < vMAX_CACHED_ANIMS; i++ )
+	{
+		SAnimCacheEntry* p_entry = &sp_anim_cache[i];
+		if ( p_entry->mAnimName && p_entry->mpFrameData == pFrameData )
+		{
+			s_evict( p_entry );
+
+			// whatever replaces it gets another look
+			p_entry->mSize = 0;
+			p_entry->mUncompressable = false;
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void UpdateAnimCache()
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "The anim cache must be updated on the main thread" ) );
+
+	uint32 frame = (uint32)Tmr::GetRenderFrame();
+
+	// The most used anims that aren't decompressed yet, most used first
+	SAnimCacheEntry* p_hot[vMAX_DECOMPRESS_PER_FRAME];
+	uint32 hot_uses[vMAX_DECOMPRESS_PER_FRAME];
+	int num_hot = 0;
+
+	for ( int i = 0; i < vMAX_CACHED_ANIMS; i++ )
+	{
+		SAnimCacheEntry* p_entry = &sp_anim_cache[i];
+		uint32 uses = p_entry->mUses.exchange( 0, std::memory_order_relaxed );
+		if ( !p_entry->mAnimName || !uses )
+		{
+			continue;
+		}
+		p_entry->mLastUsed = frame;
+
+		if ( p_entry->mpKeys || p_entry->mUncompressable )
+		{
+			continue;
+		}
+
+		int slot = num_hot;
+		while ( slot > 0 && hot_uses[slot - 1] < uses )
+		{
+			if ( slot < vMAX_DECOMPRESS_PER_FRAME )
+			{
+				p_hot[slot] = p_hot[slot - 1];
+				hot_uses[slot] = hot_uses[slot - 1];
+			}
+			slot--;
+		}
+		if ( slot < vMAX_DECOMPRESS_PER_FRAME )
+		{
+			p_hot[slot] = p_entry;
+			hot_uses[slot] = uses;
+			num_hot = ( num_hot < vMAX_DECOMPRESS_PER_FRAME ) ? num_hot + 1 : num_hot;
+		}
+	}
+
+	// In case the budget was lowered
+	while ( s_bytes_used > s_budget )
+	{
+		SAnimCacheEntry* p_lru = s_find_lru( frame + 1 );
+		if ( !p_lru )
+		{
+			break;
+		}
+		s_evict( p_lru );
+	}
+
+	if ( s_budget == 0 )
+	{
+		return;
+	}
+
+	for ( int h = 0; h < num_hot; h++ )
+	{
+		SAnimCacheEntry* p_entry = p_hot[h];
+
+		Gfx::CBonedAnimFrameData* p_frame_data = GetCachedAnim( p_entry->mAnimName, false );
+		if ( !p_frame_data || !p_frame_data->LoadFinished() )
+		{
+			continue;
+		}
+
+		// Don't decompress it again just to find it still doesn't fit
+		if ( p_entry->mSize && !s_make_room( p_entry->mSize, frame ) )
+		{
+			continue;
+		}
+
+		Gfx::SDecompressedKeys* p_keys = p_frame_data->Decompress();
+		if ( !p_keys )
+		{
+			p_entry->mpFrameData = p_frame_data;
+			p_entry->mUncompressable = true;
+			continue;
+		}
+
+		p_entry->mSize = p_keys->size;
+		if ( !s_make_room( p_keys->size, frame ) )
+		{
+			Mem::Free( p_keys );
+			continue;
+		}
+
+		p_entry->mpFrameData = p_frame_data;
+		p_entry->mpKeys = p_keys;
+		s_bytes_used += p_keys->size;
+		s_decompressions++;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void SetAnimCacheBudget( uint32 bytes )
+{
+	s_budget = bytes;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetAnimCacheBudget | Sets how much memory the anim cache can use for the
+// decompressed keys of the most played anims.  The least recently used are thrown away
+// at the end of the next update if it's now over.  0 turns the decompressing off.
+// @parm int | kilobytes | the budget
+bool ScriptSetAnimCacheBudget( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	int kilobytes = 0;
+	pParams->GetInteger( CRCD(0xca6b6075,"kilobytes"), &kilobytes, Script::ASSERT );
+	Dbg_MsgAssert( kilobytes >= 0, ( "SetAnimCacheBudget needs a budget of 0 or more" ) );
+
+	SetAnimCacheBudget( (uint32)kilobytes * 1024 );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | PrintAnimCacheStats | Prints how many anim evaluations found their keys
+// decompressed (hits) and how many had to walk the compressed keys (misses), how many
+// anims are decompressed and how much memory they take.  Also returns them as hits,
+// misses, decompressed and bytes.
+// @flag reset | start counting the hits and misses again
+bool ScriptPrintAnimCacheStats( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	uint32 hits = s_hits.load( std::memory_order_relaxed );
+	uint32 misses = s_misses.load( std::memory_order_relaxed );
+
+	int num_entries = 0;
+	int num_decompressed = 0;
+	for ( int i = 0; i < vMAX_CACHED_ANIMS; i++ )
+	{
+		num_entries += sp_anim_cache[i].mAnimName ? 1 : 0;
+		num_decompressed += sp_anim_cache[i].mpKeys ? 1 : 0;
+	}
+
+	float hit_rate = ( hits + misses ) ? ( 100.0f * hits / ( hits + misses ) ) : 0.0f;
+	printf( "AnimCache: %d hits, %d misses (%.1f%%), %d of %d anims decompressed, %d of %d bytes, %d decompressions, %d evictions\n",
+			hits, misses, hit_rate, num_decompressed, num_entries, s_bytes_used, s_budget, s_decompressions, s_evictions );
+
+	pScript->GetParams()->AddInteger( CRCD(0xe57093d4,"hits"), (int)hits );
+	pScript->GetParams()->AddInteger( CRCD(0x90ce31fb,"misses"), (int)misses );
+	pScript->GetParams()->AddInteger( CRCD(0xfa2177f5,"decompressed"), num_decompressed );
+	pScript->GetParams()->AddInteger( CRCD(0x4e66bc31,"bytes"), (int)s_bytes_used );
+
+	if ( pParams->ContainsFlag( CRCD(0xaf6240b2,"reset") ) )
+	{
+		s_hits = 0;
+		s_misses = 0;
+		s_decompressions = 0;
+		s_evictions = 0;
+	}
+
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 } // Nx
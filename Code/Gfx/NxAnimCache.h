@@ -14,6 +14,13 @@
 namespace Gfx
 {
 	class CBonedAnimFrameData;
+	struct SDecompressedKeys;
+};
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
 };
 
 namespace Nx
@@ -21,6 +28,34 @@ namespace Nx
 
 Gfx::CBonedAnimFrameData* GetCachedAnim( uint32 animChecksum, bool assertOnFail = true );
 
+// The compressed keys of every loaded anim stay resident.  The anims played the most
+// (the idles, pushes and grind loops everyone is playing) also get their keys
+// decompressed, once, into arrays that every quick anim playing them reads from.
+// Those copies are thrown away least recently used first, to keep them all under a
+// budget in bytes.
+//
+// Each quick anim holds a reference to the entry for its anim, from AcquireAnimCacheEntry(),
+// and asks for the decompressed keys every time it's evaluated, which may be on a job;
+// that's what counts as a use, and as a hit or a miss.  Decompressing allocates, so it's
+// only done in UpdateAnimCache(), on the main thread once a frame, for the anims used most
+// since the last one.
+
+// Main thread only.  Returns -1 if the table is full, which just means no caching.
+int								AcquireAnimCacheEntry( uint32 animChecksum );
+void							ReleaseAnimCacheEntry( int entry );
+
+// NULL if the entry's anim isn't decompressed, or was decompressed from other frame data
+const Gfx::SDecompressedKeys*	GetDecompressedAnim( int entry, Gfx::CBonedAnimFrameData* pFrameData );
+
+// When the frame data is destroyed
+void							ForgetDecompressedAnim( Gfx::CBonedAnimFrameData* pFrameData );
+
+void							UpdateAnimCache();
+void							SetAnimCacheBudget( uint32 bytes );
+
+bool							ScriptSetAnimCacheBudget( Script::CStruct* pParams, Script::CScript* pScript );
+bool							ScriptPrintAnimCacheStats( Script::CStruct* pParams, Script::CScript* pScript );
+
 }
 
 #endif // __GFX_NXANIMCACHE_H__
@@ -8,6 +8,7 @@
 #include <core/math.h>
 
 #include <gfx/nxgeom.h>
+#include <gfx/nxskinning.h>
 #include <gfx/image/imagebasic.h>
 
 #include <gel/collision/colltridata.h>
@@ -63,6 +64,17 @@ bool			CGeom::plat_load_geom_data(CMesh* pMesh, CModel* pModel, bool color_per_m
 /*                                                                */
 /******************************************************************/
 
+// Not a stub that prints; the platforms that leave skinning to the GPU have no skin mesh
+SSkinMesh *		CGeom::plat_get_skin_mesh()
+{
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 void			CGeom::plat_finalize()
 {
 	// do nothing...  this is only needed for the PS2 right now
@@ -523,6 +535,11 @@ CGeom::CGeom()
 	mp_coll_tri_data = NULL;
 	mp_orig_render_colors = NULL;
 	m_multipleColorsEnabled = false;
+	mp_skin_mesh = NULL;
+	mp_skinned_verts = NULL;
+	mp_skinned_normals = NULL;
+	mp_skinned_bbox = NULL;
+	m_skinned = false;
 }
 
 /******************************************************************/
@@ -545,6 +562,8 @@ CGeom::~CGeom()
 	{
 		delete mp_orig_render_colors;
 	}
+
+	SetSkinMesh(NULL);
 }
 
 /******************************************************************/
@@ -583,6 +602,7 @@ CGeom*  CGeom::Clone(bool instance, CScene* pDestScene)
 		}
 		// Mick:  bit of a patch - attempt to fix crash from deleting thigns twice
 		p_new_geom->mp_orig_render_colors = NULL;
+		p_new_geom->clone_skinning(this);
 	}
 
 	return p_new_geom;
@@ -606,6 +626,7 @@ CGeom* CGeom::Clone(bool instance, CModel* pDestModel)
 
 		// Mick:  bit of a patch - attempt to fix crash from deleting thigns twice
 		p_new_geom->mp_orig_render_colors = NULL;
+		p_new_geom->clone_skinning(this);
 	}
 
 	return p_new_geom;
@@ -622,7 +643,17 @@ bool CGeom::LoadGeomData( CMesh* pMesh, CModel* pModel, bool color_per_material
 	m_cloned = vINSTANCE;
 	m_multipleColorsEnabled = color_per_material;
 
-	return plat_load_geom_data( pMesh, pModel, color_per_material );
+	if ( !plat_load_geom_data( pMesh, pModel, color_per_material ) )
+	{
+		return false;
+	}
+
+	// The platform geom builds its skin mesh, if it has one, from the verts, bone
+	// indices and weights it has just loaded, and keeps it for as long as it lives
+#ifdef USE_CPU_SKINNING
+	SetSkinMesh( plat_get_skin_mesh() );
+#endif
+	return true;
 }
 
 /******************************************************************/
@@ -872,6 +903,14 @@ void CGeom::SetModelLights(CModelLights *p_model_lights)
 
 bool CGeom::Render( Mth::Matrix* pMatrix, Mth::Matrix* ppBoneMatrices, int numBones )
 {
+#ifdef USE_CPU_SKINNING
+	if ( mp_skin_mesh && ppBoneMatrices && numBones && SoftwareSkinningEnabled() )
+	{
+		SkinMesh( mp_skin_mesh, ppBoneMatrices, numBones, mp_skinned_verts, mp_skinned_normals, mp_skinned_bbox );
+		m_skinned = true;
+	}
+#endif
+
 	return plat_render( pMatrix, ppBoneMatrices, numBones );
 }
 
@@ -1013,6 +1052,94 @@ void CGeom::SetRenderColors(Image::RGBA *p_colors)				// - sets the colors after
 		return plat_set_render_colors(p_colors);
 }
 
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CGeom::SetSkinMesh(SSkinMesh *p_mesh)
+{
+	delete [] mp_skinned_verts;
+	delete [] mp_skinned_normals;
+	delete mp_skinned_bbox;
+	mp_skinned_verts = NULL;
+	mp_skinned_normals = NULL;
+	mp_skinned_bbox = NULL;
+	m_skinned = false;
+
+	mp_skin_mesh = p_mesh;
+	if (p_mesh)
+	{
+		Dbg_MsgAssert(p_mesh->mNumVerts > 0, ("Skin mesh has no verts"));
+		mp_skinned_verts = new Mth::Vector[p_mesh->mNumVerts];
+		if (p_mesh->mpNormals)
+		{
+			mp_skinned_normals = new Mth::Vector[p_mesh->mNumVerts];
+		}
+		mp_skinned_bbox = new Mth::CBBox;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+const SSkinMesh * CGeom::GetSkinMesh() const
+{
+	return mp_skin_mesh;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+const Mth::Vector * CGeom::GetSkinnedVerts() const
+{
+	return m_skinned ? mp_skinned_verts : NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+const Mth::Vector * CGeom::GetSkinnedNormals() const
+{
+	return m_skinned ? mp_skinned_normals : NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool CGeom::GetSkinnedBoundingBox(Mth::CBBox *p_bbox) const
+{
+	if (!m_skinned)
+	{
+		return false;
+	}
+
+	*p_bbox = *mp_skinned_bbox;
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The platform clone may have copied the pointers, so give the clone its own buffers
+void CGeom::clone_skinning(const CGeom *p_source)
+{
+	mp_skinned_verts = NULL;
+	mp_skinned_normals = NULL;
+	mp_skinned_bbox = NULL;
+	SetSkinMesh(p_source->mp_skin_mesh);
+}
+
 
 /******************************************************************/
 /*                                                                */
@@ -39,6 +39,7 @@ namespace Nx
 	class CModel;
 	class CModelLights;
 	class CCollObjTriData;
+	struct SSkinMesh;
 
 class CGeom : public Spt::Class
 {
@@ -115,6 +116,14 @@ public:
 	void 				SetRenderVerts(Mth::Vector *p_verts);				// - sets the verts after modification
 	void 				SetRenderColors(Image::RGBA *p_colors);				// - sets the colors after modification
 
+// Skinning on the CPU (see nxskinning.h), for the platforms that hand over their skin mesh
+// from plat_get_skin_mesh() when the geom is loaded
+	void				SetSkinMesh(SSkinMesh *p_mesh);						// - the geom doesn't own it; NULL to stop skinning
+	const SSkinMesh *	GetSkinMesh() const;
+	const Mth::Vector *	GetSkinnedVerts() const;							// - model space, as of the last Render(), or NULL
+	const Mth::Vector *	GetSkinnedNormals() const;
+	bool				GetSkinnedBoundingBox(Mth::CBBox *p_bbox) const;	// - false if it hasn't been skinned yet
+
 	// Wibble functions
 	void				SetUVWibbleParams(float u_vel, float u_amp, float u_freq, float u_phase,
 										  float v_vel, float v_amp, float v_freq, float v_phase);
@@ -139,6 +148,14 @@ protected:
 	Image::RGBA		*	mp_orig_render_colors;
 	bool				m_multipleColorsEnabled;
 
+	SSkinMesh		*	mp_skin_mesh;
+	Mth::Vector		*	mp_skinned_verts;
+	Mth::Vector		*	mp_skinned_normals;
+	Mth::CBBox		*	mp_skinned_bbox;
+	bool				m_skinned;
+
+	void				clone_skinning(const CGeom *p_source);
+
 private:
     // The virtual functions will have a stub implementation
     // in p_nxgeom.cpp
@@ -146,6 +163,7 @@ private:
 	virtual CGeom *		plat_clone(bool instance, CModel* pDestModel);
 
 	virtual	bool		plat_load_geom_data(CMesh* pMesh, CModel* pModel, bool color_per_material);
+	virtual	SSkinMesh *	plat_get_skin_mesh();								// - once the geom data is loaded; NULL if it has none
 
 	virtual void		plat_finalize();
 
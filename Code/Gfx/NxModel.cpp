@@ -23,6 +23,7 @@
 #include <gfx/nx.h>
 #include <gfx/nxgeom.h>
 #include <gfx/nxmesh.h>
+#include <gfx/nxskinning.h>
 #include <gfx/nxlight.h>
 #include <gfx/nxtexman.h>
 #include <gfx/skeleton.h>
@@ -336,12 +337,41 @@ bool CModel::Render( Mth::Matrix* pMatrix, bool no_anim, Gfx::CSkeleton* pSkelet
 				}
 				else
 				{
+					// the animation job phase may not have got to this one yet
+					pSkeleton->ResolvePendingPose();
+					
  					// update both root position AND bones
 					for ( int i = 0; i < numGeoms; i++ )
 					{
 						Dbg_Assert( GetGeomByIndex(i) );
 						GetGeomByIndex(i)->Render( pMatrix, pSkeleton->GetMatrices(), pSkeleton->GetNumBones() );
 					}	
+
+#ifdef USE_CPU_SKINNING
+					// if the geoms were skinned on the CPU, fit the bounding sphere
+					// to this pose rather than the one the model was exported in
+					Mth::CBBox skinned_bbox;
+					bool skinned = false;
+					for ( int i = 0; i < numGeoms; i++ )
+					{
+						Mth::CBBox geom_bbox;
+						if ( GetGeomByIndex(i)->GetSkinnedBoundingBox( &geom_bbox ) )
+						{
+							skinned_bbox.AddPoint( geom_bbox.GetMin() );
+							skinned_bbox.AddPoint( geom_bbox.GetMax() );
+							skinned = true;
+							
+							DisplaySkinnedGeom( GetGeomByIndex(i), pMatrix );
+						}
+					}
+					if ( skinned )
+					{
+						Mth::Vector half = ( skinned_bbox.GetMax() - skinned_bbox.GetMin() ) * 0.5f;
+						m_boundingSphere = skinned_bbox.GetMin() + half;
+						m_boundingSphere[W] = half.Length();
+						m_boundingSphereCached = true;
+					}
+#endif
 				}
 			}
 			else
@@ -37,6 +37,8 @@ namespace Nx
 **								 Private Data								**
 *****************************************************************************/
 
+uint32 CQuickAnim::s_invalidate_count = 0;
+
 /*****************************************************************************
 **								 Public Data								**
 *****************************************************************************/
@@ -221,7 +223,7 @@ inline void interpolate_t_frame(Mth::Vector* p_out, Gfx::CAnimTKey* p_in1, Gfx::
 /*                                                                */
 /******************************************************************/
 	
-void CQuickAnim::plat_get_interpolated_frames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time )
+void CQuickAnim::plat_get_interpolated_frames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time, Gfx::EAnimQuality quality )
 {
 	Dbg_MsgAssert( mp_frameData, ( "No pointer to frame data" ) );
 
@@ -292,6 +294,8 @@ void CQuickAnim::plat_get_interpolated_frames( Mth::Quat* pRotations, Mth::Vecto
 
 	m_quickAnimPointers.pSkipList	= pSkipList;
 	m_quickAnimPointers.skipIndex	= skipIndex;
+	m_quickAnimPointers.quality		= quality;
+	m_quickAnimPointers.pDecompressed = mp_frameData->UsesCompressTable() ? GetDecompressedAnim( m_animCacheEntry, mp_frameData ) : NULL;
 	
 	Dbg_MsgAssert( mp_frameData, ( "No frame data" ) );
 	mp_frameData->GetInterpolatedFrames(pRotations, pTranslations, time, this);
@@ -317,6 +321,12 @@ CQuickAnim::CQuickAnim()
 {
 	mp_frameData = NULL;
 	m_quickAnimPointers.valid = false;
+	m_quickAnimPointers.quality = Gfx::ANIM_QUALITY_NLERP;
+	m_quickAnimPointers.pDecompressed = NULL;
+	m_invalidateCount = s_invalidate_count;
+	m_animAssetName = 0;
+	m_animCacheEntry = -1;
+	m_customKeyCursor = 0;
 }
 
 /******************************************************************/
@@ -326,6 +336,7 @@ CQuickAnim::CQuickAnim()
 	
 CQuickAnim::~CQuickAnim()
 {
+	ReleaseAnimCacheEntry( m_animCacheEntry );
 }
 
 /******************************************************************/
@@ -349,8 +360,38 @@ void CQuickAnim::Enable( bool enabled )
 /*                                                                */
 /******************************************************************/
 
+void CQuickAnim::sInvalidateCaches()
+{
+	s_invalidate_count++;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CQuickAnim::check_invalidated()
+{
+	if ( m_invalidateCount != s_invalidate_count )
+	{
+		m_quickAnimPointers.valid = false;
+		m_invalidateCount = s_invalidate_count;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 void CQuickAnim::SetAnimAssetName( uint32 animAssetName )
 {
+	if ( animAssetName != m_animAssetName || m_animCacheEntry < 0 )
+	{
+		ReleaseAnimCacheEntry( m_animCacheEntry );
+		m_animCacheEntry = AcquireAnimCacheEntry( animAssetName );
+	}
+
 	m_animAssetName = animAssetName;
 	
 	// set the pointer to the animation
@@ -375,9 +416,11 @@ void CQuickAnim::SetAnimAssetName( uint32 animAssetName )
 /*                                                                */
 /******************************************************************/
 	
-void CQuickAnim::GetInterpolatedFrames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time )
+void CQuickAnim::GetInterpolatedFrames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time, Gfx::EAnimQuality quality )
 {
-	plat_get_interpolated_frames( pRotations, pTranslations, pSkipList, skipIndex, time );
+	check_invalidated();
+
+	plat_get_interpolated_frames( pRotations, pTranslations, pSkipList, skipIndex, time, quality );
 }
 
 /******************************************************************/
@@ -389,6 +432,8 @@ void CQuickAnim::GetInterpolatedHiResFrames( Mth::Quat* pRotations, Mth::Vector*
 {
 	Dbg_MsgAssert( mp_frameData, ( "No pointer to frame data" ) );
 
+	check_invalidated();
+
 	mp_frameData->GetInterpolatedCameraFrames(pRotations, pTranslations, time, this);
 	
 	m_quickAnimPointers.valid = true;
@@ -452,7 +497,7 @@ bool CQuickAnim::ProcessCustomKeys( float startTimeInclusive, float endTimeInclu
 	Dbg_MsgAssert( mp_frameData, ( "No pointer to frame data" ) );
 
 	bool inclusive = true;
-	return mp_frameData->ProcessCustomKeys( startTimeInclusive, endTimeInclusive, pObject, inclusive );
+	return mp_frameData->ProcessCustomKeys( startTimeInclusive, endTimeInclusive, pObject, inclusive, &m_customKeyCursor );
 }
 
 /******************************************************************/
@@ -65,7 +65,8 @@ public:
 
 public:
 	void						SetAnimAssetName( uint32 animAssetName );
-	void						GetInterpolatedFrames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time );
+	uint32						GetAnimAssetName() const { return m_animAssetName; }
+	void						GetInterpolatedFrames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time, Gfx::EAnimQuality quality = Gfx::ANIM_QUALITY_NLERP );
 	void						GetInterpolatedHiResFrames( Mth::Quat* pRotations, Mth::Vector* pTranslations, float time );
 	void						Enable(bool enabled);
 	int							GetNumBones();
@@ -74,13 +75,23 @@ public:
 	uint32						GetBoneName( int i );
 	bool						ProcessCustomKeys( float startTimeInclusive, float endTimeExclusive, Obj::CObject* pObject );
 
+	// Call after rebuilding an anim in place, so every quick anim drops its cached key pointers
+	static void					sInvalidateCaches();
+
 private:
     // The virtual functions will have a stub implementation in p_nxquickanim.cpp
-	virtual	void				plat_get_interpolated_frames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time );
+	virtual	void				plat_get_interpolated_frames( Mth::Quat* pRotations, Mth::Vector* pTranslations, uint32* pSkipList, uint32 skipIndex, float time, Gfx::EAnimQuality quality );
+
+	void						check_invalidated();
 
 protected:
 	Gfx::CBonedAnimFrameData*	mp_frameData;
 	uint32						m_animAssetName;
+	uint32						m_invalidateCount;
+	int							m_animCacheEntry;		// in the anim cache, for the shared decompressed keys
+	int							m_customKeyCursor;		// where the last custom keys were found
+
+	static uint32				s_invalidate_count;
 
 public:
 	Gfx::SQuickAnimPointers		m_quickAnimPointers;
@@ -0,0 +1,683 @@
+//****************************************************************************
+//* MODULE:         Gfx
+//* FILENAME:       NxSkinning.cpp
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#include <gfx/nxskinning.h>
+
+#ifdef USE_CPU_SKINNING
+
+#include <float.h>
+#include <math.h>
+
+#include <gel/object/compositeobject.h>
+#include <gel/object/compositeobjectmanager.h>
+#include <gel/components/modelcomponent.h>
+#include <gel/components/skeletoncomponent.h>
+
+#include <gel/scripting/checksum.h>
+#include <gel/scripting/script.h>
+#include <gel/scripting/struct.h>
+
+#include <gfx/debuggfx.h>
+#include <gfx/nxgeom.h>
+#include <gfx/nxmodel.h>
+#include <gfx/pose.h>
+#include <gfx/skeleton.h>
+
+#include <core/thread/jobsystem.h>
+#include <sys/trace.h>
+
+// GCC and clang can build the AVX2 kernel whatever the target, and it's only used if the
+// CPU turns out to have AVX2
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ))
+#define __AVX2_SKINNING__
+#define AVX2_TARGET __attribute__(( target( "avx2,fma" )))
+#include <immintrin.h>
+#elif defined( __AVX2__ )
+#define __AVX2_SKINNING__
+#define AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace Nx
+{
+
+/*****************************************************************************
+**							   Private Functions							**
+*****************************************************************************/
+
+enum
+{
+	vSKIN_BATCH_SIZE = 512,					// verts
+	vPALETTE_SIZE = 12,						// floats per bone: right, up, at and pos
+};
+
+struct alignas( 64 ) SSkinBounds
+{
+	float					mMin[3];
+	float					mMax[3];
+};
+
+struct SSkinJob
+{
+	const SSkinMesh*		mpMesh;
+	Mth::Vector*			mpPositions;
+	Mth::Vector*			mpNormals;
+	int						mMaxBone;
+	alignas( 32 ) float		mPalette[Gfx::vMAX_BONES][vPALETTE_SIZE];
+	SSkinBounds				mBounds[Job::MAX_THREADS];		// each thread only touches its own
+};
+
+#if defined( __PLAT_NGPS__ ) || defined( __PLAT_NGC__ ) || defined( __PLAT_XBOX__ ) \
+ || defined( USE_VULKAN_RENDERER ) || defined( USE_OPENGL_RENDERER ) || defined( USE_DIRECTX_RENDERER )
+static bool s_software_skinning = false;
+#else
+// nothing else is going to skin the models
+static bool s_software_skinning = true;
+#endif
+
+static bool s_display_skinning = false;
+
+// for the benchmark
+static bool s_simd_skinning = true;
+static bool s_threaded_skinning = true;
+
+static inline void s_add_bounds( SSkinBounds* p_bounds, float x, float y, float z )
+{
+	p_bounds->mMin[0] = ( x < p_bounds->mMin[0] ) ? x : p_bounds->mMin[0];
+	p_bounds->mMin[1] = ( y < p_bounds->mMin[1] ) ? y : p_bounds->mMin[1];
+	p_bounds->mMin[2] = ( z < p_bounds->mMin[2] ) ? z : p_bounds->mMin[2];
+	p_bounds->mMax[0] = ( x > p_bounds->mMax[0] ) ? x : p_bounds->mMax[0];
+	p_bounds->mMax[1] = ( y > p_bounds->mMax[1] ) ? y : p_bounds->mMax[1];
+	p_bounds->mMax[2] = ( z > p_bounds->mMax[2] ) ? z : p_bounds->mMax[2];
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// One vert at a time; also does the ones left over by the AVX2 kernel
+static void s_skin_scalar( SSkinJob* p_job, int begin, int end, SSkinBounds* p_bounds )
+{
+	const SSkinMesh* p_mesh = p_job->mpMesh;
+
+	for ( int v = begin; v < end; v++ )
+	{
+		float m[vPALETTE_SIZE];
+		for ( int k = 0; k < vPALETTE_SIZE; k++ )
+		{
+			m[k] = 0.0f;
+		}
+
+		for ( int j = 0; j < 4; j++ )
+		{
+			float weight = p_mesh->mpWeights[v * 4 + j];
+			if ( weight == 0.0f )
+			{
+				continue;
+			}
+
+			int bone = p_mesh->mpBoneIndices[v * 4 + j];
+			bone = ( bone > p_job->mMaxBone ) ? p_job->mMaxBone : bone;
+
+			const float* p_matrix = p_job->mPalette[bone];
+			for ( int k = 0; k < vPALETTE_SIZE; k++ )
+			{
+				m[k] += weight * p_matrix[k];
+			}
+		}
+
+		const Mth::Vector& pos = p_mesh->mpPositions[v];
+		float x = pos[X] * m[0] + pos[Y] * m[3] + pos[Z] * m[6] + m[9];
+		float y = pos[X] * m[1] + pos[Y] * m[4] + pos[Z] * m[7] + m[10];
+		float z = pos[X] * m[2] + pos[Y] * m[5] + pos[Z] * m[8] + m[11];
+		p_job->mpPositions[v].Set( x, y, z, 1.0f );
+		s_add_bounds( p_bounds, x, y, z );
+
+		if ( p_job->mpNormals )
+		{
+			const Mth::Vector& normal = p_mesh->mpNormals[v];
+			float nx = normal[X] * m[0] + normal[Y] * m[3] + normal[Z] * m[6];
+			float ny = normal[X] * m[1] + normal[Y] * m[4] + normal[Z] * m[7];
+			float nz = normal[X] * m[2] + normal[Y] * m[5] + normal[Z] * m[8];
+			float len_sqr = nx * nx + ny * ny + nz * nz;
+			float scale = ( len_sqr > 0.0f ) ? 1.0f / sqrtf( len_sqr ) : 0.0f;
+			p_job->mpNormals[v].Set( nx * scale, ny * scale, nz * scale, 0.0f );
+		}
+	}
+}
+
+#ifdef __AVX2_SKINNING__
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static bool s_has_avx2()
+{
+#ifdef __GNUC__
+	static int s_has = -1;
+	if ( s_has < 0 )
+	{
+		s_has = ( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" )) ? 1 : 0;
+	}
+	return s_has != 0;
+#else
+	return true;
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+AVX2_TARGET static inline float s_reduce_min( __m256 v )
+{
+	__m128 m = _mm_min_ps( _mm256_castps256_ps128( v ), _mm256_extractf128_ps( v, 1 ));
+	m = _mm_min_ps( m, _mm_movehl_ps( m, m ));
+	m = _mm_min_ss( m, _mm_shuffle_ps( m, m, 1 ));
+	return _mm_cvtss_f32( m );
+}
+
+AVX2_TARGET static inline float s_reduce_max( __m256 v )
+{
+	__m128 m = _mm_max_ps( _mm256_castps256_ps128( v ), _mm256_extractf128_ps( v, 1 ));
+	m = _mm_max_ps( m, _mm_movehl_ps( m, m ));
+	m = _mm_max_ss( m, _mm_shuffle_ps( m, m, 1 ));
+	return _mm_cvtss_f32( m );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Eight verts at a time, one per lane.  Each lane blends its own four matrices out of
+// the palette with gathers, skipping the influences no lane uses, then transforms.
+AVX2_TARGET static void s_skin_avx2( SSkinJob* p_job, int begin, int end, SSkinBounds* p_bounds )
+{
+	const SSkinMesh* p_mesh = p_job->mpMesh;
+	const float* p_palette = &p_job->mPalette[0][0];
+	const float* p_positions = (const float*)p_mesh->mpPositions;
+	const float* p_normals = (const float*)p_mesh->mpNormals;
+	const float* p_weights = p_mesh->mpWeights;
+
+	const __m256i lanes = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+	const __m256i byte_mask = _mm256_set1_epi32( 0xff );
+	const __m256i max_bone = _mm256_set1_epi32( p_job->mMaxBone );
+	const __m256i palette_size = _mm256_set1_epi32( vPALETTE_SIZE );
+	const __m256 zero = _mm256_setzero_ps();
+
+	__m256 min_x = _mm256_set1_ps( FLT_MAX );
+	__m256 min_y = min_x;
+	__m256 min_z = min_x;
+	__m256 max_x = _mm256_set1_ps( -FLT_MAX );
+	__m256 max_y = max_x;
+	__m256 max_z = max_x;
+
+	alignas( 32 ) float out[6][8];
+
+	int v = begin;
+	for ( ; v + 8 <= end; v += 8 )
+	{
+		// Vectors and the weights are both four floats per vert
+		__m256i vert4 = _mm256_slli_epi32( _mm256_add_epi32( _mm256_set1_epi32( v ), lanes ), 2 );
+		__m256i bones = _mm256_loadu_si256( (const __m256i*)( p_mesh->mpBoneIndices + v * 4 ));
+
+		__m256 m[vPALETTE_SIZE];
+		for ( int k = 0; k < vPALETTE_SIZE; k++ )
+		{
+			m[k] = zero;
+		}
+
+		for ( int j = 0; j < 4; j++ )
+		{
+			__m256 weight = _mm256_i32gather_ps( p_weights + j, vert4, 4 );
+			__m256 used = _mm256_cmp_ps( weight, zero, _CMP_NEQ_OQ );
+			if ( !_mm256_movemask_ps( used ))
+			{
+				continue;
+			}
+
+			__m256i bone = _mm256_and_si256( _mm256_srlv_epi32( bones, _mm256_set1_epi32( j * 8 )), byte_mask );
+			bone = _mm256_min_epu32( bone, max_bone );
+			__m256i base = _mm256_mullo_epi32( bone, palette_size );
+			for ( int k = 0; k < vPALETTE_SIZE; k++ )
+			{
+				__m256 entry = _mm256_mask_i32gather_ps( zero, p_palette + k, base, used, 4 );
+				m[k] = _mm256_fmadd_ps( weight, entry, m[k] );
+			}
+		}
+
+		__m256 x = _mm256_i32gather_ps( p_positions, vert4, 4 );
+		__m256 y = _mm256_i32gather_ps( p_positions + 1, vert4, 4 );
+		__m256 z = _mm256_i32gather_ps( p_positions + 2, vert4, 4 );
+		__m256 px = _mm256_fmadd_ps( x, m[0], _mm256_fmadd_ps( y, m[3], _mm256_fmadd_ps( z, m[6], m[9] )));
+		__m256 py = _mm256_fmadd_ps( x, m[1], _mm256_fmadd_ps( y, m[4], _mm256_fmadd_ps( z, m[7], m[10] )));
+		__m256 pz = _mm256_fmadd_ps( x, m[2], _mm256_fmadd_ps( y, m[5], _mm256_fmadd_ps( z, m[8], m[11] )));
+		_mm256_store_ps( out[0], px );
+		_mm256_store_ps( out[1], py );
+		_mm256_store_ps( out[2], pz );
+
+		min_x = _mm256_min_ps( min_x, px );
+		min_y = _mm256_min_ps( min_y, py );
+		min_z = _mm256_min_ps( min_z, pz );
+		max_x = _mm256_max_ps( max_x, px );
+		max_y = _mm256_max_ps( max_y, py );
+		max_z = _mm256_max_ps( max_z, pz );
+
+		if ( p_job->mpNormals )
+		{
+			x = _mm256_i32gather_ps( p_normals, vert4, 4 );
+			y = _mm256_i32gather_ps( p_normals + 1, vert4, 4 );
+			z = _mm256_i32gather_ps( p_normals + 2, vert4, 4 );
+			__m256 nx = _mm256_fmadd_ps( x, m[0], _mm256_fmadd_ps( y, m[3], _mm256_mul_ps( z, m[6] )));
+			__m256 ny = _mm256_fmadd_ps( x, m[1], _mm256_fmadd_ps( y, m[4], _mm256_mul_ps( z, m[7] )));
+			__m256 nz = _mm256_fmadd_ps( x, m[2], _mm256_fmadd_ps( y, m[5], _mm256_mul_ps( z, m[8] )));
+			__m256 len_sqr = _mm256_fmadd_ps( nx, nx, _mm256_fmadd_ps( ny, ny, _mm256_mul_ps( nz, nz )));
+			__m256 non_zero = _mm256_cmp_ps( len_sqr, zero, _CMP_GT_OQ );
+			__m256 scale = _mm256_and_ps( non_zero, _mm256_div_ps( _mm256_set1_ps( 1.0f ), _mm256_sqrt_ps( len_sqr )));
+			_mm256_store_ps( out[3], _mm256_mul_ps( nx, scale ));
+			_mm256_store_ps( out[4], _mm256_mul_ps( ny, scale ));
+			_mm256_store_ps( out[5], _mm256_mul_ps( nz, scale ));
+		}
+
+		for ( int i = 0; i < 8; i++ )
+		{
+			p_job->mpPositions[v + i].Set( out[0][i], out[1][i], out[2][i], 1.0f );
+			if ( p_job->mpNormals )
+			{
+				p_job->mpNormals[v + i].Set( out[3][i], out[4][i], out[5][i], 0.0f );
+			}
+		}
+	}
+
+	if ( v > begin )
+	{
+		s_add_bounds( p_bounds, s_reduce_min( min_x ), s_reduce_min( min_y ), s_reduce_min( min_z ));
+		s_add_bounds( p_bounds, s_reduce_max( max_x ), s_reduce_max( max_y ), s_reduce_max( max_z ));
+	}
+
+	s_skin_scalar( p_job, v, end, p_bounds );
+}
+
+#endif		// __AVX2_SKINNING__
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+static void s_skin_batch( void* p_data, int begin, int end )
+{
+	SSkinJob* p_job = (SSkinJob*)p_data;
+	SSkinBounds* p_bounds = &p_job->mBounds[Job::GetThreadIndex()];
+
+#ifdef __AVX2_SKINNING__
+	if ( s_simd_skinning && s_has_avx2())
+	{
+		s_skin_avx2( p_job, begin, end, p_bounds );
+		return;
+	}
+#endif		// __AVX2_SKINNING__
+
+	s_skin_scalar( p_job, begin, end, p_bounds );
+}
+
+/*****************************************************************************
+**							   Public Functions								**
+*****************************************************************************/
+
+void SkinMesh( const SSkinMesh* pMesh, const Mth::Matrix* pBoneMatrices, int numBones,
+			   Mth::Vector* pPositions, Mth::Vector* pNormals, Mth::CBBox* pBBox )
+{
+	Dbg_MsgAssert( !Job::IsWorkerThread(), ( "SkinMesh must be called from the main thread" ) );
+	Dbg_MsgAssert( numBones > 0 && numBones <= Gfx::vMAX_BONES, ( "Can't skin with %d bones", numBones ) );
+	Dbg_MsgAssert( pMesh->mpNormals || !pNormals, ( "The skin mesh has no normals" ) );
+
+	// too big for the stack of the main thread on some platforms
+	static SSkinJob s_job;
+
+	s_job.mpMesh = pMesh;
+	s_job.mpPositions = pPositions;
+	s_job.mpNormals = pMesh->mpNormals ? pNormals : NULL;
+	s_job.mMaxBone = numBones - 1;
+
+	for ( int i = 0; i < numBones; i++ )
+	{
+		const Mth::Matrix& matrix = pBoneMatrices[i];
+		float* p_entry = s_job.mPalette[i];
+		for ( int row = 0; row < 4; row++ )
+		{
+			p_entry[row * 3 + 0] = matrix[row][X];
+			p_entry[row * 3 + 1] = matrix[row][Y];
+			p_entry[row * 3 + 2] = matrix[row][Z];
+		}
+	}
+
+	for ( int thread = 0; thread < Job::MAX_THREADS; thread++ )
+	{
+		SSkinBounds* p_bounds = &s_job.mBounds[thread];
+		p_bounds->mMin[0] = p_bounds->mMin[1] = p_bounds->mMin[2] = FLT_MAX;
+		p_bounds->mMax[0] = p_bounds->mMax[1] = p_bounds->mMax[2] = -FLT_MAX;
+	}
+
+	if ( s_threaded_skinning )
+	{
+		Job::ParallelFor( s_skin_batch, &s_job, pMesh->mNumVerts, vSKIN_BATCH_SIZE );
+	}
+	else
+	{
+		s_skin_batch( &s_job, 0, pMesh->mNumVerts );
+	}
+
+	if ( pBBox )
+	{
+		// The threads that got no batch still have their empty bounds, with min above max
+		SSkinBounds total;
+		total.mMin[0] = total.mMin[1] = total.mMin[2] = FLT_MAX;
+		total.mMax[0] = total.mMax[1] = total.mMax[2] = -FLT_MAX;
+		for ( int thread = 0; thread < Job::MAX_THREADS; thread++ )
+		{
+			const SSkinBounds* p_bounds = &s_job.mBounds[thread];
+			if ( p_bounds->mMin[0] > p_bounds->mMax[0] )
+			{
+				continue;
+			}
+			for ( int axis = 0; axis < 3; axis++ )
+			{
+				total.mMin[axis] = ( p_bounds->mMin[axis] < total.mMin[axis] ) ? p_bounds->mMin[axis] : total.mMin[axis];
+				total.mMax[axis] = ( p_bounds->mMax[axis] > total.mMax[axis] ) ? p_bounds->mMax[axis] : total.mMax[axis];
+			}
+		}
+		if ( total.mMin[0] <= total.mMax[0] )
+		{
+			pBBox->Set( Mth::Vector( total.mMin[0], total.mMin[1], total.mMin[2] ),
+						Mth::Vector( total.mMax[0], total.mMax[1], total.mMax[2] ));
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool SoftwareSkinningEnabled()
+{
+	return s_software_skinning;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void SetSoftwareSkinning( bool enabled )
+{
+	s_software_skinning = enabled;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void DisplaySkinnedGeom( const CGeom* pGeom, const Mth::Matrix* pRootMatrix )
+{
+	enum
+	{
+		vMAX_DISPLAYED_VERTS = 256,			// the debug line buffer isn't that big
+	};
+	
+	const Mth::Vector* p_verts = pGeom->GetSkinnedVerts();
+	if ( !s_display_skinning || !p_verts )
+	{
+		return;
+	}
+	
+	const Mth::Vector* p_normals = pGeom->GetSkinnedNormals();
+	int num_verts = pGeom->GetSkinMesh()->mNumVerts;
+	int step = ( num_verts + vMAX_DISPLAYED_VERTS - 1 ) / vMAX_DISPLAYED_VERTS;
+	for ( int v = 0; v < num_verts; v += step )
+	{
+		Mth::Vector pos = pRootMatrix->Transform( p_verts[v] );
+		if ( p_normals )
+		{
+			Mth::Vector normal = p_normals[v];
+			normal[W] = 0.0f;
+			Gfx::AddDebugLine( pos, pos + pRootMatrix->Transform( normal ) * 3.0f, MAKE_RGB( 0, 200, 0 ), MAKE_RGB( 0, 200, 0 ), 1 );
+		}
+		else
+		{
+			Gfx::AddDebugStar( pos, 0.5f, MAKE_RGB( 0, 200, 0 ), 1 );
+		}
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetSoftwareSkinning | Turns skinning the models on the CPU on or off.  It's
+// on by default in the builds without a renderer, so the skinned verts and bounds are
+// there for the software rendering, shadows, imposters and bounding volumes.
+// @flag on | Skin on the CPU
+// @flag off | Leave it to the renderer
+// @flag display | Also draw some of the skinned verts, and their normals, as debug lines
+bool ScriptSetSoftwareSkinning( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	SetSoftwareSkinning( !pParams->ContainsFlag( CRCD(0xd443a2bc,"off") ));
+	s_display_skinning = pParams->ContainsFlag( CRCD(0xf32e8d5c,"display") );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// The skin meshes of the object's geoms
+static int s_get_model_meshes( Nx::CModel* p_model, SSkinMesh* p_meshes, int maxMeshes )
+{
+	int num_meshes = 0;
+	for ( int i = 0; p_model && i < p_model->GetNumGeoms() && num_meshes < maxMeshes; i++ )
+	{
+		CGeom* p_geom = p_model->GetGeomByIndex( i );
+		if ( p_geom && p_geom->GetSkinMesh())
+		{
+			p_meshes[num_meshes++] = *p_geom->GetSkinMesh();
+		}
+	}
+	return num_meshes;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// A made up mesh of numVerts, with up to four bones on each vert, for when the platform
+// geoms have no skin mesh to time
+static void s_make_up_mesh( int numBones, int numVerts, SSkinMesh* p_mesh )
+{
+	Mth::Vector* p_positions = new Mth::Vector[numVerts];
+	Mth::Vector* p_normals = new Mth::Vector[numVerts];
+	uint8* p_bone_indices = new uint8[numVerts * 4];
+	float* p_weights = new float[numVerts * 4];
+
+	static const float s_weights[4][4] =
+	{
+		{ 1.0f, 0.0f, 0.0f, 0.0f },
+		{ 0.7f, 0.3f, 0.0f, 0.0f },
+		{ 0.5f, 0.3f, 0.2f, 0.0f },
+		{ 0.4f, 0.3f, 0.2f, 0.1f },
+	};
+
+	uint32 seed = 12345;
+	for ( int v = 0; v < numVerts; v++ )
+	{
+		float coords[3];
+		for ( int c = 0; c < 3; c++ )
+		{
+			seed = seed * 1664525 + 1013904223;
+			coords[c] = ( (float)( seed >> 8 ) / (float)( 1 << 24 ) - 0.5f ) * 72.0f;
+		}
+		p_positions[v].Set( coords[X], coords[Y], coords[Z], 1.0f );
+		p_normals[v].Set( coords[X], coords[Y], coords[Z], 0.0f );
+		p_normals[v].Normalize();
+
+		for ( int j = 0; j < 4; j++ )
+		{
+			p_bone_indices[v * 4 + j] = ( v + j * 7 ) % numBones;
+			p_weights[v * 4 + j] = s_weights[v & 3][j];
+		}
+	}
+
+	p_mesh->mNumVerts = numVerts;
+	p_mesh->mpPositions = p_positions;
+	p_mesh->mpNormals = p_normals;
+	p_mesh->mpBoneIndices = p_bone_indices;
+	p_mesh->mpWeights = p_weights;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | BenchmarkSkinning | Skins the object's model on the CPU with its current pose
+// a number of times, one vert at a time on the main thread, then with AVX2 on the main
+// thread, then with AVX2 on the jobs, and prints how long each took and the biggest
+// difference from the first.  Also returns them as scalar_us, simd_us, threaded_us and
+// max_error.  It times the skin meshes of the model's geoms, so it fails if the platform
+// geoms didn't hand any over, unless made_up is given.
+// @parm name | id | the object, which needs a skeleton (the skater, usually)
+// @parmopt int | loops | 32 | times to skin each way
+// @flag made_up | Skin a made up mesh instead of the model's, with the object's pose
+// @parmopt int | verts | 8000 | size of the made up mesh
+bool ScriptBenchmarkSkinning( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	uint32 id = 0;
+	pParams->GetChecksum( CRCD(0x40c698af,"id"), &id, Script::ASSERT );
+
+	int loops = 32;
+	pParams->GetInteger( CRCD(0xa3e2a096,"loops"), &loops );
+	int num_verts = 8000;
+	pParams->GetInteger( CRCD(0x969d3af6,"verts"), &num_verts );
+	Dbg_MsgAssert( loops > 0 && num_verts > 0, ( "BenchmarkSkinning needs loops and verts of at least one" ) );
+
+	Obj::CCompositeObject* p_object = (Obj::CCompositeObject*)Obj::CCompositeObjectManager::Instance()->GetObjectByID( id );
+	Obj::CSkeletonComponent* p_skeleton_component = p_object ? GetSkeletonComponentFromObject( p_object ) : NULL;
+	if ( !p_skeleton_component || !p_skeleton_component->GetSkeleton())
+	{
+		Dbg_Message( "BenchmarkSkinning: %s has no skeleton", Script::FindChecksumName( id ));
+		return false;
+	}
+	Gfx::CSkeleton* p_skeleton = p_skeleton_component->GetSkeleton();
+	Obj::CModelComponent* p_model_component = GetModelComponentFromObject( p_object );
+
+	enum
+	{
+		vMAX_BENCHMARK_MESHES = 18,
+	};
+	SSkinMesh meshes[vMAX_BENCHMARK_MESHES];
+	int num_meshes;
+	bool made_up = pParams->ContainsFlag( CRCD(0x4ebd92e5,"made_up") );
+	if ( made_up )
+	{
+		s_make_up_mesh( p_skeleton->GetNumBones(), num_verts, &meshes[0] );
+		num_meshes = 1;
+	}
+	else
+	{
+		num_meshes = s_get_model_meshes( p_model_component ? p_model_component->GetModel() : NULL, meshes, vMAX_BENCHMARK_MESHES );
+		if ( !num_meshes )
+		{
+			Dbg_Message( "BenchmarkSkinning: none of %s's geoms have a skin mesh; this platform's geoms don't hand one over (use made_up to time a made up one)",
+						 Script::FindChecksumName( id ));
+			return false;
+		}
+	}
+
+	int total_verts = 0;
+	for ( int i = 0; i < num_meshes; i++ )
+	{
+		total_verts += meshes[i].mNumVerts;
+	}
+
+	Mth::Vector* p_reference = new Mth::Vector[total_verts];
+	Mth::Vector* p_positions = new Mth::Vector[total_verts];
+
+	bool was_simd = s_simd_skinning;
+	bool was_threaded = s_threaded_skinning;
+
+	uint64 us[3];
+	float max_error = 0.0f;
+	for ( int pass = 0; pass < 3; pass++ )
+	{
+		s_simd_skinning = ( pass > 0 );
+		s_threaded_skinning = ( pass > 1 );
+		Mth::Vector* p_out = pass ? p_positions : p_reference;
+
+		uint64 start = Trace::GetTimeUS();
+		for ( int loop = 0; loop < loops; loop++ )
+		{
+			int first = 0;
+			for ( int i = 0; i < num_meshes; i++ )
+			{
+				SkinMesh( &meshes[i], p_skeleton->GetMatrices(), p_skeleton->GetNumBones(), p_out + first, NULL, NULL );
+				first += meshes[i].mNumVerts;
+			}
+		}
+		us[pass] = Trace::GetTimeUS() - start;
+
+		for ( int v = 0; pass && v < total_verts; v++ )
+		{
+			for ( int c = X; c <= Z; c++ )
+			{
+				float error = fabsf( p_positions[v][c] - p_reference[v][c] );
+				max_error = ( error > max_error ) ? error : max_error;
+			}
+		}
+	}
+
+	s_simd_skinning = was_simd;
+	s_threaded_skinning = was_threaded;
+
+#ifndef __AVX2_SKINNING__
+	printf( "BenchmarkSkinning: no AVX2 skinning on this platform, the simd passes are scalar\n" );
+#endif		// __AVX2_SKINNING__
+
+	printf( "BenchmarkSkinning: %d %sverts x %d bones x %d loops, scalar %d us, simd %d us, threaded %d us, max error %g\n",
+			total_verts, made_up ? "made up " : "", p_skeleton->GetNumBones(), loops,
+			(int)us[0], (int)us[1], (int)us[2], max_error );
+
+	pScript->GetParams()->AddInteger( CRCD(0x458bc93b,"scalar_us"), (int)us[0] );
+	pScript->GetParams()->AddInteger( CRCD(0xb9aaa3b5,"simd_us"), (int)us[1] );
+	pScript->GetParams()->AddInteger( CRCD(0xf97b38a6,"threaded_us"), (int)us[2] );
+	pScript->GetParams()->AddFloat( CRCD(0x113b4285,"max_error"), max_error );
+
+	delete[] p_reference;
+	delete[] p_positions;
+	if ( made_up )
+	{
+		delete[] meshes[0].mpPositions;
+		delete[] meshes[0].mpNormals;
+		delete[] meshes[0].mpBoneIndices;
+		delete[] meshes[0].mpWeights;
+	}
+
+	return true;
+}
+
+}
+
+#endif // USE_CPU_SKINNING
@@ -0,0 +1,65 @@
+//****************************************************************************
+//* MODULE:         Gfx
+//* FILENAME:       NxSkinning.h
+//* OWNER:
+//* CREATION DATE:
+//****************************************************************************
+
+#ifndef	__GFX_NXSKINNING_H__
+#define	__GFX_NXSKINNING_H__
+
+#include <core/defines.h>
+#include <core/math.h>
+#include <core/math/geometry.h>
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+};
+
+namespace Nx
+{
+
+class CGeom;
+
+// Linear blend skinning on the CPU, for the builds with no renderer to skin the models
+// (dedicated servers and CI captures), and for anything else that needs the skinned verts:
+// software rendering, shadow and imposter generation, and refitting bounding volumes.
+//
+// The verts are split into ranges skinned in parallel on the jobs, eight at a time with
+// AVX2 where the CPU has it.  The bone matrices are the ones CSkeleton::Update() builds,
+// which take the bind pose into model space, so the skinned verts are in model space.
+//
+// Only built with USE_CPU_SKINNING.  No platform geom builds a skin mesh yet (none of them
+// load the vertex weights), so until one does there is nothing for it to skin.
+
+// A mesh to skin, in the bind pose.  The platform geom owns it.
+struct SSkinMesh
+{
+	int					mNumVerts;
+	const Mth::Vector*	mpPositions;
+	const Mth::Vector*	mpNormals;			// or NULL
+	const uint8*		mpBoneIndices;		// four per vert
+	const float*		mpWeights;			// four per vert, adding up to one, with the unused ones zero
+};
+
+// Skins the mesh with the bone matrices.  pNormals can be NULL, and so can pBBox, which
+// gets the bounds of the skinned positions.  Main thread only.
+void				SkinMesh( const SSkinMesh* pMesh, const Mth::Matrix* pBoneMatrices, int numBones,
+							  Mth::Vector* pPositions, Mth::Vector* pNormals, Mth::CBBox* pBBox );
+
+// Whether CGeom::Render() skins the geoms that have a skin mesh
+bool				SoftwareSkinningEnabled();
+void				SetSoftwareSkinning( bool enabled );
+
+// Draws some of the geom's skinned verts, with their normals, as debug lines, if that's
+// been turned on (SetSoftwareSkinning display).  pRootMatrix takes model space to world.
+void				DisplaySkinnedGeom( const CGeom* pGeom, const Mth::Matrix* pRootMatrix );
+
+bool				ScriptSetSoftwareSkinning( Script::CStruct* pParams, Script::CScript* pScript );
+bool				ScriptBenchmarkSkinning( Script::CStruct* pParams, Script::CScript* pScript );
+
+}
+
+#endif // __GFX_NXSKINNING_H__
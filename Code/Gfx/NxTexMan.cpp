@@ -25,6 +25,10 @@
 #include <gfx/facetexture.h>
 #include <gfx/modelappearance.h>
 
+#ifdef USE_VULKAN_RENDERER
+#include <gfx/Vulcan/p_nxtexture.h>
+#endif		// USE_VULKAN_RENDERER
+
 namespace	Nx
 {
 
@@ -802,6 +806,69 @@ void 	FlushParticleTextures(bool all)
 	
 }
 
+/*****************************************************************************
+**							Platform-Specific Functions						**
+*****************************************************************************/
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CTexDict *			CTexDictManager::s_plat_load_texture_dictionary(const char *p_tex_dict_name, bool is_level_data, uint32 texDictOffset, bool isSkin, bool forceTexDictLookup)
+{
+#ifdef USE_VULKAN_RENDERER
+	return new CVulcanTexDict(p_tex_dict_name);
+#else
+	// Fallback to default implementation, which loads nothing
+	return new CTexDict(p_tex_dict_name, true);
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CTexDict *			CTexDictManager::s_plat_load_texture_dictionary(uint32 checksum, uint32* pData, int dataSize, bool is_level_data, uint32 texDictOffset, bool isSkin, bool forceTexDictLookup)
+{
+#ifdef USE_VULKAN_RENDERER
+	CVulcanTexDict *p_dict = new CVulcanTexDict(checksum);
+	if (!p_dict->LoadFromBuffer((const uint8 *) pData, dataSize))
+	{
+		Dbg_MsgAssert(0, ("Texture dictionary %s is corrupt", Script::FindChecksumName(checksum)));
+	}
+	return p_dict;
+#else
+	return new CTexDict(checksum);
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CTexDict *			CTexDictManager::s_plat_create_texture_dictionary(uint32 checksum)
+{
+#ifdef USE_VULKAN_RENDERER
+	return new CVulcanTexDict(checksum);
+#else
+	return new CTexDict(checksum);
+#endif
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool				CTexDictManager::s_plat_unload_texture_dictionary(CTexDict *p_tex_dict)
+{
+	delete p_tex_dict;
+	return true;
+}
+
 
 } //end namespace Nx
 
@@ -7,6 +7,7 @@
 #include <core/math/vector.h>
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/symboltable.h>
+#include <sys/file/assetcache.h>
 									 
 #include <gfx/nx.h>
 #include <gfx/nxtexture.h>
@@ -14,6 +15,10 @@
 namespace	Nx
 {
 
+// Bump this whenever the 32-bit images a platform makes change, so that images
+// cached by older builds are no longer picked up.
+#define vGENERATE_32BIT_CACHE_VERSION	2
+
 /******************************************************************/
 /*                                                                */
 /*                                                                */
@@ -147,9 +152,45 @@ bool	CTexture::ReplaceTexture(CTexture *p_texture)
 /*                                                                */
 /******************************************************************/
 
+// Depalettising a big texture is slow, so the images are kept in the asset cache, keyed
+// on the texels they were made from.
 bool	CTexture::Generate32BitImage(bool renderable, bool store_original)
 {
-	return plat_generate_32bit_image(renderable, store_original);
+	int source_size;
+	const uint8 *p_source = plat_get_source_image(&source_size);
+	if (!p_source || source_size <= 0)
+	{
+		return plat_generate_32bit_image(renderable, store_original);
+	}
+
+	uint32 params[4] = { GetWidth(), GetHeight(), GetBitDepth(), GetPaletteBitDepth() };
+	AssetCache::SKey key = AssetCache::MakeKey(CRCD(0x33d4fe88,"Generate32BitImage"), vGENERATE_32BIT_CACHE_VERSION,
+											   AssetCache::HashParams(params, 4), p_source, source_size);
+
+	uint32 cached_size;
+	const void *p_cached = AssetCache::Lookup(key, &cached_size);
+	if (p_cached)
+	{
+		bool success = plat_set_32bit_image((const uint8 *) p_cached, cached_size, renderable, store_original);
+		AssetCache::Release(p_cached);
+		if (success)
+		{
+			return true;
+		}
+	}
+
+	if (!plat_generate_32bit_image(renderable, store_original))
+	{
+		return false;
+	}
+
+	int image_size;
+	const uint8 *p_image = plat_get_32bit_image(&image_size);
+	if (p_image && image_size > 0)
+	{
+		AssetCache::Store(key, p_image, image_size);
+	}
+	return true;
 }
 
 /******************************************************************/
@@ -391,6 +432,41 @@ bool	CTexture::plat_generate_32bit_image(bool renderable, bool store_original)
 /*                                                                */
 /******************************************************************/
 
+const uint8 *	CTexture::plat_get_source_image(int *p_size) const
+{
+	printf ("STUB: PlatGetSourceImage\n");
+	*p_size = 0;
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+const uint8 *	CTexture::plat_get_32bit_image(int *p_size) const
+{
+	printf ("STUB: PlatGet32BitImage\n");
+	*p_size = 0;
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool	CTexture::plat_set_32bit_image(const uint8 *p_image, int size, bool renderable, bool store_original)
+{
+	printf ("STUB: PlatSet32BitImage\n");
+	return false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool	CTexture::plat_put_32bit_image_into_texture(bool new_palette)
 {
 	printf ("STUB: PlatPut32BitImageIntoTexture\n");
@@ -831,6 +907,22 @@ CTexture * 			CTexDict::LoadTextureFromBuffer(uint8* p_buffer, int buffer_size,
 /*                                                                */
 /******************************************************************/
 
+// Replaces the images of the textures already in the dictionary with those from a
+// new copy of the dictionary file, keeping the CTexture objects so that any materials
+// using them pick up the change. Textures that were not there before are ignored.
+bool				CTexDict::ReloadFromBuffer(uint8* p_buffer, int buffer_size)
+{
+	// The old images might still be being drawn
+	Nx::CEngine::sFinishRendering();
+
+	return plat_reload_from_buffer(p_buffer, buffer_size);
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool				CTexDict::UnloadTexture(CTexture *p_texture)
 {
 	uint32 checksum = p_texture->GetChecksum();
@@ -1144,6 +1236,17 @@ CTexture *			CTexDict::plat_reload_texture(const char *p_texture_name)
 /*                                                                */
 /******************************************************************/
 
+bool				CTexDict::plat_reload_from_buffer(uint8* p_buffer, int buffer_size)
+{
+	printf ("STUB: PlatReloadFromBuffer\n");
+	return false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool				CTexDict::plat_unload_texture(CTexture *p_texture)
 {
 	printf ("STUB: PlatUnloadTexture\n");
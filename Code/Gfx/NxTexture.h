@@ -97,6 +97,11 @@ private:
 	virtual bool			plat_replace_texture(CTexture *p_texture);
 
 	virtual bool			plat_generate_32bit_image(bool renderble = false, bool store_original = false);
+	// So Generate32BitImage() can keep its results in the asset cache: the texels it works
+	// from, the image it made, and a way to use a cached image instead of making one
+	virtual const uint8 *	plat_get_source_image(int *p_size) const;
+	virtual const uint8 *	plat_get_32bit_image(int *p_size) const;
+	virtual bool			plat_set_32bit_image(const uint8 *p_image, int size, bool renderble, bool store_original);
 	virtual bool			plat_put_32bit_image_into_texture(bool new_palette = false);
 
 	virtual bool			plat_offset(int x_pixels, int y_pixels, bool use_fill_color, Image::RGBA fill_color);
@@ -174,6 +179,7 @@ public:
 	CTexture *				LoadTexture(const char *p_texture_name, bool sprite, bool alloc_vram = true, bool perm = true);
 	CTexture *				LoadTextureFromBuffer(uint8* p_buffer, int buffer_size, uint32 texture_checksum, bool sprite, bool alloc_vram = true, bool perm = true);
 	CTexture *				ReloadTexture(const char *p_texture_name);
+	bool					ReloadFromBuffer(uint8* p_buffer, int buffer_size);
 	bool					UnloadTexture(CTexture *p_texture);
 	void					AddTexture(CTexture *p_texture);
 	bool					RemoveTexture(CTexture *p_texture);
@@ -211,6 +217,7 @@ private:
 	virtual CTexture *			plat_load_texture(const char *p_texture_name, bool sprite, bool alloc_vram);
 	virtual CTexture *			plat_load_texture_from_buffer(uint8* p_buffer, int buffer_size, uint32 texture_checksum, bool sprite, bool alloc_vram);
 	virtual CTexture *			plat_reload_texture(const char *p_texture_name);
+	virtual bool				plat_reload_from_buffer(uint8* p_buffer, int buffer_size);
 	virtual bool				plat_unload_texture(CTexture *p_texture);
 	virtual void				plat_add_texture(CTexture *p_texture);
 	virtual bool				plat_remove_texture(CTexture *p_texture);
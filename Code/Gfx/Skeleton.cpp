@@ -14,6 +14,8 @@
 
 #include <gfx/skeleton.h>
 
+#include <string.h>
+
 #include <gel/scripting/script.h>
 #include <gel/scripting/array.h>
 #include <gel/scripting/checksum.h>
@@ -52,6 +54,7 @@ namespace Gfx
 #define nxBONEFLAGS_NOANIM			(1<<30)
 #define nxBONEFLAGS_SCALELOCAL		(1<<29)
 #define nxBONEFLAGS_SCALENONLOCAL	(1<<28)
+#define nxBONEFLAGS_DIRTY			(1<<27)		// only means anything during Update()
 
 #define MAX_LOD_DISTANCE			3.4e+38f;
 
@@ -76,6 +79,14 @@ public:
 //	uint32					m_parentName;
 	int						m_flipIndex;
 	Mth::Vector				m_scale;
+
+	// What the last Update() worked from, so the bones whose
+	// pose hasn't changed (and whose parents haven't moved)
+	// can keep last frame's matrices
+	int						m_parentIndex;
+	Mth::Quat				m_lastQuat;
+	Mth::Vector				m_lastTrans;
+	Mth::Matrix				m_modelMatrix;			// before the neutral pose is taken out
 };
 
 // GJ:  Removed reference to skateboard, because
@@ -96,6 +107,8 @@ public:
 **								 Private Data								**
 *****************************************************************************/
 
+static bool s_incremental_bone_update = true;
+
 /*****************************************************************************
 **								 Public Data								**
 *****************************************************************************/
@@ -142,6 +155,8 @@ CBone::CBone()
 	m_flipIndex = -1;
 	m_flags = 0;
 	m_scale = Mth::Vector( 1.0f, 1.0f, 1.0f );
+	m_parentIndex = 0;
+	m_modelMatrix.Ident();
 }
 
 /*****************************************************************************
@@ -159,6 +174,14 @@ CSkeleton::CSkeleton( CSkeletonData* pSkeletonData )
 
 	// clear out flags completely
 	m_flags = 0;
+
+	mp_pendingPoseFunc = NULL;
+	mp_pendingPoseOwner = NULL;
+
+	m_animQuality = ANIM_QUALITY_NLERP;
+
+	m_matricesValid = false;
+	m_lastSkipIndex = 0;
 	
 	if ( pSkeletonData->m_flags & 0x1 )
 	{
@@ -377,6 +400,7 @@ void CSkeleton::initialize_hierarchy( CSkeletonData* pSkeletonData )
 
 		// Assign parentage here...
 		p_currentBone->mp_parentMatrix = mp_matrices + parentIndex;
+		p_currentBone->m_parentIndex = parentIndex;
 
 // GJ:  Neutral pose has been moved to skeleton data
 //		CBone* p_parentBone = &mp_bones[parentIndex];
@@ -438,6 +462,30 @@ Mth::Matrix* CSkeleton::GetMatrices()
 /*                                                                */
 /******************************************************************/
 
+void CSkeleton::SetPendingPose( PendingPoseFunc func, void* pOwner )
+{
+	mp_pendingPoseFunc = func;
+	mp_pendingPoseOwner = pOwner;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CSkeleton::ResolvePendingPose()
+{
+	if ( mp_pendingPoseFunc )
+	{
+		mp_pendingPoseFunc( mp_pendingPoseOwner );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 int CSkeleton::GetNumBones() const
 {
 	return m_numBones;
@@ -496,6 +544,7 @@ bool CSkeleton::SetBoneActive( uint32 boneId, bool active )
 	{
 		pBone->m_flags &= ~nxBONEFLAGS_NOANIM;
 		pBone->m_flags |= ( active ? 0 : nxBONEFLAGS_NOANIM );
+		InvalidateMatrices();
 	}
 
 	return pBone;
@@ -506,6 +555,24 @@ bool CSkeleton::SetBoneActive( uint32 boneId, bool active )
 /*                                                                */
 /******************************************************************/
 
+bool CSkeleton::HasDefaultBones() const
+{
+	for ( int i = 0; i < m_numBones; i++ )
+	{
+		if ( mp_bones[i].m_flags & ( nxBONEFLAGS_NOANIM | nxBONEFLAGS_SCALELOCAL | nxBONEFLAGS_SCALENONLOCAL ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool CSkeleton::ApplyBoneScale( Script::CStruct* pBodyShapeStructure )
 {
 	// TODO:  CSkeleton shouldn't know anything about
@@ -583,6 +650,8 @@ void CSkeleton::ResetScale( void )
 		pBone->m_flags &= ~(nxBONEFLAGS_SCALELOCAL | nxBONEFLAGS_SCALENONLOCAL);
 		pBone->m_scale = Mth::Vector( 1.0f, 1.0f, 1.0f, 1.0f );
 	}
+
+	InvalidateMatrices();
 }
 
 /******************************************************************/
@@ -626,6 +695,8 @@ bool CSkeleton::SetBoneScale( uint32 boneId, const Mth::Vector& theBoneScale, bo
 		{
 			pBone->m_flags |= ( isLocalScale ? nxBONEFLAGS_SCALELOCAL : nxBONEFLAGS_SCALENONLOCAL );
 		}
+
+		InvalidateMatrices();
 	}
 	else
 	{
@@ -1091,8 +1162,17 @@ void CSkeleton::Update( Mth::Quat* pQuat, Mth::Vector* pTrans )
 	uint32 skip_index_mask	= 1 << GetBoneSkipIndex();
 	uint32*	p_skip_list		= mp_skeletonData->GetBoneSkipList();
 
+	// Only the bones whose pose has changed since the last update,
+	// and everything below them, need new matrices.  Anything that
+	// changes the matrices some other way invalidates the lot.
+	bool update_all = !s_incremental_bone_update || !m_matricesValid || ( m_lastSkipIndex != GetBoneSkipIndex() );
+
 	for ( int i = 0; i < m_numBones; i++ )
 	{
+		CBone* p_parentBone = &mp_bones[p_currentBone->m_parentIndex];
+		bool parent_dirty = ( i != 0 ) && ( p_parentBone->m_flags & nxBONEFLAGS_DIRTY );
+		bool dirty = update_all;
+
 		if( !( p_currentBone->m_flags & nxBONEFLAGS_NOANIM ))
 		{
 			// Decide whether we can skip this bone. Skipping bones where a child bone is not skipped will cause
@@ -1100,28 +1180,54 @@ void CSkeleton::Update( Mth::Quat* pQuat, Mth::Vector* pTrans )
 			bool skip_this_bone = (( p_skip_list[i] & skip_index_mask ) != 0 );
 			if( !skip_this_bone )
 			{
-				// Skateboard rotation has been moved to CAnimationComponent.
-				Dbg_MsgAssert( !( p_currentBone->m_flags & nxBONEFLAGS_ROTATE ), ( "Skateboard rotation has been moved to CAnimationComponent" ) );
-
-				sQuatVecToMatrix( p_current_quat, p_current_trans, p_currentMatrix, false, false );
-		
-				if ( p_currentBone->m_flags & nxBONEFLAGS_SCALENONLOCAL )
+				if ( !dirty )
 				{
-					p_currentMatrix->Scale( p_currentBone->m_scale );
+					dirty = parent_dirty
+						 || memcmp( p_current_quat, &p_currentBone->m_lastQuat, sizeof( Mth::Quat ) )
+						 || memcmp( p_current_trans, &p_currentBone->m_lastTrans, sizeof( Mth::Vector ) );
 				}
 
-				if ( i != 0 )
+				if ( dirty )
 				{
-					// if it's not the root, then apply the parent's xform
-					(*p_currentMatrix) *= *(p_currentBone->mp_parentMatrix);
+					p_currentBone->m_lastQuat = *p_current_quat;
+					p_currentBone->m_lastTrans = *p_current_trans;
+
+					// Skateboard rotation has been moved to CAnimationComponent.
+					Dbg_MsgAssert( !( p_currentBone->m_flags & nxBONEFLAGS_ROTATE ), ( "Skateboard rotation has been moved to CAnimationComponent" ) );
+
+					sQuatVecToMatrix( p_current_quat, p_current_trans, &p_currentBone->m_modelMatrix, false, false );
+			
+					if ( p_currentBone->m_flags & nxBONEFLAGS_SCALENONLOCAL )
+					{
+						p_currentBone->m_modelMatrix.Scale( p_currentBone->m_scale );
+					}
+
+					if ( i != 0 )
+					{
+						// if it's not the root, then apply the parent's xform
+						p_currentBone->m_modelMatrix *= p_parentBone->m_modelMatrix;
+					}
 				}
 			}
 			else
 			{
-				// Use the parent bone's matrix for now.
-				(*p_currentMatrix) = *(p_currentBone->mp_parentMatrix);
+				dirty = dirty || parent_dirty;
+				if ( dirty )
+				{
+					// Use the parent bone's matrix for now.
+					p_currentBone->m_modelMatrix = p_parentBone->m_modelMatrix;
+				}
 			}
 		}
+		else if ( dirty )
+		{
+			// Switched off bones keep whatever matrix they had,
+			// which is what their children get as a parent
+			p_currentBone->m_modelMatrix = *p_currentMatrix;
+		}
+
+		p_currentBone->m_flags &= ~nxBONEFLAGS_DIRTY;
+		p_currentBone->m_flags |= ( dirty ? nxBONEFLAGS_DIRTY : 0 );
 		
 		p_currentMatrix++;
 		p_currentBone++;
@@ -1137,8 +1243,10 @@ void CSkeleton::Update( Mth::Quat* pQuat, Mth::Vector* pTrans )
 	p_currentMatrix=mp_matrices;
 	for ( int i = 0; i < m_numBones; i++ )
 	{
-		if ( !(p_currentBone->m_flags & nxBONEFLAGS_NOANIM) )
+		if ( !(p_currentBone->m_flags & nxBONEFLAGS_NOANIM) && ( p_currentBone->m_flags & nxBONEFLAGS_DIRTY ) )
 		{
+			(*p_currentMatrix) = p_currentBone->m_modelMatrix;
+
 			if ( p_currentBone->m_flags & nxBONEFLAGS_SCALELOCAL )
 			{
 				p_currentMatrix->ScaleLocal( p_currentBone->m_scale );
@@ -1163,6 +1271,35 @@ void CSkeleton::Update( Mth::Quat* pQuat, Mth::Vector* pTrans )
 		p_currentMatrix++;
 		p_currentBone++;
 	}
+
+	m_matricesValid = true;
+	m_lastSkipIndex = GetBoneSkipIndex();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void CSkeleton::InvalidateMatrices()
+{
+	m_matricesValid = false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | SetIncrementalBoneUpdate | Turns on or off only working out the matrices of
+// the bones whose pose has changed since the last frame, along with their children.
+// It's on by default; off works out every bone every frame, as it used to.
+// @flag on | Only update the bones that have moved
+// @flag off | Update every bone
+bool ScriptSetIncrementalBoneUpdate( Script::CStruct* pParams, Script::CScript* pScript )
+{
+	s_incremental_bone_update = !pParams->ContainsFlag( CRCD(0xd443a2bc,"off") );
+	return true;
 }
 
 /******************************************************************/
@@ -1174,6 +1311,8 @@ bool CSkeleton::GetBoneMatrix( uint32 boneId, Mth::Matrix* pBoneMatrix )
 {
 	Dbg_Assert( pBoneMatrix );
 
+	ResolvePendingPose();
+
 	CBone* pBone = get_bone_by_id( boneId );
 	int i = GetBoneIndexById( boneId );
 
@@ -1266,10 +1405,22 @@ void CSkeleton::SetBoneSkipDistance( float dist )
 /*                                                                */
 /******************************************************************/
 
+void CSkeleton::SetBoneSkipIndex( uint32 index )
+{
+	m_skipIndex = ( index < m_maxBoneSkipLOD ) ? index : m_maxBoneSkipLOD;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool CSkeleton::GetBonePosition( uint32 boneId, Mth::Vector* pBonePos )
 {
 	Dbg_Assert( pBonePos );
 
+	ResolvePendingPose();
+
 	CBone* pBone = get_bone_by_id( boneId );
 	int i = GetBoneIndexById( boneId );
 
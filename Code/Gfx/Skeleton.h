@@ -16,6 +16,7 @@
 #include <core/support.h>
 
 #include <gfx/pose.h>
+#include <gfx/bonedanimtypes.h>
 
 /*****************************************************************************
 **								Defines									**
@@ -31,6 +32,7 @@ namespace Mth
 namespace Script
 {
 	class CStruct;
+	class CScript;
 };
 
 namespace Gfx
@@ -120,6 +122,11 @@ public:
 	void					SetBoneSkipDistance( float dist );
 	void					SetMaxBoneSkipLOD( uint32 max )	{ m_maxBoneSkipLOD = max; }
 
+	// Set by the animation LOD, in place of SetBoneSkipDistance()
+	void					SetBoneSkipIndex( uint32 index );
+	EAnimQuality			GetAnimQuality( void )			{ return m_animQuality; }
+	void					SetAnimQuality( EAnimQuality quality )	{ m_animQuality = quality; }
+
 public:
 	// The following should be moved to the CAnimationComponent class	
 //	bool					GetBoneRotationByIndex( int boneIndex );
@@ -132,6 +139,26 @@ public:
 	void					SetNeutralPose( Mth::Quat* pQuat, Mth::Vector* pTrans );
 	CSkeletonData*			GetSkeletonData() { return mp_skeletonData; }
 
+	// True if no bone is scaled or switched off, so the matrices follow from the pose alone
+	bool					HasDefaultBones() const;
+
+	// Update() only redoes the bones whose pose has changed since the last time, and
+	// their children.  Anything writing to GetMatrices() directly has to call this, so
+	// the next Update() does them all.
+	void					InvalidateMatrices();
+
+public:
+	// The animation component can leave this frame's pose to be worked out later, on
+	// the job system.  Until it has been, GetBoneMatrix() and GetBonePosition() call
+	// func first, which works it out there and then (or waits for the job doing it),
+	// so an object reading another's bone in the same frame never sees a stale pose.
+	// GetMatrices() isn't hooked, as the pose is written through it, so anything reading
+	// the matrices (CModel::Render(), mostly) has to call ResolvePendingPose() first.
+	typedef void (*PendingPoseFunc)( void* pOwner );
+	void					SetPendingPose( PendingPoseFunc func, void* pOwner );
+	bool					HasPendingPose() const { return mp_pendingPoseFunc != NULL; }
+	void					ResolvePendingPose();
+
 protected:
 	CBone*					get_bone_by_id( uint32 boneId );
 	void					update_matrices();
@@ -142,10 +169,17 @@ protected:
     CSkeletonData*			mp_skeletonData;
 	uint32					m_skipIndex;
 	uint32					m_maxBoneSkipLOD;
+	EAnimQuality			m_animQuality;
 
 	// for non-procedural bone anims
 	int						m_numBones;
 	CBone*					mp_bones;
+
+	PendingPoseFunc			mp_pendingPoseFunc;
+	void*					mp_pendingPoseOwner;
+
+	bool					m_matricesValid;
+	uint32					m_lastSkipIndex;
 	
 protected:
 	void					initialize_hierarchy( CSkeletonData* pSkeletonData );
@@ -169,6 +203,8 @@ protected:
 **							   Public Prototypes							**
 *****************************************************************************/
 
+bool					ScriptSetIncrementalBoneUpdate( Script::CStruct* pParams, Script::CScript* pScript );
+
 /*****************************************************************************
 **								Inline Functions							**
 *****************************************************************************/
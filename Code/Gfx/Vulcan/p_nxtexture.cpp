@@ -0,0 +1,650 @@
+#include <core/defines.h>
+#include <string.h>
+#include <sys/file/filesys.h>
+#include <gfx/Vulcan/p_nxtexture.h>
+
+namespace Nx
+{
+
+// A texture dictionary is a uint32 version and texture count, then for each texture a
+// fixed header, its palette, and each mip level as a uint32 size followed by the texels.
+struct STexDictEntryHeader
+{
+	uint32	Checksum;
+	uint32	Width;
+	uint32	Height;
+	uint32	Levels;
+	uint32	TexelDepth;
+	uint32	PaletteDepth;
+	uint32	DXT;
+	uint32	PaletteSize;
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+static bool s_read_uint32( const uint8 **pp_data, const uint8 *p_end, uint32 *p_value )
+{
+	if( *pp_data + sizeof( uint32 ) > p_end )
+	{
+		return false;
+	}
+	memcpy( p_value, *pp_data, sizeof( uint32 ) );
+	*pp_data += sizeof( uint32 );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+// Only the top level's texels are returned, the renderer makes no use of the rest
+static bool s_read_entry( const uint8 **pp_data, const uint8 *p_end, STexDictEntryHeader *p_header,
+						  const uint8 **pp_palette, const uint8 **pp_texels, uint32 *p_texels_size )
+{
+	if( *pp_data + sizeof( STexDictEntryHeader ) > p_end )
+	{
+		return false;
+	}
+	memcpy( p_header, *pp_data, sizeof( STexDictEntryHeader ));
+	*pp_data += sizeof( STexDictEntryHeader );
+
+	*pp_palette = *pp_data;
+	if( p_header->PaletteSize > (uint32)( p_end - *pp_data ))
+	{
+		return false;
+	}
+	*pp_data += p_header->PaletteSize;
+
+	*pp_texels = NULL;
+	*p_texels_size = 0;
+	for( uint32 level = 0; level < p_header->Levels; ++level )
+	{
+		uint32 level_size;
+		if( !s_read_uint32( pp_data, p_end, &level_size ) || ( level_size > (uint32)( p_end - *pp_data )))
+		{
+			return false;
+		}
+		if( level == 0 )
+		{
+			*pp_texels = *pp_data;
+			*p_texels_size = level_size;
+		}
+		*pp_data += level_size;
+	}
+
+	return ( *pp_texels != NULL );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+static void s_unpack_a1r5g5b5( const uint8 *p_texel, uint8 *p_rgba )
+{
+	uint16 c = p_texel[0] | ( p_texel[1] << 8 );
+	uint8 r = ( c >> 10 ) & 0x1f;
+	uint8 g = ( c >> 5 ) & 0x1f;
+	uint8 b = c & 0x1f;
+	p_rgba[0] = ( r << 3 ) | ( r >> 2 );
+	p_rgba[1] = ( g << 3 ) | ( g >> 2 );
+	p_rgba[2] = ( b << 3 ) | ( b >> 2 );
+	p_rgba[3] = ( c & 0x8000 ) ? 255 : 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+static void s_unpack_a8r8g8b8( const uint8 *p_texel, uint8 *p_rgba )
+{
+	// Stored little endian, so the bytes are B, G, R, A
+	p_rgba[0] = p_texel[2];
+	p_rgba[1] = p_texel[1];
+	p_rgba[2] = p_texel[0];
+	p_rgba[3] = p_texel[3];
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+CVulcanTexture::CVulcanTexture() : CTexture()
+{
+	mp_texture = NULL;
+	m_width = 0;
+	m_height = 0;
+	m_bit_depth = 0;
+	m_palette_bit_depth = 0;
+	m_num_mipmaps = 0;
+	m_dxt = 0;
+	m_transparent = false;
+	mp_source = NULL;
+	m_source_size = 0;
+	m_palette_size = 0;
+	mp_32bit_image = NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+CVulcanTexture::~CVulcanTexture()
+{
+	free_images();
+	if( mp_texture )
+	{
+		NxVulcan::destroy_texture( mp_texture );
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+void CVulcanTexture::free_images()
+{
+	if( mp_source )
+	{
+		delete [] mp_source;
+		mp_source = NULL;
+	}
+	if( mp_32bit_image )
+	{
+		delete [] mp_32bit_image;
+		mp_32bit_image = NULL;
+	}
+	m_source_size = 0;
+	m_palette_size = 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::LoadFromDictionary( const uint8 **pp_data, const uint8 *p_end )
+{
+	STexDictEntryHeader header;
+	const uint8 *p_palette;
+	const uint8 *p_texels;
+	uint32 texels_size;
+	if( !s_read_entry( pp_data, p_end, &header, &p_palette, &p_texels, &texels_size ))
+	{
+		return false;
+	}
+
+	// On a reload the engine texture is kept until the new image replaces it
+	free_images();
+
+	m_checksum = header.Checksum;
+	m_width = header.Width;
+	m_height = header.Height;
+	m_bit_depth = header.TexelDepth;
+	m_palette_bit_depth = header.PaletteDepth;
+	m_num_mipmaps = header.Levels;
+	m_dxt = header.DXT;
+	m_transparent = false;
+
+	if( m_dxt )
+	{
+		uint8 format = ( m_dxt == 1 ) ? NxVulcan::sTexture::TEXTURE_FORMAT_DXT1 :
+					   ( m_dxt == 3 ) ? NxVulcan::sTexture::TEXTURE_FORMAT_DXT3 : NxVulcan::sTexture::TEXTURE_FORMAT_DXT5;
+		m_transparent = ( m_dxt != 1 );
+		upload( format, (uint8 *) p_texels );
+		return true;
+	}
+
+	m_palette_size = header.PaletteSize;
+	m_source_size = header.PaletteSize + texels_size;
+	mp_source = new uint8[m_source_size];
+	memcpy( mp_source, p_palette, header.PaletteSize );
+	memcpy( mp_source + header.PaletteSize, p_texels, texels_size );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::sSkipDictionaryEntry( const uint8 **pp_data, const uint8 *p_end )
+{
+	STexDictEntryHeader header;
+	const uint8 *p_palette;
+	const uint8 *p_texels;
+	uint32 texels_size;
+	return s_read_entry( pp_data, p_end, &header, &p_palette, &p_texels, &texels_size );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::upload( uint8 format, uint8 *p_texels )
+{
+	if( mp_texture )
+	{
+		// Materials hold on to the engine texture, so the new image goes into the same
+		// sTexture.  The renderer looks textures up by checksum alone, so ours comes out
+		// of the table while the new one is made.
+		NxVulcan::pTextureTable->FlushItem( m_checksum );
+		NxVulcan::sTexture *p_new = NxVulcan::create_texture( m_checksum, m_width, m_height, format, p_texels );
+		if( p_new )
+		{
+			NxVulcan::sTexture old = *mp_texture;
+			*mp_texture = *p_new;
+			*p_new = old;
+
+			// Frees the old image, and takes the new one's table entry with it
+			NxVulcan::destroy_texture( p_new );
+		}
+		NxVulcan::pTextureTable->PutItem( m_checksum, mp_texture );
+		if( !p_new )
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// A texture that another dictionary has already registered is left to that one
+		if( NxVulcan::get_texture( m_checksum ))
+		{
+			Dbg_Message( "Texture %x is already loaded, not uploading it again", m_checksum );
+			return false;
+		}
+
+		mp_texture = NxVulcan::create_texture( m_checksum, m_width, m_height, format, p_texels );
+		if( !mp_texture )
+		{
+			return false;
+		}
+	}
+
+	if( m_transparent )
+	{
+		mp_texture->flags |= NxVulcan::sTexture::TEXTURE_FLAG_HAS_ALPHA;
+	}
+	else
+	{
+		mp_texture->flags &= ~NxVulcan::sTexture::TEXTURE_FLAG_HAS_ALPHA;
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::plat_generate_32bit_image( bool renderable, bool store_original )
+{
+	if( !mp_source || m_dxt )
+	{
+		return false;
+	}
+
+	const uint8 *p_palette = mp_source;
+	const uint8 *p_texels = mp_source + m_palette_size;
+	int num_texels = m_width * m_height;
+	int palette_entry_size = m_palette_bit_depth / 8;
+
+	if(( m_source_size - m_palette_size ) * 8 < num_texels * m_bit_depth )
+	{
+		Dbg_MsgAssert( 0, ( "Texture %x has too few texels for %dx%d", m_checksum, m_width, m_height ));
+		return false;
+	}
+	if(( m_bit_depth <= 8 ) && ((( m_palette_bit_depth != 16 ) && ( m_palette_bit_depth != 32 )) ||
+								( m_palette_size < ( 1 << m_bit_depth ) * palette_entry_size )))
+	{
+		Dbg_MsgAssert( 0, ( "Texture %x has a short palette", m_checksum ));
+		return false;
+	}
+
+	uint8 *p_image = new uint8[num_texels * 4];
+	m_transparent = false;
+	for( int i = 0; i < num_texels; ++i )
+	{
+		uint8 *p_rgba = p_image + ( i * 4 );
+		const uint8 *p_color;
+		int color_depth;
+		switch( m_bit_depth )
+		{
+			case 32:
+				p_color = p_texels + ( i * 4 );
+				color_depth = 32;
+				break;
+			case 16:
+				p_color = p_texels + ( i * 2 );
+				color_depth = 16;
+				break;
+			case 8:
+				p_color = p_palette + ( p_texels[i] * palette_entry_size );
+				color_depth = m_palette_bit_depth;
+				break;
+			case 4:
+				p_color = p_palette + ((( p_texels[i >> 1] >> (( i & 1 ) * 4 )) & 0xf ) * palette_entry_size );
+				color_depth = m_palette_bit_depth;
+				break;
+			default:
+				Dbg_MsgAssert( 0, ( "Texture %x has unsupported bit depth %d", m_checksum, m_bit_depth ));
+				delete [] p_image;
+				return false;
+		}
+
+		if( color_depth == 32 )
+		{
+			s_unpack_a8r8g8b8( p_color, p_rgba );
+		}
+		else
+		{
+			s_unpack_a1r5g5b5( p_color, p_rgba );
+		}
+		m_transparent |= ( p_rgba[3] != 255 );
+	}
+
+	if( mp_32bit_image )
+	{
+		delete [] mp_32bit_image;
+	}
+	mp_32bit_image = p_image;
+
+	if( renderable )
+	{
+		plat_put_32bit_image_into_texture();
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+const uint8 * CVulcanTexture::plat_get_source_image( int *p_size ) const
+{
+	*p_size = m_source_size;
+	return mp_source;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+const uint8 * CVulcanTexture::plat_get_32bit_image( int *p_size ) const
+{
+	if( mp_32bit_image )
+	{
+		*p_size = m_width * m_height * 4;
+		return mp_32bit_image;
+	}
+
+	// Once it's been put into the texture the engine's copy is the only one
+	if( mp_texture && ( mp_texture->format == NxVulcan::sTexture::TEXTURE_FORMAT_RGBA32 ))
+	{
+		*p_size = mp_texture->byte_size;
+		return mp_texture->pTexelData;
+	}
+
+	*p_size = 0;
+	return NULL;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::plat_set_32bit_image( const uint8 *p_image, int size, bool renderable, bool store_original )
+{
+	int num_texels = m_width * m_height;
+	if( m_dxt || ( size != num_texels * 4 ))
+	{
+		return false;
+	}
+
+	if( !mp_32bit_image )
+	{
+		mp_32bit_image = new uint8[size];
+	}
+	memcpy( mp_32bit_image, p_image, size );
+
+	m_transparent = false;
+	for( int i = 0; i < num_texels; ++i )
+	{
+		m_transparent |= ( mp_32bit_image[( i * 4 ) + 3] != 255 );
+	}
+
+	if( renderable )
+	{
+		plat_put_32bit_image_into_texture();
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::plat_put_32bit_image_into_texture( bool new_palette )
+{
+	if( !mp_32bit_image )
+	{
+		return false;
+	}
+
+	if( !upload( NxVulcan::sTexture::TEXTURE_FORMAT_RGBA32, mp_32bit_image ))
+	{
+		return false;
+	}
+
+	// The engine texture keeps its own copy, which plat_get_32bit_image() hands out
+	delete [] mp_32bit_image;
+	mp_32bit_image = NULL;
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+uint16 CVulcanTexture::plat_get_width() const
+{
+	return m_width;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+uint16 CVulcanTexture::plat_get_height() const
+{
+	return m_height;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+uint8 CVulcanTexture::plat_get_bitdepth() const
+{
+	return m_bit_depth;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+uint8 CVulcanTexture::plat_get_palette_bitdepth() const
+{
+	return m_palette_bit_depth;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+uint8 CVulcanTexture::plat_get_num_mipmaps() const
+{
+	return m_num_mipmaps;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexture::plat_is_transparent() const
+{
+	return m_transparent;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+CVulcanTexDict::CVulcanTexDict( uint32 checksum ) : CTexDict( checksum, true )
+{
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+CVulcanTexDict::CVulcanTexDict( const char *p_tex_dict_name ) : CTexDict( p_tex_dict_name, true )
+{
+	int size;
+	uint8 *p_data = (uint8 *) File::LoadAlloc( p_tex_dict_name, &size );
+	if( !p_data )
+	{
+		Dbg_Message( "Couldn't open texture dictionary %s", p_tex_dict_name );
+		return;
+	}
+
+	m_file_size = size;
+	if( !LoadFromBuffer( p_data, size ))
+	{
+		Dbg_MsgAssert( 0, ( "Texture dictionary %s is corrupt", p_tex_dict_name ));
+	}
+	Mem::Free( p_data );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+CVulcanTexDict::~CVulcanTexDict()
+{
+	// CTexDict deletes the textures, and each one destroys its engine texture
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexDict::LoadFromBuffer( const uint8 *p_data, int size )
+{
+	const uint8 *p_end = p_data + size;
+
+	uint32 version, num_textures;
+	if( !s_read_uint32( &p_data, p_end, &version ) || !s_read_uint32( &p_data, p_end, &num_textures ))
+	{
+		return false;
+	}
+
+	for( uint32 t = 0; t < num_textures; ++t )
+	{
+		CVulcanTexture *p_texture = new CVulcanTexture;
+		if( !p_texture->LoadFromDictionary( &p_data, p_end ))
+		{
+			delete p_texture;
+			return false;
+		}
+
+		// Depalettise now, since the renderer only takes 32-bit or DXT textures. This
+		// goes through Generate32BitImage() so repeat loads come from the asset cache.
+		if( !p_texture->IsCompressed())
+		{
+			p_texture->Generate32BitImage( true );
+		}
+		mp_texture_lookup->PutItem( p_texture->GetChecksum(), p_texture );
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexDict::plat_reload_from_buffer( uint8 *p_buffer, int buffer_size )
+{
+	const uint8 *p_data = p_buffer;
+	const uint8 *p_end = p_buffer + buffer_size;
+
+	uint32 version, num_textures;
+	if( !s_read_uint32( &p_data, p_end, &version ) || !s_read_uint32( &p_data, p_end, &num_textures ))
+	{
+		return false;
+	}
+
+	for( uint32 t = 0; t < num_textures; ++t )
+	{
+		// Each entry starts with the texture's checksum
+		uint32 checksum;
+		const uint8 *p_entry = p_data;
+		if( !s_read_uint32( &p_entry, p_end, &checksum ))
+		{
+			return false;
+		}
+
+		CVulcanTexture *p_texture = static_cast< CVulcanTexture * >( mp_texture_lookup->GetItem( checksum ));
+		if( !p_texture )
+		{
+			if( !CVulcanTexture::sSkipDictionaryEntry( &p_data, p_end ))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if( !p_texture->LoadFromDictionary( &p_data, p_end ))
+		{
+			return false;
+		}
+		if( !p_texture->IsCompressed())
+		{
+			p_texture->Generate32BitImage( true );
+		}
+	}
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexDict::plat_unload_texture( CTexture *p_texture )
+{
+	delete p_texture;
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+void CVulcanTexDict::plat_add_texture( CTexture *p_texture )
+{
+	// Nothing beyond the lookup table, which CTexDict::AddTexture() fills in
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+bool CVulcanTexDict::plat_remove_texture( CTexture *p_texture )
+{
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+} // namespace Nx
@@ -0,0 +1,98 @@
+#ifndef __GFX_P_NX_TEXTURE_H
+#define __GFX_P_NX_TEXTURE_H
+
+#include <core/defines.h>
+#include <gfx/nxtexture.h>
+#include "NX/render.h"
+
+namespace Nx
+{
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+	
+/////////////////////////////////////////////////////////////////////////////////////
+//
+// Here's a Vulkan-specific implementation of the CTexture
+//
+// The renderer has no palettised formats, so everything but DXT is turned into 32-bit
+// RGBA when it's loaded, through Generate32BitImage(), and only the top mip level is kept.
+// The texels it was made from stay with the texture, as the source for the asset cache.
+
+class CVulcanTexture : public CTexture
+{
+public:
+							CVulcanTexture();
+	virtual					~CVulcanTexture();
+
+	// Reads one texture out of a texture dictionary, moving *pp_data on past it.  Can be
+	// called again to give the texture a new image, keeping the same engine texture.
+	bool					LoadFromDictionary( const uint8 **pp_data, const uint8 *p_end );
+	static bool				sSkipDictionaryEntry( const uint8 **pp_data, const uint8 *p_end );
+
+	NxVulcan::sTexture *	GetEngineTexture() const	{ return mp_texture; }
+	bool					IsCompressed() const		{ return m_dxt != 0; }
+
+private:				// Platform-specific implementation
+	bool					plat_generate_32bit_image( bool renderable = false, bool store_original = false );
+	const uint8 *			plat_get_source_image( int *p_size ) const;
+	const uint8 *			plat_get_32bit_image( int *p_size ) const;
+	bool					plat_set_32bit_image( const uint8 *p_image, int size, bool renderable, bool store_original );
+	bool					plat_put_32bit_image_into_texture( bool new_palette = false );
+
+	uint16					plat_get_width() const;
+	uint16					plat_get_height() const;
+	uint8					plat_get_bitdepth() const;
+	uint8					plat_get_palette_bitdepth() const;
+	uint8					plat_get_num_mipmaps() const;
+	bool					plat_is_transparent() const;
+
+	void					free_images();
+	bool					upload( uint8 format, uint8 *p_texels );
+
+	NxVulcan::sTexture *	mp_texture;
+
+	uint16					m_width;
+	uint16					m_height;
+	uint8					m_bit_depth;
+	uint8					m_palette_bit_depth;
+	uint8					m_num_mipmaps;
+	uint8					m_dxt;
+	bool					m_transparent;
+
+	uint8 *					mp_source;			// the palette, if there is one, then the top level's texels
+	int						m_source_size;
+	int						m_palette_size;
+	uint8 *					mp_32bit_image;		// RGBA, NULL once it's only in the engine texture
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+//
+// Here's a Vulkan-specific implementation of the CTexDict
+
+class CVulcanTexDict : public CTexDict
+{
+public:
+							CVulcanTexDict( uint32 checksum );
+							CVulcanTexDict( const char *p_tex_dict_name );
+	virtual					~CVulcanTexDict();
+
+	bool					LoadFromBuffer( const uint8 *p_data, int size );
+
+private:				// Platform-specific implementation
+	bool					plat_reload_from_buffer( uint8 *p_buffer, int buffer_size );
+	bool					plat_unload_texture( CTexture *p_texture );
+	void					plat_add_texture( CTexture *p_texture );
+	bool					plat_remove_texture( CTexture *p_texture );
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+	
+} // namespace Nx
+
+#endif // __GFX_P_NX_TEXTURE_H
@@ -0,0 +1 @@
+AnimLOD.h
\ No newline at end of file
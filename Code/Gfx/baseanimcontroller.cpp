@@ -74,6 +74,17 @@ bool CBaseAnimController::GetPose( Gfx::CPose* pResultPose )
 /*                                                                */
 /******************************************************************/
 
+bool CBaseAnimController::AddToPoseKey( SPoseKey* pKey )
+{
+	// unless a controller says otherwise, its pose is its own
+	return false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 void CBaseAnimController::GetDebugInfo( Script::CStruct* p_info )
 {
 }
@@ -69,6 +69,30 @@ struct SWobbleDetails
 /*                                                                */
 /******************************************************************/
 
+// Everything a blend channel's pose depends on, so that objects playing the same
+// thing can share the one pose (see CAnimationComponent).  Each controller fills in
+// its part.
+struct SPoseKey
+{
+	uint32				skeletonName;
+	uint32				animName;			// the anim asset
+	float				time;
+	uint32				flags;
+	uint16				skipIndex;
+	uint16				quality;
+};
+
+enum
+{
+	vPOSE_KEY_FLIPPED			= ( 1 << 0 ),
+	vPOSE_KEY_BOARD_ROTATED		= ( 1 << 1 ),
+};
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 // TODO:  Move this to some generic procanim.h
 
 class CProceduralBone
@@ -114,6 +138,10 @@ public:
 
 	virtual bool				GetPose( Gfx::CPose* pResultPose );
 	virtual void				GetDebugInfo( Script::CStruct* p_info );
+
+	// Adds what the pose depends on to the key; false if it depends on
+	// something the key can't hold, in which case the pose isn't shared
+	virtual bool				AddToPoseKey( SPoseKey* pKey );
     virtual EAnimFunctionResult CallMemberFunction( uint32 Checksum, Script::CStruct* pParams, Script::CScript* pScript );
 
 public:
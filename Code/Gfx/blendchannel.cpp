@@ -44,6 +44,8 @@ CBlendChannel::CBlendChannel( Obj::CCompositeObject* pCompositeObject )
 
 	mp_object = pCompositeObject;
 	Dbg_MsgAssert( mp_object, ( "Blend channel has no object" ) );
+
+	m_customKeyCursor = 0;
 }
 
 // how to handle conflicts between controllers?
@@ -302,6 +304,54 @@ bool CBlendChannel::GetPose( Gfx::CPose* pResultPose )
 /*                                                                */
 /******************************************************************/
 
+// The pose at some other time, such as the one GetPoseKey() rounded down to
+bool CBlendChannel::GetPoseAt( Gfx::CPose* pResultPose, float time )
+{
+	// the controllers all go by the channel's time
+	float current_time = m_currentTime;
+	m_currentTime = time;
+	bool result = GetPose( pResultPose );
+	m_currentTime = current_time;
+
+	return result;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Adds the channel's part of the key for sharing its pose, at the current time rounded
+// down to a multiple of timeQuantum (if it isn't 0).  False if the pose can't be shared.
+bool CBlendChannel::GetPoseKey( SPoseKey* pKey, float timeQuantum )
+{
+	if ( m_numControllers == 0 )
+	{
+		return false;
+	}
+
+	for ( int i = 0; i < m_numControllers; i++ )
+	{
+		if ( !mp_controllers[i]->AddToPoseKey( pKey ) )
+		{
+			return false;
+		}
+	}
+
+	pKey->time = m_currentTime;
+	if ( timeQuantum > 0.0f )
+	{
+		pKey->time = floorf( m_currentTime / timeQuantum ) * timeQuantum;
+	}
+
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 bool CBlendChannel::Degenerate( float blend_period )
 {
 	if ( blend_period == 0.0f )
@@ -461,6 +511,8 @@ void CBlendChannel::PlaySequence( uint32 anim_name, float start_time, float end_
 	// clear out any old custom keys, and add the new ones
 	delete_custom_keys();
 	add_custom_keys( anim_name );
+	m_customKeyIndex.Build( &m_customAnimKeyList );
+	m_customKeyCursor = 0;
 	
 	m_status = ANIM_STATUS_ACTIVE;
 	
@@ -546,6 +598,7 @@ void CBlendChannel::PlaySequence( uint32 anim_name, float start_time, float end_
 
 void CBlendChannel::delete_custom_keys()
 {
+	m_customKeyIndex.Clear();
 	m_customAnimKeyList.DestroyAllNodes();
 }
 
@@ -609,11 +662,10 @@ void CBlendChannel::add_custom_keys( uint32 animName )
 
 void CBlendChannel::ResetCustomKeys()
 {
-	int customKeyCount = m_customAnimKeyList.CountItems();
+	int customKeyCount = m_customKeyIndex.GetNumKeys();
 	for ( int i = 0; i < customKeyCount; i++ )
 	{
-		Gfx::CCustomAnimKey* pKey = (Gfx::CCustomAnimKey*)m_customAnimKeyList.GetItem(i);
-		pKey->SetActive( true );
+		m_customKeyIndex.GetKey(i)->SetActive( true );
 	}
 }
 
@@ -648,20 +700,7 @@ void CBlendChannel::ProcessCustomKeys( float startTime, float endTime )
 			}
 		}
 
-		int customKeyCount = m_customAnimKeyList.CountItems();
-		for ( int i = 0; i < customKeyCount; i++ )
-		{
-			Gfx::CCustomAnimKey* pKey = (Gfx::CCustomAnimKey*)m_customAnimKeyList.GetItem(i);
-			if ( pKey->WithinRange( startTime, endTime ) )
-			{
-//				printf( "Processing key at %f (%f %f)\n", 0.0f, startTime, endTime );
-				pKey->ProcessKey( GetObject() );
-			}
-			else
-			{
-//				printf( "Not processing key at %f (%f %f)\n", custom_key_time, startTime, endTime );
-			}
-		}
+		m_customKeyIndex.ProcessKeys( startTime, endTime, false, GetObject(), &m_customKeyCursor );
 	}
 	
 	// TODO:  reset the custom keys when it loops?
@@ -61,6 +61,8 @@ public:
 public:
 	CBaseAnimController*		AddController( Script::CStruct* pParams );
 	bool						GetPose( Gfx::CPose* pPose );
+	bool						GetPoseAt( Gfx::CPose* pPose, float time );
+	bool						GetPoseKey( SPoseKey* pKey, float timeQuantum );
 	float						GetBlendValue();
 	bool						IsActive();
 	bool						IsDegenerating();
@@ -116,6 +118,8 @@ protected:
 	void 							add_custom_keys( uint32 animName );
 	void							delete_custom_keys();
 	Lst::Head<Gfx::CCustomAnimKey>	m_customAnimKeyList;	
+	Gfx::CCustomAnimKeyIndex		m_customKeyIndex;		// the same keys, indexed by frame
+	int								m_customKeyCursor;
 };
 
 /******************************************************************/
@@ -0,0 +1 @@
+NxSkinning.h
\ No newline at end of file
@@ -82,10 +82,11 @@ bool CBonedAnimController::GetPose( Gfx::CPose* pResultPose )
 //	GetSkeleton()->GetSkipList( &skipList[0] );
 	uint32*	p_skip_list = GetSkeleton()->GetBoneSkipList();
 	uint32	skip_index	= GetSkeleton()->GetBoneSkipIndex();
+	EAnimQuality quality = GetSkeleton()->GetAnimQuality();
 
 	Dbg_Assert( mp_quickAnim );
 //	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, &skipList[0], mp_blendChannel->GetCurrentAnimTime() );
-	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, p_skip_list, skip_index, mp_blendChannel->GetCurrentAnimTime() );
+	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, p_skip_list, skip_index, mp_blendChannel->GetCurrentAnimTime(), quality );
 	mp_quickAnim->Enable( true );
 	
 	return true;
@@ -96,6 +97,25 @@ bool CBonedAnimController::GetPose( Gfx::CPose* pResultPose )
 /*                                                                */
 /******************************************************************/
 
+bool CBonedAnimController::AddToPoseKey( SPoseKey* pKey )
+{
+	Dbg_Assert( mp_quickAnim );
+
+	if ( pKey->animName )
+	{
+		// more than one anim in the channel
+		return false;
+	}
+
+	pKey->animName = mp_quickAnim->GetAnimAssetName();
+	return pKey->animName != 0;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 void CBonedAnimController::Update()
 {
 	Dbg_MsgAssert( mp_blendChannel->m_loopingType != Gfx::LOOPING_WOBBLE, ( "Not supposed to be wobble type" ) );
@@ -106,10 +126,8 @@ void CBonedAnimController::Update()
 
 	mp_blendChannel->ProcessCustomKeys( oldTime, mp_blendChannel->m_currentTime );
 
-	if ( mp_blendChannel->m_currentTime < oldTime )
-	{
-		mp_quickAnim->Enable( false );
-	}
+	// no need to invalidate the quick anim when the time goes backwards
+	// (looping, pingponging, or playing backwards), as its cursor steps back
 }
 
 /******************************************************************/
@@ -230,10 +248,11 @@ bool CWobbleController::GetPose( Gfx::CPose* pResultPose )
 //	GetSkeleton()->GetSkipList( &skipList[0] );
 	uint32*	p_skip_list = GetSkeleton()->GetBoneSkipList();
 	uint32	skip_index	= GetSkeleton()->GetBoneSkipIndex();
+	EAnimQuality quality = GetSkeleton()->GetAnimQuality();
 	
 	Dbg_Assert( mp_quickAnim );
 //	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, &skipList[0], mp_blendChannel->GetCurrentAnimTime() );
-	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, p_skip_list, skip_index, mp_blendChannel->GetCurrentAnimTime() );
+	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, p_skip_list, skip_index, mp_blendChannel->GetCurrentAnimTime(), quality );
 	mp_quickAnim->Enable( true );
 	
 	return true;
@@ -305,16 +324,7 @@ void CWobbleController::Update()
 	// controller to all channels
 	Dbg_MsgAssert ( mp_blendChannel->m_loopingType == Gfx::LOOPING_WOBBLE, ( "Was supposed to be wobble type %d", mp_blendChannel->m_loopingType ) );
 
-	// remember old time, so that we know whether to use the quick anim
-	float oldTime = mp_blendChannel->m_currentTime;
-
 	mp_blendChannel->m_currentTime = get_new_wobble_time();
-
-	// remember to use the quick anim
-	if ( mp_blendChannel->m_currentTime < oldTime )
-	{
-		mp_quickAnim->Enable( false );
-	}
 }
 
 /******************************************************************/
@@ -579,6 +589,28 @@ bool CFlipRotateController::GetPose( Gfx::CPose* pResultPose )
 /*                                                                */
 /******************************************************************/
 
+bool CFlipRotateController::AddToPoseKey( SPoseKey* pKey )
+{
+	// the same as GetPose() goes by
+	Obj::CSkaterFlipAndRotateComponent* pSkaterFlipAndRotateComponent = GetSkaterFlipAndRotateComponentFromObject( GetObject() );
+	if ( pSkaterFlipAndRotateComponent && pSkaterFlipAndRotateComponent->IsBoardRotated() )
+	{
+		pKey->flags |= vPOSE_KEY_BOARD_ROTATED;
+	}
+
+	if ( m_flipped )
+	{
+		pKey->flags |= vPOSE_KEY_FLIPPED;
+	}
+
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
 CIKController::CIKController( CBlendChannel* pBlendChannel ) : CBaseAnimController( pBlendChannel )
 {
 }
@@ -1514,17 +1546,18 @@ bool CPartialAnimController::GetPose( Gfx::CPose* pResultPose )
 //	GetSkeleton()->GetSkipList( &skipList[0] );
 	uint32*	p_skip_list = GetSkeleton()->GetBoneSkipList();
 	uint32	skip_index	= GetSkeleton()->GetBoneSkipIndex();
+	EAnimQuality quality = GetSkeleton()->GetAnimQuality();
 
 #if 1
 	Dbg_Assert( mp_quickAnim );
-	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, p_skip_list, skip_index, mp_animChannel->GetCurrentAnimTime() );
+	mp_quickAnim->GetInterpolatedFrames( pResultPose->m_rotations, pResultPose->m_translations, p_skip_list, skip_index, mp_animChannel->GetCurrentAnimTime(), quality );
 	mp_quickAnim->Enable( true );
 #else
 	Mth::Quat theRot[128];
 	Mth::Vector theTrans[128];
 
 	Dbg_Assert( mp_quickAnim );
-	mp_quickAnim->GetInterpolatedFrames( theRot, theTrans, p_skip_list, skip_index, mp_animChannel->GetCurrentAnimTime() );
+	mp_quickAnim->GetInterpolatedFrames( theRot, theTrans, p_skip_list, skip_index, mp_animChannel->GetCurrentAnimTime(), quality );
 	mp_quickAnim->Enable( true );
 	
 	Script::CArray* pArray = Script::GetArray( m_boneListName, Script::ASSERT );
@@ -1554,16 +1587,9 @@ void CPartialAnimController::Update()
 	// given a CBonedAnimFrameData...
 	Dbg_MsgAssert( mp_animChannel->m_loopingType != Gfx::LOOPING_WOBBLE, ( "Not supposed to be wobble type" ) );
 			
-	float oldTime = mp_animChannel->m_currentTime;
-
 	mp_animChannel->m_currentTime = mp_animChannel->get_new_anim_time();
 
 //	mp_animChannel->ProcessCustomKeys( oldTime, mp_animChannel->m_currentTime );
-
-	if ( mp_animChannel->m_currentTime < oldTime )
-	{
-		mp_quickAnim->Enable( false );
-	}
 }
 
 /******************************************************************/
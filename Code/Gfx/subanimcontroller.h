@@ -73,6 +73,7 @@ public:
 	virtual void 				Update();
     virtual EAnimFunctionResult CallMemberFunction( uint32 Checksum, Script::CStruct* pParams, Script::CScript* pScript );
 	virtual bool				GetPose( Gfx::CPose* pResultPose );
+	virtual bool				AddToPoseKey( SPoseKey* pKey );
 	
 protected:
 	Nx::CQuickAnim*				mp_quickAnim;
@@ -136,6 +137,7 @@ public:
 	virtual void 				InitFromStructure( Script::CStruct* pParams );
 	virtual void 				Update();
 	virtual bool				GetPose( Gfx::CPose* pResultPose );
+	virtual bool				AddToPoseKey( SPoseKey* pKey );
 	
 protected:
 	bool						m_flipped;
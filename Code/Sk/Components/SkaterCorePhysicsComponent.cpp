@@ -61,6 +61,31 @@ extern bool g_CheatsEnabled;
 
 namespace Obj
 {
+
+// Tuning globals, looked up again only when a qb is reloaded (see Script::CTunable)
+static Script::CTunable< int > s_skater_trails( 0x3ae85eef /* skater_trails */ );
+static Script::CTunable< float > s_physics_acid_drop_walking_on_ground_search_distance( 0xe50a9d56 /* Physics_Acid_Drop_Walking_On_Ground_Search_Distance */ );
+static Script::CTunable< float > s_physics_acid_drop_min_air_time( 0x32c20f7e /* Physics_Acid_Drop_Min_Air_Time */ );
+static Script::CTunable< float > s_physics_disallow_rewallpush_duration( 0x0017d543 /* Physics_Disallow_Rewallpush_Duration */ );
+static Script::CTunable< float > s_wall_bounce_dont_slow_angle( 0x1483fd01 /* Wall_Bounce_Dont_Slow_Angle */ );
+static Script::CTunable< float > s_physics_wallpush_min_exit_speed( 0xb78542c2 /* Physics_Wallpush_Min_Exit_Speed */ );
+static Script::CTunable< float > s_physics_wallpush_speed_loss( 0x1112fb1c /* Physics_Wallpush_Speed_Loss */ );
+static Script::CTunable< float > s_physics_disallow_rewallplant_duration( 0x82135dd7 /* Physics_Disallow_Rewallplant_Duration */ );
+static Script::CTunable< float > s_physics_min_wallplant_height( 0xd5349cc6 /* Physics_Min_Wallplant_Height */ );
+static Script::CTunable< float > s_physics_wallplant_min_approach_angle( 0x8f79cc1c /* Physics_Wallplant_Min_Approach_Angle */ );
+static Script::CTunable< float > s_physics_wallplant_min_exit_speed( 0x7cee396c /* Physics_Wallplant_Min_Exit_Speed */ );
+static Script::CTunable< float > s_physics_wallplant_speed_loss( 0x09b2d4a3 /* Physics_Wallplant_Speed_Loss */ );
+static Script::CTunable< float > s_physics_wallplant_vertical_exit_speed( 0x074957fa /* Physics_Wallplant_Vertical_Exit_Speed */ );
+static Script::CTunable< float > s_physics_wallplant_distance_from_wall( 0x024be8f0 /* Physics_Wallplant_Distance_From_Wall */ );
+static Script::CTunable< int > s_turboollie( 0xf0a59d05 /* TurboOllie */ );
+static Script::CTunable< float > s_physics_acid_drop_min_land_speed( 0x59484878 /* Physics_Acid_Drop_Min_Land_Speed */ );
+static Script::CTunable< float > s_skater_upright_sideways_speed( 0xabd57877 /* skater_upright_sideways_speed */ );
+static Script::CTunable< int > s_physics_ignore_ceilings_after_wallplant_duration( 0x2757ed2c /* Physics_Ignore_Ceilings_After_Wallplant_Duration */ );
+static Script::CTunable< float > s_physics_wallplant_duration( 0xa06e446b /* Physics_Wallplant_Duration */ );
+static Script::CTunable< int > s_physics_wallplant_disallow_grind_duration( 0x96dca7dc /* Physics_Wallplant_Disallow_Grind_Duration */ );
+static Script::CTunable< float > s_physics_point_rail_kick_upward_angle( 0xbb357ecb /* Physics_Point_Rail_Kick_Upward_Angle */ );
+static Script::CTunable< int > s_rail_highlights( 0x01a5eab7 /* rail_highlights */ );
+static Script::CTunable< float > s_physics_time_before_free_revert( 0xf4813ad5 /* Physics_Time_Before_Free_Revert */ );
 	Mth::Vector acid_hold;
 
 /******************************************************************/
@@ -1774,7 +1799,7 @@ void CSkaterCorePhysicsComponent::do_on_ground_physics (  )
 	}
 		
 	#ifdef __NOPT_ASSERT__
-	if (Script::GetInteger(CRCD(0x3ae85eef, "skater_trails")))
+	if (s_skater_trails)
 	{
 		Gfx::AddDebugLine(GetPos() + m_current_normal, GetOldPos() + m_current_normal, GREEN, 0, 0);
 	}
@@ -3407,7 +3432,7 @@ bool CSkaterCorePhysicsComponent::maybe_acid_drop ( bool skated_off_edge, const
 		if (mp_walk_component->m_state == CWalkComponent::WALKING_GROUND)
 		{
 			// and use a reduced scan distance
-			scan_distance = Script::GetFloat(CRCD(0xe50a9d56, "Physics_Acid_Drop_Walking_On_Ground_Search_Distance"));
+			scan_distance = s_physics_acid_drop_walking_on_ground_search_distance;
 
 			// and look for vert polys above us
 			scan_height = 200.0f;
@@ -3592,7 +3617,7 @@ bool CSkaterCorePhysicsComponent::maybe_acid_drop ( bool skated_off_edge, const
 	SetFlagTrue(SPINE_PHYSICS);
 	float time_to_reach_target_height = calculate_time_to_reach_height(original_target_height, pos[Y], vel[Y]);
 	SetFlagFalse(SPINE_PHYSICS);
-	if (time_to_reach_target_height < Script::GetFloat(CRCD(0x32c20f7e, "Physics_Acid_Drop_Min_Air_Time")))
+	if (time_to_reach_target_height < s_physics_acid_drop_min_air_time)
 	{
 		Nx::CCollCacheManager::sDestroyCollCache(p_coll_cache);
 		vel = hold_vel;
@@ -4183,13 +4208,13 @@ bool CSkaterCorePhysicsComponent::check_for_wallpush (   )
 	if (!mp_input_component->GetControlPad().m_triangle.GetPressed()) return false;
 	
 	// last wallpush must not have been too recently
-	if (Tmr::ElapsedTime(m_last_wallpush_time_stamp) < Script::GetFloat(CRCD(0x17d543, "Physics_Disallow_Rewallpush_Duration"))) return false;
+	if (Tmr::ElapsedTime(m_last_wallpush_time_stamp) < s_physics_disallow_rewallpush_duration) return false;
 	
 	// wall normal must be opposite our forward direction; just under the maximum flail angle
-	if (Mth::DotProduct(GetMatrix()[Z], m_feeler.GetNormal()) >= -sinf(Mth::DegToRad(Script::GetFloat(CRCD(0x1483fd01, "Wall_Bounce_Dont_Slow_Angle")) - 1.0f))) return false;
+	if (Mth::DotProduct(GetMatrix()[Z], m_feeler.GetNormal()) >= -sinf(Mth::DegToRad(s_wall_bounce_dont_slow_angle - 1.0f))) return false;
 	
 	// last wallplant must not have been too recently
-	if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) < Script::GetFloat(CRCD(0x17d543, "Physics_Disallow_Rewallpush_Duration"))) return false;
+	if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) < s_physics_disallow_rewallpush_duration) return false;
 	
 	// throw a wallpush event for the scripts
 	GetObject()->SelfEvent(CRCD(0x4c03635b, "WallPush"));
@@ -4210,13 +4235,13 @@ bool CSkaterCorePhysicsComponent::check_for_wallpush (   )
 	if (speed > 0.001f)
 	{
 		GetVel() *= Mth::Max(
-			Script::GetFloat(CRCD(0xb78542c2, "Physics_Wallpush_Min_Exit_Speed")),
-			speed - Script::GetFloat(CRCD(0x1112fb1c, "Physics_Wallpush_Speed_Loss"))
+			s_physics_wallpush_min_exit_speed,
+			speed - s_physics_wallpush_speed_loss
 		) / speed;
 	}
 	else
 	{
-		GetVel() = -Script::GetFloat(CRCD(0xb78542c2, "Physics_Wallpush_Min_Exit_Speed")) * GetMatrix()[Z];
+		GetVel() = -s_physics_wallpush_min_exit_speed * GetMatrix()[Z];
 	}
 	
 	// project the resulting velocity into the ground's plane
@@ -4250,10 +4275,10 @@ bool CSkaterCorePhysicsComponent::check_for_wallplant (   )
 	if (GetMatrix()[Y][Y] < 0.1f) return false;
 	
 	// last wallplant must not have been too recently
-	if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) < Script::GetFloat(CRCD(0x82135dd7, "Physics_Disallow_Rewallplant_Duration"))) return false;
+	if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) < s_physics_disallow_rewallplant_duration) return false;
 	
 	// not when you're too near the ground
-	if (mp_state_component->m_height < Script::GetFloat(CRCD(0xd5349cc6, "Physics_Min_Wallplant_Height"))) return false;
+	if (mp_state_component->m_height < s_physics_min_wallplant_height) return false;
 	
 	// wall must be substantially vertical
 	if (!(m_feeler.GetFlags() & mFD_VERT) && Mth::Abs(m_feeler.GetNormal()[Y]) > 0.1f) return false;
@@ -4269,7 +4294,7 @@ bool CSkaterCorePhysicsComponent::check_for_wallplant (   )
 	Mth::Vector horizontal_normal = m_feeler.GetNormal();
 	horizontal_normal[Y] = 0.0f;
 	horizontal_normal.Normalize();
-	if (Mth::DotProduct(horizontal_forward, horizontal_normal) > -sinf(Mth::DegToRad(Script::GetFloat(CRCD(0x8f79cc1c, "Physics_Wallplant_Min_Approach_Angle"))))) return false;
+	if (Mth::DotProduct(horizontal_forward, horizontal_normal) > -sinf(Mth::DegToRad(s_physics_wallplant_min_approach_angle))) return false;
 	
 	// here we attempt to stop wallplant when in is more likely that the player is going for a grind
 	if (GetVel()[Y] > 0.0f && mp_input_component->GetControlPad().m_triangle.GetPressed())
@@ -4287,7 +4312,7 @@ bool CSkaterCorePhysicsComponent::check_for_wallplant (   )
 		if (!feeler.GetCollision())
 		{
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0x3ae85eef, "skater_trails")))
+			if (s_skater_trails)
 			{
 				feeler.DebugLine(255, 255, 0, 0);
 			}
@@ -4297,7 +4322,7 @@ bool CSkaterCorePhysicsComponent::check_for_wallplant (   )
 		else
 		{
 			#ifdef __USER_DAN__
-			if (Script::GetInteger(CRCD(0x3ae85eef, "skater_trails")))
+			if (s_skater_trails)
 			{
 				feeler.DebugLine(255, 0, 255, 0);
 			}
@@ -4341,17 +4366,17 @@ bool CSkaterCorePhysicsComponent::check_for_wallplant (   )
 	{
 		GetVel()[Y] = 0.0f;
 		GetVel().Normalize(Mth::Max(
-			Script::GetFloat(CRCD(0x7cee396c, "Physics_Wallplant_Min_Exit_Speed")),
-			horizontal_speed - Script::GetFloat(CRCD(0x9b2d4a3, "Physics_Wallplant_Speed_Loss"))
+			s_physics_wallplant_min_exit_speed,
+			horizontal_speed - s_physics_wallplant_speed_loss
 		));
 	}
 	else
 	{
-		GetVel() = -Script::GetFloat(CRCD(0x7cee396c, "Physics_Wallplant_Min_Exit_Speed")) * horizontal_forward;
+		GetVel() = -s_physics_wallplant_min_exit_speed * horizontal_forward;
 	}
 	
 	// replace vertical velocity with a wallplant boost
-	GetVel()[Y] = Script::GetFloat(CRCD(0x74957fa, "Physics_Wallplant_Vertical_Exit_Speed"));
+	GetVel()[Y] = s_physics_wallplant_vertical_exit_speed;
 	
 	if (m_feeler.IsMovableCollision())
 	{
@@ -4367,7 +4392,7 @@ bool CSkaterCorePhysicsComponent::check_for_wallplant (   )
 	
 	// move to just outside the wall, insuring that there is no additional collision along the line to that point
 	m_feeler.m_start = m_feeler.GetPoint();
-	m_feeler.m_end = m_feeler.GetPoint() + Script::GetFloat(CRCD(0x24be8f0, "Physics_Wallplant_Distance_From_Wall")) * m_feeler.GetNormal();
+	m_feeler.m_end = m_feeler.GetPoint() + s_physics_wallplant_distance_from_wall * m_feeler.GetNormal();
 	if (m_feeler.GetCollision())
 	{
 		GetPos() = m_feeler.GetPoint() + 0.1f * m_feeler.GetNormal();
@@ -4702,7 +4727,7 @@ void CSkaterCorePhysicsComponent::flip_if_skating_backwards (   )
 bool CSkaterCorePhysicsComponent::maybe_flag_ollie_exception (   )
 {
 	#ifdef __NOPT_ASSERT__
-	if (GetFlag(TENSE) && Script::GetInteger("TurboOllie"))
+	if (GetFlag(TENSE) && s_turboollie)
 	{
 		m_tense_time = GetFlagElapsedTime(TENSE);
 		SetFlagFalse(TENSE);
@@ -4897,7 +4922,7 @@ void CSkaterCorePhysicsComponent::do_in_air_physics (   )
 	DUMP_POSITION;
 	
 	#ifdef __NOPT_ASSERT__
-	if (Script::GetInteger(CRCD(0x3ae85eef, "skater_trails")))
+	if (s_skater_trails)
 	{
 		if (GetFlag(SPINE_PHYSICS))
 		{
@@ -5271,9 +5296,9 @@ void CSkaterCorePhysicsComponent::do_in_air_physics (   )
 							DUMP_VELOCITY;
 						}
 						
-						if (GetVel().LengthSqr() < Mth::Sqr(Script::GetFloat(CRCD(0x59484878, "Physics_Acid_Drop_Min_Land_Speed"))))
+						if (GetVel().LengthSqr() < Mth::Sqr(s_physics_acid_drop_min_land_speed))
 						{
-							GetVel().Normalize(Script::GetFloat(CRCD(0x59484878, "Physics_Acid_Drop_Min_Land_Speed")));
+							GetVel().Normalize(s_physics_acid_drop_min_land_speed);
 						}
 					}
 					GetVel().ZeroIfShorterThan(10.0f);
@@ -5793,13 +5818,13 @@ void CSkaterCorePhysicsComponent::rotate_upright (   )
 	float dot = Mth::DotProduct(GetMatrix()[Y], v);
 	if (dot > 0.02f * m_frame_length * 60.0f) // prevent wobbling
 	{
-		float rot = Mth::DegToRad(Script::GetFloat(CRCD(0xabd57877, "skater_upright_sideways_speed")));
+		float rot = Mth::DegToRad(s_skater_upright_sideways_speed);
 		GetMatrix().RotateZLocal(rot * m_frame_length);				
 		ResetLerpingMatrix();
 	}
 	else if (dot < -0.02f * m_frame_length * 60.0f)
 	{
-		float rot = Mth::DegToRad(Script::GetFloat(CRCD(0xabd57877, "skater_upright_sideways_speed")));
+		float rot = Mth::DegToRad(s_skater_upright_sideways_speed);
 		GetMatrix().RotateZLocal(-rot * m_frame_length);				
 		ResetLerpingMatrix();
 	}
@@ -6119,7 +6144,7 @@ bool CSkaterCorePhysicsComponent::handle_upward_collision_in_air (   )
 	float head_height = GetPhysicsFloat(CRCD(0x542cf0c7, "Skater_default_head_height"));
 	
 	// ignore head collisions for a duration after wallplants
-    if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) <= static_cast< Tmr::Time >(Script::GetInteger(CRCD(0x2757ed2c, "Physics_Ignore_Ceilings_After_Wallplant_Duration"))))
+    if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) <= static_cast< Tmr::Time >(s_physics_ignore_ceilings_after_wallplant_duration))
 	{
 		head_height = 6.0f;
 	}
@@ -6512,7 +6537,7 @@ void CSkaterCorePhysicsComponent::do_wallride_physics (   )
 	mp_trick_component->TrickOffObject(m_last_ground_feeler.GetNodeChecksum());
 			
 	#ifdef __NOPT_ASSERT__
-	if (Script::GetInteger(CRCD(0x3ae85eef, "skater_trails")))
+	if (s_skater_trails)
 	{
 		Gfx::AddDebugLine(GetPos() + m_current_normal, GetOldPos() + m_current_normal, PURPLE, 0, 0);
 	}
@@ -6527,7 +6552,7 @@ void CSkaterCorePhysicsComponent::do_wallride_physics (   )
 void CSkaterCorePhysicsComponent::do_wallplant_physics (   )
 {
 	// check if the wallplant duration is up
-	if (Tmr::ElapsedTime(m_state_change_timestamp) > Script::GetFloat(CRCD(0xa06e446b, "Physics_Wallplant_Duration")))
+	if (Tmr::ElapsedTime(m_state_change_timestamp) > s_physics_wallplant_duration)
 	{
 		SetState(AIR);
 		return;
@@ -6578,7 +6603,7 @@ void CSkaterCorePhysicsComponent::maybe_stick_to_rail ( bool override_air )
 	}
 	
 	// don't grind for a short duration after a wallplant
-	if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) < static_cast< Tmr::Time >(Script::GetInteger(CRCD(0x96dca7dc,"Physics_Wallplant_Disallow_Grind_Duration")))) return;
+	if (Tmr::ElapsedTime(m_last_wallplant_time_stamp) < static_cast< Tmr::Time >(s_physics_wallplant_disallow_grind_duration)) return;
 
 	Mth::Vector a = GetOldPos();
 	Mth::Vector b = GetPos();
@@ -6769,7 +6794,7 @@ void CSkaterCorePhysicsComponent::got_rail ( const Mth::Vector& rail_pos, const
 		Mth::Vector dir = GetVel();
 		dir[Y] = 0.0f;
 		dir.Normalize();
-		float angle = Mth::DegToRad(Script::GetFloat(CRCD(0xbb357ecb,"Physics_Point_Rail_Kick_Upward_Angle")));
+		float angle = Mth::DegToRad(s_physics_point_rail_kick_upward_angle);
 		float c = cosf(angle);
 		float s = sinf(angle);
 		Mth::Vector boost_dir(c * dir[X], s, c * dir[Z]);
@@ -7253,7 +7278,7 @@ void CSkaterCorePhysicsComponent::do_lip_physics (   )
 	}
 	
 	#ifdef __USER_DAN__
-	if (Script::GetInteger(CRCD(0x1a5eab7, "rail_highlights")))
+	if (s_rail_highlights)
 	{
 		Gfx::AddDebugLine(mp_rail_man->GetPos(mp_rail_node), mp_rail_man->GetPos(mp_rail_node->GetNextLink()), MAKE_RGB(Mth::Rnd(256), Mth::Rnd(256), Mth::Rnd(256)), 0, 1);
 		Gfx::AddDebugLine(mp_rail_man->GetPos(mp_rail_node) + Mth::Vector(1.0f, 0.0f, 0.0f), mp_rail_man->GetPos(mp_rail_node->GetNextLink()) + Mth::Vector(1.0f, 0.0f, 0.0f), MAKE_RGB(Mth::Rnd(256), Mth::Rnd(256), Mth::Rnd(256)), 0, 1);
@@ -7397,7 +7422,7 @@ void CSkaterCorePhysicsComponent::do_rail_physics (   )
 		const CRailNode* pOnto = NULL;
 		
 		#ifdef __USER_DAN__
-		if (Script::GetInteger(CRCD(0x1a5eab7, "rail_highlights")))
+		if (s_rail_highlights)
 		{
 			Gfx::AddDebugLine(mp_rail_man->GetPos(pStart), mp_rail_man->GetPos(pEnd), MAKE_RGB(Mth::Rnd(256), Mth::Rnd(256), Mth::Rnd(256)), 0, 1);
 			Gfx::AddDebugLine(mp_rail_man->GetPos(pStart) + Mth::Vector(1.0f, 0.0f, 0.0f), mp_rail_man->GetPos(pEnd) + Mth::Vector(1.0f, 0.0f, 0.0f), MAKE_RGB(Mth::Rnd(256), Mth::Rnd(256), Mth::Rnd(256)), 0, 1);
@@ -8382,7 +8407,7 @@ void CSkaterCorePhysicsComponent::update_special_friction_index (   )
 {
 	if (m_special_friction_index == 0) return;
 	
-	if (Tmr::ElapsedTime(m_special_friction_decrement_time_stamp) > static_cast< Tmr::Time >(1000.0f * Script::GetFloat(CRCD(0xf4813ad5, "Physics_Time_Before_Free_Revert"))))
+	if (Tmr::ElapsedTime(m_special_friction_decrement_time_stamp) > static_cast< Tmr::Time >(1000.0f * s_physics_time_before_free_revert))
 	{
 		m_special_friction_index--;
 		MESSAGE("You earned a free revert!!!!");
@@ -34,6 +34,7 @@
 #include <sk/components/SkaterProximitycomponent.h>
 
 #include <gel/object/compositeobject.h>
+#include <gel/object/neighbourgrid.h>
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/script.h>
 #include <gel/scripting/struct.h>
@@ -163,7 +164,7 @@ void CSkaterProximityComponent::Update()
 		}
 		else
 		{
-			distToSkaterSqr = GetDistToNearestSkaterSquared();	// MIGHT BE A NETWORK SKATER
+			distToSkaterSqr = GetDistToNearestSkaterSquared( mInnerRadiusSqr );	// MIGHT BE A NETWORK SKATER
 			if ( distToSkaterSqr <= mInnerRadiusSqr )
 			{
 				FLAGEXCEPTION( CRCD(0x5e8eb123,"AnySkaterInRadius") );
@@ -346,26 +347,15 @@ float CSkaterProximityComponent::GetDistToLocalSkaterSquared()
 /*                                                                */
 /******************************************************************/
 
-float CSkaterProximityComponent::GetDistToNearestSkaterSquared()
+float CSkaterProximityComponent::GetDistToNearestSkaterSquared( float maxDistSqr )
 {	
-	float nearest_distance = HUGE_DISTANCE_SQUARED;
-	
-	int num_skaters = Mdl::Skate::Instance()->GetNumSkaters();
-	
-	for( int i = 0; i < num_skaters; i++ )
+	SNeighbour nearest;
+	if ( FindNearestNeighbours( GetObject()->GetPos(), sqrtf( maxDistSqr ), NEIGHBOUR_TYPE( SKATE_TYPE_SKATER ), GetObject(), &nearest, 1 ) )
 	{
-		CCompositeObject* pObj = Mdl::Skate::Instance()->GetSkater( i );
-		if ( pObj && ( pObj != GetObject() ))
-		{
-			float this_dist = Mth::DistanceSqr( pObj->GetPos(), GetObject()->GetPos() );
-			if( this_dist < nearest_distance )
-			{
-				nearest_distance = this_dist;
-			}
-		}
+		return nearest.mDistSqr;
 	}
 	
-	return nearest_distance;
+	return HUGE_DISTANCE_SQUARED;
 }
 
 
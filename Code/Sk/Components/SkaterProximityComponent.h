@@ -56,7 +56,8 @@ public:
 	static CBaseComponent*			s_create();
 	
 	float					GetDistToLocalSkaterSquared();
-	float					GetDistToNearestSkaterSquared();
+	// Only looks as far as maxDistSqr; returns HUGE_DISTANCE squared if there's no skater that close
+	float					GetDistToNearestSkaterSquared( float maxDistSqr );
 
 protected:
 	float					mInnerRadiusSqr;
@@ -49,6 +49,10 @@ extern void test_render();
 #include <sys/File/PRE.h>
 #include <sys/File/filesys.h>
 #include <sys/File/AsyncFilesys.h>
+#include <sys/File/assetcache.h>
+#include <core/thread/jobsystem.h>
+#include <sys/File/prefetch.h>
+#include <sys/File/filewatch.h>
 #include <sys/mcman.h>
 #include <sys/config/config.h>
 
@@ -68,6 +72,7 @@ extern void test_render();
 #include <gel/music/music.h>
 #include <gel/net/net.h>
 #include <gel/assman/assman.h>
+#include <gel/assman/hotreload.h>
 #include <sk/modules/skate/skate.h>
 #include <sk/modules/FrontEnd/FrontEnd.h>
 #include <sk/objects/movingobject.h>
@@ -596,6 +601,37 @@ int main ( sint argc, char** argv )
 			File::InstallFileSystem();               
 			Mem::PopMemProfile(/*"File System"*/);
 
+			// Persistent cache of post-processed assets, off unless a directory is given,
+			// eg AssetCache=cache AssetCacheMB=512
+			{
+				const char *p_cache_mb=Config::GetCommandLineParam("AssetCacheMB",argc,argv);
+				uint32 cache_mb=p_cache_mb ? atoi(p_cache_mb) : 256;
+				if (cache_mb>4095)
+				{
+					cache_mb=4095;
+				}
+				AssetCache::Init(Config::GetCommandLineParam("AssetCache",argc,argv),cache_mb*1024*1024);
+			}
+
+			// Worker threads for background jobs, one less than the hardware threads
+			// unless overridden, eg JobWorkers=0 to run everything on the main thread
+			{
+				const char *p_workers=Config::GetCommandLineParam("JobWorkers",argc,argv);
+				Job::Init(p_workers ? atoi(p_workers) : -1);
+			}
+
+			// Read-ahead hints. Game file names are relative to DataRoot= (default is the
+			// working directory), and level access logs live in AccessLogs= if given.
+			File::InitPrefetch(Config::GetCommandLineParam("DataRoot",argc,argv),
+							   Config::GetCommandLineParam("AccessLogs",argc,argv));
+
+			// With HotReload on the command line, loose files rewritten under DataRoot
+			// are reloaded into the running game (see Ass::CHotReload)
+			if (Config::CommandLineContainsFlag("HotReload",argc,argv))
+			{
+				File::InitFileWatch(Config::GetCommandLineParam("DataRoot",argc,argv));
+			}
+
 								
 			DEBUG_FLASH(0x007f7f00);		// cyan
 								
@@ -608,6 +644,7 @@ int main ( sint argc, char** argv )
 			Spt::SingletonPtr< Inp::Manager >	inp_manager( true );
 			Spt::SingletonPtr< Gfx::Manager >	gfx_manager( true );
 			Spt::SingletonPtr< File::CAsyncFilePoll>	async_poll( true );
+			Spt::SingletonPtr< Ass::CHotReload>			hot_reload( true );
 			Mem::PopMemProfile(/*"System Singletons"*/);
 
 			DEBUG_FLASH(0x00007f7f);		// yellow
@@ -707,6 +744,7 @@ extern uint8 * RES_gamecube;
 			mdl_manager->RegisterModule ( *front );
 			mdl_manager->RegisterModule ( *skate_mod );
 			mdl_manager->RegisterModule ( *async_poll );
+			mdl_manager->RegisterModule ( *hot_reload );
 			#ifdef __NOPT_ASSERT__
 			mdl_manager->RegisterModule ( *script_debugger );
 			#endif
@@ -720,6 +758,7 @@ extern uint8 * RES_gamecube;
 			mdl_manager->StartModule( *skate_mod );      
 			mdl_manager->StartModule ( *grandpas_park_editor );
 			mdl_manager->StartModule ( *async_poll );
+			mdl_manager->StartModule ( *hot_reload );
 			
 			Mem::PopMemProfile(/*"Resgistering and starting modules"*/);
 		
@@ -810,6 +849,10 @@ extern uint8 * RES_gamecube;
 
 			Dbg_Message ( "End Application" );
 		}
+		File::DeInitFileWatch();
+		File::DeInitPrefetch();
+		Job::DeInit();
+		AssetCache::DeInit();
 		Tmr::DeInit();
 		Mem::Manager::sHandle().PopMemoryMarker(MAINLOOP_MEMMARKER);
 		Mem::Manager::sHandle().BottomUpHeap()->PopContext();
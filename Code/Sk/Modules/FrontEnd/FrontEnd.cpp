@@ -486,6 +486,10 @@ void FrontEnd::s_input_logic_code ( const Inp::Handler < FrontEnd >& handler )
 	Obj::CTracker* p_tracker = Obj::CTracker::Instance();
 	p_tracker->LogTick();
 	
+	// The composite objects aren't updated when the game is paused, so deliver anything
+	// the front end has queued here too
+	p_tracker->DispatchQueuedEvents();
+	
 	for (int count = 0;; count++)
 	{
 		uint32 event_type = 0; 
@@ -593,6 +593,7 @@ void CViewerObject::UpdateWheels()
 	{
 		Mth::Matrix* pMatrices = pCarSkeleton->GetMatrices();
 		Dbg_Assert( pMatrices );
+		pCarSkeleton->InvalidateMatrices();
 
 		// initialize the setup matrix once per frame
 		for ( int i = 0; i < GetModel()->GetNumObjectsInHierarchy(); i++ )
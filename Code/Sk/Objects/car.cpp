@@ -203,6 +203,7 @@ void CalculateCarHierarchyMatrices( Gfx::CSkeleton* pSkeleton,
 	
 	Nx::CHierarchyObject* pHierarchyObjects = p_renderedModel->GetHierarchy();
 	Mth::Matrix* pMatrices = pCarSkeleton->GetMatrices();
+	pCarSkeleton->InvalidateMatrices();
 
 	float carRotationXInRadians = Mth::DegToRad( carRotationX );
 	float wheelRotationYInRadians = Mth::DegToRad( wheelRotationY );
@@ -292,6 +293,7 @@ void CCar::display_wheels()
 		
 		Mth::Matrix* pMatrices = GetSkeleton()->GetMatrices();
 		*pMatrices = mat;
+		GetSkeleton()->InvalidateMatrices();
 	}
 }
 
@@ -50,6 +50,13 @@
 
 #include <sys/File/PRE.h>
 #include <sys/File/pip.h>
+#include <sys/File/assetcache.h>
+#include <sys/File/prefetch.h>
+#include <sys/trace.h>
+#include <gel/assman/loadgraph.h>
+#include <gel/assman/hotreload.h>
+#include <gel/object/compositeobjectmanager.h>
+#include <gel/object/updatetiming.h>
 #include <sys/replay/replay.h>
 
 #include <gfx/Nx.h>
@@ -61,6 +68,11 @@
 #include <gfx/2D/ScreenElemMan.h>
 #include <gfx/FaceMassage.h>
 #include <gfx/nxweather.h>
+#include <gfx/animlod.h>
+#include <gfx/nxanimcache.h>
+#include <gfx/nxskinning.h>
+#include <gfx/skeleton.h>
+#include <gfx/bonedanim.h>
 
 #include <sk/ParkEditor2/ParkEd.h>
 #include <sk/objects/gap.h>
@@ -584,6 +596,34 @@ SCFunction CFunctionLookupTable[]=
 	{"LoadPipPre",				Pip::ScriptLoadPipPre},
 	{"UnLoadPipPre",			Pip::ScriptUnloadPipPre},
 	{"DumpPipPreStatus",		Pip::ScriptDumpPipPreStatus},
+	{"PrewarmAssetCache",		AssetCache::ScriptPrewarmAssetCache},
+	{"TrimAssetCache",			AssetCache::ScriptTrimAssetCache},
+	{"DumpAssetCacheStatus",	AssetCache::ScriptDumpAssetCacheStatus},
+	{"LoadAssetGraph",			Ass::ScriptLoadAssetGraph},
+	{"PrefetchFiles",			File::ScriptPrefetchFiles},
+	{"BeginAccessLog",			File::ScriptBeginAccessLog},
+	{"EndAccessLog",			File::ScriptEndAccessLog},
+	{"PrefetchFromAccessLog",	File::ScriptPrefetchFromAccessLog},
+	{"StartTrace",				Trace::ScriptStartTrace},
+	{"StopTrace",				Trace::ScriptStopTrace},
+	{"HotReloadFile",			Ass::ScriptHotReloadFile},
+	{"SetCompositeUpdateByType",	Obj::ScriptSetCompositeUpdateByType},
+	{"SetParallelAnimation",		Obj::ScriptSetParallelAnimation},
+	{"SetPoseSharing",				Obj::ScriptSetPoseSharing},
+	{"BenchmarkCompositeUpdate",	Obj::ScriptBenchmarkCompositeUpdate},
+	{"SetComponentUpdateTiers",	Obj::ScriptSetComponentUpdateTiers},
+	{"GetUpdateTiming",			Obj::ScriptGetUpdateTiming},
+	{"WriteUpdateTiming",		Obj::ScriptWriteUpdateTiming},
+	{"ResetUpdateTiming",		Obj::ScriptResetUpdateTiming},
+	{"BenchmarkAnimDecode",		Gfx::ScriptBenchmarkAnimDecode},
+	{"SetAnimLOD",				Gfx::ScriptSetAnimLOD},
+	{"SetIncrementalBoneUpdate",	Gfx::ScriptSetIncrementalBoneUpdate},
+	{"SetAnimCacheBudget",		Nx::ScriptSetAnimCacheBudget},
+	{"PrintAnimCacheStats",		Nx::ScriptPrintAnimCacheStats},
+#ifdef USE_CPU_SKINNING
+	{"SetSoftwareSkinning",		Nx::ScriptSetSoftwareSkinning},
+	{"BenchmarkSkinning",		Nx::ScriptBenchmarkSkinning},
+#endif
 	{"StartServer",				CFuncs::ScriptStartServer},
 	{"SpawnCrown",				GameNet::Manager::ScriptSpawnCrown},
 	{"StartCTFGame",			GameNet::Manager::ScriptStartCTFGame},
@@ -148,18 +148,9 @@ void LoadAllStartupQBFiles()
 	}
 }
 
-// Calls the Script::LoadQB, and then do any game-specific stuff that needs to be done when a qb is reloaded, such as 
-// generating the node name hash table & prefix info
-void LoadQB(const char *p_fileName, EBoolAssertIfDuplicateSymbols assertIfDuplicateSymbols)
+// Does the game-specific processing of any NodeArray that the last load or reload created.
+static void process_reloaded_symbols()
 {
-	Dbg_MsgAssert(p_fileName,("NULL p_fileName"));
-	//if (strcmp("..\\runnow.qb",p_fileName) != 0)
-	//{
-	//	printf("Loading %s\n",p_fileName); // REMOVE
-	//}
-	// Call the non-game-specific LoadQB, which open the qb and create all the symbols defined within.
-	Script::LoadQB(p_fileName, assertIfDuplicateSymbols);
-	
 	CSymbolTableEntry *p_sym=GetNextSymbolTableEntry();
 	while (p_sym)
 	{
@@ -223,6 +214,30 @@ void LoadQB(const char *p_fileName, EBoolAssertIfDuplicateSymbols assertIfDuplic
 	RemoveChecksumNameLookupHashTable();
 }
 
+// Calls the Script::LoadQB, and then do any game-specific stuff that needs to be done when a qb is reloaded, such as 
+// generating the node name hash table & prefix info
+void LoadQB(const char *p_fileName, EBoolAssertIfDuplicateSymbols assertIfDuplicateSymbols)
+{
+	Dbg_MsgAssert(p_fileName,("NULL p_fileName"));
+	//if (strcmp("..\\runnow.qb",p_fileName) != 0)
+	//{
+	//	printf("Loading %s\n",p_fileName); // REMOVE
+	//}
+	// Call the non-game-specific LoadQB, which open the qb and create all the symbols defined within.
+	Script::LoadQB(p_fileName, assertIfDuplicateSymbols);
+
+	process_reloaded_symbols();
+}
+
+// As LoadQB, but for a qb that the caller has already read into memory, such as a loose
+// qb picked up by the hot reloader. The symbols it defines replace the existing ones.
+void ReloadQB(const char *p_fileName, uint8 *p_qb)
+{
+	Script::ReloadQB(p_fileName, p_qb);
+
+	process_reloaded_symbols();
+}
+
 // Calls the Script::UnloadQB and then does any game-specific stuff that needs to be done 
 // when a qb is unloaded, such as resetting the node name hash table & prefix info.
 void UnloadQB(uint32 fileNameChecksum)
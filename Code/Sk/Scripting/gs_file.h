@@ -12,6 +12,7 @@ using namespace Script;
 void LoadAllStartupQBFiles();
 void LoadQB(const char *p_fileName, 
 			EBoolAssertIfDuplicateSymbols assertIfDuplicateSymbols=NO_ASSERT_IF_DUPLICATE_SYMBOLS);
+void ReloadQB(const char *p_fileName, uint8 *p_qb);
 void UnloadQB(uint32 fileNameChecksum);
 uint32 GenerateFileNameChecksum(const char *p_fileName);
 void UnloadQB(const char *p_fileName);
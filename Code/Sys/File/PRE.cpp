@@ -42,6 +42,8 @@
 #include <sys/File/PRE.h>
 #include <sys/file/filesys.h>
 #include <sys/file/AsyncFilesys.h>
+#include <sys/file/prefetch.h>
+#include <sys/trace.h>
 #include <sys/config/config.h>
 
 // cd shared by the music streaming stuff...  ASSERT if file access attempted
@@ -441,6 +443,7 @@ PreFile::FileHandle *PreFile::GetContainedFile(const char *pName)
 			}	
 			Mem::PopMemProfile();
 			// need to uncompress data
+			Trace::CScope trace("pre","Decompress",pName);
 			DecodeLZSS(mp_activeFile->pCompressedData, mp_activeFile->pData, mp_activeFile->compressedDataSize);	
 		}
 #ifdef __PRE_ARAM__
@@ -502,6 +505,7 @@ void *PreFile::LoadContainedFile(const char *pName,int *p_size, void *p_dest)
 		{
 			// need to uncompress data
 			//DecodeLZSS(mp_activeFile->pCompressedData, mp_activeFile->pData, mp_activeFile->compressedDataSize);	
+			Trace::CScope trace("pre","Decompress",pName);
 			DecodeLZSS(pFile->pCompressedData, (uint8*)p_dest, pFile->compressedDataSize);	
 		}
 		else
@@ -854,6 +858,9 @@ void PreMgr::loadPre(const char *pFilename, bool async, bool dont_assert, bool u
 	}
 #	endif
 
+	RecordFileAccess( fullname );
+	Trace::CScope trace( "pre", "LoadPre", fullname );
+
 #	if !defined( __PLAT_NGC__ ) || ( defined( __PLAT_NGC__ ) && !defined( __NOPT_FINAL__ ) )
 	Tmr::Time basetime = Tmr::ElapsedTime(0);
 #endif
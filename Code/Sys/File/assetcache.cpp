@@ -0,0 +1,652 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//
+// assetcache.cpp
+//
+// Persistent content-addressed cache of post-processed asset data.
+//
+// Each entry lives in its own file in the cache directory, named after its key, so a
+// lookup is a single open with no index involved. The index file only records sizes
+// and last-use stamps so that the cache can be trimmed to its budget; an entry that is
+// missing from the index (eg after a crash) is re-registered the next time it is hit.
+//
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/file/assetcache.h>
+#include <sys/file/prefetch.h>
+#include <sys/mem/memman.h>
+#include <core/crc.h>
+#include <gel/scripting/struct.h>
+
+#if defined(__PLAT_LINUX__) || defined(__PLAT_MACOS__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define __ASSETCACHE_MMAP__
+#elif defined(__PLAT_WN32__)
+#include <direct.h>
+#endif
+
+namespace AssetCache
+{
+
+#define ASSETCACHE_MAGIC			0x42435341		// 'ASCB'
+#define ASSETCACHE_FORMAT_VERSION	1
+#define INDEX_MAGIC					0x58444941		// 'AIDX'
+
+enum
+{
+	MAX_ENTRIES=8192,
+	MAX_MAPPINGS=256,
+	MAX_PATH_LEN=256,
+};
+
+// Padded to 64 bytes so that the payload is well aligned in the mapped file.
+struct SBlobHeader
+{
+	uint32	mMagic;
+	uint32	mFormatVersion;
+	SKey	mKey;
+	uint32	mDataSize;
+	uint32	mDataCRC;
+	uint32	mPad[7];
+};
+
+struct SEntry
+{
+	SKey	mKey;
+	uint32	mFileSize;
+	uint32	mLastUse;
+};
+
+struct SIndexHeader
+{
+	uint32	mMagic;
+	uint32	mFormatVersion;
+	uint32	mNumEntries;
+	uint32	mUseClock;
+};
+
+struct SMapping
+{
+	const void *mpData;
+	void *		mpBase;
+	uint32		mLength;
+};
+
+static bool		s_enabled=false;
+static bool		s_index_dirty=false;
+static char		sp_dir[MAX_PATH_LEN];
+static uint32	s_budget=0;
+static uint32	s_use_clock=0;
+
+static SEntry	sp_entries[MAX_ENTRIES];
+static int		s_num_entries=0;
+static uint32	s_total_bytes=0;
+
+static SMapping	sp_mappings[MAX_MAPPINGS];
+
+static SStats	s_stats;
+
+static bool sKeysMatch(const SKey &a, const SKey &b)
+{
+	return a.mProcessor==b.mProcessor &&
+		   a.mVersion==b.mVersion &&
+		   a.mParams==b.mParams &&
+		   a.mSourceCRC==b.mSourceCRC &&
+		   a.mSourceSize==b.mSourceSize;
+}
+
+static void sGetEntryFileName(const SKey &key, char *p_buf)
+{
+	sprintf(p_buf,"%s/%08x_%x_%08x_%08x_%x.acb",sp_dir,key.mProcessor,key.mVersion,key.mParams,key.mSourceCRC,key.mSourceSize);
+}
+
+static void sGetIndexFileName(char *p_buf)
+{
+	sprintf(p_buf,"%s/index.dat",sp_dir);
+}
+
+static void sMakeDirectory(const char *p_dir)
+{
+	#if defined(__ASSETCACHE_MMAP__)
+	mkdir(p_dir,0755);
+	#elif defined(__PLAT_WN32__)
+	_mkdir(p_dir);
+	#endif
+}
+
+static SEntry *sFindEntry(const SKey &key)
+{
+	for (int i=0; i<s_num_entries; ++i)
+	{
+		if (sKeysMatch(sp_entries[i].mKey,key))
+		{
+			return &sp_entries[i];
+		}
+	}
+	return NULL;
+}
+
+static void sRemoveEntry(int index)
+{
+	Dbg_MsgAssert(index>=0 && index<s_num_entries,("Bad asset cache entry index %d",index));
+	s_total_bytes-=sp_entries[index].mFileSize;
+	sp_entries[index]=sp_entries[--s_num_entries];
+	s_index_dirty=true;
+}
+
+// Deletes the least recently used entry, both from disk and from the index.
+static void sEvictOldest()
+{
+	int oldest=0;
+	for (int i=1; i<s_num_entries; ++i)
+	{
+		if (sp_entries[i].mLastUse<sp_entries[oldest].mLastUse)
+		{
+			oldest=i;
+		}
+	}
+
+	char p_name[MAX_PATH_LEN];
+	sGetEntryFileName(sp_entries[oldest].mKey,p_name);
+	remove(p_name);
+	sRemoveEntry(oldest);
+	++s_stats.mEvictions;
+}
+
+// Adds or refreshes the index entry for key. Evicts the oldest entry if the index is full.
+static void sTouchEntry(const SKey &key, uint32 fileSize)
+{
+	SEntry *p_entry=sFindEntry(key);
+	if (!p_entry)
+	{
+		if (s_num_entries==MAX_ENTRIES)
+		{
+			sEvictOldest();
+		}
+		p_entry=&sp_entries[s_num_entries++];
+		p_entry->mKey=key;
+		p_entry->mFileSize=0;
+	}
+	s_total_bytes-=p_entry->mFileSize;
+	p_entry->mFileSize=fileSize;
+	s_total_bytes+=fileSize;
+	p_entry->mLastUse=++s_use_clock;
+	s_index_dirty=true;
+}
+
+static void sLoadIndex()
+{
+	char p_name[MAX_PATH_LEN];
+	sGetIndexFileName(p_name);
+
+	s_num_entries=0;
+	s_total_bytes=0;
+	s_use_clock=0;
+
+	FILE *p_file=fopen(p_name,"rb");
+	if (!p_file)
+	{
+		return;
+	}
+
+	SIndexHeader header;
+	if (fread(&header,sizeof(header),1,p_file)==1 &&
+		header.mMagic==INDEX_MAGIC &&
+		header.mFormatVersion==ASSETCACHE_FORMAT_VERSION &&
+		header.mNumEntries<=MAX_ENTRIES)
+	{
+		if (fread(sp_entries,sizeof(SEntry),header.mNumEntries,p_file)==header.mNumEntries)
+		{
+			s_num_entries=header.mNumEntries;
+			s_use_clock=header.mUseClock;
+			for (int i=0; i<s_num_entries; ++i)
+			{
+				s_total_bytes+=sp_entries[i].mFileSize;
+			}
+		}
+	}
+	fclose(p_file);
+}
+
+static void sSaveIndex()
+{
+	if (!s_index_dirty)
+	{
+		return;
+	}
+
+	char p_name[MAX_PATH_LEN];
+	sGetIndexFileName(p_name);
+
+	FILE *p_file=fopen(p_name,"wb");
+	if (!p_file)
+	{
+		Dbg_Message("Could not write asset cache index %s",p_name);
+		return;
+	}
+
+	SIndexHeader header;
+	header.mMagic=INDEX_MAGIC;
+	header.mFormatVersion=ASSETCACHE_FORMAT_VERSION;
+	header.mNumEntries=s_num_entries;
+	header.mUseClock=s_use_clock;
+	fwrite(&header,sizeof(header),1,p_file);
+	fwrite(sp_entries,sizeof(SEntry),s_num_entries,p_file);
+	fclose(p_file);
+
+	s_index_dirty=false;
+}
+
+static SMapping *sFindFreeMapping()
+{
+	for (int i=0; i<MAX_MAPPINGS; ++i)
+	{
+		if (!sp_mappings[i].mpData)
+		{
+			return &sp_mappings[i];
+		}
+	}
+	return NULL;
+}
+
+// Kilobytes from a script as bytes, stopping at 4GB rather than wrapping
+static uint32 sKBToBytes(int kb)
+{
+	if (kb<=0)
+	{
+		return 0;
+	}
+	if ((uint32)kb>=0xffffffff/1024)
+	{
+		return 0xffffffff;
+	}
+	return (uint32)kb*1024;
+}
+
+void Init(const char *p_dir, uint32 budgetBytes)
+{
+	if (s_enabled)
+	{
+		DeInit();
+	}
+
+	memset(&s_stats,0,sizeof(s_stats));
+	memset(sp_mappings,0,sizeof(sp_mappings));
+
+	if (!p_dir || !*p_dir)
+	{
+		return;
+	}
+
+	Dbg_MsgAssert(strlen(p_dir)<MAX_PATH_LEN-64,("Asset cache directory name too long: %s",p_dir));
+	strcpy(sp_dir,p_dir);
+	sMakeDirectory(sp_dir);
+
+	s_budget=budgetBytes;
+	s_enabled=true;
+	s_index_dirty=false;
+	sLoadIndex();
+
+	if (s_total_bytes>s_budget)
+	{
+		Trim(s_budget);
+	}
+
+	Dbg_Message("Asset cache: %s, %d entries, %d of %d KB used",sp_dir,s_num_entries,s_total_bytes/1024,s_budget/1024);
+}
+
+void DeInit()
+{
+	if (!s_enabled)
+	{
+		return;
+	}
+
+	for (int i=0; i<MAX_MAPPINGS; ++i)
+	{
+		Dbg_MsgAssert(sp_mappings[i].mpData==NULL,("Asset cache entry still in use at DeInit"));
+	}
+
+	sSaveIndex();
+	s_enabled=false;
+}
+
+bool IsEnabled()
+{
+	return s_enabled;
+}
+
+SKey MakeKey(uint32 processor, uint32 version, uint32 params, const void *p_source, uint32 sourceSize)
+{
+	SKey key;
+	key.mProcessor=processor;
+	key.mVersion=version;
+	key.mParams=params;
+	key.mSourceCRC=Crc::GenerateCRCCaseSensitive((const char*)p_source,sourceSize);
+	key.mSourceSize=sourceSize;
+	return key;
+}
+
+uint32 HashParams(const uint32 *p_params, int numParams)
+{
+	uint32 hash=2166136261u;
+	for (int i=0; i<numParams; ++i)
+	{
+		hash=(hash^p_params[i])*16777619u;
+	}
+	return hash;
+}
+
+const void *Lookup(const SKey &key, uint32 *p_size)
+{
+	if (!s_enabled)
+	{
+		return NULL;
+	}
+
+	char p_name[MAX_PATH_LEN];
+	sGetEntryFileName(key,p_name);
+
+	SMapping *p_mapping=sFindFreeMapping();
+	Dbg_MsgAssert(p_mapping,("Too many asset cache entries in use, increase MAX_MAPPINGS"));
+	if (!p_mapping)
+	{
+		++s_stats.mMisses;
+		return NULL;
+	}
+
+	uint8 *p_base=NULL;
+	uint32 file_size=0;
+
+	#ifdef __ASSETCACHE_MMAP__
+	int fd=open(p_name,O_RDONLY);
+	if (fd>=0)
+	{
+		struct stat st;
+		if (fstat(fd,&st)==0 && st.st_size>=(off_t)sizeof(SBlobHeader))
+		{
+			void *p_map=mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+			if (p_map!=MAP_FAILED)
+			{
+				p_base=(uint8*)p_map;
+				file_size=(uint32)st.st_size;
+			}
+		}
+		close(fd);
+	}
+	#else
+	FILE *p_file=fopen(p_name,"rb");
+	if (p_file)
+	{
+		fseek(p_file,0,SEEK_END);
+		long size=ftell(p_file);
+		fseek(p_file,0,SEEK_SET);
+		if (size>=(long)sizeof(SBlobHeader))
+		{
+			p_base=(uint8*)Mem::Malloc(size);
+			if (fread(p_base,1,size,p_file)==(size_t)size)
+			{
+				file_size=(uint32)size;
+			}
+			else
+			{
+				Mem::Free(p_base);
+				p_base=NULL;
+			}
+		}
+		fclose(p_file);
+	}
+	#endif
+
+	if (!p_base)
+	{
+		++s_stats.mMisses;
+		return NULL;
+	}
+
+	// Validate the header. The key is part of the file name, but checking it again
+	// guards against hash collisions in the name and half-written files.
+	SBlobHeader *p_header=(SBlobHeader*)p_base;
+	bool valid=p_header->mMagic==ASSETCACHE_MAGIC &&
+			   p_header->mFormatVersion==ASSETCACHE_FORMAT_VERSION &&
+			   sKeysMatch(p_header->mKey,key) &&
+			   p_header->mDataSize==file_size-sizeof(SBlobHeader);
+	if (valid)
+	{
+		valid=Crc::GenerateCRCCaseSensitive((const char*)(p_header+1),p_header->mDataSize)==p_header->mDataCRC;
+	}
+
+	if (!valid)
+	{
+		#ifdef __ASSETCACHE_MMAP__
+		munmap(p_base,file_size);
+		#else
+		Mem::Free(p_base);
+		#endif
+		remove(p_name);
+		++s_stats.mMisses;
+		return NULL;
+	}
+
+	p_mapping->mpData=p_header+1;
+	p_mapping->mpBase=p_base;
+	p_mapping->mLength=file_size;
+
+	sTouchEntry(key,file_size);
+	++s_stats.mHits;
+
+	if (p_size)
+	{
+		*p_size=p_header->mDataSize;
+	}
+	return p_mapping->mpData;
+}
+
+void Release(const void *p_data)
+{
+	if (!p_data)
+	{
+		return;
+	}
+
+	for (int i=0; i<MAX_MAPPINGS; ++i)
+	{
+		SMapping *p_mapping=&sp_mappings[i];
+		if (p_mapping->mpData==p_data)
+		{
+			#ifdef __ASSETCACHE_MMAP__
+			munmap(p_mapping->mpBase,p_mapping->mLength);
+			#else
+			Mem::Free(p_mapping->mpBase);
+			#endif
+			p_mapping->mpData=NULL;
+			p_mapping->mpBase=NULL;
+			p_mapping->mLength=0;
+			return;
+		}
+	}
+
+	Dbg_MsgAssert(0,("Asset cache Release called with unknown pointer %p",p_data));
+}
+
+bool Store(const SKey &key, const void *p_data, uint32 size)
+{
+	if (!s_enabled)
+	{
+		return false;
+	}
+
+	uint32 file_size=sizeof(SBlobHeader)+size;
+	if (file_size>s_budget)
+	{
+		// Would be evicted straight away.
+		return false;
+	}
+
+	char p_name[MAX_PATH_LEN];
+	sGetEntryFileName(key,p_name);
+
+	// Write to a temporary file and rename it into place, so that a concurrent or
+	// interrupted run never sees a partially written entry under the real name.
+	char p_temp_name[MAX_PATH_LEN];
+	sprintf(p_temp_name,"%s.tmp",p_name);
+
+	FILE *p_file=fopen(p_temp_name,"wb");
+	if (!p_file)
+	{
+		return false;
+	}
+
+	SBlobHeader header;
+	memset(&header,0,sizeof(header));
+	header.mMagic=ASSETCACHE_MAGIC;
+	header.mFormatVersion=ASSETCACHE_FORMAT_VERSION;
+	header.mKey=key;
+	header.mDataSize=size;
+	header.mDataCRC=Crc::GenerateCRCCaseSensitive((const char*)p_data,size);
+
+	bool ok=fwrite(&header,sizeof(header),1,p_file)==1 &&
+			fwrite(p_data,1,size,p_file)==size;
+	ok=(fclose(p_file)==0) && ok;
+
+	if (ok)
+	{
+		remove(p_name);
+		ok=rename(p_temp_name,p_name)==0;
+	}
+
+	if (!ok)
+	{
+		remove(p_temp_name);
+		return false;
+	}
+
+	sTouchEntry(key,file_size);
+	++s_stats.mStores;
+
+	if (s_total_bytes>s_budget)
+	{
+		Trim(s_budget);
+	}
+	return true;
+}
+
+void Trim(uint32 budgetBytes)
+{
+	if (!s_enabled)
+	{
+		return;
+	}
+
+	while (s_total_bytes>budgetBytes && s_num_entries)
+	{
+		sEvictOldest();
+	}
+
+	sSaveIndex();
+}
+
+int Prewarm(uint32 maxBytes)
+{
+	if (!s_enabled || !s_num_entries)
+	{
+		return 0;
+	}
+
+	// Walk the entries from most to least recently used. Selection rather than a sort,
+	// so that the index itself is left untouched.
+	uint32 below=0xffffffff;
+	uint32 bytes=0;
+	int count=0;
+	char p_name[MAX_PATH_LEN];
+
+	while (bytes<maxBytes)
+	{
+		SEntry *p_newest=NULL;
+		for (int i=0; i<s_num_entries; ++i)
+		{
+			if (sp_entries[i].mLastUse<below && (!p_newest || sp_entries[i].mLastUse>p_newest->mLastUse))
+			{
+				p_newest=&sp_entries[i];
+			}
+		}
+		if (!p_newest)
+		{
+			break;
+		}
+		below=p_newest->mLastUse;
+
+		sGetEntryFileName(p_newest->mKey,p_name);
+		File::PrefetchHostFile(p_name);
+
+		bytes+=p_newest->mFileSize;
+		++count;
+	}
+	return count;
+}
+
+void GetStats(SStats *p_stats)
+{
+	Dbg_Assert(p_stats);
+	*p_stats=s_stats;
+	p_stats->mNumEntries=s_num_entries;
+	p_stats->mTotalBytes=s_total_bytes;
+	p_stats->mBudgetBytes=s_budget;
+}
+
+// @script | PrewarmAssetCache | Starts the OS reading the most recently used asset cache
+// entries, so that the next level load finds them already in memory.
+// @parmopt int | MaxKB | whole cache | Stop after this many kilobytes.
+bool ScriptPrewarmAssetCache(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	int max_kb=0;
+	uint32 max_bytes=0xffffffff;
+	if (pParams->GetInteger("MaxKB",&max_kb) && max_kb>0)
+	{
+		max_bytes=sKBToBytes(max_kb);
+	}
+
+	int count=Prewarm(max_bytes);
+	Dbg_Message("Asset cache: prewarmed %d entries",count);
+	return true;
+}
+
+// @script | TrimAssetCache | Evicts least recently used asset cache entries.
+// @parmopt int | BudgetKB | current budget | Trim down to this many kilobytes.
+bool ScriptTrimAssetCache(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	int budget_kb=0;
+	uint32 budget=s_budget;
+	if (pParams->GetInteger("BudgetKB",&budget_kb))
+	{
+		budget=sKBToBytes(budget_kb);
+	}
+
+	Trim(budget);
+	return true;
+}
+
+// @script | DumpAssetCacheStatus | Prints the asset cache hit rate and usage.
+bool ScriptDumpAssetCacheStatus(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	if (!s_enabled)
+	{
+		printf("Asset cache disabled\n");
+		return true;
+	}
+
+	uint32 lookups=s_stats.mHits+s_stats.mMisses;
+	printf("Asset cache: %s\n",sp_dir);
+	printf("Entries:%d  Used:%dKB  Budget:%dKB\n",s_num_entries,s_total_bytes/1024,s_budget/1024);
+	printf("Hits:%d  Misses:%d (%d%% hit rate)  Stores:%d  Evictions:%d\n",
+		   s_stats.mHits,s_stats.mMisses,lookups ? (s_stats.mHits*100)/lookups : 0,
+		   s_stats.mStores,s_stats.mEvictions);
+	return true;
+}
+
+} // namespace AssetCache
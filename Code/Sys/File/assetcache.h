@@ -0,0 +1,110 @@
+/*****************************************************************************
+**																			**
+**			              Neversoft Entertainment	                        **
+**																		   	**
+**				   Copyright (C) 1999 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		Sys Library												**
+**																			**
+**	Module:			File													**
+**																			**
+**	File name:		sys/file/assetcache.h									**
+**																			**
+**	Description:	Persistent, content-addressed cache of post-processed	**
+**					asset data. Entries are keyed by a checksum of the		**
+**					unprocessed source bytes plus the processor identity,	**
+**					version and settings, so a stale entry can never be		**
+**					returned; it simply stops being looked up and ages out	**
+**					under the size budget.									**
+**																			**
+*****************************************************************************/
+
+#ifndef	__SYS_FILE_ASSETCACHE_H
+#define	__SYS_FILE_ASSETCACHE_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#ifndef __CORE_DEFINES_H
+#include <core/defines.h>
+#endif
+
+/*****************************************************************************
+**							Forward Declarations							**
+*****************************************************************************/
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
+namespace AssetCache
+{
+
+/*****************************************************************************
+**							     Type Defines								**
+*****************************************************************************/
+
+struct SKey
+{
+	uint32	mProcessor;			// Checksum of the processor name
+	uint32	mVersion;			// Bump whenever the processor's output format or algorithm changes
+	uint32	mParams;			// Checksum of any processor settings that affect the output
+	uint32	mSourceCRC;			// Crc::GenerateCRC of the unprocessed source bytes
+	uint32	mSourceSize;
+};
+
+struct SStats
+{
+	uint32	mHits;
+	uint32	mMisses;
+	uint32	mStores;
+	uint32	mEvictions;
+	uint32	mNumEntries;
+	uint32	mTotalBytes;
+	uint32	mBudgetBytes;
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// p_dir is created if needed. Passing NULL leaves the cache disabled, in which case
+// Lookup always misses and Store does nothing, so callers never need to check.
+void			Init(const char *p_dir, uint32 budgetBytes);
+void			DeInit();
+bool			IsEnabled();
+
+SKey			MakeKey(uint32 processor, uint32 version, uint32 params, const void *p_source, uint32 sourceSize);
+
+// Folds a processor's settings into one mParams value, hashing each field on its own
+// (FNV-1a) so that settings which differ in more than one field can't cancel out.
+uint32			HashParams(const uint32 *p_params, int numParams);
+
+// Returns a read-only pointer to the processed data (memory mapped where the platform
+// allows it), or NULL on a miss. Every non-NULL result must be handed back to Release.
+const void *	Lookup(const SKey &key, uint32 *p_size);
+void			Release(const void *p_data);
+
+bool			Store(const SKey &key, const void *p_data, uint32 size);
+
+// Evicts least recently used entries until the cache fits in budgetBytes.
+void			Trim(uint32 budgetBytes);
+
+// Asks the OS to start reading the most recently used entries (up to maxBytes) so the
+// next level load finds them in the page cache. Returns the number of entries touched.
+int				Prewarm(uint32 maxBytes);
+
+void			GetStats(SStats *p_stats);
+
+bool 			ScriptPrewarmAssetCache(Script::CStruct *pParams, Script::CScript *pScript);
+bool 			ScriptTrimAssetCache(Script::CStruct *pParams, Script::CScript *pScript);
+bool 			ScriptDumpAssetCacheStatus(Script::CStruct *pParams, Script::CScript *pScript);
+
+} // namespace AssetCache
+
+#endif  // __SYS_FILE_ASSETCACHE_H
@@ -0,0 +1,313 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//
+// filewatch.cpp
+//
+// Change notification for the loose files under the data root, used for hot reloading.
+//
+// On Linux this is inotify, with one watch per directory since inotify does not recurse.
+// New directories get watched as they appear. Files are reported when they are closed
+// after writing, or renamed into place, which covers both the tools that write in place
+// and the editors that save to a temporary and rename it. Elsewhere there is no watcher
+// and InitFileWatch just returns false.
+//
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/file/filewatch.h>
+
+#ifdef __PLAT_LINUX__
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+#define __FILEWATCH_INOTIFY__
+#endif
+
+namespace File
+{
+
+static char		sp_data_root[MAX_WATCHED_PATH_LEN]=".";
+
+void GetLooseFilePath(const char *p_name, char *p_path)
+{
+	if (*p_name)
+	{
+		snprintf(p_path,MAX_WATCHED_PATH_LEN,"%s/%s",sp_data_root,p_name);
+	}
+	else
+	{
+		snprintf(p_path,MAX_WATCHED_PATH_LEN,"%s",sp_data_root);
+	}
+
+	#ifndef __PLAT_WN32__
+	for (char *p_ch=p_path; *p_ch; ++p_ch)
+	{
+		if (*p_ch=='\\')
+		{
+			*p_ch='/';
+		}
+	}
+	#endif
+}
+
+#ifdef __FILEWATCH_INOTIFY__
+
+enum
+{
+	MAX_WATCHES=1024,
+	MAX_DIR_LEN=128,
+	MAX_PENDING=64,
+	EVENT_BUFFER_SIZE=4096,
+	WATCH_MASK=IN_CLOSE_WRITE|IN_MOVED_TO|IN_CREATE,
+};
+
+static int		s_fd=-1;
+
+// The directory each watch is on, relative to the data root in game form (eg "scripts\\game").
+static int		sp_watch_ids[MAX_WATCHES];
+static char		sp_watch_dirs[MAX_WATCHES][MAX_DIR_LEN];
+static int		s_num_watches=0;
+
+// Changed files that have not been handed out yet, as game file names.
+static char		sp_pending[MAX_PENDING][MAX_WATCHED_PATH_LEN];
+static int		s_num_pending=0;
+static int		s_next_pending=0;
+
+// Editor backups, swap files and the like.
+static bool sIgnoreName(const char *p_name)
+{
+	int len=strlen(p_name);
+	return !len || p_name[0]=='.' || p_name[len-1]=='~';
+}
+
+static void sAddWatchTree(const char *p_dir)
+{
+	if (s_num_watches==MAX_WATCHES)
+	{
+		Dbg_Message("File watch: out of watches, %s and below will not hot reload",p_dir);
+		return;
+	}
+
+	char p_path[MAX_WATCHED_PATH_LEN];
+	GetLooseFilePath(p_dir,p_path);
+
+	int wd=inotify_add_watch(s_fd,p_path,WATCH_MASK);
+	if (wd<0)
+	{
+		return;
+	}
+
+	// inotify hands back the same descriptor if a directory is added twice.
+	for (int i=0; i<s_num_watches; ++i)
+	{
+		if (sp_watch_ids[i]==wd)
+		{
+			return;
+		}
+	}
+	sp_watch_ids[s_num_watches]=wd;
+	strncpy(sp_watch_dirs[s_num_watches],p_dir,MAX_DIR_LEN-1);
+	sp_watch_dirs[s_num_watches][MAX_DIR_LEN-1]=0;
+	++s_num_watches;
+
+	DIR *p_dir_handle=opendir(p_path);
+	if (!p_dir_handle)
+	{
+		return;
+	}
+
+	struct dirent *p_entry;
+	while ((p_entry=readdir(p_dir_handle)))
+	{
+		if (sIgnoreName(p_entry->d_name))
+		{
+			continue;
+		}
+
+		char p_sub_dir[MAX_DIR_LEN];
+		if (*p_dir)
+		{
+			snprintf(p_sub_dir,MAX_DIR_LEN,"%s\\%s",p_dir,p_entry->d_name);
+		}
+		else
+		{
+			snprintf(p_sub_dir,MAX_DIR_LEN,"%s",p_entry->d_name);
+		}
+
+		bool is_dir=p_entry->d_type==DT_DIR;
+		if (p_entry->d_type==DT_UNKNOWN)
+		{
+			char p_sub_path[MAX_WATCHED_PATH_LEN];
+			struct stat info;
+			GetLooseFilePath(p_sub_dir,p_sub_path);
+			is_dir=stat(p_sub_path,&info)==0 && S_ISDIR(info.st_mode);
+		}
+
+		if (is_dir)
+		{
+			sAddWatchTree(p_sub_dir);
+		}
+	}
+	closedir(p_dir_handle);
+}
+
+static const char *sGetWatchDir(int wd)
+{
+	for (int i=0; i<s_num_watches; ++i)
+	{
+		if (sp_watch_ids[i]==wd)
+		{
+			return sp_watch_dirs[i];
+		}
+	}
+	return NULL;
+}
+
+static void sAddPending(const char *p_name)
+{
+	for (int i=s_next_pending; i<s_num_pending; ++i)
+	{
+		if (strcmp(sp_pending[i],p_name)==0)
+		{
+			return;
+		}
+	}
+
+	if (s_num_pending==MAX_PENDING)
+	{
+		Dbg_Message("File watch: too many changes at once, not reloading %s",p_name);
+		return;
+	}
+	strcpy(sp_pending[s_num_pending++],p_name);
+}
+
+static void sReadEvents()
+{
+	char p_buffer[EVENT_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	while (true)
+	{
+		int len=read(s_fd,p_buffer,sizeof(p_buffer));
+		if (len<=0)
+		{
+			// EAGAIN, nothing more this frame.
+			break;
+		}
+
+		for (char *p_ev=p_buffer; p_ev<p_buffer+len; )
+		{
+			struct inotify_event *p_event=(struct inotify_event*)p_ev;
+			p_ev+=sizeof(struct inotify_event)+p_event->len;
+
+			const char *p_dir=sGetWatchDir(p_event->wd);
+			if (!p_dir || !p_event->len || sIgnoreName(p_event->name))
+			{
+				continue;
+			}
+
+			char p_name[MAX_WATCHED_PATH_LEN];
+			if (*p_dir)
+			{
+				snprintf(p_name,MAX_WATCHED_PATH_LEN,"%s\\%s",p_dir,p_event->name);
+			}
+			else
+			{
+				snprintf(p_name,MAX_WATCHED_PATH_LEN,"%s",p_event->name);
+			}
+
+			if (p_event->mask&IN_ISDIR)
+			{
+				if (p_event->mask&(IN_CREATE|IN_MOVED_TO))
+				{
+					sAddWatchTree(p_name);
+				}
+			}
+			else if (p_event->mask&(IN_CLOSE_WRITE|IN_MOVED_TO))
+			{
+				sAddPending(p_name);
+			}
+		}
+	}
+}
+
+#endif // __FILEWATCH_INOTIFY__
+
+bool InitFileWatch(const char *p_dataRoot)
+{
+	strncpy(sp_data_root,p_dataRoot ? p_dataRoot : ".",MAX_WATCHED_PATH_LEN-1);
+	sp_data_root[MAX_WATCHED_PATH_LEN-1]=0;
+
+	#ifdef __FILEWATCH_INOTIFY__
+	Dbg_MsgAssert(s_fd<0,("File watch already initialised"));
+
+	s_fd=inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+	if (s_fd<0)
+	{
+		Dbg_Message("File watch: inotify is not available");
+		return false;
+	}
+
+	s_num_watches=0;
+	s_num_pending=0;
+	s_next_pending=0;
+	sAddWatchTree("");
+
+	Dbg_Message("File watch: watching %d directories under %s",s_num_watches,sp_data_root);
+	return true;
+	#else
+	return false;
+	#endif
+}
+
+void DeInitFileWatch()
+{
+	#ifdef __FILEWATCH_INOTIFY__
+	if (s_fd>=0)
+	{
+		// Closing the descriptor drops all the watches on it.
+		close(s_fd);
+		s_fd=-1;
+		s_num_watches=0;
+	}
+	#endif
+}
+
+bool FileWatchActive()
+{
+	#ifdef __FILEWATCH_INOTIFY__
+	return s_fd>=0;
+	#else
+	return false;
+	#endif
+}
+
+bool GetNextChangedFile(char *p_name, char *p_path)
+{
+	#ifdef __FILEWATCH_INOTIFY__
+	if (s_fd<0)
+	{
+		return false;
+	}
+
+	if (s_next_pending==s_num_pending)
+	{
+		s_num_pending=0;
+		s_next_pending=0;
+		sReadEvents();
+		if (!s_num_pending)
+		{
+			return false;
+		}
+	}
+
+	strcpy(p_name,sp_pending[s_next_pending++]);
+	GetLooseFilePath(p_name,p_path);
+	return true;
+	#else
+	return false;
+	#endif
+}
+
+} // namespace File
@@ -0,0 +1,65 @@
+/*****************************************************************************
+**																			**
+**			              Neversoft Entertainment	                        **
+**																		   	**
+**				   Copyright (C) 1999 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		Sys Library												**
+**																			**
+**	Module:			File													**
+**																			**
+**	File name:		sys/file/filewatch.h									**
+**																			**
+**	Description:	Watches the loose files under the data root and reports	**
+**					the ones that have been rewritten, so that they can be	**
+**					reloaded into the running game.							**
+**																			**
+*****************************************************************************/
+
+#ifndef	__SYS_FILE_FILEWATCH_H
+#define	__SYS_FILE_FILEWATCH_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#ifndef __CORE_DEFINES_H
+#include <core/defines.h>
+#endif
+
+namespace File
+{
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+enum
+{
+	MAX_WATCHED_PATH_LEN=256,
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// Starts watching every directory under p_dataRoot (the working directory if NULL).
+// Returns false if the platform has no change notification.
+bool	InitFileWatch(const char *p_dataRoot);
+void	DeInitFileWatch();
+bool	FileWatchActive();
+
+// Host path of the loose copy of a game file, under the data root given to InitFileWatch.
+void	GetLooseFilePath(const char *p_name, char *p_path);
+
+// Returns the next file that has been written since the last call, or false if there
+// are none. p_name gets the game file name (eg "scripts\\game\\skater.qb") and p_path
+// the path on the host. Both must be MAX_WATCHED_PATH_LEN long. A file saved several
+// times in one frame is only returned once.
+bool	GetNextChangedFile(char *p_name, char *p_path);
+
+} // namespace File
+
+#endif  // __SYS_FILE_FILEWATCH_H
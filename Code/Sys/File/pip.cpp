@@ -37,6 +37,8 @@
 #include <gel/scripting/checksum.h>
 #include <gel/scripting/struct.h>
 #include <sys/file/filesys.h>
+#include <sys/file/prefetch.h>
+#include <sys/trace.h>
 #include <core/compress.h>
 
 namespace Pip
@@ -426,6 +428,7 @@ void LoadPre(const char *p_preFileName)
 		if (p_source_contained->mCompressedSize)
 		{
 			uint32 num_bytes_decompressed=p_dest_contained->mDataSize;
+			Trace::CScope trace("pip","Decompress",p_source_contained->mpName);
 			uint8 *p_end=DecodeLZSS(p_source,p_dest,p_source_contained->mCompressedSize);
 			Dbg_MsgAssert(p_end==p_dest+num_bytes_decompressed,("Eh? DecodeLZSS wrote %d bytes, expected it to write %d",p_end-p_dest,num_bytes_decompressed));
 
@@ -572,6 +575,7 @@ static const char *sGetPreName(SPreContained *p_contained_file)
 
 void* Load(const char* p_fileName)
 {
+	Trace::CScope trace("pip","Load",p_fileName);
 	uint32 filename_checksum=Crc::GenerateCRCFromString(p_fileName);
 	
 	// First, see if the file is in one of the loaded pre files.
@@ -935,6 +939,7 @@ void * LoadAlloc(const char *p_fileName, int *p_filesize, void *p_dest, int maxS
 	// Mick 2/19/2003 - Removed code that stripped project specific headers
 	// as this is now handled at the gs_file level
 	
+	Trace::CScope trace("file","LoadAlloc",p_fileName);
 	int	file_size = 0;
 // Perhaps the file is in a PRE file,  so try loading it directly, as that will be quickest
 	uint8 *p_file_data = (uint8*)File::PreMgr::Instance()->LoadFile(p_fileName,&file_size, p_dest);
@@ -970,7 +975,10 @@ void * LoadAlloc(const char *p_fileName, int *p_filesize, void *p_dest, int maxS
 			// can't load quickly, so probably loading from the PC
 			// Open the file & get its file size
 
+			RecordFileAccess(p_fileName);
+			uint64 open_start=Trace::GetTimeUS();
 			void *p_file = File::Open(p_fileName, "rb");
+			Trace::AddSpan("file","Open",p_fileName,open_start,Trace::GetTimeUS());
 			if (!p_file)
 			{
 				Dbg_MsgAssert(0,("Could not open file '%s'",p_fileName));
@@ -997,6 +1005,7 @@ void * LoadAlloc(const char *p_fileName, int *p_filesize, void *p_dest, int maxS
 				p_file_data = (uint8*)p_dest;
 			}
 			// Load the file into memory then close the file.
+			Trace::CScope read_trace("file","Read",p_fileName);
 			#ifdef __NOPT_ASSERT__
 			long bytes_read=File::Read(p_file_data, 1, file_size, p_file);
 			Dbg_MsgAssert(bytes_read<=file_size,("bytes_read>file_size ?"));
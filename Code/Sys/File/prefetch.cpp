@@ -0,0 +1,364 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//
+// prefetch.cpp
+//
+// Read-ahead hints and level access logs.
+//
+// Where the OS has an advisory API the hint is just posix_fadvise(WILLNEED), which
+// queues the read in the kernel and returns straight away. Elsewhere a job reads the
+// file through a scratch buffer on a worker thread, which has the same effect of
+// leaving it in the OS cache for when the loader gets to it.
+//
+// An access log is a plain text list of file names, one per line, in the order they
+// were first loaded, so it can be edited by hand if need be.
+//
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/file/prefetch.h>
+#include <core/crc.h>
+#include <core/thread/jobsystem.h>
+#include <gel/scripting/struct.h>
+#include <gel/scripting/array.h>
+
+#if defined(__PLAT_LINUX__) || defined(__PLAT_MACOS__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(POSIX_FADV_WILLNEED)
+#define __PREFETCH_FADVISE__
+#endif
+
+namespace File
+{
+
+enum
+{
+	MAX_PATH_LEN=256,
+	MAX_LOG_ENTRIES=1024,
+	MAX_LOG_NAME_LEN=128,
+	MAX_PREFETCH_JOBS=4,
+	PREFETCH_BLOCK_SIZE=64*1024,
+};
+
+struct SPrefetchJob
+{
+	char		mpPath[MAX_PATH_LEN];
+	uint8		mpBlock[PREFETCH_BLOCK_SIZE];
+	bool		mBusy;					// only read or written on the main thread
+};
+
+static char		sp_data_root[MAX_PATH_LEN];
+static char		sp_log_dir[MAX_PATH_LEN];
+static bool		s_log_enabled=false;
+
+// The log being recorded, if any.
+static bool		s_recording=false;
+static char		sp_log_name[MAX_LOG_NAME_LEN];
+static char		sp_log[MAX_LOG_ENTRIES][MAX_LOG_NAME_LEN];
+static uint32	sp_log_checksums[MAX_LOG_ENTRIES];
+static int		s_num_logged=0;
+
+#ifndef __PREFETCH_FADVISE__
+static SPrefetchJob		sp_jobs[MAX_PREFETCH_JOBS];
+static Job::CCounter	sp_job_counters[MAX_PREFETCH_JOBS];
+#endif
+
+static void sGetHostPath(const char *p_fileName, char *p_buf)
+{
+	if (*sp_data_root)
+	{
+		snprintf(p_buf,MAX_PATH_LEN,"%s/%s",sp_data_root,p_fileName);
+	}
+	else
+	{
+		snprintf(p_buf,MAX_PATH_LEN,"%s",p_fileName);
+	}
+
+	#ifndef __PLAT_WN32__
+	for (char *p_ch=p_buf; *p_ch; ++p_ch)
+	{
+		if (*p_ch=='\\')
+		{
+			*p_ch='/';
+		}
+	}
+	#endif
+}
+
+static void sGetLogPath(const char *p_logName, char *p_buf)
+{
+	snprintf(p_buf,MAX_PATH_LEN,"%s/%s.acl",sp_log_dir,p_logName);
+}
+
+#ifndef __PREFETCH_FADVISE__
+// Runs on a worker, so sticks to stdio and the slot's own buffer.
+static void sPrefetchJob(void *p_data)
+{
+	SPrefetchJob *p_job=(SPrefetchJob*)p_data;
+	FILE *p_file=fopen(p_job->mpPath,"rb");
+	if (p_file)
+	{
+		while (fread(p_job->mpBlock,1,PREFETCH_BLOCK_SIZE,p_file)==PREFETCH_BLOCK_SIZE)
+		{
+		}
+		fclose(p_file);
+	}
+}
+
+static SPrefetchJob *sGetFreeJob(Job::CCounter **pp_counter)
+{
+	for (int i=0; i<MAX_PREFETCH_JOBS; ++i)
+	{
+		if (sp_jobs[i].mBusy && sp_job_counters[i].IsDone())
+		{
+			sp_jobs[i].mBusy=false;
+		}
+		if (!sp_jobs[i].mBusy)
+		{
+			*pp_counter=&sp_job_counters[i];
+			return &sp_jobs[i];
+		}
+	}
+	return NULL;
+}
+#endif
+
+void InitPrefetch(const char *p_dataRoot, const char *p_logDir)
+{
+	*sp_data_root=0;
+	if (p_dataRoot)
+	{
+		strncpy(sp_data_root,p_dataRoot,MAX_PATH_LEN-1);
+		sp_data_root[MAX_PATH_LEN-1]=0;
+	}
+
+	s_log_enabled=false;
+	if (p_logDir)
+	{
+		strncpy(sp_log_dir,p_logDir,MAX_PATH_LEN-1);
+		sp_log_dir[MAX_PATH_LEN-1]=0;
+		s_log_enabled=true;
+	}
+}
+
+void DeInitPrefetch()
+{
+	if (s_recording)
+	{
+		EndAccessLog();
+	}
+
+	#ifndef __PREFETCH_FADVISE__
+	for (int i=0; i<MAX_PREFETCH_JOBS; ++i)
+	{
+		if (sp_jobs[i].mBusy)
+		{
+			Job::Wait(&sp_job_counters[i]);
+			sp_jobs[i].mBusy=false;
+		}
+	}
+	#endif
+}
+
+bool PrefetchHostFile(const char *p_path)
+{
+	Dbg_MsgAssert(p_path && strlen(p_path)<MAX_PATH_LEN,("Bad prefetch path"));
+
+	#ifdef __PREFETCH_FADVISE__
+	int fd=open(p_path,O_RDONLY);
+	if (fd<0)
+	{
+		return false;
+	}
+	posix_fadvise(fd,0,0,POSIX_FADV_WILLNEED);
+	close(fd);
+	return true;
+	#else
+	// Not worth tying up the main thread to warm the cache, so if every slot
+	// is busy this file just goes without.
+	Job::CCounter *p_counter=NULL;
+	SPrefetchJob *p_job=sGetFreeJob(&p_counter);
+	if (!p_job)
+	{
+		return false;
+	}
+	strcpy(p_job->mpPath,p_path);
+	p_job->mBusy=true;
+	Job::Kick(sPrefetchJob,p_job,p_counter);
+	return true;
+	#endif
+}
+
+bool Prefetch(const char *p_fileName)
+{
+	Dbg_MsgAssert(p_fileName,("NULL p_fileName"));
+
+	char p_path[MAX_PATH_LEN];
+	sGetHostPath(p_fileName,p_path);
+	return PrefetchHostFile(p_path);
+}
+
+int Prefetch(const char **pp_fileNames, int numFiles)
+{
+	int count=0;
+	for (int i=0; i<numFiles; ++i)
+	{
+		if (Prefetch(pp_fileNames[i]))
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+void RecordFileAccess(const char *p_fileName)
+{
+	if (!s_recording || !p_fileName)
+	{
+		return;
+	}
+
+	uint32 checksum=Crc::GenerateCRCFromString(p_fileName);
+	for (int i=0; i<s_num_logged; ++i)
+	{
+		if (sp_log_checksums[i]==checksum)
+		{
+			return;
+		}
+	}
+
+	if (s_num_logged==MAX_LOG_ENTRIES || strlen(p_fileName)>=MAX_LOG_NAME_LEN)
+	{
+		return;
+	}
+
+	strcpy(sp_log[s_num_logged],p_fileName);
+	sp_log_checksums[s_num_logged]=checksum;
+	++s_num_logged;
+}
+
+void BeginAccessLog(const char *p_logName)
+{
+	Dbg_MsgAssert(p_logName,("NULL p_logName"));
+	if (!s_log_enabled)
+	{
+		return;
+	}
+
+	Dbg_MsgAssert(!s_recording,("Already recording access log %s",sp_log_name));
+	strncpy(sp_log_name,p_logName,MAX_LOG_NAME_LEN-1);
+	sp_log_name[MAX_LOG_NAME_LEN-1]=0;
+	s_num_logged=0;
+	s_recording=true;
+}
+
+void EndAccessLog()
+{
+	if (!s_recording)
+	{
+		return;
+	}
+	s_recording=false;
+
+	char p_path[MAX_PATH_LEN];
+	sGetLogPath(sp_log_name,p_path);
+	FILE *p_file=fopen(p_path,"w");
+	if (!p_file)
+	{
+		Dbg_Message("Could not write access log %s",p_path);
+		return;
+	}
+	for (int i=0; i<s_num_logged; ++i)
+	{
+		fprintf(p_file,"%s\n",sp_log[i]);
+	}
+	fclose(p_file);
+
+	Dbg_Message("Wrote access log %s (%d files)",p_path,s_num_logged);
+}
+
+int PrefetchFromAccessLog(const char *p_logName)
+{
+	Dbg_MsgAssert(p_logName,("NULL p_logName"));
+	if (!s_log_enabled)
+	{
+		return 0;
+	}
+
+	char p_path[MAX_PATH_LEN];
+	sGetLogPath(p_logName,p_path);
+	FILE *p_file=fopen(p_path,"r");
+	if (!p_file)
+	{
+		// No log yet, this is the first time this level has been loaded.
+		return 0;
+	}
+
+	int count=0;
+	char p_line[MAX_LOG_NAME_LEN];
+	while (fgets(p_line,sizeof(p_line),p_file))
+	{
+		int len=strlen(p_line);
+		while (len && (p_line[len-1]=='\n' || p_line[len-1]=='\r'))
+		{
+			p_line[--len]=0;
+		}
+		if (len && Prefetch(p_line))
+		{
+			++count;
+		}
+	}
+	fclose(p_file);
+	return count;
+}
+
+// @script | PrefetchFiles | Starts the OS reading files that are about to be loaded.
+// @parm array | files | Array of file names, as they would be passed to the loaders
+bool ScriptPrefetchFiles(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	Script::CArray *p_files=NULL;
+	pParams->GetArray("files",&p_files,Script::ASSERT);
+
+	for (uint32 i=0; i<p_files->GetSize(); ++i)
+	{
+		Prefetch(p_files->GetString(i));
+	}
+	return true;
+}
+
+// @script | BeginAccessLog | Starts recording every file loaded from disk, to be saved
+// by EndAccessLog and replayed by PrefetchFromAccessLog. Does nothing unless the game
+// was started with an AccessLogs= directory.
+// @parm name | name | Name of the log, normally the level
+bool ScriptBeginAccessLog(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	const char *p_name=NULL;
+	pParams->GetText("name",&p_name,true);
+	BeginAccessLog(p_name);
+	return true;
+}
+
+// @script | EndAccessLog | Stops recording and saves the access log started by BeginAccessLog
+bool ScriptEndAccessLog(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	EndAccessLog();
+	return true;
+}
+
+// @script | PrefetchFromAccessLog | Starts the OS reading every file in a saved access
+// log. Returns false if there is no log of that name.
+// @parm name | name | Name of the log, normally the level
+bool ScriptPrefetchFromAccessLog(Script::CStruct *pParams, Script::CScript *pScript)
+{
+	const char *p_name=NULL;
+	pParams->GetText("name",&p_name,true);
+	int count=PrefetchFromAccessLog(p_name);
+	Dbg_Message("Prefetched %d files from access log %s",count,p_name);
+	return count>0;
+}
+
+} // namespace File
@@ -0,0 +1,80 @@
+/*****************************************************************************
+**																			**
+**			              Neversoft Entertainment	                        **
+**																		   	**
+**				   Copyright (C) 1999 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		Sys Library												**
+**																			**
+**	Module:			File													**
+**																			**
+**	File name:		sys/file/prefetch.h										**
+**																			**
+**	Description:	Read-ahead hints for files we know will be loaded soon,	**
+**					and an access log that records which files a level		**
+**					load actually touched so that the next load of the		**
+**					same level can hint all of them up front.				**
+**																			**
+*****************************************************************************/
+
+#ifndef	__SYS_FILE_PREFETCH_H
+#define	__SYS_FILE_PREFETCH_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#ifndef __CORE_DEFINES_H
+#include <core/defines.h>
+#endif
+
+/*****************************************************************************
+**							Forward Declarations							**
+*****************************************************************************/
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
+namespace File
+{
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// p_dataRoot is the host directory that game file names (eg "pre\\skateshop.pre")
+// are relative to. Access logs are only read and written if p_logDir is given.
+void	InitPrefetch(const char *p_dataRoot, const char *p_logDir);
+void	DeInitPrefetch();
+
+// Asks the OS to start reading the given files in the background. Files that are
+// missing are silently skipped. The single file version returns whether the file
+// was hinted, and the list version the number of files hinted.
+bool	Prefetch(const char *p_fileName);
+int		Prefetch(const char **pp_fileNames, int numFiles);
+
+// As Prefetch, but takes a path on the host file system rather than a game file name.
+bool	PrefetchHostFile(const char *p_path);
+
+// Called by the loaders for every file they read from the host file system.
+void	RecordFileAccess(const char *p_fileName);
+
+// Everything recorded between Begin and End is saved as the named log, which
+// PrefetchFromAccessLog then replays as hints, in the order it was loaded.
+void	BeginAccessLog(const char *p_logName);
+void	EndAccessLog();
+int		PrefetchFromAccessLog(const char *p_logName);
+
+bool	ScriptPrefetchFiles(Script::CStruct *pParams, Script::CScript *pScript);
+bool	ScriptBeginAccessLog(Script::CStruct *pParams, Script::CScript *pScript);
+bool	ScriptEndAccessLog(Script::CStruct *pParams, Script::CScript *pScript);
+bool	ScriptPrefetchFromAccessLog(Script::CStruct *pParams, Script::CScript *pScript);
+
+} // namespace File
+
+#endif  // __SYS_FILE_PREFETCH_H
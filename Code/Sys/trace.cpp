@@ -0,0 +1,293 @@
+/*****************************************************************************
+**																			**
+**					   	  Neversoft Entertainment							**
+**																		   	**
+**				   Copyright (C) 2000 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		SysLib (System Library)									**
+**																			**
+**	Module:			Sys  													**
+**																			**
+**	File name:		sys/trace.cpp											**
+**																			**
+**	Description:	Span capture and Chrome trace export					**
+**																			**
+*****************************************************************************/
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <core/defines.h>
+#include <sys/trace.h>
+#include <gel/scripting/struct.h>
+
+#include <atomic>
+#include <chrono>
+
+/*****************************************************************************
+**								  Externals									**
+*****************************************************************************/
+
+namespace Trace
+{
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+enum
+{
+	MAX_SPANS		= 16384,
+	MAX_DETAIL_LEN	= 48,
+};
+
+/*****************************************************************************
+**								Private Types								**
+*****************************************************************************/
+
+struct SSpan
+{
+	const char *	mpCategory;
+	const char *	mpName;
+	uint64			mStart;
+	uint64			mEnd;
+	int				mThread;
+	char			mpDetail[MAX_DETAIL_LEN];
+};
+
+/*****************************************************************************
+**								 Private Data								**
+*****************************************************************************/
+
+static SSpan					sp_spans[MAX_SPANS];
+static std::atomic< uint32 >	s_num_spans( 0 );
+static std::atomic< bool >		s_capturing( false );
+static uint64					s_capture_start = 0;
+
+static std::atomic< int >		s_num_threads( 0 );
+static thread_local int			s_thread_id = -1;
+
+/*****************************************************************************
+**							  Private Functions								**
+*****************************************************************************/
+
+static int s_get_thread_id( void )
+{
+	if( s_thread_id < 0 )
+	{
+		s_thread_id = s_num_threads.fetch_add( 1 );
+	}
+	return s_thread_id;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// Detail strings are mostly file names, full of backslashes.
+static void s_write_escaped( FILE *p_file, const char *p_string )
+{
+	for( ; *p_string; ++p_string )
+	{
+		char ch = *p_string;
+		if( ch == '\\' || ch == '"' )
+		{
+			fputc( '\\', p_file );
+			fputc( ch, p_file );
+		}
+		else if( (uint8)ch >= 0x20 )
+		{
+			fputc( ch, p_file );
+		}
+	}
+}
+
+/*****************************************************************************
+**							  Public Functions								**
+*****************************************************************************/
+
+CScope::CScope( const char *p_category, const char *p_name, const char *p_detail )
+{
+	if( s_capturing.load( std::memory_order_relaxed ))
+	{
+		mp_category = p_category;
+		mp_name = p_name;
+		mp_detail = p_detail;
+		m_start = GetTimeUS();
+	}
+	else
+	{
+		mp_name = NULL;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+CScope::~CScope()
+{
+	if( mp_name )
+	{
+		AddSpan( mp_category, mp_name, mp_detail, m_start, GetTimeUS());
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+uint64 GetTimeUS( void )
+{
+	return (uint64)std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void StartCapture( void )
+{
+	s_get_thread_id();
+	s_num_spans = 0;
+	s_capture_start = GetTimeUS();
+	s_capturing = true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void StopCapture( void )
+{
+	s_capturing = false;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool IsCapturing( void )
+{
+	return s_capturing.load( std::memory_order_relaxed );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+void AddSpan( const char *p_category, const char *p_name, const char *p_detail, uint64 startUS, uint64 endUS )
+{
+	if( !s_capturing.load( std::memory_order_relaxed ))
+	{
+		return;
+	}
+
+	SSpan *p_span = &sp_spans[s_num_spans.fetch_add( 1 ) % MAX_SPANS];
+	p_span->mpCategory = p_category;
+	p_span->mpName = p_name;
+	p_span->mStart = startUS;
+	p_span->mEnd = endUS;
+	p_span->mThread = s_get_thread_id();
+	if( p_detail )
+	{
+		strncpy( p_span->mpDetail, p_detail, MAX_DETAIL_LEN - 1 );
+		p_span->mpDetail[MAX_DETAIL_LEN - 1] = 0;
+	}
+	else
+	{
+		p_span->mpDetail[0] = 0;
+	}
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+bool WriteChromeTrace( const char *p_fileName )
+{
+	Dbg_MsgAssert( !IsCapturing(), ( "Stop the trace capture before writing it" ));
+
+	FILE *p_file = fopen( p_fileName, "w" );
+	if( !p_file )
+	{
+		Dbg_Message( "Could not open %s for the trace", p_fileName );
+		return false;
+	}
+
+	uint32 total = s_num_spans;
+	uint32 first = total > MAX_SPANS ? total - MAX_SPANS : 0;
+
+	fprintf( p_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+	for( uint32 i = first; i < total; ++i )
+	{
+		const SSpan &span = sp_spans[i % MAX_SPANS];
+		fprintf( p_file, "%s{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%llu,\"dur\":%llu",
+				 i == first ? "" : ",\n", span.mThread, span.mpCategory, span.mpName,
+				 (unsigned long long)( span.mStart - s_capture_start ),
+				 (unsigned long long)( span.mEnd - span.mStart ));
+		if( span.mpDetail[0] )
+		{
+			fprintf( p_file, ",\"args\":{\"detail\":\"" );
+			s_write_escaped( p_file, span.mpDetail );
+			fprintf( p_file, "\"}" );
+		}
+		fprintf( p_file, "}" );
+	}
+	fprintf( p_file, "\n]}\n" );
+	fclose( p_file );
+
+	Dbg_Message( "Wrote %d trace spans to %s%s", total - first, p_fileName, first ? " (ring buffer wrapped)" : "" );
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | StartTrace | Starts capturing file and asset load timings. Use
+// StopTrace to save them.
+bool ScriptStartTrace( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	StartCapture();
+	return true;
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+// @script | StopTrace | Stops the capture started by StartTrace and writes it
+// in the Chrome trace event format (load it in chrome://tracing or Perfetto)
+// @parmopt string | file | "trace.json" | File to write the trace to
+bool ScriptStopTrace( Script::CStruct *pParams, Script::CScript *pScript )
+{
+	StopCapture();
+
+	const char *p_file_name = "trace.json";
+	pParams->GetString( CRCD(0x7360c9ef,"file"), &p_file_name );
+	return WriteChromeTrace( p_file_name );
+}
+
+/******************************************************************/
+/*                                                                */
+/*                                                                */
+/******************************************************************/
+
+} // namespace Trace
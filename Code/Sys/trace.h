@@ -0,0 +1,86 @@
+/*****************************************************************************
+**																			**
+**					   	  Neversoft Entertainment							**
+**																		   	**
+**				   Copyright (C) 2000 - All Rights Reserved				   	**
+**																			**
+******************************************************************************
+**																			**
+**	Project:		SysLib (System Library)									**
+**																			**
+**	Module:			Sys  													**
+**																			**
+**	File name:		sys/trace.h												**
+**																			**
+**	Description:	Captures timed spans (file opens, reads, decompression,	**
+**					parsing...) into a ring buffer, and writes them out in	**
+**					the Chrome trace event format, for viewing in			**
+**					chrome://tracing or Perfetto.							**
+**																			**
+*****************************************************************************/
+
+#ifndef __SYS_TRACE_H
+#define __SYS_TRACE_H
+
+/*****************************************************************************
+**							  	  Includes									**
+*****************************************************************************/
+
+#ifndef __CORE_DEFINES_H
+#include <core/defines.h>
+#endif
+
+/*****************************************************************************
+**								   Defines									**
+*****************************************************************************/
+
+namespace Script
+{
+	class CStruct;
+	class CScript;
+}
+
+namespace Trace
+{
+
+/*****************************************************************************
+**							Class Definitions								**
+*****************************************************************************/
+
+// Records a span from construction to destruction, if a capture is running.
+// p_category and p_name must be string literals. p_detail (eg a file name) is
+// copied when the span ends, so it only has to outlive the scope.
+class CScope
+{
+public:
+					CScope( const char *p_category, const char *p_name, const char *p_detail = NULL );
+					~CScope();
+
+private:
+	const char *	mp_category;
+	const char *	mp_name;
+	const char *	mp_detail;
+	uint64			m_start;
+};
+
+/*****************************************************************************
+**							   Public Prototypes							**
+*****************************************************************************/
+
+// Spans may be added from any thread. Start and Stop are main thread only.
+void	StartCapture( void );
+void	StopCapture( void );
+bool	IsCapturing( void );
+
+uint64	GetTimeUS( void );
+void	AddSpan( const char *p_category, const char *p_name, const char *p_detail, uint64 startUS, uint64 endUS );
+
+// Writes whatever is left in the ring buffer, oldest first.
+bool	WriteChromeTrace( const char *p_fileName );
+
+bool	ScriptStartTrace( Script::CStruct *pParams, Script::CScript *pScript );
+bool	ScriptStopTrace( Script::CStruct *pParams, Script::CScript *pScript );
+
+} // namespace Trace
+
+#endif	// __SYS_TRACE_H
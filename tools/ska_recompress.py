@@ -0,0 +1,523 @@
+#!/usr/bin/env python3
+"""
+THUG Animation Recompressor - Standalone Tool
+
+Re-encodes compressed skeletal animations (.ska files exported with the
+compress table, nxBONEDANIMFLAGS_USECOMPRESSTABLE) with fewer keys:
+- Every bone's rotation and translation keys are reduced separately
+- A key is only dropped if the pose stays within a positional and an angular
+  error bound, measured in model space through the skeleton hierarchy, at
+  every frame, against the original anim
+- Keys are rewritten in the smallest encoding that decodes to the same value
+
+The output sets nxBONEDANIMFLAGS_REDUCEDKEYS.  The key encoding is the one
+CBonedAnimFrameData::plat_read_compressed_stream already reads, so the seek
+table, the SIMD decode and the anim cache all work on it unchanged.
+
+Based on the key reader in Code/Gfx/BonedAnim.cpp and the pose evaluation in
+CSkeleton::Update() (Code/Gfx/Skeleton.cpp).
+
+Usage:
+    python3 ska_recompress.py in.ska out.ska --skeleton thps5_human.ske
+        [--position-error 0.1] [--angle-error 0.25]
+        [--qtable q48.bin] [--ttable t48.bin]
+
+Without a skeleton, each bone's error is measured in its parent's space.
+The q48/t48 tables are only needed if the anim uses table lookups.
+"""
+
+import argparse
+import math
+import struct
+import sys
+from typing import Dict, List, Optional, Tuple
+
+
+# ============================================================================
+# Format
+# ============================================================================
+
+FLAG_PLATFORM = 1 << 28
+FLAG_CAMERADATA = 1 << 27
+FLAG_OBJECTANIMDATA = 1 << 24
+FLAG_USECOMPRESSTABLE = 1 << 23
+FLAG_HIRESFRAMEPOINTERS = 1 << 22
+FLAG_PARTIALANIM = 1 << 19
+FLAG_REDUCEDKEYS = 1 << 17
+
+QUAT_SCALE = 16384.0
+TRANS_SCALE = 32.0
+
+MAX_SHORT_TIMESTAMP = 0x07ff       # for the table and byte Q key forms
+MAX_TIMESTAMP = 0x3fff             # for the plain Q key form
+MAX_BYTE_TIMESTAMP = 0x3f          # for the T key form with the time in the flags
+
+
+class AnimFormatError(Exception):
+    """The file isn't an anim this tool can read"""
+
+
+class QKey:
+    """A rotation key, as read by get_compressed_q_frame()"""
+
+    def __init__(self, timestamp: int, q: Tuple[int, int, int], sign: int):
+        self.timestamp = timestamp
+        self.q = q
+        self.sign = sign
+
+
+class TKey:
+    """A translation key, as read by get_compressed_t_frame()"""
+
+    def __init__(self, timestamp: int, t: Tuple[int, int, int]):
+        self.timestamp = timestamp
+        self.t = t
+
+
+class Anim:
+    """A compressed anim, split into its keys and the parts kept as they are"""
+
+    def __init__(self):
+        self.version = 0
+        self.flags = 0
+        self.duration = 0.0
+        self.num_custom_keys = 0
+        self.partial_data = b''
+        self.custom_key_data = b''
+        self.q_keys: List[List[QKey]] = []
+        self.t_keys: List[List[TKey]] = []
+
+    @property
+    def num_bones(self) -> int:
+        return len(self.q_keys)
+
+
+def _align(offset: int) -> int:
+    return (offset + 3) & ~3
+
+
+def load_table(path: str) -> List[Tuple[int, int, int]]:
+    """Reads a q48 or t48 table: 256 entries of x, y, z and a count, as shorts"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < 256 * 8:
+        raise AnimFormatError(f"{path} is too short for a compress table")
+    return [struct.unpack_from('<hhh', data, i * 8) for i in range(256)]
+
+
+def _read_q_key(data: bytes, pos: int, q_table) -> Tuple[QKey, int]:
+    bits = struct.unpack_from('<H', data, pos)[0]
+    pos += 2
+    timestamp = bits & 0x3fff
+    sign = 1 if bits & 0x8000 else 0
+
+    if bits & 0x4000:
+        timestamp &= MAX_SHORT_TIMESTAMP
+        if not bits & 0x3800:
+            if q_table is None:
+                raise AnimFormatError("The anim uses the q48 table; pass --qtable")
+            q = q_table[data[pos]]
+            pos += 1
+        else:
+            q = []
+            for byte_bit in (0x2000, 0x1000, 0x0800):
+                if bits & byte_bit:
+                    q.append(data[pos])
+                    pos += 1
+                else:
+                    q.append(struct.unpack_from('<h', data, pos)[0])
+                    pos += 2
+            q = tuple(q)
+    else:
+        q = struct.unpack_from('<hhh', data, pos)
+        pos += 6
+
+    return QKey(timestamp, q, sign), pos
+
+
+def _read_t_key(data: bytes, pos: int, t_table) -> Tuple[TKey, int]:
+    flags = data[pos]
+    pos += 1
+
+    if flags & 0x40:
+        timestamp = flags & 0x3f
+    else:
+        timestamp = struct.unpack_from('<H', data, pos)[0]
+        pos += 2
+
+    if flags & 0x80:
+        if t_table is None:
+            raise AnimFormatError("The anim uses the t48 table; pass --ttable")
+        t = t_table[data[pos]]
+        pos += 1
+    else:
+        t = struct.unpack_from('<hhh', data, pos)
+        pos += 6
+
+    return TKey(timestamp, t), pos
+
+
+def read_anim(data: bytes, q_table=None, t_table=None) -> Anim:
+    """Parses a .ska the way PostLoad() and plat_read_compressed_stream() do"""
+    anim = Anim()
+    anim.version, anim.flags, anim.duration = struct.unpack_from('<IIf', data, 0)
+
+    if anim.flags & FLAG_PLATFORM or not anim.flags & FLAG_USECOMPRESSTABLE:
+        raise AnimFormatError("Only anims exported with the compress table can be recompressed")
+    if anim.flags & (FLAG_CAMERADATA | FLAG_OBJECTANIMDATA | FLAG_HIRESFRAMEPOINTERS):
+        raise AnimFormatError("Hi res anims aren't compressed")
+
+    num_bones, _, _, anim.num_custom_keys = struct.unpack_from('<IIII', data, 12)
+    q_size, t_size = struct.unpack_from('<II', data, 28)
+    pos = 36
+    q_sizes = struct.unpack_from(f'<{num_bones}H', data, pos)
+    pos += num_bones * 2
+    t_sizes = struct.unpack_from(f'<{num_bones}H', data, pos)
+    pos = _align(pos + num_bones * 2)
+
+    if anim.flags & FLAG_PARTIALANIM:
+        start = pos
+        partial_bones = struct.unpack_from('<I', data, pos)[0]
+        pos += 4 + ((partial_bones - 1) // 32 + 1) * 4
+        anim.partial_data = data[start:pos]
+    pos = _align(pos)
+
+    for sizes, total, key_list, reader, table in ((q_sizes, q_size, anim.q_keys, _read_q_key, q_table),
+                                                  (t_sizes, t_size, anim.t_keys, _read_t_key, t_table)):
+        end = pos + total
+        for size in sizes:
+            bone_end = pos + size
+            keys = []
+            while pos < bone_end:
+                key, pos = reader(data, pos, table)
+                keys.append(key)
+            if pos != bone_end or not keys:
+                raise AnimFormatError("Bad per bone key sizes")
+            key_list.append(keys)
+        pos = end
+
+    anim.custom_key_data = data[_align(pos):]
+    return anim
+
+
+def _table_lookup(table) -> Dict[Tuple[int, int, int], int]:
+    lookup = {}
+    if table is not None:
+        for index, entry in enumerate(table):
+            lookup.setdefault(tuple(entry), index)
+    return lookup
+
+
+def _write_q_key(key: QKey, q_lookup) -> bytes:
+    sign = 0x8000 if key.sign else 0
+    if key.timestamp > MAX_TIMESTAMP:
+        raise AnimFormatError(f"Key time {key.timestamp} is too big to encode")
+
+    if key.timestamp <= MAX_SHORT_TIMESTAMP:
+        index = q_lookup.get(tuple(key.q))
+        if index is not None:
+            return struct.pack('<HB', sign | 0x4000 | key.timestamp, index)
+
+        # A mix of bytes and shorts; with no bytes it would read as a table lookup
+        bits = 0
+        body = b''
+        for value, byte_bit in zip(key.q, (0x2000, 0x1000, 0x0800)):
+            if 0 <= value <= 0xff:
+                bits |= byte_bit
+                body += struct.pack('<B', value)
+            else:
+                body += struct.pack('<h', value)
+        if bits:
+            return struct.pack('<H', sign | 0x4000 | bits | key.timestamp) + body
+
+    return struct.pack('<Hhhh', sign | key.timestamp, *key.q)
+
+
+def _write_t_key(key: TKey, t_lookup) -> bytes:
+    if key.timestamp <= MAX_BYTE_TIMESTAMP:
+        head = struct.pack('<B', 0x40 | key.timestamp)
+    else:
+        head = struct.pack('<BH', 0, key.timestamp)
+
+    index = t_lookup.get(tuple(key.t))
+    if index is not None:
+        return bytes([head[0] | 0x80]) + head[1:] + struct.pack('<B', index)
+    return head + struct.pack('<hhh', *key.t)
+
+
+def write_anim(anim: Anim, q_table=None, t_table=None) -> bytes:
+    """The inverse of read_anim(), with the smallest encoding of every key"""
+    q_lookup = _table_lookup(q_table)
+    t_lookup = _table_lookup(t_table)
+
+    q_tracks = [b''.join(_write_q_key(k, q_lookup) for k in keys) for keys in anim.q_keys]
+    t_tracks = [b''.join(_write_t_key(k, t_lookup) for k in keys) for keys in anim.t_keys]
+    for track in q_tracks + t_tracks:
+        if len(track) > 0xffff:
+            raise AnimFormatError("A bone has too many keys for its size to fit in 16 bits")
+
+    num_q = sum(len(keys) for keys in anim.q_keys)
+    num_t = sum(len(keys) for keys in anim.t_keys)
+    q_data = b''.join(q_tracks)
+    t_data = b''.join(t_tracks)
+
+    out = bytearray(struct.pack('<IIf', anim.version, anim.flags, anim.duration))
+    out += struct.pack('<IIII', anim.num_bones, num_q, num_t, anim.num_custom_keys)
+    out += struct.pack('<II', len(q_data), len(t_data))
+    out += struct.pack(f'<{anim.num_bones}H', *(len(t) for t in q_tracks))
+    out += struct.pack(f'<{anim.num_bones}H', *(len(t) for t in t_tracks))
+    out += bytes(_align(len(out)) - len(out))
+    out += anim.partial_data
+    out += bytes(_align(len(out)) - len(out))
+    out += q_data
+    out += t_data
+    out += bytes(_align(len(out)) - len(out))
+    out += anim.custom_key_data
+    return bytes(out)
+
+
+def read_skeleton_parents(data: bytes) -> List[int]:
+    """The parent of each bone in a version 2 .ske, or -1 for the root"""
+    version, _, num_bones = struct.unpack_from('<iIi', data, 0)
+    if version < 2:
+        raise AnimFormatError("Only version 2 skeletons are supported")
+    names = struct.unpack_from(f'<{num_bones}I', data, 12)
+    parent_names = struct.unpack_from(f'<{num_bones}I', data, 12 + num_bones * 4)
+    index_of = {name: i for i, name in enumerate(names)}
+
+    parents = []
+    for i, parent_name in enumerate(parent_names):
+        parent = index_of.get(parent_name, -1)
+        # CSkeleton::Update() never applies a parent to bone 0
+        parents.append(-1 if i == 0 or parent >= i else parent)
+    return parents
+
+
+# ============================================================================
+# Pose evaluation
+# ============================================================================
+
+def _q_key_quat(key: QKey) -> Tuple[float, float, float, float]:
+    # get_rotation_from_key()
+    x, y, z = (c / QUAT_SCALE for c in key.q)
+    w = math.sqrt(max(0.0, 1.0 - x * x - y * y - z * z))
+    return (x, y, z, -w if key.sign else w)
+
+
+def _t_key_vector(key: TKey) -> Tuple[float, float, float]:
+    return tuple(c / TRANS_SCALE for c in key.t)
+
+
+def _nlerp(q1, q2, alpha):
+    # Mth::FastSlerp()
+    if sum(a * b for a, b in zip(q1, q2)) < 0.0:
+        q2 = tuple(-c for c in q2)
+    q = tuple(a + (b - a) * alpha for a, b in zip(q1, q2))
+    scale = 1.0 / math.sqrt(sum(c * c for c in q))
+    return tuple(c * scale for c in q)
+
+
+def _sample_track(times: List[int], values: list, frames: range, lerp) -> list:
+    """The value at each frame, holding the first and last keys at the ends"""
+    samples = []
+    k = 0
+    for frame in frames:
+        while k + 1 < len(times) and times[k + 1] <= frame:
+            k += 1
+        if k + 1 == len(times) or frame <= times[k]:
+            samples.append(values[k])
+        else:
+            alpha = (frame - times[k]) / (times[k + 1] - times[k])
+            samples.append(lerp(values[k], values[k + 1], alpha))
+    return samples
+
+
+def _lerp(a, b, alpha):
+    return tuple(x + (y - x) * alpha for x, y in zip(a, b))
+
+
+def _quat_matrix(q):
+    # The row major matrix sQuatVecToMatrix() builds
+    x, y, z, w = q
+    return ((1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (z * x + w * y)),
+            (2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)),
+            (2 * (z * x - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)))
+
+
+def _compose(rot, pos, parent):
+    # (*p_currentMatrix) *= parentMatrix, with row vectors
+    prot, ppos = parent
+    r = tuple(tuple(sum(rot[i][k] * prot[k][j] for k in range(3)) for j in range(3)) for i in range(3))
+    p = tuple(sum(pos[k] * prot[k][j] for k in range(3)) + ppos[j] for j in range(3))
+    return r, p
+
+
+def _distance(a, b) -> float:
+    return math.sqrt(sum((x - y) * (x - y) for x, y in zip(a, b)))
+
+
+def _rotation_angle(a, b) -> float:
+    trace = sum(a[i][j] * b[i][j] for i in range(3) for j in range(3))
+    return math.acos(max(-1.0, min(1.0, (trace - 1.0) * 0.5)))
+
+
+# ============================================================================
+# Key reduction
+# ============================================================================
+
+class Reducer:
+    """Greedily drops keys while every bone stays within the error bounds.
+
+    The current pose of every bone at every frame is kept up to date as keys
+    are dropped.  Dropping a key only changes the frames between the keys on
+    either side of it, for the bone and the bones below it, so only those are
+    evaluated.  Bones are reduced root first, and every drop is checked against
+    the original pose, so the errors never add up past the bounds.
+    """
+
+    def __init__(self, anim: Anim, parents: List[int], position_error: float, angle_error: float):
+        self.anim = anim
+        self.parents = parents
+        self.position_error = position_error
+        self.angle_error = angle_error
+        self.frames = range(max(max(k[-1].timestamp for k in anim.q_keys),
+                                max(k[-1].timestamp for k in anim.t_keys)) + 1)
+
+        self.subtrees = [[b] for b in range(anim.num_bones)]
+        for bone in range(anim.num_bones - 1, -1, -1):
+            parent = parents[bone]
+            if parent >= 0:
+                self.subtrees[parent] += self.subtrees[bone]
+        for subtree in self.subtrees:
+            subtree.sort()
+
+        self.rotations = [_sample_track([k.timestamp for k in keys], [_q_key_quat(k) for k in keys],
+                                        self.frames, _nlerp)
+                          for keys in anim.q_keys]
+        self.translations = [_sample_track([k.timestamp for k in keys], [_t_key_vector(k) for k in keys],
+                                           self.frames, _lerp)
+                             for keys in anim.t_keys]
+        self.reference = [[None] * anim.num_bones for _ in self.frames]
+        for frame in self.frames:
+            for bone in range(anim.num_bones):
+                self.reference[frame][bone] = self._model(frame, bone, self.reference[frame])
+        self.current = [list(pose) for pose in self.reference]
+
+    def _model(self, frame: int, bone: int, pose: list, rotation=None, translation=None):
+        rot = _quat_matrix(rotation or self.rotations[bone][frame])
+        pos = translation or self.translations[bone][frame]
+        parent = self.parents[bone]
+        return _compose(rot, pos, pose[parent]) if parent >= 0 else (rot, pos)
+
+    def _try(self, bone: int, frames: range, rotations: Optional[list], translations: Optional[list]) -> bool:
+        """Evaluates the bone's subtree with new local values over the frames, and keeps
+        them if they are within the bounds"""
+        poses = []
+        for i, frame in enumerate(frames):
+            pose = list(self.current[frame])
+            for b in self.subtrees[bone]:
+                if b == bone:
+                    pose[b] = self._model(frame, b, pose,
+                                          rotations[i] if rotations else None,
+                                          translations[i] if translations else None)
+                else:
+                    pose[b] = self._model(frame, b, pose)
+                ref_rot, ref_pos = self.reference[frame][b]
+                rot, pos = pose[b]
+                if _distance(pos, ref_pos) > self.position_error or _rotation_angle(rot, ref_rot) > self.angle_error:
+                    return False
+            poses.append(pose)
+
+        for i, frame in enumerate(frames):
+            self.current[frame] = poses[i]
+            if rotations:
+                self.rotations[bone][frame] = rotations[i]
+            if translations:
+                self.translations[bone][frame] = translations[i]
+        return True
+
+    def _reduce_track(self, bone: int, keys: list, value_of, lerp, is_rotation: bool) -> list:
+        kept = list(keys)
+        i = 1
+        while i < len(kept):
+            prev = kept[i - 1]
+            last = i + 1 == len(kept)
+            end = self.frames.stop if last else kept[i + 1].timestamp
+            span = range(prev.timestamp + 1, end)
+            times = [prev.timestamp] if last else [prev.timestamp, kept[i + 1].timestamp]
+            values = [value_of(k) for k in ([prev] if last else [prev, kept[i + 1]])]
+            samples = _sample_track(times, values, span, lerp)
+
+            if self._try(bone, span, samples if is_rotation else None, None if is_rotation else samples):
+                del kept[i]
+            else:
+                i += 1
+        return kept
+
+    def reduce(self) -> Anim:
+        for bone in range(self.anim.num_bones):
+            self.anim.q_keys[bone] = self._reduce_track(bone, self.anim.q_keys[bone], _q_key_quat, _nlerp, True)
+            self.anim.t_keys[bone] = self._reduce_track(bone, self.anim.t_keys[bone], _t_key_vector, _lerp, False)
+        self.anim.flags |= FLAG_REDUCEDKEYS
+        return self.anim
+
+
+def recompress(data: bytes, skeleton: Optional[bytes] = None, position_error: float = 0.1,
+               angle_error_degrees: float = 0.25, q_table=None, t_table=None) -> bytes:
+    """Returns the recompressed .ska"""
+    anim = read_anim(data, q_table, t_table)
+    if skeleton is not None:
+        parents = read_skeleton_parents(skeleton)
+        if len(parents) != anim.num_bones:
+            raise AnimFormatError(f"The skeleton has {len(parents)} bones, the anim {anim.num_bones}")
+    else:
+        parents = [-1] * anim.num_bones
+
+    Reducer(anim, parents, position_error, math.radians(angle_error_degrees)).reduce()
+    return write_anim(anim, q_table, t_table)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Drop anim keys within an error bound")
+    parser.add_argument('input', help="compressed .ska to read")
+    parser.add_argument('output', help=".ska to write")
+    parser.add_argument('--skeleton', help=".ske the anim plays on, to measure the error in model space")
+    parser.add_argument('--position-error', type=float, default=0.1,
+                        help="largest change in any bone's position, in inches (default 0.1)")
+    parser.add_argument('--angle-error', type=float, default=0.25,
+                        help="largest change in any bone's orientation, in degrees (default 0.25)")
+    parser.add_argument('--qtable', help="q48 table, if the anim uses it")
+    parser.add_argument('--ttable', help="t48 table, if the anim uses it")
+    args = parser.parse_args()
+
+    try:
+        with open(args.input, 'rb') as f:
+            data = f.read()
+        skeleton = None
+        if args.skeleton:
+            with open(args.skeleton, 'rb') as f:
+                skeleton = f.read()
+        q_table = load_table(args.qtable) if args.qtable else None
+        t_table = load_table(args.ttable) if args.ttable else None
+
+        before = read_anim(data, q_table, t_table)
+        out = recompress(data, skeleton, args.position_error, args.angle_error, q_table, t_table)
+        after = read_anim(out, q_table, t_table)
+    except (AnimFormatError, OSError, struct.error) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    with open(args.output, 'wb') as f:
+        f.write(out)
+
+    def count(keys):
+        return sum(len(k) for k in keys)
+
+    print(f"Q keys: {count(before.q_keys)} -> {count(after.q_keys)}")
+    print(f"T keys: {count(before.t_keys)} -> {count(after.t_keys)}")
+    print(f"Size:   {len(data)} -> {len(out)} bytes ({100.0 * len(out) / len(data):.1f}%)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
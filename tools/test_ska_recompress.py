@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Test script for the THUG animation recompressor
+
+Builds a small skeleton and anim in memory, recompresses it, and checks the
+result reads back, is smaller, and stays within the error bounds.
+"""
+
+import math
+import struct
+import sys
+
+from ska_recompress import (
+    FLAG_USECOMPRESSTABLE,
+    FLAG_REDUCEDKEYS,
+    Anim,
+    QKey,
+    TKey,
+    Reducer,
+    read_anim,
+    read_skeleton_parents,
+    write_anim,
+    recompress,
+)
+
+# Every anim the exporter writes has these
+FLAG_COMPRESSEDTIME = 1 << 26
+FLAG_PREROTATEDROOT = 1 << 25
+
+NUM_FRAMES = 120
+POSITION_ERROR = 0.1
+ANGLE_ERROR = 0.25
+
+
+def make_skeleton(num_bones: int) -> bytes:
+    """A chain of bones, each the parent of the next"""
+    names = [0x1000 + i for i in range(num_bones)]
+    parents = [0] + names[:-1]
+    data = struct.pack('<iIi', 2, 0, num_bones)
+    data += struct.pack(f'<{num_bones}I', *names)
+    data += struct.pack(f'<{num_bones}I', *parents)
+    data += struct.pack(f'<{num_bones}I', *names)
+    for i in range(num_bones):
+        data += struct.pack('<8f', 0.0, 0.0, 0.0, 1.0, 0.0, 10.0 * i, 0.0, 1.0)
+    return data
+
+
+def make_anim(num_bones: int, table=None) -> Anim:
+    """A key on every frame: a slow swing about Z, a still bone and a moving root"""
+    anim = Anim()
+    anim.version = 2
+    anim.flags = FLAG_USECOMPRESSTABLE | FLAG_COMPRESSEDTIME | FLAG_PREROTATEDROOT
+    anim.duration = NUM_FRAMES / 60.0
+    anim.custom_key_data = b'custom keys are copied as they are'
+
+    for bone in range(num_bones):
+        q_keys = []
+        t_keys = []
+        for frame in range(NUM_FRAMES):
+            angle = 0.0 if bone == 1 else 0.5 * math.sin(frame * 2.0 * math.pi / NUM_FRAMES)
+            q = (0, 0, int(math.sin(angle * 0.5) * 16384.0))
+            q_keys.append(QKey(frame, q, 0))
+            t = (int(frame * 4) if bone == 0 else 0, 320, 0)
+            t_keys.append(TKey(frame, t))
+        anim.q_keys.append(q_keys)
+        anim.t_keys.append(t_keys)
+
+    if table is not None:
+        anim.q_keys[1][0].q = table[5]
+        anim.t_keys[1][0].t = table[7]
+    return anim
+
+
+def poses(data: bytes, skeleton: bytes):
+    """The model space pose at every frame"""
+    anim = read_anim(data)
+    reducer = Reducer(anim, read_skeleton_parents(skeleton), POSITION_ERROR, math.radians(ANGLE_ERROR))
+    return reducer.reference
+
+
+def test_round_trip():
+    print("1. Writing and reading back every key encoding...")
+    table = [(i, -i, 2 * i) for i in range(256)]
+    anim = make_anim(3, table)
+    data = write_anim(anim, table, table)
+    again = read_anim(data, table, table)
+
+    assert again.flags == anim.flags
+    assert again.custom_key_data == anim.custom_key_data
+    for bone in range(3):
+        assert [(k.timestamp, tuple(k.q), k.sign) for k in again.q_keys[bone]] == \
+               [(k.timestamp, tuple(k.q), k.sign) for k in anim.q_keys[bone]]
+        assert [(k.timestamp, tuple(k.t)) for k in again.t_keys[bone]] == \
+               [(k.timestamp, tuple(k.t)) for k in anim.t_keys[bone]]
+    assert write_anim(again, table, table) == data
+    print("   ✓ Round trip passed")
+
+
+def test_recompress():
+    print("2. Recompressing...")
+    num_bones = 4
+    skeleton = make_skeleton(num_bones)
+    data = write_anim(make_anim(num_bones))
+    out = recompress(data, skeleton, POSITION_ERROR, ANGLE_ERROR)
+
+    before = read_anim(data)
+    after = read_anim(out)
+    num_before = sum(len(k) for k in before.q_keys + before.t_keys)
+    num_after = sum(len(k) for k in after.q_keys + after.t_keys)
+    print(f"   Keys: {num_before} -> {num_after}")
+    print(f"   Size: {len(data)} -> {len(out)} bytes")
+
+    assert after.flags & FLAG_REDUCEDKEYS
+    assert after.custom_key_data == before.custom_key_data
+    assert len(out) * 2 < len(data)
+    # The still bone and the still translations come down to a single key
+    assert len(after.q_keys[1]) == 1
+    assert len(after.t_keys[2]) == 1
+    # Every track still starts where it did
+    assert all(k[0].timestamp == 0 for k in after.q_keys + after.t_keys)
+
+    print("3. Checking the error bounds...")
+    reference = poses(data, skeleton)
+    reduced = poses(out, skeleton)
+    worst_position = 0.0
+    worst_angle = 0.0
+    for frame in range(NUM_FRAMES):
+        for bone in range(num_bones):
+            ref_rot, ref_pos = reference[frame][bone]
+            rot, pos = reduced[frame][bone]
+            worst_position = max(worst_position, math.sqrt(sum((a - b) ** 2 for a, b in zip(pos, ref_pos))))
+            trace = sum(rot[i][j] * ref_rot[i][j] for i in range(3) for j in range(3))
+            worst_angle = max(worst_angle, math.degrees(math.acos(max(-1.0, min(1.0, (trace - 1.0) * 0.5)))))
+    print(f"   Worst position error: {worst_position:.4f}")
+    print(f"   Worst angle error:    {worst_angle:.4f}")
+    assert worst_position <= POSITION_ERROR + 1e-6
+    assert worst_angle <= ANGLE_ERROR + 1e-6
+    print("   ✓ Recompression passed")
+
+
+if __name__ == "__main__":
+    try:
+        test_round_trip()
+        test_recompress()
+        print("\n✓ All tests passed!")
+        sys.exit(0)
+    except Exception as e:
+        print(f"\n✗ Error: {e}", file=sys.stderr)
+        import traceback
+        traceback.print_exc()
+        sys.exit(1)